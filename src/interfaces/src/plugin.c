@@ -16,7 +16,9 @@
 #include "netlink/socket.h"
 #include "plugin/common.h"
 #include "plugin/context.h"
-#include "plugin/data/interfaces/interface_state.h"
+#include "plugin/data/interfaces/interface_state_table.h"
+#include "plugin/data/interfaces/link_index.h"
+#include "plugin/data/interfaces/object_index.h"
 
 // startup DS
 #include "plugin/startup/load.h"
@@ -27,6 +29,9 @@
 #include "plugin/running/store.h"
 
 // subscription
+#include "plugin/api/interfaces/change.h"
+#include "plugin/api/interfaces/lookup.h"
+#include "plugin/api/interfaces/plan.h"
 #include "plugin/subscription/change.h"
 #include "plugin/subscription/operational.h"
 #include "plugin/subscription/rpc.h"
@@ -34,13 +39,23 @@
 #include "srpc/feature_status.h"
 #include "srpc/types.h"
 
+#include <errno.h>
+#include <inttypes.h>
 #include <libyang/libyang.h>
 #include <pthread.h>
 #include <srpc.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
 #include <sysrepo.h>
+#include <unistd.h>
 
-static int interfaces_init_state_changes_tracking(interfaces_state_changes_ctx_t* ctx);
-static void interfaces_link_cache_change_cb(struct nl_cache* cache, struct nl_object* obj, int val, void* arg);
+static int interfaces_init_state_changes_tracking(interfaces_oper_ctx_t* oper_ctx);
+static void interfaces_link_cache_change_cb(struct nl_cache* cache, struct nl_object* old_obj, struct nl_object* new_obj, uint64_t diff, int action, void* arg);
+static bool interfaces_link_state_changed(struct rtnl_link* old_link, struct rtnl_link* new_link);
+static int interfaces_link_state_resync(interfaces_state_changes_ctx_t* ctx);
+static void interfaces_stop_state_changes_tracking(interfaces_state_changes_ctx_t* ctx);
 static void* interfaces_link_manager_thread_cb(void* data);
 
 int sr_plugin_init_cb(sr_session_ctx_t* running_session, void** private_data)
@@ -48,6 +63,8 @@ int sr_plugin_init_cb(sr_session_ctx_t* running_session, void** private_data)
     int error = 0;
 
     bool empty_startup = false;
+    const char* bulk_env = NULL;
+    const char* cache_max_age_env = NULL;
 
     // sysrepo
     sr_session_ctx_t* startup_session = NULL;
@@ -68,6 +85,18 @@ int sr_plugin_init_cb(sr_session_ctx_t* running_session, void** private_data)
     SRPC_SAFE_CALL_ERR(error, srpc_feature_status_hash_load(&ctx->features.ietf_if_extensions_features, running_session, "ietf-if-extensions"), error_out);
     SRPC_SAFE_CALL_ERR(error, srpc_feature_status_hash_load(&ctx->features.ietf_ip_features, running_session, "ietf-ip"), error_out);
 
+    // operational data mode
+    bulk_env = getenv(INTERFACES_OPER_BULK_ENV);
+    ctx->oper_ctx.bulk_mode = bulk_env != NULL && !strcmp(bulk_env, "1");
+    if (ctx->oper_ctx.bulk_mode) {
+        SRPLG_LOG_INF(PLUGIN_NAME, "Operational data will be provided in bulk mode");
+    }
+
+    // operational caches staleness bound
+    cache_max_age_env = getenv(INTERFACES_OPER_CACHE_MAX_AGE_ENV);
+    ctx->oper_ctx.cache_sync.max_age = cache_max_age_env ? (time_t)strtoul(cache_max_age_env, NULL, 10) : INTERFACES_OPER_CACHE_MAX_AGE_DEFAULT;
+    SRPLG_LOG_INF(PLUGIN_NAME, "Operational caches will be dumped again after %ld seconds", (long)ctx->oper_ctx.cache_sync.max_age);
+
     // module changes
     srpc_module_change_t module_changes[] = {
         {
@@ -230,11 +259,6 @@ int sr_plugin_init_cb(sr_session_ctx_t* running_session, void** private_data)
             INTERFACES_INTERFACES_INTERFACE_FORWARDING_MODE_YANG_PATH,
             interfaces_subscription_operational_interfaces_interface_forwarding_mode,
         },
-        {
-            IETF_INTERFACES_YANG_MODULE,
-            INTERFACES_INTERFACES_INTERFACE_IPV4_ADDRESS_ORIGIN_YANG_PATH,
-            interfaces_subscription_operational_interfaces_interface_ipv4_address_origin,
-        },
         {
             IETF_INTERFACES_YANG_MODULE,
             INTERFACES_INTERFACES_INTERFACE_IPV4_ADDRESS_YANG_PATH,
@@ -250,16 +274,6 @@ int sr_plugin_init_cb(sr_session_ctx_t* running_session, void** private_data)
             INTERFACES_INTERFACES_INTERFACE_IPV4_NEIGHBOR_YANG_PATH,
             interfaces_subscription_operational_interfaces_interface_ipv4_neighbor,
         },
-        {
-            IETF_INTERFACES_YANG_MODULE,
-            INTERFACES_INTERFACES_INTERFACE_IPV6_ADDRESS_ORIGIN_YANG_PATH,
-            interfaces_subscription_operational_interfaces_interface_ipv6_address_origin,
-        },
-        {
-            IETF_INTERFACES_YANG_MODULE,
-            INTERFACES_INTERFACES_INTERFACE_IPV6_ADDRESS_STATUS_YANG_PATH,
-            interfaces_subscription_operational_interfaces_interface_ipv6_address_status,
-        },
         {
             IETF_INTERFACES_YANG_MODULE,
             INTERFACES_INTERFACES_INTERFACE_IPV6_ADDRESS_YANG_PATH,
@@ -317,6 +331,10 @@ int sr_plugin_init_cb(sr_session_ctx_t* running_session, void** private_data)
         // SRPC_SAFE_CALL_ERR(error, interfaces_running_store(ctx, running_session), error_out);
     }
 
+    // netlink context shared by all module change callbacks
+    SRPC_SAFE_CALL_ERR(error, interfaces_change_interface_init(ctx), error_out);
+    interfaces_change_plan_init(&ctx->mod_ctx.plan);
+
     // subscribe every module change
     for (size_t i = 0; i < ARRAY_SIZE(module_changes); i++) {
         const srpc_module_change_t* change = &module_changes[i];
@@ -337,11 +355,16 @@ int sr_plugin_init_cb(sr_session_ctx_t* running_session, void** private_data)
     for (size_t i = 0; i < ARRAY_SIZE(oper); i++) {
         const srpc_operational_t* op = &oper[i];
 
+        // in bulk mode the interface list callback provides all state data
+        if (ctx->oper_ctx.bulk_mode && op->cb != interfaces_subscription_operational_interfaces_interface) {
+            continue;
+        }
+
         SRPLG_LOG_INF(PLUGIN_NAME, "Subscribing operational callback %s:%s", op->module, op->path);
 
         // in case of work on a specific callback set it to NULL
         if (op->cb) {
-            error = sr_oper_get_subscribe(running_session, op->module, op->path, op->cb, *private_data, SR_SUBSCR_DEFAULT, &subscription);
+            error = sr_oper_get_subscribe(running_session, op->module, op->path, op->cb, *private_data, SR_SUBSCR_NO_THREAD, &ctx->oper_ctx.subscription);
             if (error) {
                 SRPLG_LOG_ERR(PLUGIN_NAME, "sr_oper_get_subscribe() error for \"%s\" (%d): %s", op->path, error, sr_strerror(error));
                 goto error_out;
@@ -349,8 +372,8 @@ int sr_plugin_init_cb(sr_session_ctx_t* running_session, void** private_data)
         }
     }
 
-    // tracking oper-status changes for interfaces
-    SRPC_SAFE_CALL_ERR(error, interfaces_init_state_changes_tracking(&ctx->oper_ctx.state_changes_ctx), error_out);
+    // tracking oper-status changes for interfaces - the same thread handles the operational getters
+    SRPC_SAFE_CALL_ERR(error, interfaces_init_state_changes_tracking(&ctx->oper_ctx), error_out);
 
     goto out;
 
@@ -367,29 +390,43 @@ void sr_plugin_cleanup_cb(sr_session_ctx_t* running_session, void* private_data)
 {
     interfaces_ctx_t* ctx = (interfaces_ctx_t*)private_data;
 
-    if (ctx->oper_ctx.nl_ctx.link_cache) {
-        nl_cache_put(ctx->oper_ctx.nl_ctx.link_cache);
-    }
+    SRPLG_LOG_INF(PLUGIN_NAME, "Operational cache dumps avoided: %" PRIu64, ctx->oper_ctx.cache_sync.avoided_dumps);
 
-    if (ctx->oper_ctx.nl_ctx.socket) {
-        nl_socket_free(ctx->oper_ctx.nl_ctx.socket);
+    // stop the cache manager thread before freeing its data - it runs the operational getters as well
+    interfaces_stop_state_changes_tracking(&ctx->oper_ctx.state_changes_ctx);
+
+    if (ctx->oper_ctx.subscription) {
+        sr_unsubscribe(ctx->oper_ctx.subscription);
     }
 
-    pthread_mutex_lock(&ctx->oper_ctx.state_changes_ctx.state_hash_mutex);
+    interfaces_subscription_operational_requests_free(&ctx->oper_ctx.requests);
+    interfaces_subscription_change_dispatch_free(&ctx->mod_ctx.dispatch);
+    interfaces_change_plan_free(&ctx->mod_ctx.plan);
+    interfaces_change_interface_links_free(&ctx->mod_ctx);
+    interfaces_change_interface_free(ctx);
 
-    if (ctx->oper_ctx.state_changes_ctx.nl_ctx.socket) {
-        nl_socket_free(ctx->oper_ctx.state_changes_ctx.nl_ctx.socket);
+    interfaces_link_index_free(&ctx->oper_ctx.nl_ctx.link_index);
+    interfaces_object_index_free(&ctx->oper_ctx.nl_ctx.addr_index);
+    interfaces_object_index_free(&ctx->oper_ctx.nl_ctx.neigh_index);
+
+    // frees the managed link, address and neighbor caches as well
+    if (ctx->oper_ctx.nl_ctx.link_cache_manager) {
+        nl_cache_mngr_free(ctx->oper_ctx.nl_ctx.link_cache_manager);
+    }
+
+    if (ctx->oper_ctx.nl_ctx.socket) {
+        nl_socket_free(ctx->oper_ctx.nl_ctx.socket);
     }
 
     if (ctx->oper_ctx.state_changes_ctx.nl_ctx.link_cache_manager) {
         nl_cache_mngr_free(ctx->oper_ctx.state_changes_ctx.nl_ctx.link_cache_manager);
     }
 
-    if (ctx->oper_ctx.state_changes_ctx.state_hash) {
-        interfaces_interface_state_hash_free(&ctx->oper_ctx.state_changes_ctx.state_hash);
+    if (ctx->oper_ctx.state_changes_ctx.nl_ctx.socket) {
+        nl_socket_free(ctx->oper_ctx.state_changes_ctx.nl_ctx.socket);
     }
 
-    pthread_mutex_unlock(&ctx->oper_ctx.state_changes_ctx.state_hash_mutex);
+    interfaces_interface_state_table_free(&ctx->oper_ctx.state_changes_ctx.state_table);
 
     // free feature status hashes
     srpc_feature_status_hash_free(&ctx->features.ietf_interfaces_features);
@@ -399,146 +436,289 @@ void sr_plugin_cleanup_cb(sr_session_ctx_t* running_session, void* private_data)
     free(ctx);
 }
 
-static int interfaces_init_state_changes_tracking(interfaces_state_changes_ctx_t* ctx)
+static int interfaces_init_state_changes_tracking(interfaces_oper_ctx_t* oper_ctx)
 {
     int error = 0;
+    interfaces_state_changes_ctx_t* ctx = &oper_ctx->state_changes_ctx;
     struct rtnl_link* link = NULL;
-    pthread_attr_t attr;
-    interfaces_interface_state_hash_element_t* new_element = NULL;
+    struct epoll_event event = { 0 };
+    int event_pipe = -1;
 
-    // init hash
-    ctx->state_hash = interfaces_interface_state_hash_new();
+    ctx->epoll_fd = -1;
+    ctx->shutdown_fd = -1;
 
-    // init libnl data
-    SRPC_SAFE_CALL_PTR(ctx->nl_ctx.socket, nl_socket_alloc(), error_out);
+    // setup cache manager - the link cache is dumped once when added
+    SRPC_SAFE_CALL_ERR(error, nl_cache_mngr_alloc(NULL, NETLINK_ROUTE, 0, &ctx->nl_ctx.link_cache_manager), error_out);
+    SRPC_SAFE_CALL_ERR(error, nl_cache_alloc_name("route/link", &ctx->nl_ctx.link_cache), error_out);
 
-    // connect and get all links
-    SRPC_SAFE_CALL_ERR(error, nl_connect(ctx->nl_ctx.socket, NETLINK_ROUTE), error_out);
-    SRPC_SAFE_CALL_ERR(error, rtnl_link_alloc_cache(ctx->nl_ctx.socket, AF_UNSPEC, &ctx->nl_ctx.link_cache), error_out);
+    // v2 callback receives both the old and the new link of every change
+    error = nl_cache_mngr_add_cache_v2(ctx->nl_ctx.link_cache_manager, ctx->nl_ctx.link_cache, interfaces_link_cache_change_cb, ctx);
+    if (error) {
+        SRPLG_LOG_ERR(PLUGIN_NAME, "nl_cache_mngr_add_cache_v2() failed (%s)", nl_geterror(error));
 
-    // init hash mutex
-    SRPC_SAFE_CALL_ERR(error, pthread_mutex_init(&ctx->state_hash_mutex, NULL), error_out);
+        // the cache is owned by the manager only once it has been added
+        nl_cache_free(ctx->nl_ctx.link_cache);
+        ctx->nl_ctx.link_cache = NULL;
+        goto error_out;
+    }
 
     link = (struct rtnl_link*)nl_cache_get_first(ctx->nl_ctx.link_cache);
 
     while (link != NULL) {
-        // create hash entries
-        const uint8_t oper_state = rtnl_link_get_operstate(link);
-        const time_t current_time = time(NULL);
-        const char* link_name = rtnl_link_get_name(link);
+        // create state entries
+        SRPC_SAFE_CALL_ERR(error, interfaces_interface_state_table_set(&ctx->state_table, rtnl_link_get_name(link), rtnl_link_get_operstate(link), time(NULL)), error_out);
 
-        // create new state element
-        SRPC_SAFE_CALL_PTR(new_element, interfaces_interface_state_hash_element_new(), error_out);
-
-        // set element data
-        SRPC_SAFE_CALL_ERR(error, interfaces_interface_state_hash_element_set_name(&new_element, link_name), error_out);
-        interfaces_interface_state_hash_element_set_state(&new_element, oper_state);
-        interfaces_interface_state_hash_element_set_last_change(&new_element, current_time);
+        link = (struct rtnl_link*)nl_cache_get_next((struct nl_object*)link);
+    }
 
-        // add entry to the hash table
-        SRPC_SAFE_CALL_ERR(error, interfaces_interface_state_hash_add(&ctx->state_hash, new_element), error_out);
+    // wait for link notifications and the shutdown event
+    ctx->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (ctx->epoll_fd < 0) {
+        SRPLG_LOG_ERR(PLUGIN_NAME, "epoll_create1() failed (%s)", strerror(errno));
+        goto error_out;
+    }
 
-        link = (struct rtnl_link*)nl_cache_get_next((struct nl_object*)link);
+    ctx->shutdown_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (ctx->shutdown_fd < 0) {
+        SRPLG_LOG_ERR(PLUGIN_NAME, "eventfd() failed (%s)", strerror(errno));
+        goto error_out;
     }
 
-    // setup cache manager
-    SRPC_SAFE_CALL_ERR(error, nl_cache_mngr_alloc(NULL, NETLINK_ROUTE, 0, &ctx->nl_ctx.link_cache_manager), error_out);
-    SRPC_SAFE_CALL_ERR(error, nl_cache_mngr_add(ctx->nl_ctx.link_cache_manager, "route/link", interfaces_link_cache_change_cb, ctx, &ctx->nl_ctx.link_cache), error_out);
+    event.events = EPOLLIN;
+    event.data.fd = nl_cache_mngr_get_fd(ctx->nl_ctx.link_cache_manager);
+    SRPC_SAFE_CALL_ERR(error, epoll_ctl(ctx->epoll_fd, EPOLL_CTL_ADD, event.data.fd, &event), error_out);
+
+    event.events = EPOLLIN;
+    event.data.fd = ctx->shutdown_fd;
+    SRPC_SAFE_CALL_ERR(error, epoll_ctl(ctx->epoll_fd, EPOLL_CTL_ADD, event.data.fd, &event), error_out);
 
-    // setup detatched thread for sending change signals to the cache manager
-    SRPC_SAFE_CALL_ERR(error, pthread_attr_init(&attr), error_out);
-    SRPC_SAFE_CALL_ERR(error, pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED), error_out);
-    SRPC_SAFE_CALL_ERR(error, pthread_create(&ctx->manager_thread, &attr, interfaces_link_manager_thread_cb, ctx), error_out);
+    // operational getters run on this thread too - the operational caches are never used while notifications are applied
+    if (oper_ctx->subscription) {
+        SRPC_SAFE_CALL_ERR(error, sr_subscription_get_event_pipe(oper_ctx->subscription, &event_pipe), error_out);
+
+        event.events = EPOLLIN;
+        event.data.fd = event_pipe;
+        SRPC_SAFE_CALL_ERR(error, epoll_ctl(ctx->epoll_fd, EPOLL_CTL_ADD, event.data.fd, &event), error_out);
+    }
+
+    // setup thread for passing notifications to the cache managers - joined on cleanup
+    SRPC_SAFE_CALL_ERR(error, pthread_create(&ctx->manager_thread, NULL, interfaces_link_manager_thread_cb, oper_ctx), error_out);
+    ctx->manager_thread_started = 1;
 
     goto out;
 
 error_out:
     error = -1;
 
+    if (ctx->shutdown_fd >= 0) {
+        close(ctx->shutdown_fd);
+        ctx->shutdown_fd = -1;
+    }
+
+    if (ctx->epoll_fd >= 0) {
+        close(ctx->epoll_fd);
+        ctx->epoll_fd = -1;
+    }
+
 out:
 
     return error;
 }
 
-static void interfaces_link_cache_change_cb(struct nl_cache* cache, struct nl_object* obj, int val, void* arg)
+static void interfaces_link_cache_change_cb(struct nl_cache* cache, struct nl_object* old_obj, struct nl_object* new_obj, uint64_t diff, int action, void* arg)
 {
     interfaces_state_changes_ctx_t* ctx = arg;
-    char time_buffer[100] = { 0 };
-    struct tm* last_change = NULL;
-    time_t current = 0;
-    interfaces_interface_state_hash_element_t* new_element = NULL;
-    int rc = 0;
+    struct rtnl_link* old_link = (struct rtnl_link*)old_obj;
+    struct rtnl_link* new_link = (struct rtnl_link*)new_obj;
 
-    // block further access using mutex
+    // notifications are handled as soon as they arrive - the receive time is the change time
+    const time_t current_time = time(NULL);
 
-    pthread_mutex_lock(&ctx->state_hash_mutex);
+    (void)cache;
+    (void)diff;
 
-    struct rtnl_link* link = NULL;
+    switch (action) {
+        case NL_ACT_NEW:
+            SRPLG_LOG_DBG(PLUGIN_NAME, "Interface %s added: state = %d, time = %ld", rtnl_link_get_name(new_link), rtnl_link_get_operstate(new_link), (long)current_time);
 
-    SRPLG_LOG_INF(PLUGIN_NAME, "Entered callback function for handling link cache changes");
+            if (interfaces_interface_state_table_set(&ctx->state_table, rtnl_link_get_name(new_link), rtnl_link_get_operstate(new_link), current_time)) {
+                SRPLG_LOG_ERR(PLUGIN_NAME, "Unable to add state data for interface %s", rtnl_link_get_name(new_link));
+            }
+            break;
+        case NL_ACT_CHANGE:
+            // renamed link - track it under the new name
+            if (strcmp(rtnl_link_get_name(old_link), rtnl_link_get_name(new_link))) {
+                SRPLG_LOG_DBG(PLUGIN_NAME, "Interface %s renamed to %s", rtnl_link_get_name(old_link), rtnl_link_get_name(new_link));
+
+                if (interfaces_interface_state_table_remove(&ctx->state_table, rtnl_link_get_name(old_link))) {
+                    SRPLG_LOG_ERR(PLUGIN_NAME, "Unable to remove state data for interface %s", rtnl_link_get_name(old_link));
+                }
+            } else if (!interfaces_link_state_changed(old_link, new_link)) {
+                break;
+            }
 
-    link = (struct rtnl_link*)nl_cache_get_first(cache);
+            SRPLG_LOG_DBG(PLUGIN_NAME, "Interface %s changed oper-state from %d to %d at %ld", rtnl_link_get_name(new_link), rtnl_link_get_operstate(old_link), rtnl_link_get_operstate(new_link), (long)current_time);
 
-    while (link != NULL) {
-        const char* link_name = rtnl_link_get_name(link);
-        interfaces_interface_state_hash_element_t* state_element = interfaces_interface_state_hash_get(ctx->state_hash, link_name);
-        const uint8_t oper_state = rtnl_link_get_operstate(link);
-
-        if (state_element) {
-            SRPLG_LOG_INF(PLUGIN_NAME, "State for interface %s already exists - updating last change", link_name);
-            if (oper_state != state_element->state.state) {
-                current = time(NULL);
-                last_change = localtime(&current);
-                strftime(time_buffer, sizeof(time_buffer), "%FT%TZ", last_change);
-
-                SRPLG_LOG_INF(PLUGIN_NAME, "Interface %s changed oper-state from %d to %d at %s", link_name, state_element->state.state, oper_state, time_buffer);
-
-                // update state info
-                interfaces_interface_state_hash_element_set_state(&state_element, oper_state);
-                interfaces_interface_state_hash_element_set_last_change(&state_element, time(NULL));
+            if (interfaces_interface_state_table_set(&ctx->state_table, rtnl_link_get_name(new_link), rtnl_link_get_operstate(new_link), current_time)) {
+                SRPLG_LOG_ERR(PLUGIN_NAME, "Unable to update state data for interface %s", rtnl_link_get_name(new_link));
             }
-        } else {
-            SRPLG_LOG_INF(PLUGIN_NAME, "State for interface %s doesn\'t exist - creating a new entry in the state data hash table", link_name);
-            // new link has been added - add new data to the hash
-            current = time(NULL);
-            last_change = localtime(&current);
-
-            // create new state element
-            new_element = interfaces_interface_state_hash_element_new();
-            if (!new_element) {
-                SRPLG_LOG_ERR(PLUGIN_NAME, "Unable to create new hash element for interface %s", link_name);
-            } else {
-                rc = interfaces_interface_state_hash_element_set_name(&new_element, link_name);
-                if (rc) {
-                    SRPLG_LOG_ERR(PLUGIN_NAME, "Error setting interface name for a newly created hash element for interface %s", link_name);
-                } else {
-                    interfaces_interface_state_hash_element_set_state(&new_element, oper_state);
-                    interfaces_interface_state_hash_element_set_last_change(&new_element, current);
-                    rc = interfaces_interface_state_hash_add(&ctx->state_hash, new_element);
-                    if (rc) {
-                        SRPLG_LOG_ERR(PLUGIN_NAME, "Unable to add new interface %s to the interface hash");
-                    } else {
-                        strftime(time_buffer, sizeof(time_buffer), "%FT%TZ", last_change);
-                        SRPLG_LOG_INF(PLUGIN_NAME, "Interface %s added to the state data hash: state = %d, time = %s", link_name, oper_state, time_buffer);
-                    }
-                }
+            break;
+        case NL_ACT_DEL:
+            SRPLG_LOG_DBG(PLUGIN_NAME, "Interface %s removed", rtnl_link_get_name(old_link));
+
+            if (interfaces_interface_state_table_remove(&ctx->state_table, rtnl_link_get_name(old_link))) {
+                SRPLG_LOG_ERR(PLUGIN_NAME, "Unable to remove state data for interface %s", rtnl_link_get_name(old_link));
             }
+            break;
+        default:
+            break;
+    }
+}
+
+static bool interfaces_link_state_changed(struct rtnl_link* old_link, struct rtnl_link* new_link)
+{
+    uint32_t old_carrier_changes = 0;
+    uint32_t new_carrier_changes = 0;
+
+    if (rtnl_link_get_operstate(old_link) != rtnl_link_get_operstate(new_link)) {
+        return true;
+    }
+
+    // the kernel counts carrier transitions - a flap between two notifications leaves the same oper-state behind
+    if (rtnl_link_get_carrier_changes(old_link, &old_carrier_changes) == 0 && rtnl_link_get_carrier_changes(new_link, &new_carrier_changes) == 0) {
+        return old_carrier_changes != new_carrier_changes;
+    }
+
+    return false;
+}
+
+static int interfaces_link_state_resync(interfaces_state_changes_ctx_t* ctx)
+{
+    int error = 0;
+    interfaces_interface_state_table_t state_table = { 0 };
+    struct nl_sock* socket = NULL;
+    struct rtnl_link* link = NULL;
+    uint8_t state = 0;
+    time_t last_change = 0;
+    const time_t current_time = time(NULL);
+
+    // the manager socket only receives notifications - dump through a separate socket
+    if (!ctx->nl_ctx.socket) {
+        SRPC_SAFE_CALL_PTR(socket, nl_socket_alloc(), error_out);
+        SRPC_SAFE_CALL_ERR(error, nl_connect(socket, NETLINK_ROUTE), error_out);
+
+        ctx->nl_ctx.socket = socket;
+        socket = NULL;
+    }
+
+    SRPC_SAFE_CALL_ERR(error, nl_cache_refill(ctx->nl_ctx.socket, ctx->nl_ctx.link_cache), error_out);
+
+    link = (struct rtnl_link*)nl_cache_get_first(ctx->nl_ctx.link_cache);
+
+    while (link != NULL) {
+        // links which kept their state keep their last change - the others changed while notifications were lost
+        if (interfaces_interface_state_table_get(&ctx->state_table, rtnl_link_get_name(link), &state, &last_change) || state != rtnl_link_get_operstate(link)) {
+            last_change = current_time;
         }
 
+        SRPC_SAFE_CALL_ERR(error, interfaces_interface_state_table_set(&state_table, rtnl_link_get_name(link), rtnl_link_get_operstate(link), last_change), error_out);
+
         link = (struct rtnl_link*)nl_cache_get_next((struct nl_object*)link);
     }
 
-    // unlock further access to the state hash
-    pthread_mutex_unlock(&ctx->state_hash_mutex);
+    // links removed while notifications were lost go away with the old table
+    interfaces_interface_state_table_free(&ctx->state_table);
+    ctx->state_table = state_table;
+
+    goto out;
+
+error_out:
+    error = -1;
+
+    if (socket) {
+        nl_socket_free(socket);
+    }
+
+    interfaces_interface_state_table_free(&state_table);
+
+out:
+    return error;
+}
+
+static void interfaces_stop_state_changes_tracking(interfaces_state_changes_ctx_t* ctx)
+{
+    if (!ctx->manager_thread_started) {
+        return;
+    }
+
+    // wake up the manager thread and wait for it to exit
+    if (eventfd_write(ctx->shutdown_fd, 1) < 0) {
+        SRPLG_LOG_ERR(PLUGIN_NAME, "eventfd_write() failed (%s)", strerror(errno));
+        pthread_cancel(ctx->manager_thread);
+    }
+    pthread_join(ctx->manager_thread, NULL);
+
+    close(ctx->shutdown_fd);
+    close(ctx->epoll_fd);
+
+    ctx->manager_thread_started = 0;
 }
 
 static void* interfaces_link_manager_thread_cb(void* data)
 {
-    interfaces_state_changes_ctx_t* ctx = data;
+    interfaces_oper_ctx_t* oper_ctx = data;
+    interfaces_state_changes_ctx_t* ctx = &oper_ctx->state_changes_ctx;
+    struct epoll_event events[4];
+    int events_count = 0;
+    int event_pipe = -1;
+    int error = 0;
+
+    if (oper_ctx->subscription) {
+        sr_subscription_get_event_pipe(oper_ctx->subscription, &event_pipe);
+    }
 
     do {
-        nl_cache_mngr_data_ready(ctx->nl_ctx.link_cache_manager);
-        sleep(1);
+        // block until notifications arrive or cleanup signals the shutdown event
+        events_count = epoll_wait(ctx->epoll_fd, events, ARRAY_SIZE(events), -1);
+        if (events_count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            SRPLG_LOG_ERR(PLUGIN_NAME, "epoll_wait() failed (%s) - stopping link state tracking", strerror(errno));
+            break;
+        }
+
+        for (int i = 0; i < events_count; i++) {
+            if (events[i].data.fd == ctx->shutdown_fd) {
+                return NULL;
+            }
+
+            if (events[i].data.fd == event_pipe) {
+                error = sr_subscription_process_events(oper_ctx->subscription, NULL, NULL);
+                if (error != SR_ERR_OK) {
+                    SRPLG_LOG_ERR(PLUGIN_NAME, "sr_subscription_process_events() failed (%d): %s", error, sr_strerror(error));
+                }
+                continue;
+            }
+
+            // the operational manager socket is added by the first request
+            if (events[i].data.fd != nl_cache_mngr_get_fd(ctx->nl_ctx.link_cache_manager)) {
+                interfaces_subscription_operational_cache_drain(oper_ctx);
+                continue;
+            }
+
+            // the manager socket is non-blocking - process the whole burst of notifications
+            error = nl_cache_mngr_data_ready(ctx->nl_ctx.link_cache_manager);
+            if (error < 0) {
+                // notifications were lost (socket overrun) - the link cache and the state table can't be trusted anymore
+                SRPLG_LOG_INF(PLUGIN_NAME, "Lost link notifications (%s) - dumping links again", nl_geterror(error));
+
+                if (interfaces_link_state_resync(ctx)) {
+                    SRPLG_LOG_ERR(PLUGIN_NAME, "Unable to resync link state - retrying on the next notification");
+                }
+            }
+        }
     } while (1);
 
     return NULL;
@@ -19,6 +19,7 @@
 
 #include <linux/limits.h>
 #include <srpc.h>
+#include <string.h>
 #include <sysrepo.h>
 
 int interfaces_change_interface_init(void* priv)
@@ -35,11 +36,10 @@ int interfaces_change_interface_init(void* priv)
     // connect
     SRPC_SAFE_CALL_ERR(error, nl_connect(mod_ctx->nl_ctx.socket, NETLINK_ROUTE), error_out);
 
-    // allocate link cache
-    SRPC_SAFE_CALL_ERR(error, rtnl_link_alloc_cache(mod_ctx->nl_ctx.socket, AF_UNSPEC, &mod_ctx->nl_ctx.link_cache), error_out);
-
-    // allocate address cache
-    SRPC_SAFE_CALL_ERR(error, rtnl_addr_alloc_cache(mod_ctx->nl_ctx.socket, &mod_ctx->nl_ctx.addr_cache), error_out);
+    // link and address caches are dumped once here and then follow the kernel notifications
+    SRPC_SAFE_CALL_ERR(error, nl_cache_mngr_alloc(NULL, NETLINK_ROUTE, 0, &mod_ctx->nl_ctx.link_cache_manager), error_out);
+    SRPC_SAFE_CALL_ERR(error, nl_cache_mngr_add(mod_ctx->nl_ctx.link_cache_manager, "route/link", NULL, NULL, &mod_ctx->nl_ctx.link_cache), error_out);
+    SRPC_SAFE_CALL_ERR(error, nl_cache_mngr_add(mod_ctx->nl_ctx.link_cache_manager, "route/addr", NULL, NULL, &mod_ctx->nl_ctx.addr_cache), error_out);
 
     goto out;
 
@@ -51,6 +51,34 @@ out:
     return error;
 }
 
+int interfaces_change_interface_sync(void* priv)
+{
+    int error = 0;
+    int processed = 0;
+    interfaces_ctx_t* ctx = (interfaces_ctx_t*)priv;
+    interfaces_mod_changes_ctx_t* mod_ctx = &ctx->mod_ctx;
+
+    // apply pending notifications - the manager socket is non-blocking
+    processed = nl_cache_mngr_data_ready(mod_ctx->nl_ctx.link_cache_manager);
+    if (processed >= 0) {
+        return 0;
+    }
+
+    // notifications were lost (socket overrun) - the caches can't be trusted anymore
+    SRPLG_LOG_INF(PLUGIN_NAME, "Lost interface change cache notifications (%s) - dumping caches again", nl_geterror(processed));
+
+    SRPC_SAFE_CALL_ERR(error, nl_cache_refill(mod_ctx->nl_ctx.socket, mod_ctx->nl_ctx.link_cache), error_out);
+    SRPC_SAFE_CALL_ERR(error, nl_cache_refill(mod_ctx->nl_ctx.socket, mod_ctx->nl_ctx.addr_cache), error_out);
+
+    goto out;
+
+error_out:
+    error = -1;
+
+out:
+    return error;
+}
+
 int interfaces_change_interface(void* priv, sr_session_ctx_t* session, const srpc_change_ctx_t* change_ctx)
 {
     int error = 0;
@@ -70,23 +98,23 @@ int interfaces_change_interface(void* priv, sr_session_ctx_t* session, const srp
 
     // name
     SRPC_SAFE_CALL_ERR_COND(rc, rc < 0, snprintf(change_xpath_buffer, sizeof(change_xpath_buffer), "%s/name", xpath_buffer), error_out);
-    SRPC_SAFE_CALL_ERR(rc, srpc_iterate_changes(ctx, session, change_xpath_buffer, interfaces_interface_change_name, interfaces_change_interface_init, interfaces_change_interface_free), error_out);
+    SRPC_SAFE_CALL_ERR(rc, srpc_iterate_changes(ctx, session, change_xpath_buffer, interfaces_interface_change_name, NULL, NULL), error_out);
 
     // description
     SRPC_SAFE_CALL_ERR_COND(rc, rc < 0, snprintf(change_xpath_buffer, sizeof(change_xpath_buffer), "%s/description", xpath_buffer), error_out);
-    SRPC_SAFE_CALL_ERR(rc, srpc_iterate_changes(ctx, session, change_xpath_buffer, interfaces_interface_change_description, interfaces_change_interface_init, interfaces_change_interface_free), error_out);
+    SRPC_SAFE_CALL_ERR(rc, srpc_iterate_changes(ctx, session, change_xpath_buffer, interfaces_interface_change_description, NULL, NULL), error_out);
 
     // type
     SRPC_SAFE_CALL_ERR_COND(rc, rc < 0, snprintf(change_xpath_buffer, sizeof(change_xpath_buffer), "%s/type", xpath_buffer), error_out);
-    SRPC_SAFE_CALL_ERR(rc, srpc_iterate_changes(ctx, session, change_xpath_buffer, interfaces_interface_change_type, interfaces_change_interface_init, interfaces_change_interface_free), error_out);
+    SRPC_SAFE_CALL_ERR(rc, srpc_iterate_changes(ctx, session, change_xpath_buffer, interfaces_interface_change_type, NULL, NULL), error_out);
 
     // enabled
     SRPC_SAFE_CALL_ERR_COND(rc, rc < 0, snprintf(change_xpath_buffer, sizeof(change_xpath_buffer), "%s/enabled", xpath_buffer), error_out);
-    SRPC_SAFE_CALL_ERR(rc, srpc_iterate_changes(ctx, session, change_xpath_buffer, interfaces_interface_change_enabled, interfaces_change_interface_init, interfaces_change_interface_free), error_out);
+    SRPC_SAFE_CALL_ERR(rc, srpc_iterate_changes(ctx, session, change_xpath_buffer, interfaces_interface_change_enabled, NULL, NULL), error_out);
 
     // link-up-down-trap-enable
     SRPC_SAFE_CALL_ERR_COND(rc, rc < 0, snprintf(change_xpath_buffer, sizeof(change_xpath_buffer), "%s/link-up-down-trap-enable", xpath_buffer), error_out);
-    SRPC_SAFE_CALL_ERR(rc, srpc_iterate_changes(ctx, session, change_xpath_buffer, interfaces_interface_change_link_up_down_trap_enable, interfaces_change_interface_init, interfaces_change_interface_free), error_out);
+    SRPC_SAFE_CALL_ERR(rc, srpc_iterate_changes(ctx, session, change_xpath_buffer, interfaces_interface_change_link_up_down_trap_enable, NULL, NULL), error_out);
 
     goto out;
 
@@ -104,18 +132,16 @@ void interfaces_change_interface_free(void* priv)
 
     SRPLG_LOG_INF(PLUGIN_NAME, "Freeing context data for interface changes");
 
-    if (mod_ctx->nl_ctx.link_cache) {
-        nl_cache_put(mod_ctx->nl_ctx.link_cache);
-    }
-
-    if (mod_ctx->nl_ctx.addr_cache) {
-        nl_cache_put(mod_ctx->nl_ctx.addr_cache);
+    // frees the managed link and address caches as well
+    if (mod_ctx->nl_ctx.link_cache_manager) {
+        nl_cache_mngr_free(mod_ctx->nl_ctx.link_cache_manager);
     }
 
     if (mod_ctx->nl_ctx.socket) {
         nl_socket_free(mod_ctx->nl_ctx.socket);
     }
 
-    // set to NULL
-    ctx->mod_ctx = (interfaces_mod_changes_ctx_t) { 0 };
+    // set to NULL - the dispatch table is freed with the subscription
+    mod_ctx->nl_ctx = (interfaces_nl_ctx_t) { 0 };
+    memset(&mod_ctx->mod_data, 0, sizeof(mod_ctx->mod_data));
 }
@@ -13,9 +13,10 @@
 #include "change.h"
 #include "netlink/errno.h"
 #include "netlink/route/link.h"
+#include "plugin/api/interfaces/lookup.h"
+#include "plugin/api/interfaces/plan.h"
 #include "plugin/common.h"
 #include "plugin/context.h"
-#include "sysrepo/xpath.h"
 
 #include <linux/if.h>
 #include <linux/limits.h>
@@ -25,8 +26,6 @@
 
 #include <errno.h>
 
-static int interfacecs_interface_extract_name(sr_session_ctx_t* session, const struct lyd_node* node, char* name_buffer, size_t buffer_size);
-
 int interfaces_interface_change_parent_interface(void* priv, sr_session_ctx_t* session, const srpc_change_ctx_t* change_ctx)
 {
     int error = 0;
@@ -119,7 +118,7 @@ int interfaces_interface_change_enabled(void* priv, sr_session_ctx_t* session, c
 {
     int error = 0;
 
-    char interface_name_buffer[256] = { 0 };
+    const char* interface_name = NULL;
 
     interfaces_ctx_t* ctx = (interfaces_ctx_t*)priv;
     interfaces_mod_changes_ctx_t* mod_ctx = &ctx->mod_ctx;
@@ -132,20 +131,16 @@ int interfaces_interface_change_enabled(void* priv, sr_session_ctx_t* session, c
     SRPLG_LOG_INF(PLUGIN_NAME, "Node Name: %s; Previous Value: %s; Value: %s; Operation: %d", node_name, change_ctx->previous_value, node_value, change_ctx->operation);
 
     // get interface name
-    SRPC_SAFE_CALL_ERR(error, interfacecs_interface_extract_name(session, change_ctx->node, interface_name_buffer, sizeof(interface_name_buffer)), error_out);
+    SRPC_SAFE_CALL_PTR(interface_name, interfaces_change_get_list_key(change_ctx->node, "interface", "name"), error_out);
 
     switch (change_ctx->operation) {
     case SR_OP_CREATED:
     case SR_OP_MODIFIED:
         // get link by name
-        SRPC_SAFE_CALL_PTR(current_link, rtnl_link_get_by_name(mod_ctx->nl_ctx.link_cache, interface_name_buffer), error_out);
-
-        // create request link
-        SRPC_SAFE_CALL_PTR(request_link, rtnl_link_alloc(), error_out);
+        SRPC_SAFE_CALL_PTR(current_link, interfaces_change_get_interface_link(mod_ctx, change_ctx->node), error_out);
 
-        // set name
-        rtnl_link_set_name(request_link, interface_name_buffer);
-        rtnl_link_set_type(request_link, rtnl_link_get_type(current_link));
+        // request link shared by all link attribute changes of the interface
+        SRPC_SAFE_CALL_PTR(request_link, interfaces_change_plan_get_link_request(&mod_ctx->plan, interface_name), error_out);
 
         // set operstate
         rtnl_link_set_flags(request_link, (strcmp(node_value, "true") == 0) ? (unsigned int)rtnl_link_str2flags("up") : (unsigned int)rtnl_link_str2flags("down"));
@@ -154,21 +149,14 @@ int interfaces_interface_change_enabled(void* priv, sr_session_ctx_t* session, c
 
         SRPLG_LOG_INF(PLUGIN_NAME, "Current link status: %d", rtnl_link_get_operstate(current_link));
         SRPLG_LOG_INF(PLUGIN_NAME, "Changed link status: %d", rtnl_link_get_operstate(request_link));
-
-        // apply changes
-        SRPC_SAFE_CALL_ERR(error, rtnl_link_change(mod_ctx->nl_ctx.socket, current_link, request_link, NLM_F_REPLACE), error_out);
         break;
     case SR_OP_DELETED:
         // get link by name
         // goto out if this function fails - if the link has completely been deleted, no need to delete enabled leaf
-        SRPC_SAFE_CALL_PTR(current_link, rtnl_link_get_by_name(mod_ctx->nl_ctx.link_cache, interface_name_buffer), out);
+        SRPC_SAFE_CALL_PTR(current_link, interfaces_change_get_interface_link(mod_ctx, change_ctx->node), out);
 
-        // create request link
-        SRPC_SAFE_CALL_PTR(request_link, rtnl_link_alloc(), error_out);
-
-        // set name
-        rtnl_link_set_name(request_link, interface_name_buffer);
-        rtnl_link_set_type(request_link, rtnl_link_get_type(current_link));
+        // request link shared by all link attribute changes of the interface
+        SRPC_SAFE_CALL_PTR(request_link, interfaces_change_plan_get_link_request(&mod_ctx->plan, interface_name), error_out);
 
         // treat as set to up - default value
         rtnl_link_set_flags(request_link, (unsigned int)rtnl_link_str2flags("up"));
@@ -176,9 +164,6 @@ int interfaces_interface_change_enabled(void* priv, sr_session_ctx_t* session, c
 
         SRPLG_LOG_INF(PLUGIN_NAME, "Current link status: %d", rtnl_link_get_operstate(current_link));
         SRPLG_LOG_INF(PLUGIN_NAME, "Changed link status: %d", rtnl_link_get_operstate(request_link));
-
-        // apply changes
-        SRPC_SAFE_CALL_ERR(error, rtnl_link_change(mod_ctx->nl_ctx.socket, current_link, request_link, NLM_F_REPLACE), error_out);
         break;
     case SR_OP_MOVED:
         break;
@@ -193,10 +178,6 @@ error_out:
     error = -1;
 
 out:
-    if (request_link) {
-        rtnl_link_put(request_link);
-    }
-
     return error;
 }
 
@@ -204,7 +185,7 @@ int interfaces_interface_change_type(void* priv, sr_session_ctx_t* session, cons
 {
     int error = 0;
 
-    char interface_name_buffer[256] = { 0 };
+    const char* interface_name = NULL;
 
     interfaces_ctx_t* ctx = (interfaces_ctx_t*)priv;
     interfaces_mod_changes_ctx_t* mod_ctx = &ctx->mod_ctx;
@@ -243,16 +224,13 @@ int interfaces_interface_change_type(void* priv, sr_session_ctx_t* session, cons
     case SR_OP_CREATED:
     case SR_OP_MODIFIED:
         // get interface name
-        SRPC_SAFE_CALL_ERR(error, interfacecs_interface_extract_name(session, change_ctx->node, interface_name_buffer, sizeof(interface_name_buffer)), error_out);
+        SRPC_SAFE_CALL_PTR(interface_name, interfaces_change_get_list_key(change_ctx->node, "interface", "name"), error_out);
 
         // get link by name
-        SRPC_SAFE_CALL_PTR(current_link, rtnl_link_get_by_name(mod_ctx->nl_ctx.link_cache, interface_name_buffer), error_out);
-
-        // create request link
-        SRPC_SAFE_CALL_PTR(request_link, rtnl_link_alloc(), error_out);
+        SRPC_SAFE_CALL_PTR(current_link, interfaces_change_get_interface_link(mod_ctx, change_ctx->node), error_out);
 
-        // set name
-        rtnl_link_set_name(request_link, interface_name_buffer);
+        // request link shared by all link attribute changes of the interface
+        SRPC_SAFE_CALL_PTR(request_link, interfaces_change_plan_get_link_request(&mod_ctx->plan, interface_name), error_out);
 
         // set type
         for (size_t i = 0; i < ARRAY_SIZE(type_pairs); i++) {
@@ -267,9 +245,6 @@ int interfaces_interface_change_type(void* priv, sr_session_ctx_t* session, cons
             SRPLG_LOG_ERR(PLUGIN_NAME, "Unsupported interface type %s", node_value);
             goto error_out;
         }
-
-        // apply changes
-        SRPC_SAFE_CALL_ERR(error, rtnl_link_change(mod_ctx->nl_ctx.socket, current_link, request_link, 0), error_out);
         break;
     case SR_OP_DELETED:
         // unsupported - type is necessarry
@@ -290,22 +265,54 @@ out:
 int interfaces_interface_change_description(void* priv, sr_session_ctx_t* session, const srpc_change_ctx_t* change_ctx)
 {
     int error = 0;
+
+    const char* interface_name = NULL;
+
+    interfaces_ctx_t* ctx = (interfaces_ctx_t*)priv;
+    interfaces_mod_changes_ctx_t* mod_ctx = &ctx->mod_ctx;
+    struct rtnl_link* current_link = NULL;
+    struct rtnl_link* request_link = NULL;
+
     const char* node_name = LYD_NAME(change_ctx->node);
     const char* node_value = lyd_get_value(change_ctx->node);
 
     SRPLG_LOG_INF(PLUGIN_NAME, "Node Name: %s; Previous Value: %s; Value: %s; Operation: %d", node_name, change_ctx->previous_value, node_value, change_ctx->operation);
 
+    // get interface name
+    SRPC_SAFE_CALL_PTR(interface_name, interfaces_change_get_list_key(change_ctx->node, "interface", "name"), error_out);
+
     switch (change_ctx->operation) {
     case SR_OP_CREATED:
-        break;
     case SR_OP_MODIFIED:
+        // get link by name
+        SRPC_SAFE_CALL_PTR(current_link, interfaces_change_get_interface_link(mod_ctx, change_ctx->node), error_out);
+
+        // request link shared by all link attribute changes of the interface
+        SRPC_SAFE_CALL_PTR(request_link, interfaces_change_plan_get_link_request(&mod_ctx->plan, interface_name), error_out);
+
+        // description is stored as the link alias
+        rtnl_link_set_ifalias(request_link, node_value);
         break;
     case SR_OP_DELETED:
+        // goto out if this function fails - if the link has completely been deleted, no need to delete description leaf
+        SRPC_SAFE_CALL_PTR(current_link, interfaces_change_get_interface_link(mod_ctx, change_ctx->node), out);
+
+        // request link shared by all link attribute changes of the interface
+        SRPC_SAFE_CALL_PTR(request_link, interfaces_change_plan_get_link_request(&mod_ctx->plan, interface_name), error_out);
+
+        // an empty alias removes it
+        rtnl_link_set_ifalias(request_link, "");
         break;
     case SR_OP_MOVED:
         break;
     }
 
+    goto out;
+
+error_out:
+    error = -1;
+
+out:
     return error;
 }
 
@@ -325,7 +332,7 @@ int interfaces_interface_change_name(void* priv, sr_session_ctx_t* session, cons
 
     switch (change_ctx->operation) {
     case SR_OP_CREATED:
-        old_link = rtnl_link_get_by_name(mod_ctx->nl_ctx.link_cache, node_value);
+        old_link = interfaces_change_plan_get_link(&mod_ctx->plan, mod_ctx->nl_ctx.link_cache, node_value);
 
         // add a new link if such a link doesn't exist
         if (!old_link) {
@@ -338,17 +345,20 @@ int interfaces_interface_change_name(void* priv, sr_session_ctx_t* session, cons
             // set temp as initial type
             SRPC_SAFE_CALL_ERR(error, rtnl_link_set_type(new_link, "dummy"), error_out);
 
-            SRPC_SAFE_CALL_ERR(error, rtnl_link_add(mod_ctx->nl_ctx.socket, new_link, NLM_F_CREATE), error_out);
+            SRPC_SAFE_CALL_ERR(error, interfaces_change_plan_add(&mod_ctx->plan, interfaces_change_operation_link_add, node_value, (struct nl_object*)new_link, NLM_F_CREATE), error_out);
         }
         break;
     case SR_OP_MODIFIED:
         // name cannot be modified - only deleted and created again
         goto error_out;
     case SR_OP_DELETED:
-        // get link and delete it
-        SRPC_SAFE_CALL_PTR(old_link, rtnl_link_get_by_name(mod_ctx->nl_ctx.link_cache, node_value), error_out);
+        // get link and delete it - by name, the ifindex is resolved on commit
+        SRPC_SAFE_CALL_PTR(old_link, interfaces_change_plan_get_link(&mod_ctx->plan, mod_ctx->nl_ctx.link_cache, node_value), error_out);
 
-        SRPC_SAFE_CALL_ERR(error, rtnl_link_delete(mod_ctx->nl_ctx.socket, old_link), error_out);
+        SRPC_SAFE_CALL_PTR(new_link, rtnl_link_alloc(), error_out);
+        rtnl_link_set_name(new_link, node_value);
+
+        SRPC_SAFE_CALL_ERR(error, interfaces_change_plan_add(&mod_ctx->plan, interfaces_change_operation_link_delete, node_value, (struct nl_object*)new_link, 0), error_out);
         break;
     case SR_OP_MOVED:
         break;
@@ -363,34 +373,9 @@ error_out:
     error = -1;
 
 out:
-    return error;
-}
-
-static int interfacecs_interface_extract_name(sr_session_ctx_t* session, const struct lyd_node* node, char* name_buffer, size_t buffer_size)
-{
-    int error = 0;
-    int rc = 0;
-    void* error_ptr = NULL;
-
-    const char* name = NULL;
-
-    sr_xpath_ctx_t xpath_ctx = { 0 };
-    char path_buffer[PATH_MAX] = { 0 };
-
-    // get node full path
-    SRPC_SAFE_CALL_PTR(error_ptr, lyd_path(node, LYD_PATH_STD, path_buffer, sizeof(path_buffer)), error_out);
-
-    // extract key
-    SRPC_SAFE_CALL_PTR(name, sr_xpath_key_value(path_buffer, "interface", "name", &xpath_ctx), error_out);
-
-    // store to buffer
-    SRPC_SAFE_CALL_ERR_COND(rc, rc < 0, snprintf(name_buffer, buffer_size, "%s", name), error_out);
-
-    goto out;
-
-error_out:
-    error = -1;
+    if (new_link) {
+        rtnl_link_put(new_link);
+    }
 
-out:
     return error;
 }
\ No newline at end of file
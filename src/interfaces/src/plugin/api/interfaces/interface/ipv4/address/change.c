@@ -11,6 +11,8 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 #include "change.h"
+#include "plugin/api/interfaces/lookup.h"
+#include "plugin/api/interfaces/plan.h"
 #include "plugin/common.h"
 #include "plugin/context.h"
 #include "plugin/data/interfaces/interface/ipv4/address.h"
@@ -38,14 +40,12 @@ int interfaces_interface_ipv4_address_change_netmask_init(void* priv)
 int interfaces_interface_ipv4_address_change_netmask(void* priv, sr_session_ctx_t* session, const srpc_change_ctx_t* change_ctx)
 {
     int error = 0;
-    void* error_ptr = NULL;
 
     // strings and buffers
     const char* node_name = LYD_NAME(change_ctx->node);
     const char* node_value = lyd_get_value(change_ctx->node);
-    char path_buffer[PATH_MAX] = { 0 };
-    char interface_name_buffer[100] = { 0 };
-    char ip_buffer[100] = { 0 };
+    const char* interface_name = NULL;
+    const char* ip = NULL;
     char address_buffer[100] = { 0 };
     char old_address_buffer[100] = { 0 };
 
@@ -68,19 +68,16 @@ int interfaces_interface_ipv4_address_change_netmask(void* priv, sr_session_ctx_
 
     SRPLG_LOG_INF(PLUGIN_NAME, "Node Name: %s; Previous Value: %s, Value: %s; Operation: %d", node_name, change_ctx->previous_value, node_value, change_ctx->operation);
 
-    // get node path
-    SRPC_SAFE_CALL_PTR(error_ptr, lyd_path(change_ctx->node, LYD_PATH_STD, path_buffer, sizeof(path_buffer)), error_out);
-
     // get interface name
-    SRPC_SAFE_CALL_ERR(error, srpc_extract_xpath_key_value(path_buffer, "interface", "name", interface_name_buffer, sizeof(interface_name_buffer)), error_out);
+    SRPC_SAFE_CALL_PTR(interface_name, interfaces_change_get_list_key(change_ctx->node, "interface", "name"), error_out);
 
     // get IP
-    SRPC_SAFE_CALL_ERR(error, srpc_extract_xpath_key_value(path_buffer, "address", "ip", ip_buffer, sizeof(ip_buffer)), error_out);
+    SRPC_SAFE_CALL_PTR(ip, interfaces_change_get_list_key(change_ctx->node, "address", "ip"), error_out);
 
-    SRPLG_LOG_INF(PLUGIN_NAME, "Node Path: %s; Interface Name: %s; Address IP: %s", path_buffer, interface_name_buffer, ip_buffer);
+    SRPLG_LOG_INF(PLUGIN_NAME, "Interface Name: %s; Address IP: %s", interface_name, ip);
 
     // get link
-    SRPC_SAFE_CALL_PTR(current_link, rtnl_link_get_by_name(mod_ctx->nl_ctx.link_cache, interface_name_buffer), error_out);
+    SRPC_SAFE_CALL_PTR(current_link, interfaces_change_get_interface_link(mod_ctx, change_ctx->node), error_out);
 
     switch (change_ctx->operation) {
     case SR_OP_CREATED:
@@ -97,8 +94,8 @@ int interfaces_interface_ipv4_address_change_netmask(void* priv, sr_session_ctx_
         SRPC_SAFE_CALL_ERR(error, interfaces_interface_ipv4_address_netmask2prefix(change_ctx->previous_value, &old_prefix_length), error_out);
 
         // get full address
-        SRPC_SAFE_CALL_ERR_COND(error, error < 0, snprintf(address_buffer, sizeof(address_buffer), "%s/%d", ip_buffer, prefix_length), error_out);
-        SRPC_SAFE_CALL_ERR_COND(error, error < 0, snprintf(old_address_buffer, sizeof(old_address_buffer), "%s/%d", ip_buffer, old_prefix_length), error_out);
+        SRPC_SAFE_CALL_ERR_COND(error, error < 0, snprintf(address_buffer, sizeof(address_buffer), "%s/%d", ip, prefix_length), error_out);
+        SRPC_SAFE_CALL_ERR_COND(error, error < 0, snprintf(old_address_buffer, sizeof(old_address_buffer), "%s/%d", ip, old_prefix_length), error_out);
 
         // parse local address
         SRPC_SAFE_CALL_ERR(error, nl_addr_parse(address_buffer, AF_INET, &local_addr), error_out);
@@ -108,15 +105,11 @@ int interfaces_interface_ipv4_address_change_netmask(void* priv, sr_session_ctx_
         SRPC_SAFE_CALL_ERR(error, rtnl_addr_set_local(request_addr, local_addr), error_out);
         SRPC_SAFE_CALL_ERR(error, rtnl_addr_set_local(delete_addr, old_local_addr), error_out);
 
-        // set interface
-        rtnl_addr_set_ifindex(request_addr, rtnl_link_get_ifindex(current_link));
-        rtnl_addr_set_ifindex(delete_addr, rtnl_link_get_ifindex(current_link));
-
         // delete old address
-        SRPC_SAFE_CALL_ERR(error, rtnl_addr_delete(mod_ctx->nl_ctx.socket, delete_addr, 0), error_out);
+        SRPC_SAFE_CALL_ERR(error, interfaces_change_plan_add(&mod_ctx->plan, interfaces_change_operation_address_delete, interface_name, (struct nl_object*)delete_addr, 0), error_out);
 
         // add new address
-        SRPC_SAFE_CALL_ERR(error, rtnl_addr_add(mod_ctx->nl_ctx.socket, request_addr, 0), error_out);
+        SRPC_SAFE_CALL_ERR(error, interfaces_change_plan_add(&mod_ctx->plan, interfaces_change_operation_address_add, interface_name, (struct nl_object*)request_addr, 0), error_out);
 
         break;
     case SR_OP_DELETED:
@@ -169,14 +162,12 @@ int interfaces_interface_ipv4_address_change_prefix_length_init(void* priv)
 int interfaces_interface_ipv4_address_change_prefix_length(void* priv, sr_session_ctx_t* session, const srpc_change_ctx_t* change_ctx)
 {
     int error = 0;
-    void* error_ptr = NULL;
 
     // strings and buffers
     const char* node_name = LYD_NAME(change_ctx->node);
     const char* node_value = lyd_get_value(change_ctx->node);
-    char path_buffer[PATH_MAX] = { 0 };
-    char interface_name_buffer[100] = { 0 };
-    char ip_buffer[100] = { 0 };
+    const char* interface_name = NULL;
+    const char* ip = NULL;
     char address_buffer[100] = { 0 };
     char old_address_buffer[100] = { 0 };
 
@@ -195,19 +186,16 @@ int interfaces_interface_ipv4_address_change_prefix_length(void* priv, sr_sessio
 
     SRPLG_LOG_INF(PLUGIN_NAME, "Node Name: %s; Previous Value: %s, Value: %s; Operation: %d", node_name, change_ctx->previous_value, node_value, change_ctx->operation);
 
-    // get node path
-    SRPC_SAFE_CALL_PTR(error_ptr, lyd_path(change_ctx->node, LYD_PATH_STD, path_buffer, sizeof(path_buffer)), error_out);
-
     // get interface name
-    SRPC_SAFE_CALL_ERR(error, srpc_extract_xpath_key_value(path_buffer, "interface", "name", interface_name_buffer, sizeof(interface_name_buffer)), error_out);
+    SRPC_SAFE_CALL_PTR(interface_name, interfaces_change_get_list_key(change_ctx->node, "interface", "name"), error_out);
 
     // get IP
-    SRPC_SAFE_CALL_ERR(error, srpc_extract_xpath_key_value(path_buffer, "address", "ip", ip_buffer, sizeof(ip_buffer)), error_out);
+    SRPC_SAFE_CALL_PTR(ip, interfaces_change_get_list_key(change_ctx->node, "address", "ip"), error_out);
 
-    SRPLG_LOG_INF(PLUGIN_NAME, "Node Path: %s; Interface Name: %s; Address IP: %s", path_buffer, interface_name_buffer, ip_buffer);
+    SRPLG_LOG_INF(PLUGIN_NAME, "Interface Name: %s; Address IP: %s", interface_name, ip);
 
     // get link
-    SRPC_SAFE_CALL_PTR(current_link, rtnl_link_get_by_name(mod_ctx->nl_ctx.link_cache, interface_name_buffer), error_out);
+    SRPC_SAFE_CALL_PTR(current_link, interfaces_change_get_interface_link(mod_ctx, change_ctx->node), error_out);
 
     switch (change_ctx->operation) {
     case SR_OP_CREATED:
@@ -220,8 +208,8 @@ int interfaces_interface_ipv4_address_change_prefix_length(void* priv, sr_sessio
         delete_addr = rtnl_addr_alloc();
 
         // get full address
-        SRPC_SAFE_CALL_ERR_COND(error, error < 0, snprintf(address_buffer, sizeof(address_buffer), "%s/%s", ip_buffer, node_value), error_out);
-        SRPC_SAFE_CALL_ERR_COND(error, error < 0, snprintf(old_address_buffer, sizeof(old_address_buffer), "%s/%s", ip_buffer, change_ctx->previous_value), error_out);
+        SRPC_SAFE_CALL_ERR_COND(error, error < 0, snprintf(address_buffer, sizeof(address_buffer), "%s/%s", ip, node_value), error_out);
+        SRPC_SAFE_CALL_ERR_COND(error, error < 0, snprintf(old_address_buffer, sizeof(old_address_buffer), "%s/%s", ip, change_ctx->previous_value), error_out);
 
         // parse local address
         SRPC_SAFE_CALL_ERR(error, nl_addr_parse(address_buffer, AF_INET, &local_addr), error_out);
@@ -231,15 +219,11 @@ int interfaces_interface_ipv4_address_change_prefix_length(void* priv, sr_sessio
         SRPC_SAFE_CALL_ERR(error, rtnl_addr_set_local(request_addr, local_addr), error_out);
         SRPC_SAFE_CALL_ERR(error, rtnl_addr_set_local(delete_addr, old_local_addr), error_out);
 
-        // set interface
-        rtnl_addr_set_ifindex(request_addr, rtnl_link_get_ifindex(current_link));
-        rtnl_addr_set_ifindex(delete_addr, rtnl_link_get_ifindex(current_link));
-
         // delete old address
-        SRPC_SAFE_CALL_ERR(error, rtnl_addr_delete(mod_ctx->nl_ctx.socket, delete_addr, 0), error_out);
+        SRPC_SAFE_CALL_ERR(error, interfaces_change_plan_add(&mod_ctx->plan, interfaces_change_operation_address_delete, interface_name, (struct nl_object*)delete_addr, 0), error_out);
 
         // add new address
-        SRPC_SAFE_CALL_ERR(error, rtnl_addr_add(mod_ctx->nl_ctx.socket, request_addr, 0), error_out);
+        SRPC_SAFE_CALL_ERR(error, interfaces_change_plan_add(&mod_ctx->plan, interfaces_change_operation_address_add, interface_name, (struct nl_object*)request_addr, 0), error_out);
 
         break;
     case SR_OP_DELETED:
@@ -291,7 +275,6 @@ int interfaces_interface_ipv4_address_change_ip_init(void* priv)
 int interfaces_interface_ipv4_address_change_ip(void* priv, sr_session_ctx_t* session, const srpc_change_ctx_t* change_ctx)
 {
     int error = 0;
-    void* error_ptr = NULL;
 
     // sysrepo
     sr_val_t* prefix_val = NULL;
@@ -303,7 +286,7 @@ int interfaces_interface_ipv4_address_change_ip(void* priv, sr_session_ctx_t* se
     const char* node_name = LYD_NAME(change_ctx->node);
     const char* node_value = lyd_get_value(change_ctx->node);
     char path_buffer[PATH_MAX] = { 0 };
-    char interface_name_buffer[100] = { 0 };
+    const char* interface_name = NULL;
     char address_buffer[100] = { 0 };
 
     // app context
@@ -322,16 +305,13 @@ int interfaces_interface_ipv4_address_change_ip(void* priv, sr_session_ctx_t* se
 
     SRPLG_LOG_INF(PLUGIN_NAME, "Node Name: %s; Previous Value: %s, Value: %s; Operation: %d", node_name, change_ctx->previous_value, node_value, change_ctx->operation);
 
-    // get node path
-    SRPC_SAFE_CALL_PTR(error_ptr, lyd_path(change_ctx->node, LYD_PATH_STD, path_buffer, sizeof(path_buffer)), error_out);
-
     // get interface name
-    SRPC_SAFE_CALL_ERR(error, srpc_extract_xpath_key_value(path_buffer, "interface", "name", interface_name_buffer, sizeof(interface_name_buffer)), error_out);
+    SRPC_SAFE_CALL_PTR(interface_name, interfaces_change_get_list_key(change_ctx->node, "interface", "name"), error_out);
 
-    SRPLG_LOG_INF(PLUGIN_NAME, "Node Path: %s; Interface Name: %s", path_buffer, interface_name_buffer);
+    SRPLG_LOG_INF(PLUGIN_NAME, "Interface Name: %s", interface_name);
 
     // get link
-    SRPC_SAFE_CALL_PTR(current_link, rtnl_link_get_by_name(mod_ctx->nl_ctx.link_cache, interface_name_buffer), error_out);
+    SRPC_SAFE_CALL_PTR(current_link, interfaces_change_get_interface_link(mod_ctx, change_ctx->node), error_out);
 
     // get connection
     SRPC_SAFE_CALL_PTR(conn_ctx, sr_session_get_connection(session), error_out);
@@ -348,12 +328,12 @@ int interfaces_interface_ipv4_address_change_ip(void* priv, sr_session_ctx_t* se
         SRPC_SAFE_CALL_ERR(error, nl_addr_parse(node_value, AF_INET, &local_addr), error_out);
 
         // get prefix length by using prefix-length or netmask leafs
-        SRPC_SAFE_CALL_ERR_COND(error, error < 0, snprintf(path_buffer, sizeof(path_buffer), "%s[name=\"%s\"]/ietf-ip:ipv4/address[ip=\"%s\"]/prefix-length", INTERFACES_INTERFACES_LIST_YANG_PATH, interface_name_buffer, node_value), error_out);
+        SRPC_SAFE_CALL_ERR_COND(error, error < 0, snprintf(path_buffer, sizeof(path_buffer), "%s[name=\"%s\"]/ietf-ip:ipv4/address[ip=\"%s\"]/prefix-length", INTERFACES_INTERFACES_LIST_YANG_PATH, interface_name, node_value), error_out);
         SRPC_SAFE_CALL_ERR(error, srpc_iterate_changes(ctx, session, path_buffer, interfaces_interface_ipv4_address_get_prefix_length, NULL, NULL), error_out);
 
         if (!mod_ctx->mod_data.ipv4.address.prefix_set) {
             // prefix not found - check for netmask
-            SRPC_SAFE_CALL_ERR_COND(error, error < 0, snprintf(path_buffer, sizeof(path_buffer), "%s[name=\"%s\"]/ietf-ip:ipv4/address[ip=\"%s\"]/netmask", INTERFACES_INTERFACES_LIST_YANG_PATH, interface_name_buffer, node_value), error_out);
+            SRPC_SAFE_CALL_ERR_COND(error, error < 0, snprintf(path_buffer, sizeof(path_buffer), "%s[name=\"%s\"]/ietf-ip:ipv4/address[ip=\"%s\"]/netmask", INTERFACES_INTERFACES_LIST_YANG_PATH, interface_name, node_value), error_out);
             SRPC_SAFE_CALL_ERR(error, srpc_iterate_changes(ctx, session, path_buffer, interfaces_interface_ipv4_address_get_netmask, NULL, NULL), error_out);
 
             if (!mod_ctx->mod_data.ipv4.address.prefix_set) {
@@ -372,11 +352,8 @@ int interfaces_interface_ipv4_address_change_ip(void* priv, sr_session_ctx_t* se
         // set to route address
         SRPC_SAFE_CALL_ERR(error, rtnl_addr_set_local(request_addr, local_addr), error_out);
 
-        // set interface
-        rtnl_addr_set_ifindex(request_addr, rtnl_link_get_ifindex(current_link));
-
         // add address
-        SRPC_SAFE_CALL_ERR(error, rtnl_addr_add(mod_ctx->nl_ctx.socket, request_addr, 0), error_out);
+        SRPC_SAFE_CALL_ERR(error, interfaces_change_plan_add(&mod_ctx->plan, interfaces_change_operation_address_add, interface_name, (struct nl_object*)request_addr, 0), error_out);
 
         break;
     case SR_OP_MODIFIED:
@@ -390,7 +367,7 @@ int interfaces_interface_ipv4_address_change_ip(void* priv, sr_session_ctx_t* se
         request_addr = rtnl_addr_alloc();
 
         // check for prefix-length
-        SRPC_SAFE_CALL_ERR_COND(error, error < 0, snprintf(path_buffer, sizeof(path_buffer), INTERFACES_INTERFACES_INTERFACE_YANG_PATH "[name=\"%s\"]/ietf-ip:ipv4/address[ip=\"%s\"]/prefix-length", interface_name_buffer, node_value), error_out);
+        SRPC_SAFE_CALL_ERR_COND(error, error < 0, snprintf(path_buffer, sizeof(path_buffer), INTERFACES_INTERFACES_INTERFACE_YANG_PATH "[name=\"%s\"]/ietf-ip:ipv4/address[ip=\"%s\"]/prefix-length", interface_name, node_value), error_out);
         SRPLG_LOG_INF(PLUGIN_NAME, "Searching running DS for %s", path_buffer);
 
         error = sr_get_item(running_session, path_buffer, 0, &prefix_val);
@@ -399,7 +376,7 @@ int interfaces_interface_ipv4_address_change_ip(void* priv, sr_session_ctx_t* se
             prefix_length = prefix_val->data.uint8_val;
         } else if (error == SR_ERR_NOT_FOUND) {
             // fetch netmask
-            SRPC_SAFE_CALL_ERR_COND(error, error < 0, snprintf(path_buffer, sizeof(path_buffer), "%s[name=\"%s\"]/ietf-ip:ipv4/address[ip=\"%s\"]/netmask", INTERFACES_INTERFACES_LIST_YANG_PATH, interface_name_buffer, node_value), error_out);
+            SRPC_SAFE_CALL_ERR_COND(error, error < 0, snprintf(path_buffer, sizeof(path_buffer), "%s[name=\"%s\"]/ietf-ip:ipv4/address[ip=\"%s\"]/netmask", INTERFACES_INTERFACES_LIST_YANG_PATH, interface_name, node_value), error_out);
             SRPC_SAFE_CALL_ERR(error, sr_get_item(running_session, path_buffer, 0, &netmask_val), error_out);
 
             // convert netmask to prefix
@@ -423,11 +400,8 @@ int interfaces_interface_ipv4_address_change_ip(void* priv, sr_session_ctx_t* se
         // set to route address
         SRPC_SAFE_CALL_ERR(error, rtnl_addr_set_local(request_addr, local_addr), error_out);
 
-        // set interface
-        rtnl_addr_set_ifindex(request_addr, rtnl_link_get_ifindex(current_link));
-
         // remove wanted address
-        SRPC_SAFE_CALL_ERR(error, rtnl_addr_delete(mod_ctx->nl_ctx.socket, request_addr, 0), error_out);
+        SRPC_SAFE_CALL_ERR(error, interfaces_change_plan_add(&mod_ctx->plan, interfaces_change_operation_address_delete, interface_name, (struct nl_object*)request_addr, 0), error_out);
 
         break;
     case SR_OP_MOVED:
@@ -14,6 +14,8 @@
 #include "libyang/tree_data.h"
 #include "netlink/cache.h"
 #include "netlink/route/link.h"
+#include "plugin/api/interfaces/lookup.h"
+#include "plugin/api/interfaces/plan.h"
 #include "plugin/common.h"
 #include "plugin/context.h"
 #include "sysrepo_types.h"
@@ -96,11 +98,9 @@ int interfaces_interface_ipv4_change_mtu_init(void* priv)
 int interfaces_interface_ipv4_change_mtu(void* priv, sr_session_ctx_t* session, const srpc_change_ctx_t* change_ctx)
 {
     int error = SR_ERR_OK;
-    void* error_ptr = NULL;
     const char* node_name = LYD_NAME(change_ctx->node);
     const char* node_value = lyd_get_value(change_ctx->node);
-    char path_buffer[PATH_MAX] = { 0 };
-    char interface_name_buffer[100] = { 0 };
+    const char* interface_name = NULL;
 
     // app context
     interfaces_ctx_t* ctx = priv;
@@ -114,21 +114,16 @@ int interfaces_interface_ipv4_change_mtu(void* priv, sr_session_ctx_t* session,
 
     SRPLG_LOG_INF(PLUGIN_NAME, "Node Name: %s; Previous Value: %s, Value: %s; Operation: %d", node_name, change_ctx->previous_value, node_value, change_ctx->operation);
 
-    // get node path
-    SRPC_SAFE_CALL_PTR(error_ptr, lyd_path(change_ctx->node, LYD_PATH_STD, path_buffer, sizeof(path_buffer)), error_out);
-
     // get interface name
-    SRPC_SAFE_CALL_ERR(error, srpc_extract_xpath_key_value(path_buffer, "interface", "name", interface_name_buffer, sizeof(interface_name_buffer)), error_out);
+    SRPC_SAFE_CALL_PTR(interface_name, interfaces_change_get_list_key(change_ctx->node, "interface", "name"), error_out);
 
-    SRPLG_LOG_INF(PLUGIN_NAME, "Node Path: %s; Interface Name: %s", path_buffer, interface_name_buffer);
+    SRPLG_LOG_INF(PLUGIN_NAME, "Interface Name: %s", interface_name);
 
     // get link
-    SRPC_SAFE_CALL_PTR(current_link, rtnl_link_get_by_name(mod_ctx->nl_ctx.link_cache, interface_name_buffer), error_out);
+    SRPC_SAFE_CALL_PTR(current_link, interfaces_change_get_interface_link(mod_ctx, change_ctx->node), error_out);
 
-    // create request
-    request_link = rtnl_link_alloc();
-    rtnl_link_set_name(request_link, rtnl_link_get_name(current_link));
-    SRPC_SAFE_CALL_ERR(error, rtnl_link_set_type(request_link, rtnl_link_get_type(current_link)), error_out);
+    // request link shared by all link attribute changes of the interface
+    SRPC_SAFE_CALL_PTR(request_link, interfaces_change_plan_get_link_request(&mod_ctx->plan, interface_name), error_out);
 
     switch (change_ctx->operation) {
     case SR_OP_CREATED:
@@ -148,9 +143,6 @@ int interfaces_interface_ipv4_change_mtu(void* priv, sr_session_ctx_t* session,
         break;
     }
 
-    // apply changes
-    SRPC_SAFE_CALL_ERR(error, rtnl_link_change(mod_ctx->nl_ctx.socket, current_link, request_link, 0), error_out);
-
     goto out;
 
 error_out:
@@ -208,7 +200,6 @@ int interfaces_interface_ipv4_change_enabled_init(void* priv)
 int interfaces_interface_ipv4_change_enabled(void* priv, sr_session_ctx_t* session, const srpc_change_ctx_t* change_ctx)
 {
     int error = 0;
-    void* error_ptr = NULL;
     interfaces_ctx_t* ctx = priv;
     interfaces_mod_changes_ctx_t* mod_ctx = &ctx->mod_ctx;
 
@@ -220,7 +211,7 @@ int interfaces_interface_ipv4_change_enabled(void* priv, sr_session_ctx_t* sessi
     const char* node_value = lyd_get_value(change_ctx->node);
 
     char path_buffer[PATH_MAX] = { 0 };
-    char interface_name_buffer[100] = { 0 };
+    const char* interface_name = NULL;
 
     struct rtnl_link* current_link = NULL;
     struct rtnl_addr* addr_iter = NULL;
@@ -229,16 +220,13 @@ int interfaces_interface_ipv4_change_enabled(void* priv, sr_session_ctx_t* sessi
 
     SRPLG_LOG_INF(PLUGIN_NAME, "Node Name: %s; Previous Value: %s, Value: %s; Operation: %d", node_name, change_ctx->previous_value, node_value, change_ctx->operation);
 
-    // get node path
-    SRPC_SAFE_CALL_PTR(error_ptr, lyd_path(change_ctx->node, LYD_PATH_STD, path_buffer, sizeof(path_buffer)), error_out);
-
     // get interface name
-    SRPC_SAFE_CALL_ERR(error, srpc_extract_xpath_key_value(path_buffer, "interface", "name", interface_name_buffer, sizeof(interface_name_buffer)), error_out);
+    SRPC_SAFE_CALL_PTR(interface_name, interfaces_change_get_list_key(change_ctx->node, "interface", "name"), error_out);
 
-    SRPLG_LOG_INF(PLUGIN_NAME, "Node Path: %s; Interface Name: %s", path_buffer, interface_name_buffer);
+    SRPLG_LOG_INF(PLUGIN_NAME, "Interface Name: %s", interface_name);
 
     // get link
-    SRPC_SAFE_CALL_PTR(current_link, rtnl_link_get_by_name(mod_ctx->nl_ctx.link_cache, interface_name_buffer), error_out);
+    SRPC_SAFE_CALL_PTR(current_link, interfaces_change_get_interface_link(mod_ctx, change_ctx->node), error_out);
 
     // get address iterator
     SRPC_SAFE_CALL_PTR(addr_iter, (struct rtnl_addr*)nl_cache_get_first(mod_ctx->nl_ctx.addr_cache), error_out);
@@ -255,9 +243,9 @@ int interfaces_interface_ipv4_change_enabled(void* priv, sr_session_ctx_t* sessi
         // if IPv4 disabled - delete all v4 addresses on the interface
         if (!strcmp(node_value, "false")) {
             // configure path buffer
-            SRPC_SAFE_CALL_ERR_COND(error, error < 0, snprintf(path_buffer, sizeof(path_buffer), "%s[name=\"%s\"]/ietf-ip:ipv4/address", INTERFACES_INTERFACES_LIST_YANG_PATH, interface_name_buffer), error_out);
+            SRPC_SAFE_CALL_ERR_COND(error, error < 0, snprintf(path_buffer, sizeof(path_buffer), "%s[name=\"%s\"]/ietf-ip:ipv4/address", INTERFACES_INTERFACES_LIST_YANG_PATH, interface_name), error_out);
 
-            SRPLG_LOG_INF(PLUGIN_NAME, "Deleting every IPv4 address for interface %s: path = %s", interface_name_buffer, path_buffer);
+            SRPLG_LOG_INF(PLUGIN_NAME, "Deleting every IPv4 address for interface %s: path = %s", interface_name, path_buffer);
         }
         break;
     case SR_OP_DELETED:
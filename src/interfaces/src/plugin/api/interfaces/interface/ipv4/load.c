@@ -21,6 +21,7 @@
 #include "plugin/data/interfaces/interface.h"
 #include "plugin/data/interfaces/interface/ipv4.h"
 #include "plugin/data/interfaces/interface/ipv4/address.h"
+#include "plugin/data/interfaces/object_index.h"
 #include "plugin/types.h"
 #include "sysrepo.h"
 
@@ -73,6 +74,8 @@ int interfaces_interface_ipv4_load_address(interfaces_ctx_t* ctx, interfaces_int
     int error = 0;
     interfaces_nl_ctx_t* nl_ctx = &ctx->startup_ctx.nl_ctx;
     struct rtnl_addr* addr_iter = NULL;
+    struct nl_object* const* objects = NULL;
+    size_t objects_count = 0;
 
     // created element
     interfaces_interface_ipv4_address_element_t* new_element = NULL;
@@ -81,31 +84,23 @@ int interfaces_interface_ipv4_load_address(interfaces_ctx_t* ctx, interfaces_int
     // allocate address list
     ipv4->address = interfaces_interface_ipv4_address_new();
 
-    // allocate cache
-    SRPC_SAFE_CALL_ERR(error, rtnl_addr_alloc_cache(nl_ctx->socket, &nl_ctx->addr_cache), error_out);
+    // addresses of the link - dumped and indexed once by interfaces_load_interface()
+    objects_count = interfaces_object_index_get(&nl_ctx->addr_index, rtnl_link_get_ifindex(link), AF_INET, &objects);
 
-    // get link iterator
-    SRPC_SAFE_CALL_PTR(addr_iter, (struct rtnl_addr*)nl_cache_get_first(nl_ctx->addr_cache), error_out);
+    for (size_t i = 0; i < objects_count; i++) {
+        addr_iter = (struct rtnl_addr*)objects[i];
 
-    // iterate links
-    while (addr_iter) {
-        // get all addresses from the link and extract info
-        if (rtnl_addr_get_ifindex(addr_iter) == rtnl_link_get_ifindex(link) && rtnl_addr_get_family(addr_iter) == AF_INET) {
-            // create new element
-            new_element = interfaces_interface_ipv4_address_element_new();
-            element_added = 0;
+        // create new element
+        new_element = interfaces_interface_ipv4_address_element_new();
+        element_added = 0;
 
-            // load IP and prefix
-            SRPC_SAFE_CALL_ERR(error, interfaces_interface_ipv4_address_load_ip(ctx, &new_element, addr_iter), error_out);
-            SRPC_SAFE_CALL_ERR(error, interfaces_interface_ipv4_address_load_prefix_length(ctx, &new_element, addr_iter), error_out);
+        // load IP and prefix
+        SRPC_SAFE_CALL_ERR(error, interfaces_interface_ipv4_address_load_ip(ctx, &new_element, addr_iter), error_out);
+        SRPC_SAFE_CALL_ERR(error, interfaces_interface_ipv4_address_load_prefix_length(ctx, &new_element, addr_iter), error_out);
 
-            // add element to the list
-            SRPC_SAFE_CALL_ERR(error, interfaces_interface_ipv4_address_add_element(&ipv4->address, new_element), error_out);
-            element_added = 1;
-        }
-
-        // iterate
-        addr_iter = (struct rtnl_addr*)nl_cache_get_next((struct nl_object*)addr_iter);
+        // add element to the list
+        SRPC_SAFE_CALL_ERR(error, interfaces_interface_ipv4_address_add_element(&ipv4->address, new_element), error_out);
+        element_added = 1;
     }
 
     goto out;
@@ -128,6 +123,8 @@ int interfaces_interface_ipv4_load_neighbor(interfaces_ctx_t* ctx, interfaces_in
     int error = 0;
     interfaces_nl_ctx_t* nl_ctx = &ctx->startup_ctx.nl_ctx;
     struct rtnl_neigh* neigh_iter = NULL;
+    struct nl_object* const* objects = NULL;
+    size_t objects_count = 0;
 
     // created element
     interfaces_interface_ipv4_neighbor_element_t* new_element = NULL;
@@ -136,31 +133,23 @@ int interfaces_interface_ipv4_load_neighbor(interfaces_ctx_t* ctx, interfaces_in
     // allocate address list
     ipv4->neighbor = interfaces_interface_ipv4_neighbor_new();
 
-    // allocate cache
-    SRPC_SAFE_CALL_ERR(error, rtnl_neigh_alloc_cache(nl_ctx->socket, &nl_ctx->neigh_cache), error_out);
-
-    // get link iterator
-    SRPC_SAFE_CALL_PTR(neigh_iter, (struct rtnl_neigh*)nl_cache_get_first(nl_ctx->neigh_cache), error_out);
+    // neighbors of the link
+    objects_count = interfaces_object_index_get(&nl_ctx->neigh_index, rtnl_link_get_ifindex(link), AF_INET, &objects);
 
-    // iterate links
-    while (neigh_iter) {
-        // get all neighbors from the link and extract info
-        if (rtnl_neigh_get_ifindex(neigh_iter) == rtnl_link_get_ifindex(link) && rtnl_neigh_get_family(neigh_iter) == AF_INET) {
-            // create new element
-            new_element = interfaces_interface_ipv4_neighbor_element_new();
-            element_added = 0;
+    for (size_t i = 0; i < objects_count; i++) {
+        neigh_iter = (struct rtnl_neigh*)objects[i];
 
-            // load IP and prefix
-            SRPC_SAFE_CALL_ERR(error, interfaces_interface_ipv4_neighbor_load_ip(ctx, &new_element, neigh_iter), error_out);
-            SRPC_SAFE_CALL_ERR(error, interfaces_interface_ipv4_neighbor_load_link_layer_address(ctx, &new_element, neigh_iter), error_out);
+        // create new element
+        new_element = interfaces_interface_ipv4_neighbor_element_new();
+        element_added = 0;
 
-            // add element to the list
-            SRPC_SAFE_CALL_ERR(error, interfaces_interface_ipv4_neighbor_add_element(&ipv4->neighbor, new_element), error_out);
-            element_added = 1;
-        }
+        // load IP and prefix
+        SRPC_SAFE_CALL_ERR(error, interfaces_interface_ipv4_neighbor_load_ip(ctx, &new_element, neigh_iter), error_out);
+        SRPC_SAFE_CALL_ERR(error, interfaces_interface_ipv4_neighbor_load_link_layer_address(ctx, &new_element, neigh_iter), error_out);
 
-        // iterate
-        neigh_iter = (struct rtnl_neigh*)nl_cache_get_next((struct nl_object*)neigh_iter);
+        // add element to the list
+        SRPC_SAFE_CALL_ERR(error, interfaces_interface_ipv4_neighbor_add_element(&ipv4->neighbor, new_element), error_out);
+        element_added = 1;
     }
 
     goto out;
@@ -11,6 +11,8 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 #include "change.h"
+#include "plugin/api/interfaces/lookup.h"
+#include "plugin/api/interfaces/plan.h"
 #include "plugin/common.h"
 #include "plugin/context.h"
 
@@ -32,14 +34,12 @@ int interfaces_interface_ipv6_neighbor_change_link_layer_address_init(void* priv
 int interfaces_interface_ipv6_neighbor_change_link_layer_address(void* priv, sr_session_ctx_t* session, const srpc_change_ctx_t* change_ctx)
 {
     int error = 0;
-    void* error_ptr = NULL;
 
     // strings and buffers
     const char* node_name = LYD_NAME(change_ctx->node);
     const char* node_value = lyd_get_value(change_ctx->node);
-    char path_buffer[PATH_MAX] = { 0 };
-    char interface_name_buffer[100] = { 0 };
-    char ip_buffer[100] = { 0 };
+    const char* interface_name = NULL;
+    const char* ip = NULL;
 
     // app context
     interfaces_ctx_t* ctx = priv;
@@ -49,25 +49,24 @@ int interfaces_interface_ipv6_neighbor_change_link_layer_address(void* priv, sr_
 
     // libnl
     struct rtnl_neigh* request_neigh = NULL;
+    struct rtnl_neigh* undo_neigh = NULL;
     struct rtnl_link* current_link = NULL;
     struct nl_addr* dst_addr = NULL;
     struct nl_addr* ll_addr = NULL;
+    struct nl_addr* old_ll_addr = NULL;
 
     SRPLG_LOG_INF(PLUGIN_NAME, "Node Name: %s; Previous Value: %s, Value: %s; Operation: %d", node_name, change_ctx->previous_value, node_value, change_ctx->operation);
 
-    // get node path
-    SRPC_SAFE_CALL_PTR(error_ptr, lyd_path(change_ctx->node, LYD_PATH_STD, path_buffer, sizeof(path_buffer)), error_out);
-
     // get interface name
-    SRPC_SAFE_CALL_ERR(error, srpc_extract_xpath_key_value(path_buffer, "interface", "name", interface_name_buffer, sizeof(interface_name_buffer)), error_out);
+    SRPC_SAFE_CALL_PTR(interface_name, interfaces_change_get_list_key(change_ctx->node, "interface", "name"), error_out);
 
     // get IP
-    SRPC_SAFE_CALL_ERR(error, srpc_extract_xpath_key_value(path_buffer, "neighbor", "ip", ip_buffer, sizeof(ip_buffer)), error_out);
+    SRPC_SAFE_CALL_PTR(ip, interfaces_change_get_list_key(change_ctx->node, "neighbor", "ip"), error_out);
 
-    SRPLG_LOG_INF(PLUGIN_NAME, "Node Path: %s; Interface Name: %s; Neighbor IP: %s", path_buffer, interface_name_buffer, ip_buffer);
+    SRPLG_LOG_INF(PLUGIN_NAME, "Interface Name: %s; Neighbor IP: %s", interface_name, ip);
 
     // get link
-    SRPC_SAFE_CALL_PTR(current_link, rtnl_link_get_by_name(mod_ctx->nl_ctx.link_cache, interface_name_buffer), error_out);
+    SRPC_SAFE_CALL_PTR(current_link, interfaces_change_get_interface_link(mod_ctx, change_ctx->node), error_out);
 
     switch (change_ctx->operation) {
     case SR_OP_CREATED:
@@ -77,11 +76,8 @@ int interfaces_interface_ipv6_neighbor_change_link_layer_address(void* priv, sr_
         // change lladdr
         request_neigh = rtnl_neigh_alloc();
 
-        // set interface
-        rtnl_neigh_set_ifindex(request_neigh, rtnl_link_get_ifindex(current_link));
-
         // parse destination and LL address
-        SRPC_SAFE_CALL_ERR(error, nl_addr_parse(ip_buffer, AF_INET6, &dst_addr), error_out);
+        SRPC_SAFE_CALL_ERR(error, nl_addr_parse(ip, AF_INET6, &dst_addr), error_out);
         SRPC_SAFE_CALL_ERR(error, nl_addr_parse(node_value, AF_LLC, &ll_addr), error_out);
 
         // set destination and LL address
@@ -89,7 +85,15 @@ int interfaces_interface_ipv6_neighbor_change_link_layer_address(void* priv, sr_
         rtnl_neigh_set_lladdr(request_neigh, ll_addr);
 
         // change neighbor
-        SRPC_SAFE_CALL_ERR(error, rtnl_neigh_add(mod_ctx->nl_ctx.socket, request_neigh, NLM_F_REPLACE), error_out);
+        SRPC_SAFE_CALL_ERR(error, interfaces_change_plan_add(&mod_ctx->plan, interfaces_change_operation_neighbor_add, interface_name, (struct nl_object*)request_neigh, NLM_F_REPLACE), error_out);
+
+        // restore the previous LL address on rollback
+        SRPC_SAFE_CALL_PTR(undo_neigh, rtnl_neigh_alloc(), error_out);
+        SRPC_SAFE_CALL_ERR(error, nl_addr_parse(change_ctx->previous_value, AF_LLC, &old_ll_addr), error_out);
+        SRPC_SAFE_CALL_ERR(error, rtnl_neigh_set_dst(undo_neigh, dst_addr), error_out);
+        rtnl_neigh_set_lladdr(undo_neigh, old_ll_addr);
+
+        SRPC_SAFE_CALL_ERR(error, interfaces_change_plan_set_undo(&mod_ctx->plan, interfaces_change_operation_neighbor_add, (struct nl_object*)undo_neigh, NLM_F_REPLACE), error_out);
 
         break;
     case SR_OP_DELETED:
@@ -109,6 +113,14 @@ out:
         rtnl_neigh_put(request_neigh);
     }
 
+    if (undo_neigh) {
+        rtnl_neigh_put(undo_neigh);
+    }
+
+    if (old_ll_addr) {
+        nl_addr_put(old_ll_addr);
+    }
+
     return error;
 }
 
@@ -125,13 +137,12 @@ int interfaces_interface_ipv6_neighbor_change_ip_init(void* priv)
 int interfaces_interface_ipv6_neighbor_change_ip(void* priv, sr_session_ctx_t* session, const srpc_change_ctx_t* change_ctx)
 {
     int error = 0;
-    void* error_ptr = NULL;
 
     // strings and buffers
     const char* node_name = LYD_NAME(change_ctx->node);
     const char* node_value = lyd_get_value(change_ctx->node);
     char path_buffer[PATH_MAX] = { 0 };
-    char interface_name_buffer[100] = { 0 };
+    const char* interface_name = NULL;
 
     // app context
     interfaces_ctx_t* ctx = priv;
@@ -141,22 +152,21 @@ int interfaces_interface_ipv6_neighbor_change_ip(void* priv, sr_session_ctx_t* s
 
     // libnl
     struct rtnl_neigh* request_neigh = NULL;
+    struct rtnl_neigh* undo_neigh = NULL;
     struct rtnl_link* current_link = NULL;
     struct nl_addr* dst_addr = NULL;
     struct nl_addr* ll_addr = NULL;
+    struct nl_addr* old_ll_addr = NULL;
 
     SRPLG_LOG_INF(PLUGIN_NAME, "Node Name: %s; Previous Value: %s, Value: %s; Operation: %d", node_name, change_ctx->previous_value, node_value, change_ctx->operation);
 
-    // get node path
-    SRPC_SAFE_CALL_PTR(error_ptr, lyd_path(change_ctx->node, LYD_PATH_STD, path_buffer, sizeof(path_buffer)), error_out);
-
     // get interface name
-    SRPC_SAFE_CALL_ERR(error, srpc_extract_xpath_key_value(path_buffer, "interface", "name", interface_name_buffer, sizeof(interface_name_buffer)), error_out);
+    SRPC_SAFE_CALL_PTR(interface_name, interfaces_change_get_list_key(change_ctx->node, "interface", "name"), error_out);
 
-    SRPLG_LOG_INF(PLUGIN_NAME, "Node Path: %s; Interface Name: %s", path_buffer, interface_name_buffer);
+    SRPLG_LOG_INF(PLUGIN_NAME, "Interface Name: %s", interface_name);
 
     // get link
-    SRPC_SAFE_CALL_PTR(current_link, rtnl_link_get_by_name(mod_ctx->nl_ctx.link_cache, interface_name_buffer), error_out);
+    SRPC_SAFE_CALL_PTR(current_link, interfaces_change_get_interface_link(mod_ctx, change_ctx->node), error_out);
 
     switch (change_ctx->operation) {
     case SR_OP_CREATED:
@@ -167,7 +177,7 @@ int interfaces_interface_ipv6_neighbor_change_ip(void* priv, sr_session_ctx_t* s
         SRPC_SAFE_CALL_ERR(error, nl_addr_parse(node_value, AF_INET6, &dst_addr), error_out);
 
         // get prefix length by using prefix-length or netmask leafs
-        SRPC_SAFE_CALL_ERR_COND(error, error < 0, snprintf(path_buffer, sizeof(path_buffer), INTERFACES_INTERFACES_INTERFACE_YANG_PATH "[name=\"%s\"]/ietf-ip:ipv6/neighbor[ip=\"%s\"]/link-layer-address", interface_name_buffer, node_value), error_out);
+        SRPC_SAFE_CALL_ERR_COND(error, error < 0, snprintf(path_buffer, sizeof(path_buffer), INTERFACES_INTERFACES_INTERFACE_YANG_PATH "[name=\"%s\"]/ietf-ip:ipv6/neighbor[ip=\"%s\"]/link-layer-address", interface_name, node_value), error_out);
         SRPC_SAFE_CALL_ERR(error, srpc_iterate_changes(ctx, session, path_buffer, interfaces_interface_ipv6_neighbor_get_link_layer_address, NULL, NULL), error_out);
 
         SRPLG_LOG_INF(PLUGIN_NAME, "Recieved link-layer-address %s for neighbor address %s", mod_ctx->mod_data.ipv6.neighbor.link_layer_address, node_value);
@@ -179,11 +189,8 @@ int interfaces_interface_ipv6_neighbor_change_ip(void* priv, sr_session_ctx_t* s
         SRPC_SAFE_CALL_ERR(error, rtnl_neigh_set_dst(request_neigh, dst_addr), error_out);
         rtnl_neigh_set_lladdr(request_neigh, ll_addr);
 
-        // set interface
-        rtnl_neigh_set_ifindex(request_neigh, rtnl_link_get_ifindex(current_link));
-
         // add neighbor
-        SRPC_SAFE_CALL_ERR(error, rtnl_neigh_add(mod_ctx->nl_ctx.socket, request_neigh, NLM_F_CREATE), error_out);
+        SRPC_SAFE_CALL_ERR(error, interfaces_change_plan_add(&mod_ctx->plan, interfaces_change_operation_neighbor_add, interface_name, (struct nl_object*)request_neigh, NLM_F_CREATE), error_out);
 
         break;
     case SR_OP_MODIFIED:
@@ -194,9 +201,6 @@ int interfaces_interface_ipv6_neighbor_change_ip(void* priv, sr_session_ctx_t* s
     case SR_OP_DELETED:
         request_neigh = rtnl_neigh_alloc();
 
-        // set interface
-        rtnl_neigh_set_ifindex(request_neigh, rtnl_link_get_ifindex(current_link));
-
         // parse destination
         SRPC_SAFE_CALL_ERR(error, nl_addr_parse(node_value, AF_INET6, &dst_addr), error_out);
 
@@ -204,7 +208,20 @@ int interfaces_interface_ipv6_neighbor_change_ip(void* priv, sr_session_ctx_t* s
         SRPC_SAFE_CALL_ERR(error, rtnl_neigh_set_dst(request_neigh, dst_addr), error_out);
 
         // remove wanted neighbor
-        SRPC_SAFE_CALL_ERR(error, rtnl_neigh_delete(mod_ctx->nl_ctx.socket, request_neigh, 0), error_out);
+        SRPC_SAFE_CALL_ERR(error, interfaces_change_plan_add(&mod_ctx->plan, interfaces_change_operation_neighbor_delete, interface_name, (struct nl_object*)request_neigh, 0), error_out);
+
+        // re-adding the neighbor on rollback needs its deleted LL address
+        SRPC_SAFE_CALL_ERR_COND(error, error < 0, snprintf(path_buffer, sizeof(path_buffer), INTERFACES_INTERFACES_INTERFACE_YANG_PATH "[name=\"%s\"]/ietf-ip:ipv6/neighbor[ip=\"%s\"]/link-layer-address", interface_name, node_value), error_out);
+        SRPC_SAFE_CALL_ERR(error, srpc_iterate_changes(ctx, session, path_buffer, interfaces_interface_ipv6_neighbor_get_link_layer_address, NULL, NULL), error_out);
+
+        if (mod_ctx->mod_data.ipv6.neighbor.link_layer_set) {
+            SRPC_SAFE_CALL_PTR(undo_neigh, rtnl_neigh_alloc(), error_out);
+            SRPC_SAFE_CALL_ERR(error, nl_addr_parse(mod_ctx->mod_data.ipv6.neighbor.link_layer_address, AF_LLC, &old_ll_addr), error_out);
+            SRPC_SAFE_CALL_ERR(error, rtnl_neigh_set_dst(undo_neigh, dst_addr), error_out);
+            rtnl_neigh_set_lladdr(undo_neigh, old_ll_addr);
+
+            SRPC_SAFE_CALL_ERR(error, interfaces_change_plan_set_undo(&mod_ctx->plan, interfaces_change_operation_neighbor_add, (struct nl_object*)undo_neigh, NLM_F_CREATE), error_out);
+        }
 
         break;
     case SR_OP_MOVED:
@@ -232,6 +249,14 @@ out:
         rtnl_neigh_put(request_neigh);
     }
 
+    if (undo_neigh) {
+        rtnl_neigh_put(undo_neigh);
+    }
+
+    if (old_ll_addr) {
+        nl_addr_put(old_ll_addr);
+    }
+
     return error;
 }
 
@@ -16,6 +16,7 @@
 #include "plugin/common.h"
 #include "plugin/context.h"
 #include "plugin/data/interfaces/interface.h"
+#include "plugin/data/interfaces/object_index.h"
 #include "plugin/types.h"
 #include "read.h"
 #include "utils/memory.h"
@@ -66,7 +67,14 @@ int interfaces_load_interface(interfaces_ctx_t* ctx, interfaces_interface_hash_e
     // socket + cache
     SRPC_SAFE_CALL_PTR(nl_ctx->socket, nl_socket_alloc(), error_out);
     SRPC_SAFE_CALL_ERR(error, nl_connect(nl_ctx->socket, NETLINK_ROUTE), error_out);
+
+    // dump links, addresses and neighbors once - the per-link loaders only look up their own objects
     SRPC_SAFE_CALL_ERR(error, rtnl_link_alloc_cache(nl_ctx->socket, AF_UNSPEC, &nl_ctx->link_cache), error_out);
+    SRPC_SAFE_CALL_ERR(error, rtnl_addr_alloc_cache(nl_ctx->socket, &nl_ctx->addr_cache), error_out);
+    SRPC_SAFE_CALL_ERR(error, rtnl_neigh_alloc_cache(nl_ctx->socket, &nl_ctx->neigh_cache), error_out);
+
+    SRPC_SAFE_CALL_ERR(error, interfaces_object_index_build_addresses(&nl_ctx->addr_index, nl_ctx->addr_cache), error_out);
+    SRPC_SAFE_CALL_ERR(error, interfaces_object_index_build_neighbors(&nl_ctx->neigh_index, nl_ctx->neigh_cache), error_out);
 
     // get link iterator
     SRPC_SAFE_CALL_PTR(link_iter, (struct rtnl_link*)nl_cache_get_first(nl_ctx->link_cache), error_out);
@@ -119,16 +127,28 @@ error_out:
 
 out:
     // dealloc nl_ctx data
+    interfaces_object_index_free(&nl_ctx->addr_index);
+    interfaces_object_index_free(&nl_ctx->neigh_index);
 
     if (nl_ctx->socket != NULL) {
         nl_socket_free(nl_ctx->socket);
+        nl_ctx->socket = NULL;
     }
 
     if (nl_ctx->link_cache != NULL) {
         nl_cache_free(nl_ctx->link_cache);
+        nl_ctx->link_cache = NULL;
     }
 
-    // address and neighbor caches should be freed by their functions (_load_address and _load_neighbor)
+    if (nl_ctx->addr_cache != NULL) {
+        nl_cache_free(nl_ctx->addr_cache);
+        nl_ctx->addr_cache = NULL;
+    }
+
+    if (nl_ctx->neigh_cache != NULL) {
+        nl_cache_free(nl_ctx->neigh_cache);
+        nl_ctx->neigh_cache = NULL;
+    }
 
     return error;
 }
\ No newline at end of file
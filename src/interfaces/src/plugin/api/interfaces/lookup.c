@@ -0,0 +1,98 @@
+/*
+ * telekom / sysrepo-plugin-system
+ *
+ * This program is made available under the terms of the
+ * BSD 3-Clause license which is available at
+ * https://opensource.org/licenses/BSD-3-Clause
+ *
+ * SPDX-FileCopyrightText: 2022 Deutsche Telekom AG
+ * SPDX-FileContributor: Sartura Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include "lookup.h"
+#include "plan.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static const struct lyd_node* interfaces_change_get_list_node(const struct lyd_node* node, const char* list_name);
+
+const char* interfaces_change_get_list_key(const struct lyd_node* node, const char* list_name, const char* key_name)
+{
+    const struct lyd_node* list_node = interfaces_change_get_list_node(node, list_name);
+
+    if (!list_node) {
+        return NULL;
+    }
+
+    // keys are always the first children of a list instance - the change tree keeps them for every operation
+    for (const struct lyd_node* key_iter = lyd_child(list_node); key_iter && lysc_is_key(key_iter->schema); key_iter = key_iter->next) {
+        if (!strcmp(LYD_NAME(key_iter), key_name)) {
+            return lyd_get_value(key_iter);
+        }
+    }
+
+    return NULL;
+}
+
+struct rtnl_link* interfaces_change_get_interface_link(interfaces_mod_changes_ctx_t* mod_ctx, const struct lyd_node* node)
+{
+    const struct lyd_node* interface_node = NULL;
+    const char* interface_name = NULL;
+    interfaces_change_interface_link_t* interface_link = NULL;
+
+    interface_node = interfaces_change_get_list_node(node, "interface");
+    if (!interface_node) {
+        return NULL;
+    }
+
+    // resolved once per interface - links are added and deleted only by the name handler, which runs first
+    HASH_FIND_PTR(mod_ctx->interface_links, &interface_node, interface_link);
+    if (interface_link) {
+        return interface_link->link;
+    }
+
+    interface_name = interfaces_change_get_list_key(interface_node, "interface", "name");
+    if (!interface_name) {
+        return NULL;
+    }
+
+    interface_link = malloc(sizeof(*interface_link));
+    if (!interface_link) {
+        return NULL;
+    }
+
+    *interface_link = (interfaces_change_interface_link_t) {
+        .interface_node = interface_node,
+        .link = interfaces_change_plan_get_link(&mod_ctx->plan, mod_ctx->nl_ctx.link_cache, interface_name),
+    };
+
+    HASH_ADD_PTR(mod_ctx->interface_links, interface_node, interface_link);
+
+    return interface_link->link;
+}
+
+void interfaces_change_interface_links_free(interfaces_mod_changes_ctx_t* mod_ctx)
+{
+    interfaces_change_interface_link_t* interface_link = NULL;
+    interfaces_change_interface_link_t* tmp = NULL;
+
+    HASH_ITER(hh, mod_ctx->interface_links, interface_link, tmp)
+    {
+        HASH_DEL(mod_ctx->interface_links, interface_link);
+        free(interface_link);
+    }
+}
+
+static const struct lyd_node* interfaces_change_get_list_node(const struct lyd_node* node, const char* list_name)
+{
+    // closest list instance with the given name - the node itself for a list or an ancestor for its leafs
+    for (const struct lyd_node* node_iter = node; node_iter; node_iter = lyd_parent(node_iter)) {
+        if (node_iter->schema->nodetype == LYS_LIST && !strcmp(LYD_NAME(node_iter), list_name)) {
+            return node_iter;
+        }
+    }
+
+    return NULL;
+}
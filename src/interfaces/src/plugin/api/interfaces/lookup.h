@@ -0,0 +1,25 @@
+/*
+ * telekom / sysrepo-plugin-system
+ *
+ * This program is made available under the terms of the
+ * BSD 3-Clause license which is available at
+ * https://opensource.org/licenses/BSD-3-Clause
+ *
+ * SPDX-FileCopyrightText: 2022 Deutsche Telekom AG
+ * SPDX-FileContributor: Sartura Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#ifndef INTERFACES_PLUGIN_API_INTERFACES_LOOKUP_H
+#define INTERFACES_PLUGIN_API_INTERFACES_LOOKUP_H
+
+#include "plugin/context.h"
+
+#include <libyang/libyang.h>
+#include <netlink/route/link.h>
+
+const char* interfaces_change_get_list_key(const struct lyd_node* node, const char* list_name, const char* key_name);
+struct rtnl_link* interfaces_change_get_interface_link(interfaces_mod_changes_ctx_t* mod_ctx, const struct lyd_node* node);
+void interfaces_change_interface_links_free(interfaces_mod_changes_ctx_t* mod_ctx);
+
+#endif // INTERFACES_PLUGIN_API_INTERFACES_LOOKUP_H
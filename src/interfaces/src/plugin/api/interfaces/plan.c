@@ -0,0 +1,633 @@
+/*
+ * telekom / sysrepo-plugin-system
+ *
+ * This program is made available under the terms of the
+ * BSD 3-Clause license which is available at
+ * https://opensource.org/licenses/BSD-3-Clause
+ *
+ * SPDX-FileCopyrightText: 2022 Deutsche Telekom AG
+ * SPDX-FileContributor: Sartura Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include "plan.h"
+#include "plugin/common.h"
+
+#include "utils/netlink_batch.h"
+
+#include <linux/if.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sysrepo.h>
+
+#include <netlink/errno.h>
+#include <netlink/msg.h>
+#include <netlink/netlink.h>
+#include <netlink/route/addr.h>
+#include <netlink/route/neighbour.h>
+
+// link presence of one interface while a plan is checked
+typedef struct interfaces_change_plan_check_link_s {
+    const char* name; // key - owned by the operations
+    uint8_t exists;
+    UT_hash_handle hh;
+} interfaces_change_plan_check_link_t;
+
+static int interfaces_change_plan_send_all(interfaces_change_plan_t* plan, interfaces_nl_ctx_t* nl_ctx, uint8_t capture_undo);
+static int interfaces_change_plan_build_request(interfaces_change_operation_t* operation, interfaces_nl_ctx_t* nl_ctx, uint8_t capture_undo, struct nl_msg** msg);
+static int interfaces_change_plan_capture_undo(interfaces_change_operation_t* operation, struct rtnl_link* current_link);
+static void interfaces_change_plan_clear_undo(interfaces_change_operation_t* operation);
+static int interfaces_change_plan_index_link(interfaces_change_plan_t* plan, size_t index);
+static void interfaces_change_plan_sync_links(interfaces_nl_ctx_t* nl_ctx);
+
+void interfaces_change_plan_init(interfaces_change_plan_t* plan)
+{
+    *plan = (interfaces_change_plan_t) { 0 };
+}
+
+int interfaces_change_plan_add(interfaces_change_plan_t* plan, enum interfaces_change_operation_type type, const char* interface_name, struct nl_object* object, int flags)
+{
+    interfaces_change_operation_t* operations = NULL;
+    interfaces_change_operation_t* operation = NULL;
+    struct rtnl_link* undo_link = NULL;
+
+    if (plan->count == plan->size) {
+        const size_t size = plan->size ? plan->size * 2 : 64;
+
+        operations = realloc(plan->operations, sizeof(*operations) * size);
+        if (!operations) {
+            return -1;
+        }
+
+        plan->operations = operations;
+        plan->size = size;
+    }
+
+    operation = &plan->operations[plan->count];
+    *operation = (interfaces_change_operation_t) {
+        .type = type,
+        .interface_name = strdup(interface_name),
+        .object = object,
+        .flags = flags,
+    };
+
+    if (!operation->interface_name) {
+        return -1;
+    }
+
+    // the plan holds its own reference until it is freed
+    nl_object_get(object);
+    plan->count++;
+
+    if (type == interfaces_change_operation_link_add || type == interfaces_change_operation_link_delete || type == interfaces_change_operation_link_change) {
+        if (interfaces_change_plan_index_link(plan, plan->count - 1)) {
+            return -1;
+        }
+    }
+
+    // inverse requests known up front - link deletes and changes are captured from the kernel state when sent
+    switch (type) {
+    case interfaces_change_operation_link_add:
+        undo_link = rtnl_link_alloc();
+        if (!undo_link) {
+            return -1;
+        }
+        rtnl_link_set_name(undo_link, interface_name);
+
+        operation->undo.type = interfaces_change_operation_link_delete;
+        operation->undo.object = (struct nl_object*)undo_link;
+        operation->undo.set = 1;
+        break;
+    case interfaces_change_operation_address_add:
+        return interfaces_change_plan_set_undo(plan, interfaces_change_operation_address_delete, object, 0);
+    case interfaces_change_operation_address_delete:
+        return interfaces_change_plan_set_undo(plan, interfaces_change_operation_address_add, object, 0);
+    case interfaces_change_operation_neighbor_add:
+        // a replaced neighbor is restored from its previous LL address - known only to the caller
+        if (!(flags & NLM_F_REPLACE)) {
+            return interfaces_change_plan_set_undo(plan, interfaces_change_operation_neighbor_delete, object, 0);
+        }
+        break;
+    case interfaces_change_operation_neighbor_delete:
+        // re-adding a neighbor needs its LL address - known only to the caller
+    case interfaces_change_operation_link_delete:
+    case interfaces_change_operation_link_change:
+        break;
+    }
+
+    return 0;
+}
+
+int interfaces_change_plan_set_undo(interfaces_change_plan_t* plan, enum interfaces_change_operation_type type, struct nl_object* object, int flags)
+{
+    interfaces_change_operation_t* operation = NULL;
+
+    if (!plan->count) {
+        return -1;
+    }
+
+    // undo of the last added operation
+    operation = &plan->operations[plan->count - 1];
+
+    nl_object_get(object);
+    interfaces_change_plan_clear_undo(operation);
+
+    operation->undo.type = type;
+    operation->undo.object = object;
+    operation->undo.flags = flags;
+    operation->undo.set = 1;
+
+    return 0;
+}
+
+struct rtnl_link* interfaces_change_plan_get_link(const interfaces_change_plan_t* plan, struct nl_cache* link_cache, const char* interface_name)
+{
+    struct rtnl_link* link = NULL;
+    interfaces_change_plan_link_t* plan_link = NULL;
+
+    // links added or deleted earlier in the commit aren't in the kernel yet
+    HASH_FIND_STR(plan->links, interface_name, plan_link);
+    if (plan_link && plan_link->link_index != SIZE_MAX) {
+        const interfaces_change_operation_t* operation = &plan->operations[plan_link->link_index];
+
+        return operation->type == interfaces_change_operation_link_add ? (struct rtnl_link*)operation->object : NULL;
+    }
+
+    // the cache keeps its own reference - the link stays valid until the cache changes
+    link = rtnl_link_get_by_name(link_cache, interface_name);
+    if (link) {
+        rtnl_link_put(link);
+    }
+
+    return link;
+}
+
+struct rtnl_link* interfaces_change_plan_get_link_request(interfaces_change_plan_t* plan, const char* interface_name)
+{
+    struct rtnl_link* request_link = NULL;
+    interfaces_change_plan_link_t* plan_link = NULL;
+
+    // all link attribute edits of the commit go into one request - unless the link is added or deleted in between
+    HASH_FIND_STR(plan->links, interface_name, plan_link);
+    if (plan_link && plan_link->change_index != SIZE_MAX && (plan_link->link_index == SIZE_MAX || plan_link->change_index > plan_link->link_index)) {
+        return (struct rtnl_link*)plan->operations[plan_link->change_index].object;
+    }
+
+    request_link = rtnl_link_alloc();
+    if (!request_link) {
+        return NULL;
+    }
+
+    // the type is left out - drivers refuse a link kind in change requests, see interfaces_interface_change_type()
+    rtnl_link_set_name(request_link, interface_name);
+
+    if (interfaces_change_plan_add(plan, interfaces_change_operation_link_change, interface_name, (struct nl_object*)request_link, 0)) {
+        rtnl_link_put(request_link);
+        return NULL;
+    }
+
+    // the plan keeps the request alive until it is freed
+    rtnl_link_put(request_link);
+
+    return request_link;
+}
+
+int interfaces_change_plan_check(const interfaces_change_plan_t* plan, struct nl_cache* link_cache)
+{
+    int error = 0;
+    struct rtnl_link* link = NULL;
+    interfaces_change_plan_check_link_t* links = NULL;
+    interfaces_change_plan_check_link_t* check_link = NULL;
+    interfaces_change_plan_check_link_t* tmp = NULL;
+
+    // walk the plan in order against the current links - a request for a missing link fails the change before anything is sent
+    for (size_t i = 0; i < plan->count; i++) {
+        const interfaces_change_operation_t* operation = &plan->operations[i];
+
+        HASH_FIND_STR(links, operation->interface_name, check_link);
+        if (!check_link) {
+            SRPC_SAFE_CALL_PTR(check_link, malloc(sizeof(*check_link)), error_out);
+
+            link = rtnl_link_get_by_name(link_cache, operation->interface_name);
+            *check_link = (interfaces_change_plan_check_link_t) {
+                .name = operation->interface_name,
+                .exists = link != NULL,
+            };
+            if (link) {
+                rtnl_link_put(link);
+            }
+
+            HASH_ADD_KEYPTR(hh, links, check_link->name, strlen(check_link->name), check_link);
+        }
+
+        if (operation->type == interfaces_change_operation_link_add ? check_link->exists : !check_link->exists) {
+            SRPLG_LOG_ERR(PLUGIN_NAME, "Unable to %s for interface %s - the link %s", interfaces_change_operation_type2str(operation->type), operation->interface_name, check_link->exists ? "already exists" : "doesn't exist");
+            goto error_out;
+        }
+
+        if (operation->type == interfaces_change_operation_link_add || operation->type == interfaces_change_operation_link_delete) {
+            check_link->exists = operation->type == interfaces_change_operation_link_add;
+        }
+    }
+
+    goto out;
+
+error_out:
+    error = -1;
+
+out:
+    HASH_ITER(hh, links, check_link, tmp)
+    {
+        HASH_DEL(links, check_link);
+        free(check_link);
+    }
+
+    return error;
+}
+
+int interfaces_change_plan_apply(interfaces_change_plan_t* plan, interfaces_nl_ctx_t* nl_ctx)
+{
+    return interfaces_change_plan_send_all(plan, nl_ctx, 1);
+}
+
+void interfaces_change_plan_rollback(interfaces_change_plan_t* plan, interfaces_nl_ctx_t* nl_ctx)
+{
+    interfaces_change_plan_t undo_plan = { 0 };
+    interfaces_change_operation_t* undo = NULL;
+    interfaces_change_operation_t** unconfirmed = NULL;
+
+    undo_plan.operations = calloc(plan->count ? plan->count : 1, sizeof(*undo_plan.operations));
+    unconfirmed = calloc(plan->count ? plan->count : 1, sizeof(*unconfirmed));
+    if (!undo_plan.operations || !unconfirmed) {
+        SRPLG_LOG_ERR(PLUGIN_NAME, "Unable to allocate rollback plan");
+        free(undo_plan.operations);
+        free(unconfirmed);
+        return;
+    }
+    undo_plan.size = plan->count;
+
+    // undo in reverse order - a link is restored before its addresses and neighbors
+    for (size_t i = plan->count; i-- > 0;) {
+        interfaces_change_operation_t* operation = &plan->operations[i];
+
+        // requests without a reply are undone as well - undoing a request the kernel never applied only fails
+        if (!operation->applied && !operation->unconfirmed) {
+            continue;
+        }
+
+        operation->applied = 0;
+
+        if (!operation->undo.set) {
+            SRPLG_LOG_ERR(PLUGIN_NAME, "Unable to undo %s for interface %s", interfaces_change_operation_type2str(operation->type), operation->interface_name);
+            continue;
+        }
+
+        undo = &undo_plan.operations[undo_plan.count];
+        *undo = (interfaces_change_operation_t) {
+            .type = operation->undo.type,
+            .interface_name = strdup(operation->interface_name),
+            .object = operation->undo.object,
+            .flags = operation->undo.flags,
+        };
+
+        if (!undo->interface_name) {
+            SRPLG_LOG_ERR(PLUGIN_NAME, "Unable to undo %s for interface %s", interfaces_change_operation_type2str(operation->type), operation->interface_name);
+            continue;
+        }
+
+        nl_object_get(undo->object);
+        unconfirmed[undo_plan.count] = operation->unconfirmed ? operation : NULL;
+        undo_plan.count++;
+    }
+
+    // failed undo requests are logged by the sender - nothing else can be done at this point
+    interfaces_change_plan_send_all(&undo_plan, nl_ctx, 0);
+
+    // the undo outcome tells whether an unanswered request had been applied
+    for (size_t i = 0; i < undo_plan.count; i++) {
+        interfaces_change_operation_t* operation = unconfirmed[i];
+
+        if (!operation) {
+            continue;
+        }
+
+        undo = &undo_plan.operations[i];
+
+        if (undo->unconfirmed) {
+            SRPLG_LOG_ERR(PLUGIN_NAME, "Unknown whether %s for interface %s was applied - the kernel may differ from the previous configuration", interfaces_change_operation_type2str(operation->type), operation->interface_name);
+        } else if (undo->applied) {
+            SRPLG_LOG_INF(PLUGIN_NAME, "Unanswered %s for interface %s undone", interfaces_change_operation_type2str(operation->type), operation->interface_name);
+            operation->unconfirmed = 0;
+        } else {
+            SRPLG_LOG_INF(PLUGIN_NAME, "Unanswered %s for interface %s was most likely never applied - its undo failed (%s)", interfaces_change_operation_type2str(operation->type), operation->interface_name, nl_geterror(undo->error));
+            operation->unconfirmed = 0;
+        }
+    }
+
+    free(unconfirmed);
+    interfaces_change_plan_free(&undo_plan);
+}
+
+const char* interfaces_change_operation_type2str(enum interfaces_change_operation_type type)
+{
+    switch (type) {
+    case interfaces_change_operation_link_add:
+        return "add link";
+    case interfaces_change_operation_link_delete:
+        return "delete link";
+    case interfaces_change_operation_link_change:
+        return "change link";
+    case interfaces_change_operation_address_add:
+        return "add address";
+    case interfaces_change_operation_address_delete:
+        return "delete address";
+    case interfaces_change_operation_neighbor_add:
+        return "add neighbor";
+    case interfaces_change_operation_neighbor_delete:
+        return "delete neighbor";
+    }
+
+    return "unknown";
+}
+
+void interfaces_change_plan_free(interfaces_change_plan_t* plan)
+{
+    interfaces_change_plan_link_t* plan_link = NULL;
+    interfaces_change_plan_link_t* tmp = NULL;
+
+    // names are owned by the operations - drop the index first
+    HASH_ITER(hh, plan->links, plan_link, tmp)
+    {
+        HASH_DEL(plan->links, plan_link);
+        free(plan_link);
+    }
+
+    for (size_t i = 0; i < plan->count; i++) {
+        interfaces_change_operation_t* operation = &plan->operations[i];
+
+        interfaces_change_plan_clear_undo(operation);
+        nl_object_put(operation->object);
+        free(operation->interface_name);
+    }
+
+    free(plan->operations);
+
+    *plan = (interfaces_change_plan_t) { 0 };
+}
+
+static int interfaces_change_plan_send_all(interfaces_change_plan_t* plan, interfaces_nl_ctx_t* nl_ctx, uint8_t capture_undo)
+{
+    int error = 0;
+    struct nl_sock* socket = NULL;
+    struct nl_msg* msg = NULL;
+    struct netlink_batch batch = { 0 };
+
+    if (!plan->count) {
+        return 0;
+    }
+
+    // own socket - the shared one checks every ACK against the single request libnl expects
+    SRPC_SAFE_CALL_PTR(socket, nl_socket_alloc(), error_out);
+    SRPC_SAFE_CALL_ERR(error, nl_connect(socket, NETLINK_ROUTE), error_out);
+
+    netlink_batch_init(&batch, socket, INTERFACES_CHANGE_PLAN_WINDOW);
+
+    for (size_t i = 0; i < plan->count; i++) {
+        interfaces_change_operation_t* operation = &plan->operations[i];
+
+        error = interfaces_change_plan_build_request(operation, nl_ctx, capture_undo, &msg);
+        if (error) {
+            SRPLG_LOG_ERR(PLUGIN_NAME, "Unable to build %s request for interface %s (%s)", interfaces_change_operation_type2str(operation->type), operation->interface_name, nl_geterror(error));
+            operation->error = error;
+            break;
+        }
+
+        error = netlink_batch_add(&batch, msg);
+        nlmsg_free(msg);
+        msg = NULL;
+
+        if (error) {
+            SRPLG_LOG_ERR(PLUGIN_NAME, "Unable to send interface change requests (%s)", nl_geterror(error));
+            break;
+        }
+
+        // following requests look up the links this one creates or removes
+        if (operation->type == interfaces_change_operation_link_add || operation->type == interfaces_change_operation_link_delete) {
+            error = netlink_batch_flush(&batch);
+            if (error) {
+                SRPLG_LOG_ERR(PLUGIN_NAME, "Unable to send interface change requests (%s)", nl_geterror(error));
+                break;
+            }
+
+            interfaces_change_plan_sync_links(nl_ctx);
+        }
+    }
+
+    // requests packed before an error are still sent - a rollback needs to know which of them were applied or left unanswered
+    if (netlink_batch_flush(&batch)) {
+        SRPLG_LOG_ERR(PLUGIN_NAME, "Unable to send interface change requests");
+        error = -1;
+    }
+
+    // the batch keeps the requests in plan order
+    for (size_t i = 0; i < batch.count; i++) {
+        interfaces_change_operation_t* operation = &plan->operations[i];
+
+        operation->error = batch.acks[i].error;
+        operation->applied = batch.acks[i].done && !batch.acks[i].error;
+        operation->unconfirmed = batch.acks[i].lost;
+
+        if (operation->unconfirmed) {
+            SRPLG_LOG_ERR(PLUGIN_NAME, "No reply to %s for interface %s (%s) - the kernel may have applied it", interfaces_change_operation_type2str(operation->type), operation->interface_name, nl_geterror(operation->error));
+            error = -1;
+        } else if (operation->error) {
+            SRPLG_LOG_ERR(PLUGIN_NAME, "Unable to %s for interface %s (%s)", interfaces_change_operation_type2str(operation->type), operation->interface_name, nl_geterror(operation->error));
+            error = -1;
+        }
+    }
+
+    if (error) {
+        goto error_out;
+    }
+
+    goto out;
+
+error_out:
+    error = -1;
+
+out:
+    netlink_batch_free(&batch);
+
+    if (socket) {
+        nl_socket_free(socket);
+    }
+
+    return error;
+}
+
+static int interfaces_change_plan_build_request(interfaces_change_operation_t* operation, interfaces_nl_ctx_t* nl_ctx, uint8_t capture_undo, struct nl_msg** msg)
+{
+    int error = 0;
+    struct rtnl_link* current_link = NULL;
+
+    // every request except a new link refers to an existing link - resolved by name as ifindexes change with re-created links
+    if (operation->type != interfaces_change_operation_link_add) {
+        current_link = rtnl_link_get_by_name(nl_ctx->link_cache, operation->interface_name);
+        if (!current_link) {
+            return -NLE_OBJ_NOTFOUND;
+        }
+    }
+
+    if (capture_undo) {
+        error = interfaces_change_plan_capture_undo(operation, current_link);
+        if (error) {
+            goto out;
+        }
+    }
+
+    switch (operation->type) {
+    case interfaces_change_operation_link_add:
+        error = rtnl_link_build_add_request((struct rtnl_link*)operation->object, operation->flags, msg);
+        break;
+    case interfaces_change_operation_link_delete:
+        error = rtnl_link_build_delete_request((struct rtnl_link*)operation->object, msg);
+        break;
+    case interfaces_change_operation_link_change:
+        error = rtnl_link_build_change_request(current_link, (struct rtnl_link*)operation->object, operation->flags, msg);
+        break;
+    case interfaces_change_operation_address_add:
+        rtnl_addr_set_ifindex((struct rtnl_addr*)operation->object, rtnl_link_get_ifindex(current_link));
+        error = rtnl_addr_build_add_request((struct rtnl_addr*)operation->object, operation->flags, msg);
+        break;
+    case interfaces_change_operation_address_delete:
+        rtnl_addr_set_ifindex((struct rtnl_addr*)operation->object, rtnl_link_get_ifindex(current_link));
+        error = rtnl_addr_build_delete_request((struct rtnl_addr*)operation->object, operation->flags, msg);
+        break;
+    case interfaces_change_operation_neighbor_add:
+        rtnl_neigh_set_ifindex((struct rtnl_neigh*)operation->object, rtnl_link_get_ifindex(current_link));
+        error = rtnl_neigh_build_add_request((struct rtnl_neigh*)operation->object, operation->flags, msg);
+        break;
+    case interfaces_change_operation_neighbor_delete:
+        rtnl_neigh_set_ifindex((struct rtnl_neigh*)operation->object, rtnl_link_get_ifindex(current_link));
+        error = rtnl_neigh_build_delete_request((struct rtnl_neigh*)operation->object, operation->flags, msg);
+        break;
+    }
+
+out:
+    if (current_link) {
+        rtnl_link_put(current_link);
+    }
+
+    return error;
+}
+
+static int interfaces_change_plan_capture_undo(interfaces_change_operation_t* operation, struct rtnl_link* current_link)
+{
+    struct rtnl_link* request_link = (struct rtnl_link*)operation->object;
+    struct rtnl_link* undo_link = NULL;
+
+    if (operation->type != interfaces_change_operation_link_delete && operation->type != interfaces_change_operation_link_change) {
+        return 0;
+    }
+
+    undo_link = rtnl_link_alloc();
+    if (!undo_link) {
+        return -NLE_NOMEM;
+    }
+
+    rtnl_link_set_name(undo_link, operation->interface_name);
+
+    if (operation->type == interfaces_change_operation_link_delete) {
+        // only software links can be created again - addresses and neighbors of the link are lost
+        if (!rtnl_link_get_type(current_link)) {
+            rtnl_link_put(undo_link);
+            return 0;
+        }
+
+        rtnl_link_set_type(undo_link, rtnl_link_get_type(current_link));
+
+        operation->undo.type = interfaces_change_operation_link_add;
+        operation->undo.flags = NLM_F_CREATE;
+    } else {
+        // restore only the attributes the request changes - the kernel refuses a link kind in change requests
+        if (rtnl_link_get_type(request_link)) {
+            SRPLG_LOG_INF(PLUGIN_NAME, "Type change of interface %s can't be undone - a rollback restores only its other attributes", operation->interface_name);
+        }
+
+        if (rtnl_link_get_mtu(request_link)) {
+            rtnl_link_set_mtu(undo_link, rtnl_link_get_mtu(current_link));
+        }
+
+        if (rtnl_link_get_ifalias(request_link)) {
+            rtnl_link_set_ifalias(undo_link, rtnl_link_get_ifalias(current_link) ? rtnl_link_get_ifalias(current_link) : "");
+        }
+
+        if (rtnl_link_get_flags(request_link) || rtnl_link_get_operstate(request_link) != IF_OPER_UNKNOWN) {
+            if (rtnl_link_get_flags(current_link) & IFF_UP) {
+                rtnl_link_set_flags(undo_link, IFF_UP);
+            } else {
+                rtnl_link_unset_flags(undo_link, IFF_UP);
+            }
+            rtnl_link_set_operstate(undo_link, rtnl_link_get_operstate(current_link));
+        }
+
+        operation->undo.type = interfaces_change_operation_link_change;
+        operation->undo.flags = operation->flags;
+    }
+
+    interfaces_change_plan_clear_undo(operation);
+    operation->undo.object = (struct nl_object*)undo_link;
+    operation->undo.set = 1;
+
+    return 0;
+}
+
+static int interfaces_change_plan_index_link(interfaces_change_plan_t* plan, size_t index)
+{
+    const interfaces_change_operation_t* operation = &plan->operations[index];
+    interfaces_change_plan_link_t* plan_link = NULL;
+
+    HASH_FIND_STR(plan->links, operation->interface_name, plan_link);
+    if (!plan_link) {
+        plan_link = malloc(sizeof(*plan_link));
+        if (!plan_link) {
+            return -1;
+        }
+
+        *plan_link = (interfaces_change_plan_link_t) {
+            .name = operation->interface_name,
+            .link_index = SIZE_MAX,
+            .change_index = SIZE_MAX,
+        };
+
+        HASH_ADD_KEYPTR(hh, plan->links, plan_link->name, strlen(plan_link->name), plan_link);
+    }
+
+    if (operation->type == interfaces_change_operation_link_change) {
+        plan_link->change_index = index;
+    } else {
+        plan_link->link_index = index;
+    }
+
+    return 0;
+}
+
+static void interfaces_change_plan_clear_undo(interfaces_change_operation_t* operation)
+{
+    if (operation->undo.object) {
+        nl_object_put(operation->undo.object);
+    }
+
+    operation->undo.object = NULL;
+    operation->undo.set = 0;
+}
+
+static void interfaces_change_plan_sync_links(interfaces_nl_ctx_t* nl_ctx)
+{
+    // the ACK of a link request arrives after its notification - pending notifications already contain the change
+    if (nl_cache_mngr_data_ready(nl_ctx->link_cache_manager) < 0) {
+        SRPLG_LOG_INF(PLUGIN_NAME, "Lost link cache notifications - dumping links again");
+
+        nl_cache_refill(nl_ctx->socket, nl_ctx->link_cache);
+    }
+}
@@ -0,0 +1,37 @@
+/*
+ * telekom / sysrepo-plugin-system
+ *
+ * This program is made available under the terms of the
+ * BSD 3-Clause license which is available at
+ * https://opensource.org/licenses/BSD-3-Clause
+ *
+ * SPDX-FileCopyrightText: 2022 Deutsche Telekom AG
+ * SPDX-FileContributor: Sartura Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#ifndef INTERFACES_PLUGIN_API_INTERFACES_PLAN_H
+#define INTERFACES_PLUGIN_API_INTERFACES_PLAN_H
+
+#include "plugin/context.h"
+#include "plugin/types.h"
+
+#include <netlink/cache.h>
+#include <netlink/object.h>
+#include <netlink/route/link.h>
+
+// requests waiting for their ACKs at a time - a commit rarely has more, larger plans are sent in several windows
+#define INTERFACES_CHANGE_PLAN_WINDOW 256
+
+void interfaces_change_plan_init(interfaces_change_plan_t* plan);
+int interfaces_change_plan_add(interfaces_change_plan_t* plan, enum interfaces_change_operation_type type, const char* interface_name, struct nl_object* object, int flags);
+int interfaces_change_plan_set_undo(interfaces_change_plan_t* plan, enum interfaces_change_operation_type type, struct nl_object* object, int flags);
+struct rtnl_link* interfaces_change_plan_get_link(const interfaces_change_plan_t* plan, struct nl_cache* link_cache, const char* interface_name);
+struct rtnl_link* interfaces_change_plan_get_link_request(interfaces_change_plan_t* plan, const char* interface_name);
+int interfaces_change_plan_check(const interfaces_change_plan_t* plan, struct nl_cache* link_cache);
+int interfaces_change_plan_apply(interfaces_change_plan_t* plan, interfaces_nl_ctx_t* nl_ctx);
+void interfaces_change_plan_rollback(interfaces_change_plan_t* plan, interfaces_nl_ctx_t* nl_ctx);
+const char* interfaces_change_operation_type2str(enum interfaces_change_operation_type type);
+void interfaces_change_plan_free(interfaces_change_plan_t* plan);
+
+#endif // INTERFACES_PLUGIN_API_INTERFACES_PLAN_H
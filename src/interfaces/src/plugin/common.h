@@ -171,4 +171,14 @@ extern const char* const PLUGIN_NAME;
 
 #define ADDR_STR_BUF_SIZE 45 // max ip string length (15 for ipv4 and 45 for ipv6)
 
+// set to "1" to serve all operational data from the interface list callback
+#define INTERFACES_OPER_BULK_ENV "INTERFACES_PLUGIN_OPER_BULK"
+
+// max age in seconds of the notification driven operational caches before they are dumped again
+#define INTERFACES_OPER_CACHE_MAX_AGE_ENV "INTERFACES_PLUGIN_OPER_CACHE_MAX_AGE"
+#define INTERFACES_OPER_CACHE_MAX_AGE_DEFAULT 60
+
+// seconds without callbacks after which an operational request is done and its lookups are released
+#define INTERFACES_OPER_REQUEST_IDLE_TIMEOUT 30
+
 #endif // INTERFACES_PLUGIN_COMMON_H
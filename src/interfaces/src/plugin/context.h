@@ -17,6 +17,7 @@
 #include "plugin/types.h"
 #include <pthread.h>
 #include <sysrepo_types.h>
+#include <time.h>
 
 #include <netlink/route/link.h>
 
@@ -27,7 +28,9 @@ typedef struct interfaces_nl_ctx_s interfaces_nl_ctx_t;
 typedef struct interfaces_ctx_s interfaces_ctx_t;
 typedef struct interfaces_state_changes_ctx_s interfaces_state_changes_ctx_t;
 typedef struct interfaces_mod_changes_ctx_s interfaces_mod_changes_ctx_t;
+typedef struct interfaces_change_dispatch_ctx_s interfaces_change_dispatch_ctx_t;
 typedef struct interfaces_oper_ctx_s interfaces_oper_ctx_t;
+typedef struct interfaces_oper_request_ctx_s interfaces_oper_request_ctx_t;
 typedef struct interfaces_startup_ctx_s interfaces_startup_ctx_t;
 typedef struct interfaces_features_ctx_s interfaces_features_ctx_t;
 
@@ -43,12 +46,35 @@ struct interfaces_nl_ctx_s {
     struct nl_cache* addr_cache;
     struct nl_cache* neigh_cache;
     struct nl_cache_mngr* link_cache_manager;
+
+    // link lookup by name and ifindex - rebuilt when link_cache changes
+    interfaces_link_index_t link_index;
+
+    // addresses and neighbors grouped by (ifindex, family) - rebuilt when addr_cache/neigh_cache change
+    interfaces_object_index_t addr_index;
+    interfaces_object_index_t neigh_index;
+};
+
+// change handlers looked up by the schema node of a changed node
+struct interfaces_change_dispatch_ctx_s {
+    const struct ly_ctx* ly_ctx; ///< context the schema nodes were resolved in
+    const struct lysc_node** schema_nodes; ///< schema node of every change handler - NULL if missing from the context
+    size_t count;
 };
 
 struct interfaces_mod_changes_ctx_s {
     // libnl links data
     interfaces_nl_ctx_t nl_ctx;
 
+    // handler of every changed node - kept between commits
+    interfaces_change_dispatch_ctx_t dispatch;
+
+    // kernel requests of the current commit
+    interfaces_change_plan_t plan;
+
+    // links of the interfaces visited by the current change event
+    interfaces_change_interface_link_t* interface_links;
+
     // temporary module changing data
     struct {
         struct {
@@ -78,22 +104,53 @@ struct interfaces_state_changes_ctx_s {
     // libnl data
     interfaces_nl_ctx_t nl_ctx;
 
-    // cache manager refresh thread
+    // cache manager refresh thread - waits on the manager sockets, the operational subscription and the shutdown event
     pthread_t manager_thread;
+    uint8_t manager_thread_started;
+    int epoll_fd;
+    int shutdown_fd;
 
-    // main hash DS for storing state info
-    interfaces_interface_state_hash_element_t* state_hash;
+    // state info - written by the manager thread, read by the operational callbacks dispatched on it
+    interfaces_interface_state_table_t state_table;
+};
 
-    // mutex for accessing state hash data
-    pthread_mutex_t state_hash_mutex;
+// lookups shared by all operational callbacks of one sysrepo request - callbacks of concurrent requests can interleave
+struct interfaces_oper_request_ctx_s {
+    uint32_t request_id;
+    time_t last_used; ///< time of the last callback of this request
+
+    // last interface list instance and its link
+    const struct lyd_node* interface_node;
+    struct rtnl_link* link;
+
+    UT_hash_handle hh;
 };
 
 struct interfaces_oper_ctx_s {
-    // operational libnl context - refill cache of links
+    // operational libnl context - caches kept current by the cache manager
     interfaces_nl_ctx_t nl_ctx;
 
     // state changes monitoring
     interfaces_state_changes_ctx_t state_changes_ctx;
+
+    // fill all state data from the interface list callback in one pass over the caches
+    uint8_t bulk_mode;
+
+    // operational getters - processed by the state changes manager thread which also applies the cache notifications
+    sr_subscription_ctx_t* subscription;
+
+    // lookups of the requests in progress - hashed by request_id
+    interfaces_oper_request_ctx_t* requests;
+
+    // link, address and neighbor caches kept current by the nl_ctx cache manager
+    struct {
+        time_t last_sync; ///< time of the last full dump of the caches
+        time_t max_age; ///< dump again once the caches are older than this - 0 dumps on every request
+        uint8_t links_changed; ///< link cache changed since the link index was built
+        uint8_t addresses_changed; ///< address cache changed since the address index was built
+        uint8_t neighbors_changed; ///< neighbor cache changed since the neighbor index was built
+        uint64_t avoided_dumps; ///< cache dumps served from notifications instead of the kernel
+    } cache_sync;
 };
 
 struct interfaces_startup_ctx_s {
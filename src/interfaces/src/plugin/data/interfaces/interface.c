@@ -82,11 +82,11 @@ void interfaces_interface_hash_element_free(interfaces_interface_hash_element_t*
             INTERFACES_INTERFACE_LIST_FREE((*el)->interface.ipv6.address);
         }
 
-        if ((*el)->interface.ipv4.address) {
+        if ((*el)->interface.ipv4.neighbor) {
             INTERFACES_INTERFACE_LIST_FREE((*el)->interface.ipv4.neighbor);
         }
 
-        if ((*el)->interface.ipv6.address) {
+        if ((*el)->interface.ipv6.neighbor) {
             INTERFACES_INTERFACE_LIST_FREE((*el)->interface.ipv6.neighbor);
         }
 
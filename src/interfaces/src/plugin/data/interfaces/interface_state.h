@@ -1,37 +0,0 @@
-/*
- * telekom / sysrepo-plugin-system
- *
- * This program is made available under the terms of the
- * BSD 3-Clause license which is available at
- * https://opensource.org/licenses/BSD-3-Clause
- *
- * SPDX-FileCopyrightText: 2022 Deutsche Telekom AG
- * SPDX-FileContributor: Sartura Ltd.
- *
- * SPDX-License-Identifier: BSD-3-Clause
- */
-#ifndef INTERFACES_PLUGIN_DATA_INTERFACES_INTERFACE_STATE_H
-#define INTERFACES_PLUGIN_DATA_INTERFACES_INTERFACE_STATE_H
-
-#include "plugin/types.h"
-
-/*
-    Hash table operations
-*/
-
-interfaces_interface_state_hash_element_t* interfaces_interface_state_hash_new(void);
-int interfaces_interface_state_hash_add(interfaces_interface_state_hash_element_t** state_hash, interfaces_interface_state_hash_element_t* new_element);
-interfaces_interface_state_hash_element_t* interfaces_interface_state_hash_get(const interfaces_interface_state_hash_element_t* state_hash, const char* name);
-void interfaces_interface_state_hash_free(interfaces_interface_state_hash_element_t** state_hash);
-
-/*
-    Element operations
-*/
-
-interfaces_interface_state_hash_element_t* interfaces_interface_state_hash_element_new(void);
-int interfaces_interface_state_hash_element_set_name(interfaces_interface_state_hash_element_t** el, const char* name);
-void interfaces_interface_state_hash_element_set_state(interfaces_interface_state_hash_element_t** el, const uint8_t state);
-void interfaces_interface_state_hash_element_set_last_change(interfaces_interface_state_hash_element_t** el, const time_t last_change);
-void interfaces_interface_state_hash_element_free(interfaces_interface_state_hash_element_t** el);
-
-#endif // INTERFACES_PLUGIN_DATA_INTERFACES_INTERFACE_STATE_H
\ No newline at end of file
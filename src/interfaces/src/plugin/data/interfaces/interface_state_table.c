@@ -0,0 +1,92 @@
+/*
+ * telekom / sysrepo-plugin-system
+ *
+ * This program is made available under the terms of the
+ * BSD 3-Clause license which is available at
+ * https://opensource.org/licenses/BSD-3-Clause
+ *
+ * SPDX-FileCopyrightText: 2022 Deutsche Telekom AG
+ * SPDX-FileContributor: Sartura Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include "interface_state_table.h"
+#include "src/uthash.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+int interfaces_interface_state_table_get(interfaces_interface_state_table_t* table, const char* name, uint8_t* state, time_t* last_change)
+{
+    interfaces_interface_state_table_element_t* element = NULL;
+
+    HASH_FIND_STR(table->elements, name, element);
+    if (!element) {
+        return -1;
+    }
+
+    if (state) {
+        *state = element->state;
+    }
+
+    if (last_change) {
+        *last_change = element->last_change;
+    }
+
+    return 0;
+}
+
+int interfaces_interface_state_table_set(interfaces_interface_state_table_t* table, const char* name, const uint8_t state, const time_t last_change)
+{
+    interfaces_interface_state_table_element_t* element = NULL;
+
+    HASH_FIND_STR(table->elements, name, element);
+    if (!element) {
+        element = malloc(sizeof(interfaces_interface_state_table_element_t));
+        if (!element) {
+            return -1;
+        }
+
+        element->name = strdup(name);
+        if (!element->name) {
+            free(element);
+            return -1;
+        }
+
+        HASH_ADD_KEYPTR(hh, table->elements, element->name, strlen(element->name), element);
+    }
+
+    element->state = state;
+    element->last_change = last_change;
+
+    return 0;
+}
+
+int interfaces_interface_state_table_remove(interfaces_interface_state_table_t* table, const char* name)
+{
+    interfaces_interface_state_table_element_t* element = NULL;
+
+    // nothing to remove
+    HASH_FIND_STR(table->elements, name, element);
+    if (!element) {
+        return 0;
+    }
+
+    HASH_DEL(table->elements, element);
+    free(element->name);
+    free(element);
+
+    return 0;
+}
+
+void interfaces_interface_state_table_free(interfaces_interface_state_table_t* table)
+{
+    interfaces_interface_state_table_element_t *current = NULL, *tmp = NULL;
+
+    HASH_ITER(hh, table->elements, current, tmp)
+    {
+        HASH_DEL(table->elements, current);
+        free(current->name);
+        free(current);
+    }
+}
@@ -0,0 +1,25 @@
+/*
+ * telekom / sysrepo-plugin-system
+ *
+ * This program is made available under the terms of the
+ * BSD 3-Clause license which is available at
+ * https://opensource.org/licenses/BSD-3-Clause
+ *
+ * SPDX-FileCopyrightText: 2022 Deutsche Telekom AG
+ * SPDX-FileContributor: Sartura Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#ifndef INTERFACES_PLUGIN_DATA_INTERFACES_INTERFACE_STATE_TABLE_H
+#define INTERFACES_PLUGIN_DATA_INTERFACES_INTERFACE_STATE_TABLE_H
+
+#include "plugin/types.h"
+
+// the table is only used from the manager thread - the operational subscriptions are dispatched on it as well
+
+int interfaces_interface_state_table_get(interfaces_interface_state_table_t* table, const char* name, uint8_t* state, time_t* last_change);
+int interfaces_interface_state_table_set(interfaces_interface_state_table_t* table, const char* name, const uint8_t state, const time_t last_change);
+int interfaces_interface_state_table_remove(interfaces_interface_state_table_t* table, const char* name);
+void interfaces_interface_state_table_free(interfaces_interface_state_table_t* table);
+
+#endif // INTERFACES_PLUGIN_DATA_INTERFACES_INTERFACE_STATE_TABLE_H
@@ -0,0 +1,108 @@
+/*
+ * telekom / sysrepo-plugin-system
+ *
+ * This program is made available under the terms of the
+ * BSD 3-Clause license which is available at
+ * https://opensource.org/licenses/BSD-3-Clause
+ *
+ * SPDX-FileCopyrightText: 2022 Deutsche Telekom AG
+ * SPDX-FileContributor: Sartura Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include "link_index.h"
+#include "src/uthash.h"
+
+#include <netlink/object.h>
+#include <stdlib.h>
+#include <string.h>
+
+int interfaces_link_index_build(interfaces_link_index_t* index, struct nl_cache* link_cache)
+{
+    struct rtnl_link* link_iter = NULL;
+
+    // drop links from the previous cache contents
+    interfaces_link_index_free(index);
+
+    link_iter = (struct rtnl_link*)nl_cache_get_first(link_cache);
+
+    while (link_iter) {
+        if (interfaces_link_index_add(index, link_iter)) {
+            interfaces_link_index_free(index);
+            return -1;
+        }
+
+        link_iter = (struct rtnl_link*)nl_cache_get_next((struct nl_object*)link_iter);
+    }
+
+    return 0;
+}
+
+int interfaces_link_index_add(interfaces_link_index_t* index, struct rtnl_link* link)
+{
+    interfaces_link_index_element_t* new_element = NULL;
+    const char* name = rtnl_link_get_name(link);
+    const int ifindex = rtnl_link_get_ifindex(link);
+
+    // names and indexes are unique - keep the first link seen
+    if (!name || interfaces_link_index_get_by_name(index, name) || interfaces_link_index_get_by_ifindex(index, ifindex)) {
+        return 0;
+    }
+
+    new_element = malloc(sizeof(interfaces_link_index_element_t));
+    if (!new_element) {
+        return -1;
+    }
+
+    // the index holds a reference so the name stays valid after a cache refill
+    nl_object_get((struct nl_object*)link);
+
+    *new_element = (interfaces_link_index_element_t) {
+        .ifindex = ifindex,
+        .name = name,
+        .link = link,
+    };
+
+    HASH_ADD_KEYPTR(name_hh, index->by_name, new_element->name, strlen(new_element->name), new_element);
+    HASH_ADD(ifindex_hh, index->by_ifindex, ifindex, sizeof(int), new_element);
+
+    return 0;
+}
+
+struct rtnl_link* interfaces_link_index_get_by_name(const interfaces_link_index_t* index, const char* name)
+{
+    interfaces_link_index_element_t* element = NULL;
+
+    HASH_FIND(name_hh, index->by_name, name, strlen(name), element);
+
+    return element ? element->link : NULL;
+}
+
+struct rtnl_link* interfaces_link_index_get_by_ifindex(const interfaces_link_index_t* index, int ifindex)
+{
+    interfaces_link_index_element_t* element = NULL;
+
+    HASH_FIND(ifindex_hh, index->by_ifindex, &ifindex, sizeof(int), element);
+
+    return element ? element->link : NULL;
+}
+
+unsigned int interfaces_link_index_count(const interfaces_link_index_t* index)
+{
+    return HASH_CNT(name_hh, index->by_name);
+}
+
+void interfaces_link_index_free(interfaces_link_index_t* index)
+{
+    interfaces_link_index_element_t *current = NULL, *tmp = NULL;
+
+    HASH_CLEAR(ifindex_hh, index->by_ifindex);
+
+    HASH_ITER(name_hh, index->by_name, current, tmp)
+    {
+        HASH_DELETE(name_hh, index->by_name, current);
+
+        rtnl_link_put(current->link);
+        free(current);
+    }
+}
@@ -0,0 +1,32 @@
+/*
+ * telekom / sysrepo-plugin-system
+ *
+ * This program is made available under the terms of the
+ * BSD 3-Clause license which is available at
+ * https://opensource.org/licenses/BSD-3-Clause
+ *
+ * SPDX-FileCopyrightText: 2022 Deutsche Telekom AG
+ * SPDX-FileContributor: Sartura Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#ifndef INTERFACES_PLUGIN_DATA_INTERFACES_LINK_INDEX_H
+#define INTERFACES_PLUGIN_DATA_INTERFACES_LINK_INDEX_H
+
+#include "plugin/types.h"
+
+#include <netlink/cache.h>
+#include <netlink/route/link.h>
+
+/*
+    Index operations
+*/
+
+int interfaces_link_index_build(interfaces_link_index_t* index, struct nl_cache* link_cache);
+int interfaces_link_index_add(interfaces_link_index_t* index, struct rtnl_link* link);
+struct rtnl_link* interfaces_link_index_get_by_name(const interfaces_link_index_t* index, const char* name);
+struct rtnl_link* interfaces_link_index_get_by_ifindex(const interfaces_link_index_t* index, int ifindex);
+unsigned int interfaces_link_index_count(const interfaces_link_index_t* index);
+void interfaces_link_index_free(interfaces_link_index_t* index);
+
+#endif // INTERFACES_PLUGIN_DATA_INTERFACES_LINK_INDEX_H
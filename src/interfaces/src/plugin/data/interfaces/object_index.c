@@ -0,0 +1,157 @@
+/*
+ * telekom / sysrepo-plugin-system
+ *
+ * This program is made available under the terms of the
+ * BSD 3-Clause license which is available at
+ * https://opensource.org/licenses/BSD-3-Clause
+ *
+ * SPDX-FileCopyrightText: 2022 Deutsche Telekom AG
+ * SPDX-FileContributor: Sartura Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include "object_index.h"
+#include "src/uthash.h"
+
+#include <netlink/object.h>
+#include <netlink/route/addr.h>
+#include <netlink/route/neighbour.h>
+#include <stdlib.h>
+
+typedef void (*interfaces_object_index_key_cb)(struct nl_object* object, int* ifindex, int* family);
+
+static int interfaces_object_index_build(interfaces_object_index_t* index, struct nl_cache* cache, interfaces_object_index_key_cb get_key);
+static interfaces_object_index_bucket_t* interfaces_object_index_find(const interfaces_object_index_t* index, int ifindex, int family);
+static void interfaces_object_index_address_key(struct nl_object* object, int* ifindex, int* family);
+static void interfaces_object_index_neighbor_key(struct nl_object* object, int* ifindex, int* family);
+
+int interfaces_object_index_build_addresses(interfaces_object_index_t* index, struct nl_cache* addr_cache)
+{
+    return interfaces_object_index_build(index, addr_cache, interfaces_object_index_address_key);
+}
+
+int interfaces_object_index_build_neighbors(interfaces_object_index_t* index, struct nl_cache* neigh_cache)
+{
+    return interfaces_object_index_build(index, neigh_cache, interfaces_object_index_neighbor_key);
+}
+
+size_t interfaces_object_index_get(const interfaces_object_index_t* index, int ifindex, int family, struct nl_object* const** objects)
+{
+    const interfaces_object_index_bucket_t* bucket = interfaces_object_index_find(index, ifindex, family);
+
+    if (!bucket) {
+        *objects = NULL;
+        return 0;
+    }
+
+    *objects = &index->objects[bucket->offset];
+
+    return bucket->count;
+}
+
+void interfaces_object_index_free(interfaces_object_index_t* index)
+{
+    interfaces_object_index_bucket_t *current = NULL, *tmp = NULL;
+
+    for (size_t i = 0; i < index->objects_count; i++) {
+        nl_object_put(index->objects[i]);
+    }
+
+    HASH_ITER(hh, index->buckets, current, tmp)
+    {
+        HASH_DEL(index->buckets, current);
+        free(current);
+    }
+
+    free(index->objects);
+
+    *index = (interfaces_object_index_t) { 0 };
+}
+
+static int interfaces_object_index_build(interfaces_object_index_t* index, struct nl_cache* cache, interfaces_object_index_key_cb get_key)
+{
+    interfaces_object_index_bucket_t *bucket = NULL, *tmp = NULL;
+    struct nl_object* object_iter = NULL;
+    const int cache_count = nl_cache_nitems(cache);
+    size_t offset = 0;
+    int ifindex = 0;
+    int family = 0;
+
+    // drop objects of the previous cache generation
+    interfaces_object_index_free(index);
+
+    if (cache_count <= 0) {
+        return 0;
+    }
+
+    index->objects = malloc(sizeof(struct nl_object*) * (size_t)cache_count);
+    if (!index->objects) {
+        return -1;
+    }
+
+    // count objects of every bucket
+    for (object_iter = nl_cache_get_first(cache); object_iter; object_iter = nl_cache_get_next(object_iter)) {
+        get_key(object_iter, &ifindex, &family);
+
+        bucket = interfaces_object_index_find(index, ifindex, family);
+        if (!bucket) {
+            bucket = calloc(1, sizeof(interfaces_object_index_bucket_t));
+            if (!bucket) {
+                interfaces_object_index_free(index);
+                return -1;
+            }
+
+            bucket->key.ifindex = ifindex;
+            bucket->key.family = family;
+            HASH_ADD(hh, index->buckets, key, sizeof(bucket->key), bucket);
+        }
+
+        bucket->count++;
+    }
+
+    // reserve a contiguous run for every bucket
+    HASH_ITER(hh, index->buckets, bucket, tmp)
+    {
+        bucket->offset = offset;
+        offset += bucket->count;
+        bucket->count = 0;
+    }
+
+    // place objects in cache order - the index holds a reference on each of them
+    for (object_iter = nl_cache_get_first(cache); object_iter; object_iter = nl_cache_get_next(object_iter)) {
+        get_key(object_iter, &ifindex, &family);
+
+        bucket = interfaces_object_index_find(index, ifindex, family);
+
+        nl_object_get(object_iter);
+        index->objects[bucket->offset + bucket->count++] = object_iter;
+        index->objects_count++;
+    }
+
+    return 0;
+}
+
+static interfaces_object_index_bucket_t* interfaces_object_index_find(const interfaces_object_index_t* index, int ifindex, int family)
+{
+    interfaces_object_index_bucket_t* bucket = NULL;
+    const struct {
+        int ifindex;
+        int family;
+    } key = { ifindex, family };
+
+    HASH_FIND(hh, index->buckets, &key, sizeof(key), bucket);
+
+    return bucket;
+}
+
+static void interfaces_object_index_address_key(struct nl_object* object, int* ifindex, int* family)
+{
+    *ifindex = rtnl_addr_get_ifindex((struct rtnl_addr*)object);
+    *family = rtnl_addr_get_family((struct rtnl_addr*)object);
+}
+
+static void interfaces_object_index_neighbor_key(struct nl_object* object, int* ifindex, int* family)
+{
+    *ifindex = rtnl_neigh_get_ifindex((struct rtnl_neigh*)object);
+    *family = rtnl_neigh_get_family((struct rtnl_neigh*)object);
+}
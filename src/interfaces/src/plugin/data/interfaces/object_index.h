@@ -0,0 +1,29 @@
+/*
+ * telekom / sysrepo-plugin-system
+ *
+ * This program is made available under the terms of the
+ * BSD 3-Clause license which is available at
+ * https://opensource.org/licenses/BSD-3-Clause
+ *
+ * SPDX-FileCopyrightText: 2022 Deutsche Telekom AG
+ * SPDX-FileContributor: Sartura Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#ifndef INTERFACES_PLUGIN_DATA_INTERFACES_OBJECT_INDEX_H
+#define INTERFACES_PLUGIN_DATA_INTERFACES_OBJECT_INDEX_H
+
+#include "plugin/types.h"
+
+#include <netlink/cache.h>
+
+/*
+    Index operations
+*/
+
+int interfaces_object_index_build_addresses(interfaces_object_index_t* index, struct nl_cache* addr_cache);
+int interfaces_object_index_build_neighbors(interfaces_object_index_t* index, struct nl_cache* neigh_cache);
+size_t interfaces_object_index_get(const interfaces_object_index_t* index, int ifindex, int family, struct nl_object* const** objects);
+void interfaces_object_index_free(interfaces_object_index_t* index);
+
+#endif // INTERFACES_PLUGIN_DATA_INTERFACES_OBJECT_INDEX_H
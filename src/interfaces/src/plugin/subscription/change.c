@@ -17,10 +17,14 @@
 #include <libyang/libyang.h>
 #include <linux/limits.h>
 #include <srpc.h>
+#include <stdlib.h>
+#include <string.h>
 #include <sysrepo.h>
 
 // change API
 #include "plugin/api/interfaces/change.h"
+#include "plugin/api/interfaces/lookup.h"
+#include "plugin/api/interfaces/plan.h"
 #include "plugin/api/interfaces/interface/change.h"
 #include "plugin/api/interfaces/interface/ipv4/address/change.h"
 #include "plugin/api/interfaces/interface/ipv4/change.h"
@@ -28,87 +32,233 @@
 #include "plugin/api/interfaces/interface/ipv6/address/change.h"
 #include "plugin/api/interfaces/interface/ipv6/neighbor/change.h"
 
+// handler of one leaf, relative to the interface list
+typedef struct interfaces_change_handler_s {
+    const char* path;
+    srpc_change_cb cb;
+} interfaces_change_handler_t;
+
+// one visited change - node and values are owned by the change iterator
+typedef struct interfaces_change_node_s {
+    sr_change_oper_t operation;
+    const struct lyd_node* node;
+    const char* previous_value;
+    const char* previous_list;
+    int previous_default;
+} interfaces_change_node_t;
+
+// changes of one handler in change tree order
+typedef struct interfaces_change_bucket_s {
+    interfaces_change_node_t* changes;
+    size_t count;
+    size_t size;
+} interfaces_change_bucket_t;
+
+// handlers run in this order - every handler sees all of its changes before the next one starts
+// handlers only plan their netlink requests - see interfaces_change_plan_add()
+static const interfaces_change_handler_t interfaces_change_handlers[] = {
+    { "/name", interfaces_interface_change_name },
+    { "/description", interfaces_interface_change_description },
+    { "/type", interfaces_interface_change_type },
+    { "/enabled", interfaces_interface_change_enabled },
+    { "/link-up-down-trap-enable", interfaces_interface_change_link_up_down_trap_enable },
+    { "/ietf-ip:ipv4/mtu", interfaces_interface_ipv4_change_mtu },
+    { "/ietf-ip:ipv4/enabled", interfaces_interface_ipv4_change_enabled },
+    { "/ietf-ip:ipv4/address/ip", interfaces_interface_ipv4_address_change_ip },
+    { "/ietf-ip:ipv4/address/prefix-length", interfaces_interface_ipv4_address_change_prefix_length },
+    { "/ietf-ip:ipv4/address/netmask", interfaces_interface_ipv4_address_change_netmask },
+    { "/ietf-ip:ipv4/neighbor/ip", interfaces_interface_ipv4_neighbor_change_ip },
+    { "/ietf-ip:ipv4/neighbor/link-layer-address", interfaces_interface_ipv4_neighbor_change_link_layer_address },
+    { "/ietf-ip:ipv6/address/ip", interfaces_interface_ipv6_address_change_ip },
+    { "/ietf-ip:ipv6/address/prefix-length", interfaces_interface_ipv6_address_change_prefix_length },
+    { "/ietf-ip:ipv6/neighbor/ip", interfaces_interface_ipv6_neighbor_change_ip },
+    { "/ietf-ip:ipv6/neighbor/link-layer-address", interfaces_interface_ipv6_neighbor_change_link_layer_address },
+};
+
+static int interfaces_subscription_change_resolve_handlers(interfaces_change_dispatch_ctx_t* dispatch, const struct ly_ctx* ly_ctx, const char* xpath);
+static int interfaces_subscription_change_find_handler(const interfaces_change_dispatch_ctx_t* dispatch, const struct lysc_node* schema);
+static int interfaces_subscription_change_bucket_add(interfaces_change_bucket_t* bucket, const interfaces_change_node_t* change);
+
 int interfaces_subscription_change_interfaces_interface(sr_session_ctx_t* session, uint32_t subscription_id, const char* module_name, const char* xpath, sr_event_t event, uint32_t request_id, void* private_data)
 {
     int error = SR_ERR_OK;
     interfaces_ctx_t* ctx = (interfaces_ctx_t*)private_data;
+    interfaces_mod_changes_ctx_t* mod_ctx = &ctx->mod_ctx;
     char change_xpath_buffer[PATH_MAX] = { 0 };
     int rc = 0;
 
+    // change tree
+    sr_change_iter_t* changes_iterator = NULL;
+    interfaces_change_node_t change = { 0 };
+    interfaces_change_bucket_t buckets[ARRAY_SIZE(interfaces_change_handlers)] = { 0 };
+    int handler = -1;
+    size_t changes_count = 0;
+
     if (event == SR_EV_ABORT) {
-        SRPLG_LOG_ERR(PLUGIN_NAME, "Aborting changes for %s", xpath);
-        goto error_out;
+        // nothing reached the kernel yet - the plan is applied only once the commit is done
+        SRPLG_LOG_ERR(PLUGIN_NAME, "Aborting changes for %s - discarding %zu planned requests", xpath, mod_ctx->plan.count);
+        interfaces_change_plan_free(&mod_ctx->plan);
+    } else if (event == SR_EV_DONE) {
+        if (!mod_ctx->plan.count) {
+            goto out;
+        }
+
+        // sysrepo ignores errors of a finished commit - the running datastore keeps the new configuration either way.
+        // a failed plan is rolled back so the kernel at least stays at the previous configuration, which then differs
+        // from running until the next commit. only kernel refusals get this far - missing links fail on SR_EV_CHANGE.
+        if (interfaces_change_interface_sync(ctx) || interfaces_change_plan_apply(&mod_ctx->plan, &mod_ctx->nl_ctx)) {
+            SRPLG_LOG_ERR(PLUGIN_NAME, "Unable to apply changes for %s - rolling back applied requests, running datastore no longer matches the kernel", xpath);
+            interfaces_change_plan_rollback(&mod_ctx->plan, &mod_ctx->nl_ctx);
+            error = SR_ERR_CALLBACK_FAILED;
+        }
+
+        interfaces_change_plan_free(&mod_ctx->plan);
     } else if (event == SR_EV_CHANGE) {
-        // name
-        SRPC_SAFE_CALL_ERR_COND(rc, rc < 0, snprintf(change_xpath_buffer, sizeof(change_xpath_buffer), "%s/name", xpath), error_out);
-        SRPC_SAFE_CALL_ERR(rc, srpc_iterate_changes(ctx, session, change_xpath_buffer, interfaces_interface_change_name, interfaces_change_interface_init, interfaces_change_interface_free), error_out);
+        // a plan left by a commit which never finished
+        interfaces_change_plan_free(&mod_ctx->plan);
+
+        // walk the change tree once and group changed nodes by their handler
+        SRPC_SAFE_CALL_ERR_COND(rc, rc < 0, snprintf(change_xpath_buffer, sizeof(change_xpath_buffer), "%s//.", xpath), error_out);
+        SRPC_SAFE_CALL_ERR(rc, sr_get_changes_iter(session, change_xpath_buffer, &changes_iterator), error_out);
+
+        while (sr_get_change_tree_next(session, changes_iterator, &change.operation, &change.node, &change.previous_value, &change.previous_list, &change.previous_default) == SR_ERR_OK) {
+            // schema nodes are resolved again only if sysrepo switched the libyang context
+            if (mod_ctx->dispatch.ly_ctx != LYD_CTX(change.node)) {
+                SRPC_SAFE_CALL_ERR(rc, interfaces_subscription_change_resolve_handlers(&mod_ctx->dispatch, LYD_CTX(change.node), xpath), error_out);
+            }
+
+            handler = interfaces_subscription_change_find_handler(&mod_ctx->dispatch, change.node->schema);
+            if (handler < 0) {
+                continue;
+            }
 
-        // description
-        SRPC_SAFE_CALL_ERR_COND(rc, rc < 0, snprintf(change_xpath_buffer, sizeof(change_xpath_buffer), "%s/description", xpath), error_out);
-        SRPC_SAFE_CALL_ERR(rc, srpc_iterate_changes(ctx, session, change_xpath_buffer, interfaces_interface_change_description, interfaces_change_interface_init, interfaces_change_interface_free), error_out);
+            SRPC_SAFE_CALL_ERR(rc, interfaces_subscription_change_bucket_add(&buckets[handler], &change), error_out);
+            changes_count++;
+        }
 
-        // type
-        SRPC_SAFE_CALL_ERR_COND(rc, rc < 0, snprintf(change_xpath_buffer, sizeof(change_xpath_buffer), "%s/type", xpath), error_out);
-        SRPC_SAFE_CALL_ERR(rc, srpc_iterate_changes(ctx, session, change_xpath_buffer, interfaces_interface_change_type, interfaces_change_interface_init, interfaces_change_interface_free), error_out);
+        if (!changes_count) {
+            goto out;
+        }
 
-        // enabled
-        SRPC_SAFE_CALL_ERR_COND(rc, rc < 0, snprintf(change_xpath_buffer, sizeof(change_xpath_buffer), "%s/enabled", xpath), error_out);
-        SRPC_SAFE_CALL_ERR(rc, srpc_iterate_changes(ctx, session, change_xpath_buffer, interfaces_interface_change_enabled, interfaces_change_interface_init, interfaces_change_interface_free), error_out);
+        // catch up with kernel changes since the last commit - handlers validate against the caches
+        SRPC_SAFE_CALL_ERR(rc, interfaces_change_interface_sync(ctx), error_out);
 
-        // link-up-down-trap-enable
-        SRPC_SAFE_CALL_ERR_COND(rc, rc < 0, snprintf(change_xpath_buffer, sizeof(change_xpath_buffer), "%s/link-up-down-trap-enable", xpath), error_out);
-        SRPC_SAFE_CALL_ERR(rc, srpc_iterate_changes(ctx, session, change_xpath_buffer, interfaces_interface_change_link_up_down_trap_enable, interfaces_change_interface_init, interfaces_change_interface_free), error_out);
+        for (size_t i = 0; i < ARRAY_SIZE(interfaces_change_handlers); i++) {
+            for (size_t j = 0; j < buckets[i].count; j++) {
+                const interfaces_change_node_t* bucket_change = &buckets[i].changes[j];
+                const srpc_change_ctx_t change_ctx = {
+                    .operation = bucket_change->operation,
+                    .node = bucket_change->node,
+                    .previous_value = bucket_change->previous_value,
+                    .previous_list = bucket_change->previous_list,
+                    .previous_default = bucket_change->previous_default,
+                };
 
-        // ipv4/mtu
-        SRPC_SAFE_CALL_ERR_COND(rc, rc < 0, snprintf(change_xpath_buffer, sizeof(change_xpath_buffer), "%s/ipv4/mtu", xpath), error_out);
-        SRPC_SAFE_CALL_ERR(rc, srpc_iterate_changes(ctx, session, change_xpath_buffer, interfaces_interface_ipv4_change_mtu, interfaces_change_interface_init, interfaces_change_interface_free), error_out);
+                SRPC_SAFE_CALL_ERR(rc, interfaces_change_handlers[i].cb(ctx, session, &change_ctx), error_out);
+            }
+        }
 
-        // ipv4/enabled
-        SRPC_SAFE_CALL_ERR_COND(rc, rc < 0, snprintf(change_xpath_buffer, sizeof(change_xpath_buffer), "%s/ipv4/enabled", xpath), error_out);
-        SRPC_SAFE_CALL_ERR(rc, srpc_iterate_changes(ctx, session, change_xpath_buffer, interfaces_interface_ipv4_change_enabled, interfaces_change_interface_init, interfaces_change_interface_free), error_out);
+        // last point where the commit can still be refused - see SR_EV_DONE
+        SRPC_SAFE_CALL_ERR(rc, interfaces_change_plan_check(&mod_ctx->plan, mod_ctx->nl_ctx.link_cache), error_out);
+    }
+
+    goto out;
+
+error_out:
+    // sysrepo sends no abort event to the subscriber which failed the change
+    interfaces_change_plan_free(&mod_ctx->plan);
+    error = SR_ERR_CALLBACK_FAILED;
 
-        // ipv4/address/ip
-        SRPC_SAFE_CALL_ERR_COND(rc, rc < 0, snprintf(change_xpath_buffer, sizeof(change_xpath_buffer), "%s/ipv4/address/ip", xpath), error_out);
-        SRPC_SAFE_CALL_ERR(rc, srpc_iterate_changes(ctx, session, change_xpath_buffer, interfaces_interface_ipv4_address_change_ip, interfaces_change_interface_init, interfaces_change_interface_free), error_out);
+out:
+    // temporary handler data doesn't outlive the commit
+    memset(&mod_ctx->mod_data, 0, sizeof(mod_ctx->mod_data));
+
+    // keyed by change tree nodes - freed together with the iterator below
+    interfaces_change_interface_links_free(mod_ctx);
+
+    for (size_t i = 0; i < ARRAY_SIZE(buckets); i++) {
+        free(buckets[i].changes);
+    }
+
+    // changed nodes are valid until the iterator is freed
+    if (changes_iterator) {
+        sr_free_change_iter(changes_iterator);
+    }
 
-        // ipv4/address/prefix-length
-        SRPC_SAFE_CALL_ERR_COND(rc, rc < 0, snprintf(change_xpath_buffer, sizeof(change_xpath_buffer), "%s/ipv4/address/prefix-length", xpath), error_out);
-        SRPC_SAFE_CALL_ERR(rc, srpc_iterate_changes(ctx, session, change_xpath_buffer, interfaces_interface_ipv4_address_change_prefix_length, interfaces_change_interface_init, interfaces_change_interface_free), error_out);
+    return error;
+}
 
-        // ipv4/address/netmask
-        SRPC_SAFE_CALL_ERR_COND(rc, rc < 0, snprintf(change_xpath_buffer, sizeof(change_xpath_buffer), "%s/ipv4/address/netmask", xpath), error_out);
-        SRPC_SAFE_CALL_ERR(rc, srpc_iterate_changes(ctx, session, change_xpath_buffer, interfaces_interface_ipv4_address_change_netmask, interfaces_change_interface_init, interfaces_change_interface_free), error_out);
+void interfaces_subscription_change_dispatch_free(interfaces_change_dispatch_ctx_t* dispatch)
+{
+    free(dispatch->schema_nodes);
 
-        // ipv4/neighbor/ip
-        SRPC_SAFE_CALL_ERR_COND(rc, rc < 0, snprintf(change_xpath_buffer, sizeof(change_xpath_buffer), "%s/ipv4/neighbor/ip", xpath), error_out);
-        SRPC_SAFE_CALL_ERR(rc, srpc_iterate_changes(ctx, session, change_xpath_buffer, interfaces_interface_ipv4_neighbor_change_ip, interfaces_change_interface_init, interfaces_change_interface_free), error_out);
+    *dispatch = (interfaces_change_dispatch_ctx_t) { 0 };
+}
 
-        // ipv4/neighbor/link-layer-address
-        SRPC_SAFE_CALL_ERR_COND(rc, rc < 0, snprintf(change_xpath_buffer, sizeof(change_xpath_buffer), "%s/ipv4/neighbor/link-layer-address", xpath), error_out);
-        SRPC_SAFE_CALL_ERR(rc, srpc_iterate_changes(ctx, session, change_xpath_buffer, interfaces_interface_ipv4_neighbor_change_link_layer_address, interfaces_change_interface_init, interfaces_change_interface_free), error_out);
+static int interfaces_subscription_change_resolve_handlers(interfaces_change_dispatch_ctx_t* dispatch, const struct ly_ctx* ly_ctx, const char* xpath)
+{
+    int error = 0;
+    int rc = 0;
+    char path_buffer[PATH_MAX] = { 0 };
 
-        // ipv6/address/ip
-        SRPC_SAFE_CALL_ERR_COND(rc, rc < 0, snprintf(change_xpath_buffer, sizeof(change_xpath_buffer), "%s/ipv6/address/ip", xpath), error_out);
-        SRPC_SAFE_CALL_ERR(rc, srpc_iterate_changes(ctx, session, change_xpath_buffer, interfaces_interface_ipv6_address_change_ip, interfaces_change_interface_init, interfaces_change_interface_free), error_out);
+    interfaces_subscription_change_dispatch_free(dispatch);
 
-        // ipv6/address/prefix-length
-        SRPC_SAFE_CALL_ERR_COND(rc, rc < 0, snprintf(change_xpath_buffer, sizeof(change_xpath_buffer), "%s/ipv6/address/prefix-length", xpath), error_out);
-        SRPC_SAFE_CALL_ERR(rc, srpc_iterate_changes(ctx, session, change_xpath_buffer, interfaces_interface_ipv6_address_change_prefix_length, interfaces_change_interface_init, interfaces_change_interface_free), error_out);
+    dispatch->schema_nodes = calloc(ARRAY_SIZE(interfaces_change_handlers), sizeof(*dispatch->schema_nodes));
+    if (!dispatch->schema_nodes) {
+        goto error_out;
+    }
 
-        // ipv6/neighbor/ip
-        SRPC_SAFE_CALL_ERR_COND(rc, rc < 0, snprintf(change_xpath_buffer, sizeof(change_xpath_buffer), "%s/ipv6/neighbor/ip", xpath), error_out);
-        SRPC_SAFE_CALL_ERR(rc, srpc_iterate_changes(ctx, session, change_xpath_buffer, interfaces_interface_ipv6_neighbor_change_ip, interfaces_change_interface_init, interfaces_change_interface_free), error_out);
+    for (size_t i = 0; i < ARRAY_SIZE(interfaces_change_handlers); i++) {
+        SRPC_SAFE_CALL_ERR_COND(rc, rc < 0, snprintf(path_buffer, sizeof(path_buffer), "%s%s", xpath, interfaces_change_handlers[i].path), error_out);
 
-        // ipv6/neighbor/link-layer-address
-        SRPC_SAFE_CALL_ERR_COND(rc, rc < 0, snprintf(change_xpath_buffer, sizeof(change_xpath_buffer), "%s/ipv6/neighbor/link-layer-address", xpath), error_out);
-        SRPC_SAFE_CALL_ERR(rc, srpc_iterate_changes(ctx, session, change_xpath_buffer, interfaces_interface_ipv6_neighbor_change_link_layer_address, interfaces_change_interface_init, interfaces_change_interface_free), error_out);
+        // modules which aren't implemented leave their handlers without changes
+        dispatch->schema_nodes[i] = lys_find_path(ly_ctx, NULL, path_buffer, 0);
+        if (!dispatch->schema_nodes[i]) {
+            SRPLG_LOG_DBG(PLUGIN_NAME, "No schema node for %s - changes will not be handled", path_buffer);
+        }
     }
 
+    dispatch->ly_ctx = ly_ctx;
+    dispatch->count = ARRAY_SIZE(interfaces_change_handlers);
+
     goto out;
 
 error_out:
-    error = SR_ERR_CALLBACK_FAILED;
+    interfaces_subscription_change_dispatch_free(dispatch);
+    error = -1;
 
 out:
     return error;
 }
+
+static int interfaces_subscription_change_find_handler(const interfaces_change_dispatch_ctx_t* dispatch, const struct lysc_node* schema)
+{
+    for (size_t i = 0; i < dispatch->count; i++) {
+        if (dispatch->schema_nodes[i] == schema) {
+            return (int)i;
+        }
+    }
+
+    return -1;
+}
+
+static int interfaces_subscription_change_bucket_add(interfaces_change_bucket_t* bucket, const interfaces_change_node_t* change)
+{
+    interfaces_change_node_t* changes = NULL;
+
+    if (bucket->count == bucket->size) {
+        const size_t size = bucket->size ? bucket->size * 2 : 16;
+
+        changes = realloc(bucket->changes, sizeof(*changes) * size);
+        if (!changes) {
+            return -1;
+        }
+
+        bucket->changes = changes;
+        bucket->size = size;
+    }
+
+    bucket->changes[bucket->count++] = *change;
+
+    return 0;
+}
@@ -13,8 +13,11 @@
 #ifndef INTERFACES_PLUGIN_SUBSCRIPTION_CHANGE_H
 #define INTERFACES_PLUGIN_SUBSCRIPTION_CHANGE_H
 
+#include "plugin/context.h"
+
 #include <sysrepo_types.h>
 
 int interfaces_subscription_change_interfaces_interface(sr_session_ctx_t* session, uint32_t subscription_id, const char* module_name, const char* xpath, sr_event_t event, uint32_t request_id, void* private_data);
+void interfaces_subscription_change_dispatch_free(interfaces_change_dispatch_ctx_t* dispatch);
 
 #endif // INTERFACES_PLUGIN_SUBSCRIPTION_CHANGE_H
\ No newline at end of file
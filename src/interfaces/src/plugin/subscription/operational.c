@@ -21,13 +21,17 @@
 #include "netlink/socket.h"
 #include "plugin/common.h"
 #include "plugin/context.h"
-#include "plugin/data/interfaces/interface_state.h"
+#include "plugin/data/interfaces/interface_state_table.h"
+#include "plugin/data/interfaces/link_index.h"
+#include "plugin/data/interfaces/object_index.h"
 #include "plugin/ly_tree.h"
 #include "plugin/types.h"
 #include "srpc/common.h"
 #include "sysrepo_types.h"
 
 #include <assert.h>
+#include <errno.h>
+#include <inttypes.h>
 #include <libyang/libyang.h>
 #include <linux/if.h>
 #include <linux/if_addr.h>
@@ -44,17 +48,50 @@
 #include <sys/sysinfo.h>
 
 #include <linux/limits.h>
-
-static struct rtnl_link* interfaces_get_current_link(interfaces_ctx_t* ctx, sr_session_ctx_t* session, const char* xpath);
-static int interfaces_extract_interface_name(sr_session_ctx_t* session, const char* xpath, char* buffer, size_t buffer_size);
-static int interfaces_extract_interface_address_ip(sr_session_ctx_t* session, const char* xpath, char* buffer, size_t buffer_size);
-static int interfaces_extract_interface_neighbor_ip(sr_session_ctx_t* session, const char* xpath, char* buffer, size_t buffer_size);
+#include <sys/epoll.h>
+
+#include <uthash.h>
+
+// interface nodes created by the bulk provider, found by ifindex
+typedef struct interfaces_oper_bulk_node_s interfaces_oper_bulk_node_t;
+
+struct interfaces_oper_bulk_node_s {
+    int ifindex;
+    struct lyd_node* interface_node;
+    struct lyd_node* ipv4_node;
+    struct lyd_node* ipv6_node;
+    UT_hash_handle hh;
+};
+
+static struct rtnl_link* interfaces_get_current_link(interfaces_ctx_t* ctx, uint32_t request_id, const struct lyd_node* node);
+static const struct lyd_node* interfaces_get_list_node(const struct lyd_node* node, const char* list_name);
+static const char* interfaces_get_list_key_value(const struct lyd_node* node, const char* list_name, const char* key_name);
+static int interfaces_extract_interface_address_ip(const struct lyd_node* address_node, char* buffer, size_t buffer_size);
+static int interfaces_extract_interface_neighbor_ip(const struct lyd_node* neighbor_node, char* buffer, size_t buffer_size);
 static int interfaces_get_system_boot_time(char* buffer, size_t buffer_size);
+static int interfaces_extract_request_interface_name(const char* request_xpath, char* buffer, size_t buffer_size);
+
+// per request lookups
+static interfaces_oper_request_ctx_t* interfaces_oper_request_get(interfaces_oper_ctx_t* oper_ctx, uint32_t request_id);
+static void interfaces_oper_request_release_idle(interfaces_oper_ctx_t* oper_ctx, time_t current_time);
+static void interfaces_oper_request_reset_links(interfaces_oper_ctx_t* oper_ctx);
+
+// notification driven caches
+static int interfaces_oper_cache_sync(interfaces_oper_ctx_t* oper_ctx);
+static int interfaces_oper_cache_index(interfaces_oper_ctx_t* oper_ctx);
+static void interfaces_oper_cache_change_cb(struct nl_cache* cache, struct nl_object* obj, int action, void* arg);
+
+// bulk mode
+static int interfaces_oper_bulk_fill_interface(interfaces_ctx_t* ctx, struct rtnl_link* link, struct lyd_node* interface_node);
+static int interfaces_oper_bulk_fill_statistics(struct rtnl_link* link, struct lyd_node* statistics_node, const char* discontinuity_time);
+static int interfaces_oper_bulk_fill_layers(interfaces_nl_ctx_t* nl_ctx, interfaces_oper_bulk_node_t* nodes_hash);
+static int interfaces_oper_bulk_fill_addresses(interfaces_nl_ctx_t* nl_ctx, interfaces_oper_bulk_node_t* nodes_hash);
+static int interfaces_oper_bulk_fill_neighbors(interfaces_nl_ctx_t* nl_ctx, interfaces_oper_bulk_node_t* nodes_hash);
+static const char* interfaces_oper_get_neighbor_state(int state);
 
 int interfaces_subscription_operational_interfaces_interface_admin_status(sr_session_ctx_t* session, uint32_t sub_id, const char* module_name, const char* path, const char* request_xpath, uint32_t request_id, struct lyd_node** parent, void* private_data)
 {
     int error = SR_ERR_OK;
-    void* error_ptr = NULL;
 
     // context
     const struct ly_ctx* ly_ctx = NULL;
@@ -78,17 +115,12 @@ int interfaces_subscription_operational_interfaces_interface_admin_status(sr_ses
     // libnl
     struct rtnl_link* link = NULL;
 
-    char xpath_buffer[PATH_MAX] = { 0 };
-
     // there needs to be an allocated link cache in memory
     assert(*parent != NULL);
     assert(strcmp(LYD_NAME(*parent), "interface") == 0);
 
-    // get node xpath
-    SRPC_SAFE_CALL_PTR(error_ptr, lyd_path(*parent, LYD_PATH_STD, xpath_buffer, sizeof(xpath_buffer)), error_out);
-
     // get link
-    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, session, xpath_buffer), error_out);
+    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, request_id, *parent), error_out);
 
     // get admin status
     const unsigned int flags = rtnl_link_get_flags(link);
@@ -121,7 +153,6 @@ out:
 int interfaces_subscription_operational_interfaces_interface_oper_status(sr_session_ctx_t* session, uint32_t sub_id, const char* module_name, const char* path, const char* request_xpath, uint32_t request_id, struct lyd_node** parent, void* private_data)
 {
     int error = SR_ERR_OK;
-    void* error_ptr = NULL;
 
     // context
     const struct ly_ctx* ly_ctx = NULL;
@@ -130,8 +161,6 @@ int interfaces_subscription_operational_interfaces_interface_oper_status(sr_sess
     // libnl
     struct rtnl_link* link = NULL;
 
-    char xpath_buffer[PATH_MAX] = { 0 };
-
     const char* operstate_map[] = {
         [IF_OPER_UNKNOWN] = "unknown",
         [IF_OPER_NOTPRESENT] = "not-present",
@@ -146,11 +175,8 @@ int interfaces_subscription_operational_interfaces_interface_oper_status(sr_sess
     assert(*parent != NULL);
     assert(strcmp(LYD_NAME(*parent), "interface") == 0);
 
-    // get node xpath
-    SRPC_SAFE_CALL_PTR(error_ptr, lyd_path(*parent, LYD_PATH_STD, xpath_buffer, sizeof(xpath_buffer)), error_out);
-
     // get link
-    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, session, xpath_buffer), error_out);
+    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, request_id, *parent), error_out);
 
     // get oper status
     const uint8_t oper_status = rtnl_link_get_operstate(link);
@@ -173,38 +199,29 @@ out:
 int interfaces_subscription_operational_interfaces_interface_last_change(sr_session_ctx_t* session, uint32_t sub_id, const char* module_name, const char* path, const char* request_xpath, uint32_t request_id, struct lyd_node** parent, void* private_data)
 {
     int error = SR_ERR_OK;
-    void* error_ptr = NULL;
 
     // context
     const struct ly_ctx* ly_ctx = NULL;
     interfaces_ctx_t* ctx = private_data;
     interfaces_state_changes_ctx_t* state_ctx = &ctx->oper_ctx.state_changes_ctx;
-    interfaces_interface_state_hash_element_t* state_element = NULL;
+    time_t last_change = 0;
 
     // libnl
     struct rtnl_link* link = NULL;
 
     // buffers
     char last_change_buffer[100] = { 0 };
-    char xpath_buffer[PATH_MAX] = { 0 };
 
     // there needs to be an allocated link cache in memory
     assert(*parent != NULL);
     assert(strcmp(LYD_NAME(*parent), "interface") == 0);
 
-    // get node xpath
-    SRPC_SAFE_CALL_PTR(error_ptr, lyd_path(*parent, LYD_PATH_STD, xpath_buffer, sizeof(xpath_buffer)), error_out);
-
     // get link
-    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, session, xpath_buffer), error_out);
-
-    // synchronization
-    pthread_mutex_lock(&state_ctx->state_hash_mutex);
+    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, request_id, *parent), error_out);
 
     // get last change
-    SRPC_SAFE_CALL_PTR(state_element, interfaces_interface_state_hash_get(state_ctx->state_hash, rtnl_link_get_name(link)), error_out);
+    SRPC_SAFE_CALL_ERR(error, interfaces_interface_state_table_get(&state_ctx->state_table, rtnl_link_get_name(link), NULL, &last_change), error_out);
 
-    const time_t last_change = state_element->state.last_change;
     struct tm* last_change_tm = localtime(&last_change);
 
     size_t written = strftime(last_change_buffer, sizeof(last_change_buffer), "%FT%TZ", last_change_tm);
@@ -224,15 +241,12 @@ error_out:
     error = SR_ERR_CALLBACK_FAILED;
 
 out:
-    pthread_mutex_unlock(&state_ctx->state_hash_mutex);
-
     return error;
 }
 
 int interfaces_subscription_operational_interfaces_interface_if_index(sr_session_ctx_t* session, uint32_t sub_id, const char* module_name, const char* path, const char* request_xpath, uint32_t request_id, struct lyd_node** parent, void* private_data)
 {
     int error = SR_ERR_OK;
-    void* error_ptr = NULL;
 
     // context
     const struct ly_ctx* ly_ctx = NULL;
@@ -240,7 +254,6 @@ int interfaces_subscription_operational_interfaces_interface_if_index(sr_session
 
     // buffers
     char ifindex_buffer[100] = { 0 };
-    char xpath_buffer[PATH_MAX] = { 0 };
 
     // libnl
     struct rtnl_link* link = NULL;
@@ -249,11 +262,8 @@ int interfaces_subscription_operational_interfaces_interface_if_index(sr_session
     assert(*parent != NULL);
     assert(strcmp(LYD_NAME(*parent), "interface") == 0);
 
-    // get node xpath
-    SRPC_SAFE_CALL_PTR(error_ptr, lyd_path(*parent, LYD_PATH_STD, xpath_buffer, sizeof(xpath_buffer)), error_out);
-
     // get link
-    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, session, xpath_buffer), error_out);
+    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, request_id, *parent), error_out);
 
     // get if-index
     const int ifindex = rtnl_link_get_ifindex(link);
@@ -286,7 +296,6 @@ int interfaces_subscription_operational_interfaces_interface_phys_address(sr_ses
 
     // buffers
     char phys_address_buffer[100] = { 0 };
-    char xpath_buffer[PATH_MAX] = { 0 };
 
     // libnl
     struct rtnl_link* link = NULL;
@@ -296,11 +305,8 @@ int interfaces_subscription_operational_interfaces_interface_phys_address(sr_ses
     assert(*parent != NULL);
     assert(strcmp(LYD_NAME(*parent), "interface") == 0);
 
-    // get node xpath
-    SRPC_SAFE_CALL_PTR(error_ptr, lyd_path(*parent, LYD_PATH_STD, xpath_buffer, sizeof(xpath_buffer)), error_out);
-
     // get link
-    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, session, xpath_buffer), error_out);
+    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, request_id, *parent), error_out);
 
     // get phys-address
     SRPC_SAFE_CALL_PTR(addr, rtnl_link_get_addr(link), error_out);
@@ -324,15 +330,12 @@ out:
 int interfaces_subscription_operational_interfaces_interface_higher_layer_if(sr_session_ctx_t* session, uint32_t sub_id, const char* module_name, const char* path, const char* request_xpath, uint32_t request_id, struct lyd_node** parent, void* private_data)
 {
     int error = SR_ERR_OK;
-    void* error_ptr = NULL;
 
     // context
     const struct ly_ctx* ly_ctx = NULL;
     interfaces_ctx_t* ctx = private_data;
     interfaces_nl_ctx_t* nl_ctx = &ctx->oper_ctx.nl_ctx;
 
-    char xpath_buffer[PATH_MAX] = { 0 };
-
     // libnl
     struct rtnl_link* link = NULL;
     struct rtnl_link* master_link = NULL;
@@ -340,15 +343,12 @@ int interfaces_subscription_operational_interfaces_interface_higher_layer_if(sr_
     assert(*parent != NULL);
     assert(strcmp(LYD_NAME(*parent), "interface") == 0);
 
-    // get node xpath
-    SRPC_SAFE_CALL_PTR(error_ptr, lyd_path(*parent, LYD_PATH_STD, xpath_buffer, sizeof(xpath_buffer)), error_out);
-
     // get link
-    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, session, xpath_buffer), error_out);
+    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, request_id, *parent), error_out);
 
     int master_if_index = rtnl_link_get_master(link);
     while (master_if_index) {
-        master_link = rtnl_link_get(nl_ctx->link_cache, master_if_index);
+        SRPC_SAFE_CALL_PTR(master_link, interfaces_link_index_get_by_ifindex(&nl_ctx->link_index, master_if_index), error_out);
         const char* master_name = rtnl_link_get_name(master_link);
 
         SRPLG_LOG_INF(PLUGIN_NAME, "higher-layer-if(%s) = %s", rtnl_link_get_name(link), master_name);
@@ -373,15 +373,12 @@ out:
 int interfaces_subscription_operational_interfaces_interface_lower_layer_if(sr_session_ctx_t* session, uint32_t sub_id, const char* module_name, const char* path, const char* request_xpath, uint32_t request_id, struct lyd_node** parent, void* private_data)
 {
     int error = SR_ERR_OK;
-    void* error_ptr = NULL;
 
     // context
     const struct ly_ctx* ly_ctx = NULL;
     interfaces_ctx_t* ctx = private_data;
     interfaces_nl_ctx_t* nl_ctx = &ctx->oper_ctx.nl_ctx;
 
-    char xpath_buffer[PATH_MAX] = { 0 };
-
     // libnl
     struct rtnl_link* link = NULL;
     struct rtnl_link* master_link = NULL;
@@ -389,20 +386,21 @@ int interfaces_subscription_operational_interfaces_interface_lower_layer_if(sr_s
     assert(*parent != NULL);
     assert(strcmp(LYD_NAME(*parent), "interface") == 0);
 
-    // get node xpath
-    SRPC_SAFE_CALL_PTR(error_ptr, lyd_path(*parent, LYD_PATH_STD, xpath_buffer, sizeof(xpath_buffer)), error_out);
-
     // get link
-    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, session, xpath_buffer), error_out);
+    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, request_id, *parent), error_out);
 
     // iterate over all links and check for ones which have a master equal to the current link
     struct nl_cache* link_cache = nl_ctx->link_cache;
     struct rtnl_link* link_iter = (struct rtnl_link*)nl_cache_get_first(link_cache);
 
     while (link_iter) {
-        int master_if_index = rtnl_link_get_master(link);
+        int master_if_index = rtnl_link_get_master(link_iter);
         while (master_if_index) {
-            master_link = rtnl_link_get(nl_ctx->link_cache, master_if_index);
+            master_link = interfaces_link_index_get_by_ifindex(&nl_ctx->link_index, master_if_index);
+            if (!master_link) {
+                break;
+            }
+
             const char* master_name = rtnl_link_get_name(master_link);
 
             if (!strcmp(master_name, rtnl_link_get_name(link))) {
@@ -436,7 +434,6 @@ out:
 int interfaces_subscription_operational_interfaces_interface_speed(sr_session_ctx_t* session, uint32_t sub_id, const char* module_name, const char* path, const char* request_xpath, uint32_t request_id, struct lyd_node** parent, void* private_data)
 {
     int error = SR_ERR_OK;
-    void* error_ptr = NULL;
 
     // context
     const struct ly_ctx* ly_ctx = NULL;
@@ -444,7 +441,6 @@ int interfaces_subscription_operational_interfaces_interface_speed(sr_session_ct
 
     // buffers
     char speed_buffer[100] = { 0 };
-    char xpath_buffer[PATH_MAX] = { 0 };
 
     // libnl
     struct rtnl_link* link = NULL;
@@ -455,11 +451,8 @@ int interfaces_subscription_operational_interfaces_interface_speed(sr_session_ct
     assert(*parent != NULL);
     assert(strcmp(LYD_NAME(*parent), "interface") == 0);
 
-    // get node xpath
-    SRPC_SAFE_CALL_PTR(error_ptr, lyd_path(*parent, LYD_PATH_STD, xpath_buffer, sizeof(xpath_buffer)), error_out);
-
     // get link
-    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, session, xpath_buffer), error_out);
+    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, request_id, *parent), error_out);
 
     qdisc = rtnl_qdisc_alloc();
 
@@ -492,7 +485,6 @@ out:
 int interfaces_subscription_operational_interfaces_interface_statistics_discontinuity_time(sr_session_ctx_t* session, uint32_t sub_id, const char* module_name, const char* path, const char* request_xpath, uint32_t request_id, struct lyd_node** parent, void* private_data)
 {
     int error = SR_ERR_OK;
-    void* error_ptr = NULL;
 
     // context
     const struct ly_ctx* ly_ctx = NULL;
@@ -500,7 +492,6 @@ int interfaces_subscription_operational_interfaces_interface_statistics_disconti
 
     // buffers
     char discontinuity_time_buffer[100] = { 0 };
-    char xpath_buffer[PATH_MAX] = { 0 };
 
     // libnl
     struct rtnl_link* link = NULL;
@@ -509,11 +500,8 @@ int interfaces_subscription_operational_interfaces_interface_statistics_disconti
     assert(*parent != NULL);
     assert(strcmp(LYD_NAME(*parent), "statistics") == 0);
 
-    // get node xpath
-    SRPC_SAFE_CALL_PTR(error_ptr, lyd_path(*parent, LYD_PATH_STD, xpath_buffer, sizeof(xpath_buffer)), error_out);
-
     // get link
-    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, session, xpath_buffer), error_out);
+    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, request_id, *parent), error_out);
 
     // get boot time as discontinuity time
     SRPC_SAFE_CALL_ERR(error, interfaces_get_system_boot_time(discontinuity_time_buffer, sizeof(discontinuity_time_buffer)), error_out);
@@ -535,7 +523,6 @@ out:
 int interfaces_subscription_operational_interfaces_interface_statistics_in_octets(sr_session_ctx_t* session, uint32_t sub_id, const char* module_name, const char* path, const char* request_xpath, uint32_t request_id, struct lyd_node** parent, void* private_data)
 {
     int error = SR_ERR_OK;
-    void* error_ptr = NULL;
 
     // context
     const struct ly_ctx* ly_ctx = NULL;
@@ -543,7 +530,6 @@ int interfaces_subscription_operational_interfaces_interface_statistics_in_octet
 
     // buffers
     char in_octets_buffer[100] = { 0 };
-    char xpath_buffer[PATH_MAX] = { 0 };
 
     // libnl
     struct rtnl_link* link = NULL;
@@ -552,11 +538,8 @@ int interfaces_subscription_operational_interfaces_interface_statistics_in_octet
     assert(*parent != NULL);
     assert(strcmp(LYD_NAME(*parent), "statistics") == 0);
 
-    // get node xpath
-    SRPC_SAFE_CALL_PTR(error_ptr, lyd_path(*parent, LYD_PATH_STD, xpath_buffer, sizeof(xpath_buffer)), error_out);
-
     // get link
-    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, session, xpath_buffer), error_out);
+    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, request_id, *parent), error_out);
 
     const uint64_t in_octets = rtnl_link_get_stat(link, RTNL_LINK_RX_BYTES);
 
@@ -579,7 +562,6 @@ out:
 int interfaces_subscription_operational_interfaces_interface_statistics_in_unicast_pkts(sr_session_ctx_t* session, uint32_t sub_id, const char* module_name, const char* path, const char* request_xpath, uint32_t request_id, struct lyd_node** parent, void* private_data)
 {
     int error = SR_ERR_OK;
-    void* error_ptr = NULL;
 
     // context
     const struct ly_ctx* ly_ctx = NULL;
@@ -587,7 +569,6 @@ int interfaces_subscription_operational_interfaces_interface_statistics_in_unica
 
     // buffers
     char in_unicast_pkts_buffer[100] = { 0 };
-    char xpath_buffer[PATH_MAX] = { 0 };
 
     // libnl
     struct rtnl_link* link = NULL;
@@ -596,11 +577,8 @@ int interfaces_subscription_operational_interfaces_interface_statistics_in_unica
     assert(*parent != NULL);
     assert(strcmp(LYD_NAME(*parent), "statistics") == 0);
 
-    // get node xpath
-    SRPC_SAFE_CALL_PTR(error_ptr, lyd_path(*parent, LYD_PATH_STD, xpath_buffer, sizeof(xpath_buffer)), error_out);
-
     // get link
-    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, session, xpath_buffer), error_out);
+    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, request_id, *parent), error_out);
 
     const uint64_t in_pkts = rtnl_link_get_stat(link, RTNL_LINK_RX_PACKETS);
     const uint64_t in_broadcast_pkts = rtnl_link_get_stat(link, RTNL_LINK_IP6_INBCASTPKTS);
@@ -626,7 +604,6 @@ out:
 int interfaces_subscription_operational_interfaces_interface_statistics_in_broadcast_pkts(sr_session_ctx_t* session, uint32_t sub_id, const char* module_name, const char* path, const char* request_xpath, uint32_t request_id, struct lyd_node** parent, void* private_data)
 {
     int error = SR_ERR_OK;
-    void* error_ptr = NULL;
 
     // context
     const struct ly_ctx* ly_ctx = NULL;
@@ -634,7 +611,6 @@ int interfaces_subscription_operational_interfaces_interface_statistics_in_broad
 
     // buffers
     char in_broadcast_pkts_buffer[100] = { 0 };
-    char xpath_buffer[PATH_MAX] = { 0 };
 
     // libnl
     struct rtnl_link* link = NULL;
@@ -643,11 +619,8 @@ int interfaces_subscription_operational_interfaces_interface_statistics_in_broad
     assert(*parent != NULL);
     assert(strcmp(LYD_NAME(*parent), "statistics") == 0);
 
-    // get node xpath
-    SRPC_SAFE_CALL_PTR(error_ptr, lyd_path(*parent, LYD_PATH_STD, xpath_buffer, sizeof(xpath_buffer)), error_out);
-
     // get link
-    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, session, xpath_buffer), error_out);
+    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, request_id, *parent), error_out);
 
     const uint64_t in_broadcast_pkts = rtnl_link_get_stat(link, RTNL_LINK_IP6_INBCASTPKTS);
 
@@ -670,7 +643,6 @@ out:
 int interfaces_subscription_operational_interfaces_interface_statistics_in_multicast_pkts(sr_session_ctx_t* session, uint32_t sub_id, const char* module_name, const char* path, const char* request_xpath, uint32_t request_id, struct lyd_node** parent, void* private_data)
 {
     int error = SR_ERR_OK;
-    void* error_ptr = NULL;
 
     // context
     const struct ly_ctx* ly_ctx = NULL;
@@ -678,7 +650,6 @@ int interfaces_subscription_operational_interfaces_interface_statistics_in_multi
 
     // buffers
     char in_multicast_pkts_buffer[100] = { 0 };
-    char xpath_buffer[PATH_MAX] = { 0 };
 
     // libnl
     struct rtnl_link* link = NULL;
@@ -687,11 +658,8 @@ int interfaces_subscription_operational_interfaces_interface_statistics_in_multi
     assert(*parent != NULL);
     assert(strcmp(LYD_NAME(*parent), "statistics") == 0);
 
-    // get node xpath
-    SRPC_SAFE_CALL_PTR(error_ptr, lyd_path(*parent, LYD_PATH_STD, xpath_buffer, sizeof(xpath_buffer)), error_out);
-
     // get link
-    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, session, xpath_buffer), error_out);
+    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, request_id, *parent), error_out);
 
     const uint64_t in_multicast_pkts = rtnl_link_get_stat(link, RTNL_LINK_IP6_INMCASTPKTS);
 
@@ -714,7 +682,6 @@ out:
 int interfaces_subscription_operational_interfaces_interface_statistics_in_discards(sr_session_ctx_t* session, uint32_t sub_id, const char* module_name, const char* path, const char* request_xpath, uint32_t request_id, struct lyd_node** parent, void* private_data)
 {
     int error = SR_ERR_OK;
-    void* error_ptr = NULL;
 
     // context
     const struct ly_ctx* ly_ctx = NULL;
@@ -722,7 +689,6 @@ int interfaces_subscription_operational_interfaces_interface_statistics_in_disca
 
     // buffers
     char in_discards_buffer[100] = { 0 };
-    char xpath_buffer[PATH_MAX] = { 0 };
 
     // libnl
     struct rtnl_link* link = NULL;
@@ -731,11 +697,8 @@ int interfaces_subscription_operational_interfaces_interface_statistics_in_disca
     assert(*parent != NULL);
     assert(strcmp(LYD_NAME(*parent), "statistics") == 0);
 
-    // get node xpath
-    SRPC_SAFE_CALL_PTR(error_ptr, lyd_path(*parent, LYD_PATH_STD, xpath_buffer, sizeof(xpath_buffer)), error_out);
-
     // get link
-    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, session, xpath_buffer), error_out);
+    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, request_id, *parent), error_out);
 
     const uint32_t in_discards = (uint32_t)rtnl_link_get_stat(link, RTNL_LINK_RX_DROPPED);
 
@@ -758,7 +721,6 @@ out:
 int interfaces_subscription_operational_interfaces_interface_statistics_in_errors(sr_session_ctx_t* session, uint32_t sub_id, const char* module_name, const char* path, const char* request_xpath, uint32_t request_id, struct lyd_node** parent, void* private_data)
 {
     int error = SR_ERR_OK;
-    void* error_ptr = NULL;
 
     // context
     const struct ly_ctx* ly_ctx = NULL;
@@ -766,7 +728,6 @@ int interfaces_subscription_operational_interfaces_interface_statistics_in_error
 
     // buffers
     char in_errors_buffer[100] = { 0 };
-    char xpath_buffer[PATH_MAX] = { 0 };
 
     // libnl
     struct rtnl_link* link = NULL;
@@ -775,11 +736,8 @@ int interfaces_subscription_operational_interfaces_interface_statistics_in_error
     assert(*parent != NULL);
     assert(strcmp(LYD_NAME(*parent), "statistics") == 0);
 
-    // get node xpath
-    SRPC_SAFE_CALL_PTR(error_ptr, lyd_path(*parent, LYD_PATH_STD, xpath_buffer, sizeof(xpath_buffer)), error_out);
-
     // get link
-    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, session, xpath_buffer), error_out);
+    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, request_id, *parent), error_out);
 
     const uint32_t in_errors = (uint32_t)rtnl_link_get_stat(link, RTNL_LINK_RX_ERRORS);
 
@@ -802,7 +760,6 @@ out:
 int interfaces_subscription_operational_interfaces_interface_statistics_in_unknown_protos(sr_session_ctx_t* session, uint32_t sub_id, const char* module_name, const char* path, const char* request_xpath, uint32_t request_id, struct lyd_node** parent, void* private_data)
 {
     int error = SR_ERR_OK;
-    void* error_ptr = NULL;
 
     // context
     const struct ly_ctx* ly_ctx = NULL;
@@ -810,7 +767,6 @@ int interfaces_subscription_operational_interfaces_interface_statistics_in_unkno
 
     // buffers
     char in_unknown_protos_buffer[100] = { 0 };
-    char xpath_buffer[PATH_MAX] = { 0 };
 
     // libnl
     struct rtnl_link* link = NULL;
@@ -819,11 +775,8 @@ int interfaces_subscription_operational_interfaces_interface_statistics_in_unkno
     assert(*parent != NULL);
     assert(strcmp(LYD_NAME(*parent), "statistics") == 0);
 
-    // get node xpath
-    SRPC_SAFE_CALL_PTR(error_ptr, lyd_path(*parent, LYD_PATH_STD, xpath_buffer, sizeof(xpath_buffer)), error_out);
-
     // get link
-    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, session, xpath_buffer), error_out);
+    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, request_id, *parent), error_out);
 
     const uint32_t in_unknown_protos = (uint32_t)rtnl_link_get_stat(link, RTNL_LINK_IP6_INUNKNOWNPROTOS);
 
@@ -846,7 +799,6 @@ out:
 int interfaces_subscription_operational_interfaces_interface_statistics_out_octets(sr_session_ctx_t* session, uint32_t sub_id, const char* module_name, const char* path, const char* request_xpath, uint32_t request_id, struct lyd_node** parent, void* private_data)
 {
     int error = SR_ERR_OK;
-    void* error_ptr = NULL;
 
     // context
     const struct ly_ctx* ly_ctx = NULL;
@@ -854,7 +806,6 @@ int interfaces_subscription_operational_interfaces_interface_statistics_out_octe
 
     // buffers
     char out_octets_buffer[100] = { 0 };
-    char xpath_buffer[PATH_MAX] = { 0 };
 
     // libnl
     struct rtnl_link* link = NULL;
@@ -863,11 +814,8 @@ int interfaces_subscription_operational_interfaces_interface_statistics_out_octe
     assert(*parent != NULL);
     assert(strcmp(LYD_NAME(*parent), "statistics") == 0);
 
-    // get node xpath
-    SRPC_SAFE_CALL_PTR(error_ptr, lyd_path(*parent, LYD_PATH_STD, xpath_buffer, sizeof(xpath_buffer)), error_out);
-
     // get link
-    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, session, xpath_buffer), error_out);
+    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, request_id, *parent), error_out);
 
     const uint64_t out_octets = rtnl_link_get_stat(link, RTNL_LINK_TX_BYTES);
 
@@ -890,7 +838,6 @@ out:
 int interfaces_subscription_operational_interfaces_interface_statistics_out_unicast_pkts(sr_session_ctx_t* session, uint32_t sub_id, const char* module_name, const char* path, const char* request_xpath, uint32_t request_id, struct lyd_node** parent, void* private_data)
 {
     int error = SR_ERR_OK;
-    void* error_ptr = NULL;
 
     // context
     const struct ly_ctx* ly_ctx = NULL;
@@ -898,7 +845,6 @@ int interfaces_subscription_operational_interfaces_interface_statistics_out_unic
 
     // buffers
     char out_unicast_pkts_buffer[100] = { 0 };
-    char xpath_buffer[PATH_MAX] = { 0 };
 
     // libnl
     struct rtnl_link* link = NULL;
@@ -907,11 +853,8 @@ int interfaces_subscription_operational_interfaces_interface_statistics_out_unic
     assert(*parent != NULL);
     assert(strcmp(LYD_NAME(*parent), "statistics") == 0);
 
-    // get node xpath
-    SRPC_SAFE_CALL_PTR(error_ptr, lyd_path(*parent, LYD_PATH_STD, xpath_buffer, sizeof(xpath_buffer)), error_out);
-
     // get link
-    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, session, xpath_buffer), error_out);
+    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, request_id, *parent), error_out);
 
     const uint64_t out_pkts = rtnl_link_get_stat(link, RTNL_LINK_TX_PACKETS);
     const uint64_t out_broadcast_pkts = rtnl_link_get_stat(link, RTNL_LINK_IP6_OUTBCASTPKTS);
@@ -937,7 +880,6 @@ out:
 int interfaces_subscription_operational_interfaces_interface_statistics_out_broadcast_pkts(sr_session_ctx_t* session, uint32_t sub_id, const char* module_name, const char* path, const char* request_xpath, uint32_t request_id, struct lyd_node** parent, void* private_data)
 {
     int error = SR_ERR_OK;
-    void* error_ptr = NULL;
 
     // context
     const struct ly_ctx* ly_ctx = NULL;
@@ -945,7 +887,6 @@ int interfaces_subscription_operational_interfaces_interface_statistics_out_broa
 
     // buffers
     char out_broadcast_pkts_buffer[100] = { 0 };
-    char xpath_buffer[PATH_MAX] = { 0 };
 
     // libnl
     struct rtnl_link* link = NULL;
@@ -954,11 +895,8 @@ int interfaces_subscription_operational_interfaces_interface_statistics_out_broa
     assert(*parent != NULL);
     assert(strcmp(LYD_NAME(*parent), "statistics") == 0);
 
-    // get node xpath
-    SRPC_SAFE_CALL_PTR(error_ptr, lyd_path(*parent, LYD_PATH_STD, xpath_buffer, sizeof(xpath_buffer)), error_out);
-
     // get link
-    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, session, xpath_buffer), error_out);
+    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, request_id, *parent), error_out);
 
     const uint64_t out_broadcast_pkts = rtnl_link_get_stat(link, RTNL_LINK_IP6_OUTBCASTPKTS);
 
@@ -981,7 +919,6 @@ out:
 int interfaces_subscription_operational_interfaces_interface_statistics_out_multicast_pkts(sr_session_ctx_t* session, uint32_t sub_id, const char* module_name, const char* path, const char* request_xpath, uint32_t request_id, struct lyd_node** parent, void* private_data)
 {
     int error = SR_ERR_OK;
-    void* error_ptr = NULL;
 
     // context
     const struct ly_ctx* ly_ctx = NULL;
@@ -989,7 +926,6 @@ int interfaces_subscription_operational_interfaces_interface_statistics_out_mult
 
     // buffers
     char out_multicast_pkts_buffer[100] = { 0 };
-    char xpath_buffer[PATH_MAX] = { 0 };
 
     // libnl
     struct rtnl_link* link = NULL;
@@ -998,11 +934,8 @@ int interfaces_subscription_operational_interfaces_interface_statistics_out_mult
     assert(*parent != NULL);
     assert(strcmp(LYD_NAME(*parent), "statistics") == 0);
 
-    // get node xpath
-    SRPC_SAFE_CALL_PTR(error_ptr, lyd_path(*parent, LYD_PATH_STD, xpath_buffer, sizeof(xpath_buffer)), error_out);
-
     // get link
-    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, session, xpath_buffer), error_out);
+    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, request_id, *parent), error_out);
 
     const uint64_t out_multicast_pkts = rtnl_link_get_stat(link, RTNL_LINK_IP6_OUTMCASTPKTS);
 
@@ -1025,7 +958,6 @@ out:
 int interfaces_subscription_operational_interfaces_interface_statistics_out_discards(sr_session_ctx_t* session, uint32_t sub_id, const char* module_name, const char* path, const char* request_xpath, uint32_t request_id, struct lyd_node** parent, void* private_data)
 {
     int error = SR_ERR_OK;
-    void* error_ptr = NULL;
 
     // context
     const struct ly_ctx* ly_ctx = NULL;
@@ -1033,7 +965,6 @@ int interfaces_subscription_operational_interfaces_interface_statistics_out_disc
 
     // buffers
     char out_discards_buffer[100] = { 0 };
-    char xpath_buffer[PATH_MAX] = { 0 };
 
     // libnl
     struct rtnl_link* link = NULL;
@@ -1042,11 +973,8 @@ int interfaces_subscription_operational_interfaces_interface_statistics_out_disc
     assert(*parent != NULL);
     assert(strcmp(LYD_NAME(*parent), "statistics") == 0);
 
-    // get node xpath
-    SRPC_SAFE_CALL_PTR(error_ptr, lyd_path(*parent, LYD_PATH_STD, xpath_buffer, sizeof(xpath_buffer)), error_out);
-
     // get link
-    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, session, xpath_buffer), error_out);
+    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, request_id, *parent), error_out);
 
     const uint64_t out_discards = rtnl_link_get_stat(link, RTNL_LINK_TX_DROPPED);
 
@@ -1069,7 +997,6 @@ out:
 int interfaces_subscription_operational_interfaces_interface_statistics_out_errors(sr_session_ctx_t* session, uint32_t sub_id, const char* module_name, const char* path, const char* request_xpath, uint32_t request_id, struct lyd_node** parent, void* private_data)
 {
     int error = SR_ERR_OK;
-    void* error_ptr = NULL;
 
     // context
     const struct ly_ctx* ly_ctx = NULL;
@@ -1077,7 +1004,6 @@ int interfaces_subscription_operational_interfaces_interface_statistics_out_erro
 
     // buffers
     char out_errors_buffer[100] = { 0 };
-    char xpath_buffer[PATH_MAX] = { 0 };
 
     // libnl
     struct rtnl_link* link = NULL;
@@ -1086,13 +1012,10 @@ int interfaces_subscription_operational_interfaces_interface_statistics_out_erro
     assert(*parent != NULL);
     assert(strcmp(LYD_NAME(*parent), "statistics") == 0);
 
-    // get node xpath
-    SRPC_SAFE_CALL_PTR(error_ptr, lyd_path(*parent, LYD_PATH_STD, xpath_buffer, sizeof(xpath_buffer)), error_out);
-
     // get link
-    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, session, xpath_buffer), error_out);
+    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, request_id, *parent), error_out);
 
-    const uint64_t out_errors = rtnl_link_get_stat(link, RTNL_LINK_TX_DROPPED);
+    const uint64_t out_errors = rtnl_link_get_stat(link, RTNL_LINK_TX_ERRORS);
 
     SRPC_SAFE_CALL_ERR_COND(error, error < 0, snprintf(out_errors_buffer, sizeof(out_errors_buffer), "%lu", out_errors), error_out);
 
@@ -1271,90 +1194,6 @@ out:
     return error;
 }
 
-int interfaces_subscription_operational_interfaces_interface_ipv4_address_origin(sr_session_ctx_t* session, uint32_t sub_id, const char* module_name, const char* path, const char* request_xpath, uint32_t request_id, struct lyd_node** parent, void* private_data)
-{
-    int error = SR_ERR_OK;
-    int rc = 0;
-    void* error_ptr = NULL;
-
-    sr_session_ctx_t* running_session = NULL;
-    sr_conn_ctx_t* connection = NULL;
-
-    sr_val_t* prefix_length_val = NULL;
-
-    interfaces_ctx_t* ctx = private_data;
-    interfaces_oper_ctx_t* oper_ctx = &ctx->oper_ctx;
-
-    char xpath_buffer[PATH_MAX] = { 0 };
-    char ip_buffer[20] = { 0 };
-    char address_buffer[100] = { 0 };
-
-    char prefix_path_buffer[PATH_MAX] = { 0 };
-
-    const struct ly_ctx* ly_ctx = NULL;
-
-    struct rtnl_link* link = NULL;
-    struct nl_addr* local = NULL;
-    struct rtnl_addr* addr = NULL;
-
-    if (*parent == NULL) {
-        ly_ctx = sr_acquire_context(sr_session_get_connection(session));
-        if (ly_ctx == NULL) {
-            SRPLG_LOG_ERR(PLUGIN_NAME, "sr_acquire_context() failed");
-            goto error_out;
-        }
-    }
-
-    // connect to the operational DS
-    SRPC_SAFE_CALL_PTR(connection, sr_session_get_connection(session), error_out);
-    SRPC_SAFE_CALL_ERR(error, sr_session_start(connection, SR_DS_RUNNING, &running_session), error_out);
-
-    assert(*parent != NULL);
-    assert(strcmp(LYD_NAME(*parent), "address") == 0);
-
-    // get node xpath
-    SRPC_SAFE_CALL_PTR(error_ptr, lyd_path(*parent, LYD_PATH_STD, xpath_buffer, sizeof(xpath_buffer)), error_out);
-
-    // get link
-    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, session, xpath_buffer), error_out);
-
-    // get IP
-    SRPC_SAFE_CALL_ERR(error, interfaces_extract_interface_address_ip(session, xpath_buffer, ip_buffer, sizeof(ip_buffer)), error_out);
-
-    // get prefix length from the operational DS
-    SRPC_SAFE_CALL_ERR_COND(rc, rc < 0, snprintf(prefix_path_buffer, sizeof(prefix_path_buffer), "/ietf-interfaces:interfaces/interface[name=\"%s\"]/ietf-ip:ipv4/address[ip=\"%s\"]/prefix-length", rtnl_link_get_name(link), ip_buffer), error_out);
-    SRPC_SAFE_CALL_ERR(error, sr_get_item(running_session, prefix_path_buffer, 0, &prefix_length_val), error_out);
-
-    // create an address
-    SRPC_SAFE_CALL_ERR_COND(rc, rc < 0, snprintf(address_buffer, sizeof(address_buffer), "%s/%d", ip_buffer, prefix_length_val->data.uint8_val), error_out);
-
-    // parse address
-    SRPC_SAFE_CALL_ERR(error, nl_addr_parse(address_buffer, AF_INET, &local), error_out);
-
-    // get rtnl address
-    SRPC_SAFE_CALL_PTR(addr, rtnl_addr_get(oper_ctx->nl_ctx.addr_cache, rtnl_link_get_ifindex(link), local), error_out);
-
-    // get address origin - static or dynamic
-    const char* origin = (rtnl_addr_get_flags(addr) & IFA_F_PERMANENT) > 0 ? "static" : "dhcp";
-
-    SRPLG_LOG_INF(PLUGIN_NAME, "origin(interface[%s]:address[%s]) = %s", rtnl_link_get_name(link), ip_buffer, origin);
-
-    // add origin
-    SRPC_SAFE_CALL_ERR(error, interfaces_ly_tree_create_interfaces_interface_ipv4_address_origin(ly_ctx, *parent, origin), error_out);
-
-    goto out;
-
-error_out:
-    error = SR_ERR_CALLBACK_FAILED;
-
-out:
-    if (running_session) {
-        sr_session_stop(running_session);
-    }
-
-    return error;
-}
-
 int interfaces_subscription_operational_interfaces_interface_ipv4_address(sr_session_ctx_t* session, uint32_t sub_id, const char* module_name, const char* path, const char* request_xpath, uint32_t request_id, struct lyd_node** parent, void* private_data)
 {
     int error = SR_ERR_OK;
@@ -1364,7 +1203,6 @@ int interfaces_subscription_operational_interfaces_interface_ipv4_address(sr_ses
     interfaces_ctx_t* ctx = private_data;
     interfaces_oper_ctx_t* oper_ctx = &ctx->oper_ctx;
 
-    char xpath_buffer[PATH_MAX] = { 0 };
     char ip_buffer[20] = { 0 };
     char prefix_buffer[20] = { 0 };
 
@@ -1374,6 +1212,8 @@ int interfaces_subscription_operational_interfaces_interface_ipv4_address(sr_ses
     struct rtnl_link* link = NULL;
     struct rtnl_addr* addr_iter = NULL;
     struct nl_addr* local = NULL;
+    struct nl_object* const* objects = NULL;
+    size_t objects_count = 0;
 
     if (*parent == NULL) {
         ly_ctx = sr_acquire_context(sr_session_get_connection(session));
@@ -1387,41 +1227,39 @@ int interfaces_subscription_operational_interfaces_interface_ipv4_address(sr_ses
     assert(*parent != NULL);
     assert(strcmp(LYD_NAME(*parent), "ipv4") == 0);
 
-    // get node xpath
-    SRPC_SAFE_CALL_PTR(error_ptr, lyd_path(*parent, LYD_PATH_STD, xpath_buffer, sizeof(xpath_buffer)), error_out);
-
     // get link
-    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, session, xpath_buffer), error_out);
+    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, request_id, *parent), error_out);
 
-    addr_iter = (struct rtnl_addr*)nl_cache_get_first(oper_ctx->nl_ctx.addr_cache);
+    objects_count = interfaces_object_index_get(&oper_ctx->nl_ctx.addr_index, rtnl_link_get_ifindex(link), AF_INET, &objects);
 
-    while (addr_iter) {
-        if (rtnl_addr_get_ifindex(addr_iter) == rtnl_link_get_ifindex(link) && rtnl_addr_get_family(addr_iter) == AF_INET) {
-            SRPLG_LOG_INF(PLUGIN_NAME, "Found IPv4 address for %s", rtnl_link_get_name(link));
+    for (size_t i = 0; i < objects_count; i++) {
+        addr_iter = (struct rtnl_addr*)objects[i];
 
-            // IP
-            SRPC_SAFE_CALL_PTR(local, rtnl_addr_get_local(addr_iter), error_out);
-            SRPC_SAFE_CALL_PTR(error_ptr, nl_addr2str(local, ip_buffer, sizeof(ip_buffer)), error_out);
+        SRPLG_LOG_INF(PLUGIN_NAME, "Found IPv4 address for %s", rtnl_link_get_name(link));
 
-            // remove prefix from IP
-            char* prefix = strchr(ip_buffer, '/');
-            if (prefix) {
-                *prefix = 0;
-            }
+        // IP
+        SRPC_SAFE_CALL_PTR(local, rtnl_addr_get_local(addr_iter), error_out);
+        SRPC_SAFE_CALL_PTR(error_ptr, nl_addr2str(local, ip_buffer, sizeof(ip_buffer)), error_out);
 
-            // prefix
-            SRPC_SAFE_CALL_ERR_COND(rc, rc < 0, snprintf(prefix_buffer, sizeof(prefix_buffer), "%d", rtnl_addr_get_prefixlen(addr_iter)), error_out);
+        // remove prefix from IP
+        char* prefix = strchr(ip_buffer, '/');
+        if (prefix) {
+            *prefix = 0;
+        }
 
-            SRPLG_LOG_INF(PLUGIN_NAME, "ipv4:address(%s) = %s/%s", rtnl_link_get_name(link), ip_buffer, prefix_buffer);
+        // prefix
+        SRPC_SAFE_CALL_ERR_COND(rc, rc < 0, snprintf(prefix_buffer, sizeof(prefix_buffer), "%d", rtnl_addr_get_prefixlen(addr_iter)), error_out);
 
-            // address from the current link - add to the list
-            SRPC_SAFE_CALL_ERR(error, interfaces_ly_tree_create_interfaces_interface_ipv4_address(ly_ctx, *parent, &address_node, ip_buffer), error_out);
+        SRPLG_LOG_INF(PLUGIN_NAME, "ipv4:address(%s) = %s/%s", rtnl_link_get_name(link), ip_buffer, prefix_buffer);
 
-            // prefix
-            SRPC_SAFE_CALL_ERR(error, interfaces_ly_tree_create_interfaces_interface_ipv4_address_prefix_length(ly_ctx, address_node, prefix_buffer), error_out);
-        }
+        // address from the current link - add to the list
+        SRPC_SAFE_CALL_ERR(error, interfaces_ly_tree_create_interfaces_interface_ipv4_address(ly_ctx, *parent, &address_node, ip_buffer), error_out);
 
-        addr_iter = (struct rtnl_addr*)nl_cache_get_next((struct nl_object*)addr_iter);
+        // prefix
+        SRPC_SAFE_CALL_ERR(error, interfaces_ly_tree_create_interfaces_interface_ipv4_address_prefix_length(ly_ctx, address_node, prefix_buffer), error_out);
+
+        // origin
+        SRPC_SAFE_CALL_ERR(error, interfaces_ly_tree_create_interfaces_interface_ipv4_address_origin(ly_ctx, address_node, interfaces_oper_get_address_origin(addr_iter)), error_out);
     }
 
     goto out;
@@ -1436,12 +1274,10 @@ out:
 int interfaces_subscription_operational_interfaces_interface_ipv4_neighbor_origin(sr_session_ctx_t* session, uint32_t sub_id, const char* module_name, const char* path, const char* request_xpath, uint32_t request_id, struct lyd_node** parent, void* private_data)
 {
     int error = SR_ERR_OK;
-    void* error_ptr = NULL;
 
     interfaces_ctx_t* ctx = private_data;
     interfaces_oper_ctx_t* oper_ctx = &ctx->oper_ctx;
 
-    char xpath_buffer[PATH_MAX] = { 0 };
     char ip_buffer[20] = { 0 };
 
     const struct ly_ctx* ly_ctx = NULL;
@@ -1461,14 +1297,11 @@ int interfaces_subscription_operational_interfaces_interface_ipv4_neighbor_origi
     assert(*parent != NULL);
     assert(strcmp(LYD_NAME(*parent), "neighbor") == 0);
 
-    // get node xpath
-    SRPC_SAFE_CALL_PTR(error_ptr, lyd_path(*parent, LYD_PATH_STD, xpath_buffer, sizeof(xpath_buffer)), error_out);
-
     // get link
-    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, session, xpath_buffer), error_out);
+    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, request_id, *parent), error_out);
 
     // get IP
-    SRPC_SAFE_CALL_ERR(error, interfaces_extract_interface_neighbor_ip(session, xpath_buffer, ip_buffer, sizeof(ip_buffer)), error_out);
+    SRPC_SAFE_CALL_ERR(error, interfaces_extract_interface_neighbor_ip(*parent, ip_buffer, sizeof(ip_buffer)), error_out);
 
     // parse address
     SRPC_SAFE_CALL_ERR(error, nl_addr_parse(ip_buffer, AF_INET, &neigh_addr), error_out);
@@ -1502,7 +1335,6 @@ int interfaces_subscription_operational_interfaces_interface_ipv4_neighbor(sr_se
     interfaces_ctx_t* ctx = private_data;
     interfaces_oper_ctx_t* oper_ctx = &ctx->oper_ctx;
 
-    char xpath_buffer[PATH_MAX] = { 0 };
     char dst_buffer[20] = { 0 };
     char ll_buffer[100] = { 0 };
 
@@ -1512,6 +1344,8 @@ int interfaces_subscription_operational_interfaces_interface_ipv4_neighbor(sr_se
     struct rtnl_link* link = NULL;
     struct rtnl_neigh* neigh_iter = NULL;
     struct nl_addr *dst_addr = NULL, *ll_addr = NULL;
+    struct nl_object* const* objects = NULL;
+    size_t objects_count = 0;
 
     if (*parent == NULL) {
         ly_ctx = sr_acquire_context(sr_session_get_connection(session));
@@ -1525,43 +1359,37 @@ int interfaces_subscription_operational_interfaces_interface_ipv4_neighbor(sr_se
     assert(*parent != NULL);
     assert(strcmp(LYD_NAME(*parent), "ipv4") == 0);
 
-    // get node xpath
-    SRPC_SAFE_CALL_PTR(error_ptr, lyd_path(*parent, LYD_PATH_STD, xpath_buffer, sizeof(xpath_buffer)), error_out);
-
     // get link
-    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, session, xpath_buffer), error_out);
+    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, request_id, *parent), error_out);
 
-    neigh_iter = (struct rtnl_neigh*)nl_cache_get_first(oper_ctx->nl_ctx.neigh_cache);
+    objects_count = interfaces_object_index_get(&oper_ctx->nl_ctx.neigh_index, rtnl_link_get_ifindex(link), AF_INET, &objects);
 
-    while (neigh_iter) {
-        // check for interface IPv4 neighbor
-        if (rtnl_neigh_get_ifindex(neigh_iter) == rtnl_link_get_ifindex(link) && rtnl_neigh_get_family(neigh_iter) == AF_INET) {
-            SRPLG_LOG_INF(PLUGIN_NAME, "Found IPv4 neighbor for %s", rtnl_link_get_name(link));
+    for (size_t i = 0; i < objects_count; i++) {
+        neigh_iter = (struct rtnl_neigh*)objects[i];
 
-            // IP
-            SRPC_SAFE_CALL_PTR(dst_addr, rtnl_neigh_get_dst(neigh_iter), error_out);
-            SRPC_SAFE_CALL_PTR(error_ptr, nl_addr2str(dst_addr, dst_buffer, sizeof(dst_buffer)), error_out);
+        SRPLG_LOG_INF(PLUGIN_NAME, "Found IPv4 neighbor for %s", rtnl_link_get_name(link));
 
-            // link-layer-address
-            SRPC_SAFE_CALL_PTR(ll_addr, rtnl_neigh_get_lladdr(neigh_iter), error_out);
-            SRPC_SAFE_CALL_PTR(error_ptr, nl_addr2str(ll_addr, ll_buffer, sizeof(ll_buffer)), error_out);
+        // IP
+        SRPC_SAFE_CALL_PTR(dst_addr, rtnl_neigh_get_dst(neigh_iter), error_out);
+        SRPC_SAFE_CALL_PTR(error_ptr, nl_addr2str(dst_addr, dst_buffer, sizeof(dst_buffer)), error_out);
 
-            // remove prefix from IP
-            char* prefix = strchr(dst_buffer, '/');
-            if (prefix) {
-                *prefix = 0;
-            }
+        // link-layer-address
+        SRPC_SAFE_CALL_PTR(ll_addr, rtnl_neigh_get_lladdr(neigh_iter), error_out);
+        SRPC_SAFE_CALL_PTR(error_ptr, nl_addr2str(ll_addr, ll_buffer, sizeof(ll_buffer)), error_out);
 
-            SRPLG_LOG_INF(PLUGIN_NAME, "ipv4:neighbor(%s) = %s | %s", rtnl_link_get_name(link), dst_buffer, ll_buffer);
+        // remove prefix from IP
+        char* prefix = strchr(dst_buffer, '/');
+        if (prefix) {
+            *prefix = 0;
+        }
 
-            // neighbor IP
-            SRPC_SAFE_CALL_ERR(error, interfaces_ly_tree_create_interfaces_interface_ipv4_neighbor(ly_ctx, *parent, &address_node, dst_buffer), error_out);
+        SRPLG_LOG_INF(PLUGIN_NAME, "ipv4:neighbor(%s) = %s | %s", rtnl_link_get_name(link), dst_buffer, ll_buffer);
 
-            // link-layer-address
-            SRPC_SAFE_CALL_ERR(error, interfaces_ly_tree_create_interfaces_interface_ipv4_neighbor_link_layer_address(ly_ctx, address_node, ll_buffer), error_out);
-        }
+        // neighbor IP
+        SRPC_SAFE_CALL_ERR(error, interfaces_ly_tree_create_interfaces_interface_ipv4_neighbor(ly_ctx, *parent, &address_node, dst_buffer), error_out);
 
-        neigh_iter = (struct rtnl_neigh*)nl_cache_get_next((struct nl_object*)neigh_iter);
+        // link-layer-address
+        SRPC_SAFE_CALL_ERR(error, interfaces_ly_tree_create_interfaces_interface_ipv4_neighbor_link_layer_address(ly_ctx, address_node, ll_buffer), error_out);
     }
 
     goto out;
@@ -1573,31 +1401,26 @@ out:
     return error;
 }
 
-int interfaces_subscription_operational_interfaces_interface_ipv6_address_origin(sr_session_ctx_t* session, uint32_t sub_id, const char* module_name, const char* path, const char* request_xpath, uint32_t request_id, struct lyd_node** parent, void* private_data)
+int interfaces_subscription_operational_interfaces_interface_ipv6_address(sr_session_ctx_t* session, uint32_t sub_id, const char* module_name, const char* path, const char* request_xpath, uint32_t request_id, struct lyd_node** parent, void* private_data)
 {
     int error = SR_ERR_OK;
     int rc = 0;
     void* error_ptr = NULL;
 
-    sr_session_ctx_t* running_session = NULL;
-    sr_conn_ctx_t* connection = NULL;
-
-    sr_val_t* prefix_length_val = NULL;
-
     interfaces_ctx_t* ctx = private_data;
     interfaces_oper_ctx_t* oper_ctx = &ctx->oper_ctx;
 
-    char xpath_buffer[PATH_MAX] = { 0 };
     char ip_buffer[100] = { 0 };
-    char address_buffer[100] = { 0 };
-
-    char prefix_path_buffer[PATH_MAX] = { 0 };
+    char prefix_buffer[20] = { 0 };
 
     const struct ly_ctx* ly_ctx = NULL;
+    struct lyd_node* address_node = NULL;
 
     struct rtnl_link* link = NULL;
+    struct rtnl_addr* addr_iter = NULL;
     struct nl_addr* local = NULL;
-    struct rtnl_addr* addr = NULL;
+    struct nl_object* const* objects = NULL;
+    size_t objects_count = 0;
 
     if (*parent == NULL) {
         ly_ctx = sr_acquire_context(sr_session_get_connection(session));
@@ -1607,42 +1430,44 @@ int interfaces_subscription_operational_interfaces_interface_ipv6_address_origin
         }
     }
 
-    // connect to the operational DS
-    SRPC_SAFE_CALL_PTR(connection, sr_session_get_connection(session), error_out);
-    SRPC_SAFE_CALL_ERR(error, sr_session_start(connection, SR_DS_RUNNING, &running_session), error_out);
-
+    // there needs to be an allocated link cache in memory
     assert(*parent != NULL);
-    assert(strcmp(LYD_NAME(*parent), "address") == 0);
-
-    // get node xpath
-    SRPC_SAFE_CALL_PTR(error_ptr, lyd_path(*parent, LYD_PATH_STD, xpath_buffer, sizeof(xpath_buffer)), error_out);
+    assert(strcmp(LYD_NAME(*parent), "ipv6") == 0);
 
     // get link
-    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, session, xpath_buffer), error_out);
+    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, request_id, *parent), error_out);
 
-    // get IP
-    SRPC_SAFE_CALL_ERR(error, interfaces_extract_interface_address_ip(session, xpath_buffer, ip_buffer, sizeof(ip_buffer)), error_out);
+    objects_count = interfaces_object_index_get(&oper_ctx->nl_ctx.addr_index, rtnl_link_get_ifindex(link), AF_INET6, &objects);
 
-    // get prefix length from the operational DS
-    SRPC_SAFE_CALL_ERR_COND(rc, rc < 0, snprintf(prefix_path_buffer, sizeof(prefix_path_buffer), "/ietf-interfaces:interfaces/interface[name=\"%s\"]/ietf-ip:ipv6/address[ip=\"%s\"]/prefix-length", rtnl_link_get_name(link), ip_buffer), error_out);
-    SRPC_SAFE_CALL_ERR(error, sr_get_item(running_session, prefix_path_buffer, 0, &prefix_length_val), error_out);
+    for (size_t i = 0; i < objects_count; i++) {
+        addr_iter = (struct rtnl_addr*)objects[i];
 
-    // create an address
-    SRPC_SAFE_CALL_ERR_COND(rc, rc < 0, snprintf(address_buffer, sizeof(address_buffer), "%s/%d", ip_buffer, prefix_length_val->data.uint8_val), error_out);
+        SRPLG_LOG_INF(PLUGIN_NAME, "Found IPv6 address for %s", rtnl_link_get_name(link));
 
-    // parse address
-    SRPC_SAFE_CALL_ERR(error, nl_addr_parse(address_buffer, AF_INET6, &local), error_out);
+        SRPC_SAFE_CALL_PTR(local, rtnl_addr_get_local(addr_iter), error_out);
+        SRPC_SAFE_CALL_PTR(error_ptr, nl_addr2str(local, ip_buffer, sizeof(ip_buffer)), error_out);
+
+        // remove prefix from IP
+        char* prefix = strchr(ip_buffer, '/');
+        if (prefix) {
+            *prefix = 0;
+        }
 
-    // get rtnl address
-    SRPC_SAFE_CALL_PTR(addr, rtnl_addr_get(oper_ctx->nl_ctx.addr_cache, rtnl_link_get_ifindex(link), local), error_out);
+        // prefix
+        SRPC_SAFE_CALL_ERR_COND(rc, rc < 0, snprintf(prefix_buffer, sizeof(prefix_buffer), "%d", rtnl_addr_get_prefixlen(addr_iter)), error_out);
 
-    // get address origin - static or dynamic
-    const char* origin = (rtnl_addr_get_flags(addr) & IFA_F_PERMANENT) > 0 ? "static" : "dhcp";
+        SRPLG_LOG_INF(PLUGIN_NAME, "ipv6:address(%s) = %s/%s", rtnl_link_get_name(link), ip_buffer, prefix_buffer);
 
-    SRPLG_LOG_INF(PLUGIN_NAME, "origin(interface[%s]:address[%s]) = %s", rtnl_link_get_name(link), ip_buffer, origin);
+        // address from the current link - add to the list
+        SRPC_SAFE_CALL_ERR(error, interfaces_ly_tree_create_interfaces_interface_ipv6_address(ly_ctx, *parent, &address_node, ip_buffer), error_out);
 
-    // add origin
-    SRPC_SAFE_CALL_ERR(error, interfaces_ly_tree_create_interfaces_interface_ipv6_address_origin(ly_ctx, *parent, origin), error_out);
+        // prefix
+        SRPC_SAFE_CALL_ERR(error, interfaces_ly_tree_create_interfaces_interface_ipv6_address_prefix_length(ly_ctx, address_node, prefix_buffer), error_out);
+
+        // origin and status
+        SRPC_SAFE_CALL_ERR(error, interfaces_ly_tree_create_interfaces_interface_ipv6_address_origin(ly_ctx, address_node, interfaces_oper_get_address_origin(addr_iter)), error_out);
+        SRPC_SAFE_CALL_ERR(error, interfaces_ly_tree_create_interfaces_interface_ipv6_address_status(ly_ctx, address_node, interfaces_oper_get_ipv6_address_status(addr_iter)), error_out);
+    }
 
     goto out;
 
@@ -1650,38 +1475,23 @@ error_out:
     error = SR_ERR_CALLBACK_FAILED;
 
 out:
-    if (running_session) {
-        sr_session_stop(running_session);
-    }
-
     return error;
 }
 
-int interfaces_subscription_operational_interfaces_interface_ipv6_address_status(sr_session_ctx_t* session, uint32_t sub_id, const char* module_name, const char* path, const char* request_xpath, uint32_t request_id, struct lyd_node** parent, void* private_data)
+int interfaces_subscription_operational_interfaces_interface_ipv6_neighbor_origin(sr_session_ctx_t* session, uint32_t sub_id, const char* module_name, const char* path, const char* request_xpath, uint32_t request_id, struct lyd_node** parent, void* private_data)
 {
     int error = SR_ERR_OK;
-    int rc = 0;
-    void* error_ptr = NULL;
-
-    sr_session_ctx_t* running_session = NULL;
-    sr_conn_ctx_t* connection = NULL;
-
-    sr_val_t* prefix_length_val = NULL;
 
     interfaces_ctx_t* ctx = private_data;
     interfaces_oper_ctx_t* oper_ctx = &ctx->oper_ctx;
 
-    char xpath_buffer[PATH_MAX] = { 0 };
     char ip_buffer[100] = { 0 };
-    char address_buffer[100] = { 0 };
-
-    char prefix_path_buffer[PATH_MAX] = { 0 };
 
     const struct ly_ctx* ly_ctx = NULL;
 
     struct rtnl_link* link = NULL;
-    struct nl_addr* local = NULL;
-    struct rtnl_addr* addr = NULL;
+    struct rtnl_neigh* neigh = NULL;
+    struct nl_addr* neigh_addr = NULL;
 
     if (*parent == NULL) {
         ly_ctx = sr_acquire_context(sr_session_get_connection(session));
@@ -1691,42 +1501,28 @@ int interfaces_subscription_operational_interfaces_interface_ipv6_address_status
         }
     }
 
-    // connect to the operational DS
-    SRPC_SAFE_CALL_PTR(connection, sr_session_get_connection(session), error_out);
-    SRPC_SAFE_CALL_ERR(error, sr_session_start(connection, SR_DS_RUNNING, &running_session), error_out);
-
     assert(*parent != NULL);
-    assert(strcmp(LYD_NAME(*parent), "address") == 0);
-
-    // get node xpath
-    SRPC_SAFE_CALL_PTR(error_ptr, lyd_path(*parent, LYD_PATH_STD, xpath_buffer, sizeof(xpath_buffer)), error_out);
+    assert(strcmp(LYD_NAME(*parent), "neighbor") == 0);
 
     // get link
-    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, session, xpath_buffer), error_out);
+    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, request_id, *parent), error_out);
 
     // get IP
-    SRPC_SAFE_CALL_ERR(error, interfaces_extract_interface_address_ip(session, xpath_buffer, ip_buffer, sizeof(ip_buffer)), error_out);
-
-    // get prefix length from the operational DS
-    SRPC_SAFE_CALL_ERR_COND(rc, rc < 0, snprintf(prefix_path_buffer, sizeof(prefix_path_buffer), "/ietf-interfaces:interfaces/interface[name=\"%s\"]/ietf-ip:ipv6/address[ip=\"%s\"]/prefix-length", rtnl_link_get_name(link), ip_buffer), error_out);
-    SRPC_SAFE_CALL_ERR(error, sr_get_item(running_session, prefix_path_buffer, 0, &prefix_length_val), error_out);
-
-    // create an address
-    SRPC_SAFE_CALL_ERR_COND(rc, rc < 0, snprintf(address_buffer, sizeof(address_buffer), "%s/%d", ip_buffer, prefix_length_val->data.uint8_val), error_out);
+    SRPC_SAFE_CALL_ERR(error, interfaces_extract_interface_neighbor_ip(*parent, ip_buffer, sizeof(ip_buffer)), error_out);
 
     // parse address
-    SRPC_SAFE_CALL_ERR(error, nl_addr_parse(address_buffer, AF_INET6, &local), error_out);
+    SRPC_SAFE_CALL_ERR(error, nl_addr_parse(ip_buffer, AF_INET6, &neigh_addr), error_out);
 
-    // get rtnl address
-    SRPC_SAFE_CALL_PTR(addr, rtnl_addr_get(oper_ctx->nl_ctx.addr_cache, rtnl_link_get_ifindex(link), local), error_out);
+    // get neighbor
+    SRPC_SAFE_CALL_PTR(neigh, rtnl_neigh_get(oper_ctx->nl_ctx.neigh_cache, rtnl_link_get_ifindex(link), neigh_addr), error_out);
 
-    // get address status
-    const char* status = "preferred";
+    // get address origin - static or dynamic
+    const char* origin = (rtnl_neigh_get_flags(neigh) & NTF_ROUTER) > 0 ? "dynamic" : "static";
 
-    SRPLG_LOG_INF(PLUGIN_NAME, "status(interface[%s]:address[%s]) = %s", rtnl_link_get_name(link), ip_buffer, status);
+    SRPLG_LOG_INF(PLUGIN_NAME, "origin(interface[%s]:neighbor[%s]) = %s", rtnl_link_get_name(link), ip_buffer, origin);
 
     // add origin
-    SRPC_SAFE_CALL_ERR(error, interfaces_ly_tree_create_interfaces_interface_ipv6_address_status(ly_ctx, *parent, status), error_out);
+    SRPC_SAFE_CALL_ERR(error, interfaces_ly_tree_create_interfaces_interface_ipv6_neighbor_origin(ly_ctx, *parent, origin), error_out);
 
     goto out;
 
@@ -1734,32 +1530,24 @@ error_out:
     error = SR_ERR_CALLBACK_FAILED;
 
 out:
-    if (running_session) {
-        sr_session_stop(running_session);
-    }
 
     return error;
 }
 
-int interfaces_subscription_operational_interfaces_interface_ipv6_address(sr_session_ctx_t* session, uint32_t sub_id, const char* module_name, const char* path, const char* request_xpath, uint32_t request_id, struct lyd_node** parent, void* private_data)
+int interfaces_subscription_operational_interfaces_interface_ipv6_neighbor_is_router(sr_session_ctx_t* session, uint32_t sub_id, const char* module_name, const char* path, const char* request_xpath, uint32_t request_id, struct lyd_node** parent, void* private_data)
 {
     int error = SR_ERR_OK;
-    int rc = 0;
-    void* error_ptr = NULL;
 
     interfaces_ctx_t* ctx = private_data;
     interfaces_oper_ctx_t* oper_ctx = &ctx->oper_ctx;
 
-    char xpath_buffer[PATH_MAX] = { 0 };
     char ip_buffer[100] = { 0 };
-    char prefix_buffer[20] = { 0 };
 
     const struct ly_ctx* ly_ctx = NULL;
-    struct lyd_node* address_node = NULL;
 
     struct rtnl_link* link = NULL;
-    struct rtnl_addr* addr_iter = NULL;
-    struct nl_addr* local = NULL;
+    struct rtnl_neigh* neigh = NULL;
+    struct nl_addr* neigh_addr = NULL;
 
     if (*parent == NULL) {
         ly_ctx = sr_acquire_context(sr_session_get_connection(session));
@@ -1769,44 +1557,29 @@ int interfaces_subscription_operational_interfaces_interface_ipv6_address(sr_ses
         }
     }
 
-    // there needs to be an allocated link cache in memory
     assert(*parent != NULL);
-    assert(strcmp(LYD_NAME(*parent), "ipv6") == 0);
-
-    // get node xpath
-    SRPC_SAFE_CALL_PTR(error_ptr, lyd_path(*parent, LYD_PATH_STD, xpath_buffer, sizeof(xpath_buffer)), error_out);
+    assert(strcmp(LYD_NAME(*parent), "neighbor") == 0);
 
     // get link
-    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, session, xpath_buffer), error_out);
-
-    addr_iter = (struct rtnl_addr*)nl_cache_get_first(oper_ctx->nl_ctx.addr_cache);
+    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, request_id, *parent), error_out);
 
-    while (addr_iter) {
-        if (rtnl_addr_get_ifindex(addr_iter) == rtnl_link_get_ifindex(link) && rtnl_addr_get_family(addr_iter) == AF_INET6) {
-            SRPLG_LOG_INF(PLUGIN_NAME, "Found IPv6 address for %s", rtnl_link_get_name(link));
-
-            SRPC_SAFE_CALL_PTR(local, rtnl_addr_get_local(addr_iter), error_out);
-            SRPC_SAFE_CALL_PTR(error_ptr, nl_addr2str(local, ip_buffer, sizeof(ip_buffer)), error_out);
-
-            // remove prefix from IP
-            char* prefix = strchr(ip_buffer, '/');
-            if (prefix) {
-                *prefix = 0;
-            }
+    // get IP
+    SRPC_SAFE_CALL_ERR(error, interfaces_extract_interface_neighbor_ip(*parent, ip_buffer, sizeof(ip_buffer)), error_out);
 
-            // prefix
-            SRPC_SAFE_CALL_ERR_COND(rc, rc < 0, snprintf(prefix_buffer, sizeof(prefix_buffer), "%d", rtnl_addr_get_prefixlen(addr_iter)), error_out);
+    // parse address
+    SRPC_SAFE_CALL_ERR(error, nl_addr_parse(ip_buffer, AF_INET6, &neigh_addr), error_out);
 
-            SRPLG_LOG_INF(PLUGIN_NAME, "ipv6:address(%s) = %s/%s", rtnl_link_get_name(link), ip_buffer, prefix_buffer);
+    // get neighbor
+    SRPC_SAFE_CALL_PTR(neigh, rtnl_neigh_get(oper_ctx->nl_ctx.neigh_cache, rtnl_link_get_ifindex(link), neigh_addr), error_out);
 
-            // address from the current link - add to the list
-            SRPC_SAFE_CALL_ERR(error, interfaces_ly_tree_create_interfaces_interface_ipv6_address(ly_ctx, *parent, &address_node, ip_buffer), error_out);
+    // check if is-router
+    const bool is_router = (rtnl_neigh_get_flags(neigh) & NTF_ROUTER) > 0;
 
-            // prefix
-            SRPC_SAFE_CALL_ERR(error, interfaces_ly_tree_create_interfaces_interface_ipv6_address_prefix_length(ly_ctx, address_node, prefix_buffer), error_out);
-        }
+    SRPLG_LOG_INF(PLUGIN_NAME, "is-router(interface[%s]:neighbor[%s]) = %s", rtnl_link_get_name(link), ip_buffer, is_router ? "true" : "false");
 
-        addr_iter = (struct rtnl_addr*)nl_cache_get_next((struct nl_object*)addr_iter);
+    // add is-router
+    if (is_router) {
+        SRPC_SAFE_CALL_ERR(error, interfaces_ly_tree_create_interfaces_interface_ipv6_neighbor_is_router(ly_ctx, *parent, ""), error_out);
     }
 
     goto out;
@@ -1815,18 +1588,17 @@ error_out:
     error = SR_ERR_CALLBACK_FAILED;
 
 out:
+
     return error;
 }
 
-int interfaces_subscription_operational_interfaces_interface_ipv6_neighbor_origin(sr_session_ctx_t* session, uint32_t sub_id, const char* module_name, const char* path, const char* request_xpath, uint32_t request_id, struct lyd_node** parent, void* private_data)
+int interfaces_subscription_operational_interfaces_interface_ipv6_neighbor_state(sr_session_ctx_t* session, uint32_t sub_id, const char* module_name, const char* path, const char* request_xpath, uint32_t request_id, struct lyd_node** parent, void* private_data)
 {
     int error = SR_ERR_OK;
-    void* error_ptr = NULL;
 
     interfaces_ctx_t* ctx = private_data;
     interfaces_oper_ctx_t* oper_ctx = &ctx->oper_ctx;
 
-    char xpath_buffer[PATH_MAX] = { 0 };
     char ip_buffer[100] = { 0 };
 
     const struct ly_ctx* ly_ctx = NULL;
@@ -1843,17 +1615,25 @@ int interfaces_subscription_operational_interfaces_interface_ipv6_neighbor_origi
         }
     }
 
+    const char* state_map[] = {
+        [NUD_INCOMPLETE] = "incomplete",
+        [NUD_REACHABLE] = "reachable",
+        [NUD_STALE] = "stale",
+        [NUD_DELAY] = "delay",
+        [NUD_PROBE] = "probe",
+        [NUD_FAILED] = "failed",
+        [NUD_NOARP] = "noarp",
+        [NUD_PERMANENT] = "permanent",
+    };
+
     assert(*parent != NULL);
     assert(strcmp(LYD_NAME(*parent), "neighbor") == 0);
 
-    // get node xpath
-    SRPC_SAFE_CALL_PTR(error_ptr, lyd_path(*parent, LYD_PATH_STD, xpath_buffer, sizeof(xpath_buffer)), error_out);
-
     // get link
-    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, session, xpath_buffer), error_out);
+    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, request_id, *parent), error_out);
 
     // get IP
-    SRPC_SAFE_CALL_ERR(error, interfaces_extract_interface_neighbor_ip(session, xpath_buffer, ip_buffer, sizeof(ip_buffer)), error_out);
+    SRPC_SAFE_CALL_ERR(error, interfaces_extract_interface_neighbor_ip(*parent, ip_buffer, sizeof(ip_buffer)), error_out);
 
     // parse address
     SRPC_SAFE_CALL_ERR(error, nl_addr_parse(ip_buffer, AF_INET6, &neigh_addr), error_out);
@@ -1861,13 +1641,15 @@ int interfaces_subscription_operational_interfaces_interface_ipv6_neighbor_origi
     // get neighbor
     SRPC_SAFE_CALL_PTR(neigh, rtnl_neigh_get(oper_ctx->nl_ctx.neigh_cache, rtnl_link_get_ifindex(link), neigh_addr), error_out);
 
-    // get address origin - static or dynamic
-    const char* origin = (rtnl_neigh_get_flags(neigh) & NTF_ROUTER) > 0 ? "dynamic" : "static";
+    // get neighbor state - static or dynamic
+    const char* state = state_map[rtnl_neigh_get_state(neigh)];
 
-    SRPLG_LOG_INF(PLUGIN_NAME, "origin(interface[%s]:neighbor[%s]) = %s", rtnl_link_get_name(link), ip_buffer, origin);
+    SRPLG_LOG_INF(PLUGIN_NAME, "state(interface[%s]:neighbor[%s]) = %s", rtnl_link_get_name(link), ip_buffer, state);
 
-    // add origin
-    SRPC_SAFE_CALL_ERR(error, interfaces_ly_tree_create_interfaces_interface_ipv6_neighbor_origin(ly_ctx, *parent, origin), error_out);
+    if (rtnl_neigh_get_state(neigh) != NUD_FAILED && rtnl_neigh_get_state(neigh) != NUD_NOARP && rtnl_neigh_get_state(neigh) != NUD_PERMANENT) {
+        // add state
+        SRPC_SAFE_CALL_ERR(error, interfaces_ly_tree_create_interfaces_interface_ipv6_neighbor_state(ly_ctx, *parent, state), error_out);
+    }
 
     goto out;
 
@@ -1879,7 +1661,7 @@ out:
     return error;
 }
 
-int interfaces_subscription_operational_interfaces_interface_ipv6_neighbor_is_router(sr_session_ctx_t* session, uint32_t sub_id, const char* module_name, const char* path, const char* request_xpath, uint32_t request_id, struct lyd_node** parent, void* private_data)
+int interfaces_subscription_operational_interfaces_interface_ipv6_neighbor(sr_session_ctx_t* session, uint32_t sub_id, const char* module_name, const char* path, const char* request_xpath, uint32_t request_id, struct lyd_node** parent, void* private_data)
 {
     int error = SR_ERR_OK;
     void* error_ptr = NULL;
@@ -1887,14 +1669,17 @@ int interfaces_subscription_operational_interfaces_interface_ipv6_neighbor_is_ro
     interfaces_ctx_t* ctx = private_data;
     interfaces_oper_ctx_t* oper_ctx = &ctx->oper_ctx;
 
-    char xpath_buffer[PATH_MAX] = { 0 };
-    char ip_buffer[100] = { 0 };
+    char dst_buffer[100] = { 0 };
+    char ll_buffer[100] = { 0 };
 
     const struct ly_ctx* ly_ctx = NULL;
+    struct lyd_node* address_node = NULL;
 
     struct rtnl_link* link = NULL;
-    struct rtnl_neigh* neigh = NULL;
-    struct nl_addr* neigh_addr = NULL;
+    struct rtnl_neigh* neigh_iter = NULL;
+    struct nl_addr *dst_addr = NULL, *ll_addr = NULL;
+    struct nl_object* const* objects = NULL;
+    size_t objects_count = 0;
 
     if (*parent == NULL) {
         ly_ctx = sr_acquire_context(sr_session_get_connection(session));
@@ -1904,32 +1689,41 @@ int interfaces_subscription_operational_interfaces_interface_ipv6_neighbor_is_ro
         }
     }
 
+    // there needs to be an allocated link cache in memory
     assert(*parent != NULL);
-    assert(strcmp(LYD_NAME(*parent), "neighbor") == 0);
-
-    // get node xpath
-    SRPC_SAFE_CALL_PTR(error_ptr, lyd_path(*parent, LYD_PATH_STD, xpath_buffer, sizeof(xpath_buffer)), error_out);
+    assert(strcmp(LYD_NAME(*parent), "ipv6") == 0);
 
     // get link
-    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, session, xpath_buffer), error_out);
+    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, request_id, *parent), error_out);
 
-    // get IP
-    SRPC_SAFE_CALL_ERR(error, interfaces_extract_interface_neighbor_ip(session, xpath_buffer, ip_buffer, sizeof(ip_buffer)), error_out);
+    objects_count = interfaces_object_index_get(&oper_ctx->nl_ctx.neigh_index, rtnl_link_get_ifindex(link), AF_INET6, &objects);
 
-    // parse address
-    SRPC_SAFE_CALL_ERR(error, nl_addr_parse(ip_buffer, AF_INET6, &neigh_addr), error_out);
+    for (size_t i = 0; i < objects_count; i++) {
+        neigh_iter = (struct rtnl_neigh*)objects[i];
 
-    // get neighbor
-    SRPC_SAFE_CALL_PTR(neigh, rtnl_neigh_get(oper_ctx->nl_ctx.neigh_cache, rtnl_link_get_ifindex(link), neigh_addr), error_out);
+        SRPLG_LOG_INF(PLUGIN_NAME, "Found IPv6 neighbor for %s", rtnl_link_get_name(link));
 
-    // check if is-router
-    const bool is_router = (rtnl_neigh_get_flags(neigh) & NTF_ROUTER) > 0;
+        // IP
+        SRPC_SAFE_CALL_PTR(dst_addr, rtnl_neigh_get_dst(neigh_iter), error_out);
+        SRPC_SAFE_CALL_PTR(error_ptr, nl_addr2str(dst_addr, dst_buffer, sizeof(dst_buffer)), error_out);
 
-    SRPLG_LOG_INF(PLUGIN_NAME, "is-router(interface[%s]:neighbor[%s]) = %s", rtnl_link_get_name(link), ip_buffer, is_router ? "true" : "false");
+        // link-layer-address
+        SRPC_SAFE_CALL_PTR(ll_addr, rtnl_neigh_get_lladdr(neigh_iter), error_out);
+        SRPC_SAFE_CALL_PTR(error_ptr, nl_addr2str(ll_addr, ll_buffer, sizeof(ll_buffer)), error_out);
 
-    // add is-router
-    if (is_router) {
-        SRPC_SAFE_CALL_ERR(error, interfaces_ly_tree_create_interfaces_interface_ipv6_neighbor_is_router(ly_ctx, *parent, ""), error_out);
+        // remove prefix from IP
+        char* prefix = strchr(dst_buffer, '/');
+        if (prefix) {
+            *prefix = 0;
+        }
+
+        SRPLG_LOG_INF(PLUGIN_NAME, "ipv6:neighbor(%s) = %s | %s", rtnl_link_get_name(link), dst_buffer, ll_buffer);
+
+        // neighbor IP
+        SRPC_SAFE_CALL_ERR(error, interfaces_ly_tree_create_interfaces_interface_ipv6_neighbor(ly_ctx, *parent, &address_node, dst_buffer), error_out);
+
+        // link-layer-address
+        SRPC_SAFE_CALL_ERR(error, interfaces_ly_tree_create_interfaces_interface_ipv6_neighbor_link_layer_address(ly_ctx, address_node, ll_buffer), error_out);
     }
 
     goto out;
@@ -1938,26 +1732,42 @@ error_out:
     error = SR_ERR_CALLBACK_FAILED;
 
 out:
-
     return error;
 }
 
-int interfaces_subscription_operational_interfaces_interface_ipv6_neighbor_state(sr_session_ctx_t* session, uint32_t sub_id, const char* module_name, const char* path, const char* request_xpath, uint32_t request_id, struct lyd_node** parent, void* private_data)
+int interfaces_subscription_operational_interfaces_interface(sr_session_ctx_t* session, uint32_t sub_id, const char* module_name, const char* path, const char* request_xpath, uint32_t request_id, struct lyd_node** parent, void* private_data)
 {
     int error = SR_ERR_OK;
-    void* error_ptr = NULL;
-
+    // void* error_ptr = NULL;
+    const struct ly_ctx* ly_ctx = NULL;
     interfaces_ctx_t* ctx = private_data;
-    interfaces_oper_ctx_t* oper_ctx = &ctx->oper_ctx;
+    interfaces_nl_ctx_t* nl_ctx = &ctx->oper_ctx.nl_ctx;
+    interfaces_oper_request_ctx_t* request = NULL;
+    struct rtnl_link* link_iter = NULL;
 
-    char xpath_buffer[PATH_MAX] = { 0 };
-    char ip_buffer[100] = { 0 };
+    // libyang
+    struct lyd_node* interface_list_node = NULL;
+    struct lyd_node* statistics_node = NULL;
+    struct lyd_node* ipv4_node = NULL;
+    struct lyd_node* ipv6_node = NULL;
 
-    const struct ly_ctx* ly_ctx = NULL;
+    // requested interface - NULL if all interfaces are requested
+    char name_buffer[100] = { 0 };
+    const char* requested_name = NULL;
 
-    struct rtnl_link* link = NULL;
-    struct rtnl_neigh* neigh = NULL;
-    struct nl_addr* neigh_addr = NULL;
+    // bulk mode data
+    char discontinuity_time_buffer[100] = { 0 };
+    interfaces_oper_bulk_node_t* nodes = NULL;
+    interfaces_oper_bulk_node_t* nodes_hash = NULL;
+    size_t nodes_count = 0;
+
+    // first callback of a request - lookups of finished requests are released
+    SRPC_SAFE_CALL_PTR(request, interfaces_oper_request_get(&ctx->oper_ctx, request_id), error_out);
+    request->interface_node = NULL;
+    request->link = NULL;
+
+    // bring the link, address and neighbor caches up to date
+    SRPC_SAFE_CALL_ERR(error, interfaces_oper_cache_sync(&ctx->oper_ctx), error_out);
 
     if (*parent == NULL) {
         ly_ctx = sr_acquire_context(sr_session_get_connection(session));
@@ -1965,107 +1775,362 @@ int interfaces_subscription_operational_interfaces_interface_ipv6_neighbor_state
             SRPLG_LOG_ERR(PLUGIN_NAME, "sr_acquire_context() failed");
             goto error_out;
         }
+
+        // set parent to the interfaces container
+        SRPC_SAFE_CALL_ERR(error, interfaces_ly_tree_create_interfaces(ly_ctx, parent), error_out);
     }
 
-    const char* state_map[] = {
-        [NUD_INCOMPLETE] = "incomplete",
-        [NUD_REACHABLE] = "reachable",
-        [NUD_STALE] = "stale",
-        [NUD_DELAY] = "delay",
-        [NUD_PROBE] = "probe",
-        [NUD_FAILED] = "failed",
-        [NUD_NOARP] = "noarp",
-        [NUD_PERMANENT] = "permanent",
-    };
+    // narrow requests only need a single interface
+    if (request_xpath && interfaces_extract_request_interface_name(request_xpath, name_buffer, sizeof(name_buffer)) == 0) {
+        requested_name = name_buffer;
+    }
 
-    assert(*parent != NULL);
-    assert(strcmp(LYD_NAME(*parent), "neighbor") == 0);
+    if (ctx->oper_ctx.bulk_mode) {
+        // one node entry for every link in the cache
+        nodes_count = (size_t)nl_cache_nitems(nl_ctx->link_cache);
+        if (nodes_count > 0) {
+            SRPC_SAFE_CALL_PTR(nodes, calloc(nodes_count, sizeof(*nodes)), error_out);
+        }
 
-    // get node xpath
-    SRPC_SAFE_CALL_PTR(error_ptr, lyd_path(*parent, LYD_PATH_STD, xpath_buffer, sizeof(xpath_buffer)), error_out);
+        // boot time is the same discontinuity time for all interfaces
+        SRPC_SAFE_CALL_ERR(error, interfaces_get_system_boot_time(discontinuity_time_buffer, sizeof(discontinuity_time_buffer)), error_out);
+    }
 
-    // get link
-    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, session, xpath_buffer), error_out);
+    // iterate links and add them to the operational DS
+    link_iter = (struct rtnl_link*)nl_cache_get_first(nl_ctx->link_cache);
+    for (size_t i = 0; link_iter; link_iter = (struct rtnl_link*)nl_cache_get_next((struct nl_object*)link_iter), i++) {
+        if (requested_name && strcmp(requested_name, rtnl_link_get_name(link_iter))) {
+            continue;
+        }
 
-    // get IP
-    SRPC_SAFE_CALL_ERR(error, interfaces_extract_interface_neighbor_ip(session, xpath_buffer, ip_buffer, sizeof(ip_buffer)), error_out);
+        // add interface
+        SRPC_SAFE_CALL_ERR(error, interfaces_ly_tree_create_interfaces_interface(ly_ctx, *parent, &interface_list_node, rtnl_link_get_name(link_iter)), error_out);
 
-    // parse address
-    SRPC_SAFE_CALL_ERR(error, nl_addr_parse(ip_buffer, AF_INET6, &neigh_addr), error_out);
+        // create needed containers for the interface
+        SRPC_SAFE_CALL_ERR(error, interfaces_ly_tree_create_interfaces_interface_statistics(ly_ctx, interface_list_node, &statistics_node), error_out);
+        SRPC_SAFE_CALL_ERR(error, interfaces_ly_tree_create_interfaces_interface_ipv4(ly_ctx, interface_list_node, &ipv4_node), error_out);
+        SRPC_SAFE_CALL_ERR(error, interfaces_ly_tree_create_interfaces_interface_ipv6(ly_ctx, interface_list_node, &ipv6_node), error_out);
+
+        if (ctx->oper_ctx.bulk_mode && i < nodes_count) {
+            // remember created nodes for filling address, neighbor and layer data
+            nodes[i].ifindex = rtnl_link_get_ifindex(link_iter);
+            nodes[i].interface_node = interface_list_node;
+            nodes[i].ipv4_node = ipv4_node;
+            nodes[i].ipv6_node = ipv6_node;
+            HASH_ADD_INT(nodes_hash, ifindex, &nodes[i]);
+
+            // link data
+            SRPC_SAFE_CALL_ERR(error, interfaces_oper_bulk_fill_interface(ctx, link_iter, interface_list_node), error_out);
+            SRPC_SAFE_CALL_ERR(error, interfaces_oper_bulk_fill_statistics(link_iter, statistics_node, discontinuity_time_buffer), error_out);
+        }
+    }
 
-    // get neighbor
-    SRPC_SAFE_CALL_PTR(neigh, rtnl_neigh_get(oper_ctx->nl_ctx.neigh_cache, rtnl_link_get_ifindex(link), neigh_addr), error_out);
+    if (ctx->oper_ctx.bulk_mode) {
+        // single walk over the link, address and neighbor caches
+        SRPC_SAFE_CALL_ERR(error, interfaces_oper_bulk_fill_layers(nl_ctx, nodes_hash), error_out);
+        SRPC_SAFE_CALL_ERR(error, interfaces_oper_bulk_fill_addresses(nl_ctx, nodes_hash), error_out);
+        SRPC_SAFE_CALL_ERR(error, interfaces_oper_bulk_fill_neighbors(nl_ctx, nodes_hash), error_out);
+    }
 
-    // get neighbor state - static or dynamic
-    const char* state = state_map[rtnl_neigh_get_state(neigh)];
+    goto out;
 
-    SRPLG_LOG_INF(PLUGIN_NAME, "state(interface[%s]:neighbor[%s]) = %s", rtnl_link_get_name(link), ip_buffer, state);
+error_out:
+    error = SR_ERR_CALLBACK_FAILED;
 
-    if (rtnl_neigh_get_state(neigh) != NUD_FAILED && rtnl_neigh_get_state(neigh) != NUD_NOARP && rtnl_neigh_get_state(neigh) != NUD_PERMANENT) {
-        // add state
-        SRPC_SAFE_CALL_ERR(error, interfaces_ly_tree_create_interfaces_interface_ipv6_neighbor_state(ly_ctx, *parent, state), error_out);
+out:
+    HASH_CLEAR(hh, nodes_hash);
+    if (nodes) {
+        free(nodes);
+    }
+
+    // bulk mode requests end with this callback
+    if (request && ctx->oper_ctx.bulk_mode) {
+        HASH_DEL(ctx->oper_ctx.requests, request);
+        free(request);
+    }
+
+    return error;
+}
+
+static int interfaces_oper_bulk_fill_interface(interfaces_ctx_t* ctx, struct rtnl_link* link, struct lyd_node* interface_node)
+{
+    int error = 0;
+
+    // context
+    const struct ly_ctx* ly_ctx = NULL;
+    interfaces_state_changes_ctx_t* state_ctx = &ctx->oper_ctx.state_changes_ctx;
+    time_t last_change = 0;
+    const bool if_mib = srpc_feature_status_hash_check(ctx->features.ietf_interfaces_features, "if-mib");
+
+    // buffers
+    char buffer[100] = { 0 };
+
+    // libnl
+    struct nl_addr* phys_addr = NULL;
+    struct rtnl_qdisc* qdisc = NULL;
+    struct rtnl_tc* tc = NULL;
+
+    const char* operstate_map[] = {
+        [IF_OPER_UNKNOWN] = "unknown",
+        [IF_OPER_NOTPRESENT] = "not-present",
+        [IF_OPER_DOWN] = "down",
+        [IF_OPER_LOWERLAYERDOWN] = "lower-layer-down",
+        [IF_OPER_TESTING] = "testing",
+        [IF_OPER_DORMANT] = "dormant",
+        [IF_OPER_UP] = "up",
+    };
+
+    const char* link_name = rtnl_link_get_name(link);
+    const unsigned int flags = rtnl_link_get_flags(link);
+    const uint8_t oper_status = rtnl_link_get_operstate(link);
+
+    // admin-status and if-index depend on the if-mib feature
+    if (if_mib) {
+        SRPC_SAFE_CALL_ERR(error, interfaces_ly_tree_create_interfaces_interface_admin_status(ly_ctx, interface_node, (flags & IFF_UP) || (flags & IFF_RUNNING) ? "up" : "down"), error_out);
+
+        SRPC_SAFE_CALL_ERR_COND(error, error < 0, snprintf(buffer, sizeof(buffer), "%d", rtnl_link_get_ifindex(link)), error_out);
+        SRPC_SAFE_CALL_ERR(error, interfaces_ly_tree_create_interfaces_interface_if_index(ly_ctx, interface_node, buffer), error_out);
+    }
+
+    // oper-status
+    SRPC_SAFE_CALL_ERR(error, interfaces_ly_tree_create_interfaces_interface_oper_status(ly_ctx, interface_node, oper_status < ARRAY_SIZE(operstate_map) ? operstate_map[oper_status] : "unknown"), error_out);
+
+    // last-change
+    if (interfaces_interface_state_table_get(&state_ctx->state_table, link_name, NULL, &last_change) == 0 && strftime(buffer, sizeof(buffer), "%FT%TZ", localtime(&last_change)) > 0) {
+        SRPC_SAFE_CALL_ERR(error, interfaces_ly_tree_create_interfaces_interface_last_change(ly_ctx, interface_node, buffer), error_out);
+    }
+
+    // phys-address
+    phys_addr = rtnl_link_get_addr(link);
+    if (phys_addr && nl_addr2str(phys_addr, buffer, sizeof(buffer))) {
+        SRPC_SAFE_CALL_ERR(error, interfaces_ly_tree_create_interfaces_interface_phys_address(ly_ctx, interface_node, buffer), error_out);
     }
 
+    // speed
+    SRPC_SAFE_CALL_PTR(qdisc, rtnl_qdisc_alloc(), error_out);
+    tc = TC_CAST(qdisc);
+    rtnl_tc_set_link(tc, link);
+
+    SRPC_SAFE_CALL_ERR_COND(error, error < 0, snprintf(buffer, sizeof(buffer), "%lu", rtnl_tc_get_stat(tc, RTNL_TC_RATE_BPS)), error_out);
+    SRPC_SAFE_CALL_ERR(error, interfaces_ly_tree_create_interfaces_interface_speed(ly_ctx, interface_node, buffer), error_out);
+
+    SRPLG_LOG_DBG(PLUGIN_NAME, "bulk: interface %s filled", link_name);
+
+    error = 0;
     goto out;
 
 error_out:
-    error = SR_ERR_CALLBACK_FAILED;
+    error = -1;
 
 out:
+    if (qdisc) {
+        rtnl_qdisc_put(qdisc);
+    }
 
     return error;
 }
 
-int interfaces_subscription_operational_interfaces_interface_ipv6_neighbor(sr_session_ctx_t* session, uint32_t sub_id, const char* module_name, const char* path, const char* request_xpath, uint32_t request_id, struct lyd_node** parent, void* private_data)
+static int interfaces_oper_bulk_fill_statistics(struct rtnl_link* link, struct lyd_node* statistics_node, const char* discontinuity_time)
 {
-    int error = SR_ERR_OK;
-    void* error_ptr = NULL;
+    int error = 0;
 
-    interfaces_ctx_t* ctx = private_data;
-    interfaces_oper_ctx_t* oper_ctx = &ctx->oper_ctx;
+    const struct ly_ctx* ly_ctx = NULL;
+    char counter_buffer[100] = { 0 };
 
-    char xpath_buffer[PATH_MAX] = { 0 };
-    char dst_buffer[100] = { 0 };
-    char ll_buffer[100] = { 0 };
+    const uint64_t in_pkts = rtnl_link_get_stat(link, RTNL_LINK_RX_PACKETS);
+    const uint64_t in_broadcast_pkts = rtnl_link_get_stat(link, RTNL_LINK_IP6_INBCASTPKTS);
+    const uint64_t in_multicast_pkts = rtnl_link_get_stat(link, RTNL_LINK_IP6_INMCASTPKTS);
+    const uint64_t out_pkts = rtnl_link_get_stat(link, RTNL_LINK_TX_PACKETS);
+    const uint64_t out_broadcast_pkts = rtnl_link_get_stat(link, RTNL_LINK_IP6_OUTBCASTPKTS);
+    const uint64_t out_multicast_pkts = rtnl_link_get_stat(link, RTNL_LINK_IP6_OUTMCASTPKTS);
+
+    // counter32 leafs are truncated the same way as in the per-leaf callbacks
+    const struct {
+        int (*create)(const struct ly_ctx* ly_ctx, struct lyd_node* statistics_node, const char* value);
+        uint64_t value;
+    } counters[] = {
+        { interfaces_ly_tree_create_interfaces_interface_statistics_in_octets, rtnl_link_get_stat(link, RTNL_LINK_RX_BYTES) },
+        { interfaces_ly_tree_create_interfaces_interface_statistics_in_unicast_pkts, in_pkts - in_broadcast_pkts - in_multicast_pkts },
+        { interfaces_ly_tree_create_interfaces_interface_statistics_in_broadcast_pkts, in_broadcast_pkts },
+        { interfaces_ly_tree_create_interfaces_interface_statistics_in_multicast_pkts, in_multicast_pkts },
+        { interfaces_ly_tree_create_interfaces_interface_statistics_in_discards, (uint32_t)rtnl_link_get_stat(link, RTNL_LINK_RX_DROPPED) },
+        { interfaces_ly_tree_create_interfaces_interface_statistics_in_errors, (uint32_t)rtnl_link_get_stat(link, RTNL_LINK_RX_ERRORS) },
+        { interfaces_ly_tree_create_interfaces_interface_statistics_in_unknown_protos, (uint32_t)rtnl_link_get_stat(link, RTNL_LINK_IP6_INUNKNOWNPROTOS) },
+        { interfaces_ly_tree_create_interfaces_interface_statistics_out_octets, rtnl_link_get_stat(link, RTNL_LINK_TX_BYTES) },
+        { interfaces_ly_tree_create_interfaces_interface_statistics_out_unicast_pkts, out_pkts - out_broadcast_pkts - out_multicast_pkts },
+        { interfaces_ly_tree_create_interfaces_interface_statistics_out_broadcast_pkts, out_broadcast_pkts },
+        { interfaces_ly_tree_create_interfaces_interface_statistics_out_multicast_pkts, out_multicast_pkts },
+        { interfaces_ly_tree_create_interfaces_interface_statistics_out_discards, rtnl_link_get_stat(link, RTNL_LINK_TX_DROPPED) },
+        { interfaces_ly_tree_create_interfaces_interface_statistics_out_errors, rtnl_link_get_stat(link, RTNL_LINK_TX_ERRORS) },
+    };
+
+    SRPC_SAFE_CALL_ERR(error, interfaces_ly_tree_create_interfaces_interface_statistics_discontinuity_time(ly_ctx, statistics_node, discontinuity_time), error_out);
+
+    for (size_t i = 0; i < ARRAY_SIZE(counters); i++) {
+        SRPC_SAFE_CALL_ERR_COND(error, error < 0, snprintf(counter_buffer, sizeof(counter_buffer), "%lu", counters[i].value), error_out);
+        SRPC_SAFE_CALL_ERR(error, counters[i].create(ly_ctx, statistics_node, counter_buffer), error_out);
+    }
+
+    error = 0;
+    goto out;
+
+error_out:
+    error = -1;
+
+out:
+    return error;
+}
+
+static int interfaces_oper_bulk_fill_layers(interfaces_nl_ctx_t* nl_ctx, interfaces_oper_bulk_node_t* nodes_hash)
+{
+    int error = 0;
 
     const struct ly_ctx* ly_ctx = NULL;
+    interfaces_oper_bulk_node_t* node = NULL;
+    interfaces_oper_bulk_node_t* master_node = NULL;
+
+    // libnl
+    struct rtnl_link* link_iter = NULL;
+    struct rtnl_link* master_link = NULL;
+
+    link_iter = (struct rtnl_link*)nl_cache_get_first(nl_ctx->link_cache);
+
+    while (link_iter) {
+        const int ifindex = rtnl_link_get_ifindex(link_iter);
+        int master_if_index = rtnl_link_get_master(link_iter);
+
+        HASH_FIND_INT(nodes_hash, &ifindex, node);
+
+        // every master up the chain is a higher layer of this link and this link is its lower layer
+        while (master_if_index) {
+            master_link = interfaces_link_index_get_by_ifindex(&nl_ctx->link_index, master_if_index);
+            if (!master_link) {
+                break;
+            }
+
+            if (node) {
+                SRPC_SAFE_CALL_ERR(error, interfaces_ly_tree_create_interfaces_interface_higher_layer_if(ly_ctx, node->interface_node, rtnl_link_get_name(master_link)), error_out);
+            }
+
+            HASH_FIND_INT(nodes_hash, &master_if_index, master_node);
+            if (master_node) {
+                SRPC_SAFE_CALL_ERR(error, interfaces_ly_tree_create_interfaces_interface_lower_layer_if(ly_ctx, master_node->interface_node, rtnl_link_get_name(link_iter)), error_out);
+            }
+
+            // go one layer higher
+            master_if_index = rtnl_link_get_master(master_link);
+        }
+
+        link_iter = (struct rtnl_link*)nl_cache_get_next((struct nl_object*)link_iter);
+    }
+
+    error = 0;
+    goto out;
+
+error_out:
+    error = -1;
+
+out:
+    return error;
+}
+
+static int interfaces_oper_bulk_fill_addresses(interfaces_nl_ctx_t* nl_ctx, interfaces_oper_bulk_node_t* nodes_hash)
+{
+    int error = 0;
+    void* error_ptr = NULL;
+
+    const struct ly_ctx* ly_ctx = NULL;
+    interfaces_oper_bulk_node_t* node = NULL;
     struct lyd_node* address_node = NULL;
 
-    struct rtnl_link* link = NULL;
-    struct rtnl_neigh* neigh_iter = NULL;
-    struct nl_addr *dst_addr = NULL, *ll_addr = NULL;
+    // buffers
+    char ip_buffer[100] = { 0 };
+    char prefix_buffer[20] = { 0 };
 
-    if (*parent == NULL) {
-        ly_ctx = sr_acquire_context(sr_session_get_connection(session));
-        if (ly_ctx == NULL) {
-            SRPLG_LOG_ERR(PLUGIN_NAME, "sr_acquire_context() failed");
-            goto error_out;
+    // libnl
+    struct rtnl_addr* addr_iter = NULL;
+    struct nl_addr* local = NULL;
+
+    addr_iter = (struct rtnl_addr*)nl_cache_get_first(nl_ctx->addr_cache);
+
+    while (addr_iter) {
+        const int ifindex = rtnl_addr_get_ifindex(addr_iter);
+        const int family = rtnl_addr_get_family(addr_iter);
+
+        HASH_FIND_INT(nodes_hash, &ifindex, node);
+
+        local = rtnl_addr_get_local(addr_iter);
+
+        if (node && local && (family == AF_INET || family == AF_INET6)) {
+            SRPC_SAFE_CALL_PTR(error_ptr, nl_addr2str(local, ip_buffer, sizeof(ip_buffer)), error_out);
+
+            // remove prefix from IP
+            char* prefix = strchr(ip_buffer, '/');
+            if (prefix) {
+                *prefix = 0;
+            }
+
+            SRPC_SAFE_CALL_ERR_COND(error, error < 0, snprintf(prefix_buffer, sizeof(prefix_buffer), "%d", rtnl_addr_get_prefixlen(addr_iter)), error_out);
+
+            const char* origin = interfaces_oper_get_address_origin(addr_iter);
+
+            if (family == AF_INET) {
+                SRPC_SAFE_CALL_ERR(error, interfaces_ly_tree_create_interfaces_interface_ipv4_address(ly_ctx, node->ipv4_node, &address_node, ip_buffer), error_out);
+                SRPC_SAFE_CALL_ERR(error, interfaces_ly_tree_create_interfaces_interface_ipv4_address_prefix_length(ly_ctx, address_node, prefix_buffer), error_out);
+                SRPC_SAFE_CALL_ERR(error, interfaces_ly_tree_create_interfaces_interface_ipv4_address_origin(ly_ctx, address_node, origin), error_out);
+            } else {
+                SRPC_SAFE_CALL_ERR(error, interfaces_ly_tree_create_interfaces_interface_ipv6_address(ly_ctx, node->ipv6_node, &address_node, ip_buffer), error_out);
+                SRPC_SAFE_CALL_ERR(error, interfaces_ly_tree_create_interfaces_interface_ipv6_address_prefix_length(ly_ctx, address_node, prefix_buffer), error_out);
+                SRPC_SAFE_CALL_ERR(error, interfaces_ly_tree_create_interfaces_interface_ipv6_address_origin(ly_ctx, address_node, origin), error_out);
+                SRPC_SAFE_CALL_ERR(error, interfaces_ly_tree_create_interfaces_interface_ipv6_address_status(ly_ctx, address_node, interfaces_oper_get_ipv6_address_status(addr_iter)), error_out);
+            }
         }
+
+        addr_iter = (struct rtnl_addr*)nl_cache_get_next((struct nl_object*)addr_iter);
     }
 
-    // there needs to be an allocated link cache in memory
-    assert(*parent != NULL);
-    assert(strcmp(LYD_NAME(*parent), "ipv6") == 0);
+    error = 0;
+    goto out;
 
-    // get node xpath
-    SRPC_SAFE_CALL_PTR(error_ptr, lyd_path(*parent, LYD_PATH_STD, xpath_buffer, sizeof(xpath_buffer)), error_out);
+error_out:
+    error = -1;
 
-    // get link
-    SRPC_SAFE_CALL_PTR(link, interfaces_get_current_link(ctx, session, xpath_buffer), error_out);
+out:
+    return error;
+}
+
+static int interfaces_oper_bulk_fill_neighbors(interfaces_nl_ctx_t* nl_ctx, interfaces_oper_bulk_node_t* nodes_hash)
+{
+    int error = 0;
+    void* error_ptr = NULL;
+
+    const struct ly_ctx* ly_ctx = NULL;
+    interfaces_oper_bulk_node_t* node = NULL;
+    struct lyd_node* neighbor_node = NULL;
 
-    neigh_iter = (struct rtnl_neigh*)nl_cache_get_first(oper_ctx->nl_ctx.neigh_cache);
+    // buffers
+    char dst_buffer[100] = { 0 };
+    char ll_buffer[100] = { 0 };
+
+    // libnl
+    struct rtnl_neigh* neigh_iter = NULL;
+    struct nl_addr* dst_addr = NULL;
+    struct nl_addr* ll_addr = NULL;
+
+    neigh_iter = (struct rtnl_neigh*)nl_cache_get_first(nl_ctx->neigh_cache);
 
     while (neigh_iter) {
-        // check for interface IPv6 neighbor
-        if (rtnl_neigh_get_ifindex(neigh_iter) == rtnl_link_get_ifindex(link) && rtnl_neigh_get_family(neigh_iter) == AF_INET6) {
-            SRPLG_LOG_INF(PLUGIN_NAME, "Found IPv6 neighbor for %s", rtnl_link_get_name(link));
+        const int ifindex = rtnl_neigh_get_ifindex(neigh_iter);
+        const int family = rtnl_neigh_get_family(neigh_iter);
 
-            // IP
-            SRPC_SAFE_CALL_PTR(dst_addr, rtnl_neigh_get_dst(neigh_iter), error_out);
-            SRPC_SAFE_CALL_PTR(error_ptr, nl_addr2str(dst_addr, dst_buffer, sizeof(dst_buffer)), error_out);
+        HASH_FIND_INT(nodes_hash, &ifindex, node);
 
-            // link-layer-address
-            SRPC_SAFE_CALL_PTR(ll_addr, rtnl_neigh_get_lladdr(neigh_iter), error_out);
+        dst_addr = rtnl_neigh_get_dst(neigh_iter);
+        ll_addr = rtnl_neigh_get_lladdr(neigh_iter);
+
+        // unresolved neighbors have no link-layer address
+        if (node && dst_addr && ll_addr && (family == AF_INET || family == AF_INET6)) {
+            SRPC_SAFE_CALL_PTR(error_ptr, nl_addr2str(dst_addr, dst_buffer, sizeof(dst_buffer)), error_out);
             SRPC_SAFE_CALL_PTR(error_ptr, nl_addr2str(ll_addr, ll_buffer, sizeof(ll_buffer)), error_out);
 
             // remove prefix from IP
@@ -2074,172 +2139,271 @@ int interfaces_subscription_operational_interfaces_interface_ipv6_neighbor(sr_se
                 *prefix = 0;
             }
 
-            SRPLG_LOG_INF(PLUGIN_NAME, "ipv6:neighbor(%s) = %s | %s", rtnl_link_get_name(link), dst_buffer, ll_buffer);
+            const bool is_router = (rtnl_neigh_get_flags(neigh_iter) & NTF_ROUTER) > 0;
+            const char* origin = is_router ? "dynamic" : "static";
 
-            // neighbor IP
-            SRPC_SAFE_CALL_ERR(error, interfaces_ly_tree_create_interfaces_interface_ipv6_neighbor(ly_ctx, *parent, &address_node, dst_buffer), error_out);
+            if (family == AF_INET) {
+                SRPC_SAFE_CALL_ERR(error, interfaces_ly_tree_create_interfaces_interface_ipv4_neighbor(ly_ctx, node->ipv4_node, &neighbor_node, dst_buffer), error_out);
+                SRPC_SAFE_CALL_ERR(error, interfaces_ly_tree_create_interfaces_interface_ipv4_neighbor_link_layer_address(ly_ctx, neighbor_node, ll_buffer), error_out);
+                SRPC_SAFE_CALL_ERR(error, interfaces_ly_tree_create_interfaces_interface_ipv4_neighbor_origin(ly_ctx, neighbor_node, origin), error_out);
+            } else {
+                const char* state = interfaces_oper_get_neighbor_state(rtnl_neigh_get_state(neigh_iter));
 
-            // link-layer-address
-            SRPC_SAFE_CALL_ERR(error, interfaces_ly_tree_create_interfaces_interface_ipv6_neighbor_link_layer_address(ly_ctx, address_node, ll_buffer), error_out);
+                SRPC_SAFE_CALL_ERR(error, interfaces_ly_tree_create_interfaces_interface_ipv6_neighbor(ly_ctx, node->ipv6_node, &neighbor_node, dst_buffer), error_out);
+                SRPC_SAFE_CALL_ERR(error, interfaces_ly_tree_create_interfaces_interface_ipv6_neighbor_link_layer_address(ly_ctx, neighbor_node, ll_buffer), error_out);
+                SRPC_SAFE_CALL_ERR(error, interfaces_ly_tree_create_interfaces_interface_ipv6_neighbor_origin(ly_ctx, neighbor_node, origin), error_out);
+
+                if (is_router) {
+                    SRPC_SAFE_CALL_ERR(error, interfaces_ly_tree_create_interfaces_interface_ipv6_neighbor_is_router(ly_ctx, neighbor_node, ""), error_out);
+                }
+
+                if (state) {
+                    SRPC_SAFE_CALL_ERR(error, interfaces_ly_tree_create_interfaces_interface_ipv6_neighbor_state(ly_ctx, neighbor_node, state), error_out);
+                }
+            }
         }
 
         neigh_iter = (struct rtnl_neigh*)nl_cache_get_next((struct nl_object*)neigh_iter);
     }
 
+    error = 0;
     goto out;
 
 error_out:
-    error = SR_ERR_CALLBACK_FAILED;
+    error = -1;
 
 out:
     return error;
 }
 
-int interfaces_subscription_operational_interfaces_interface(sr_session_ctx_t* session, uint32_t sub_id, const char* module_name, const char* path, const char* request_xpath, uint32_t request_id, struct lyd_node** parent, void* private_data)
+static const char* interfaces_oper_get_neighbor_state(int state)
 {
-    int error = SR_ERR_OK;
-    // void* error_ptr = NULL;
-    const struct ly_ctx* ly_ctx = NULL;
-    interfaces_ctx_t* ctx = private_data;
-    interfaces_nl_ctx_t* nl_ctx = &ctx->oper_ctx.nl_ctx;
-    struct rtnl_link* link_iter = NULL;
+    // failed, noarp and permanent states are not reported
+    switch (state) {
+    case NUD_INCOMPLETE:
+        return "incomplete";
+    case NUD_REACHABLE:
+        return "reachable";
+    case NUD_STALE:
+        return "stale";
+    case NUD_DELAY:
+        return "delay";
+    case NUD_PROBE:
+        return "probe";
+    default:
+        return NULL;
+    }
+}
 
-    // libyang
-    struct lyd_node* interface_list_node = NULL;
+const char* interfaces_oper_get_address_origin(struct rtnl_addr* addr)
+{
+    const unsigned int flags = rtnl_addr_get_flags(addr);
+    struct nl_addr* local = rtnl_addr_get_local(addr);
 
-    // setup nl socket
-    if (!nl_ctx->socket) {
-        // netlink
-        SRPC_SAFE_CALL_PTR(nl_ctx->socket, nl_socket_alloc(), error_out);
+    // fe80::/10 - generated by the kernel from the link-layer address, even though it is marked permanent
+    if (rtnl_addr_get_family(addr) == AF_INET6 && local != NULL && nl_addr_get_len(local) == 16) {
+        const uint8_t* bytes = nl_addr_get_binary_addr(local);
 
-        // connect
-        SRPC_SAFE_CALL_ERR(error, nl_connect(nl_ctx->socket, NETLINK_ROUTE), error_out);
+        if (bytes[0] == 0xfe && (bytes[1] & 0xc0) == 0x80) {
+            return "link-layer";
+        }
     }
 
-    // cache was already allocated - free existing cache
-    if (nl_ctx->link_cache) {
-        nl_cache_refill(nl_ctx->socket, nl_ctx->link_cache);
-        nl_cache_refill(nl_ctx->socket, nl_ctx->addr_cache);
-        nl_cache_refill(nl_ctx->socket, nl_ctx->neigh_cache);
-    } else {
-        // allocate new link cache
-        SRPC_SAFE_CALL_ERR(error, rtnl_link_alloc_cache(nl_ctx->socket, AF_UNSPEC, &nl_ctx->link_cache), error_out);
+    // configured by the administrator
+    if (flags & IFA_F_PERMANENT) {
+        return "static";
+    }
+
+    if (rtnl_addr_get_family(addr) == AF_INET6) {
+        // RFC 4941 privacy addresses - IFA_F_TEMPORARY shares its value with the IPv4 secondary flag
+        return (flags & IFA_F_TEMPORARY) ? "random" : "link-layer";
+    }
+
+    return "dhcp";
+}
 
-        // allocate new address cache
-        SRPC_SAFE_CALL_ERR(error, rtnl_addr_alloc_cache(nl_ctx->socket, &nl_ctx->addr_cache), error_out);
+const char* interfaces_oper_get_ipv6_address_status(struct rtnl_addr* addr)
+{
+    const unsigned int flags = rtnl_addr_get_flags(addr);
 
-        // allocate new neighbor cache
-        SRPC_SAFE_CALL_ERR(error, rtnl_neigh_alloc_cache(nl_ctx->socket, &nl_ctx->neigh_cache), error_out);
+    // DAD failures stay tentative - check them first
+    if (flags & IFA_F_DADFAILED) {
+        return "duplicate";
     }
 
-    if (*parent == NULL) {
-        ly_ctx = sr_acquire_context(sr_session_get_connection(session));
-        if (ly_ctx == NULL) {
-            SRPLG_LOG_ERR(PLUGIN_NAME, "sr_acquire_context() failed");
-            goto error_out;
-        }
+    if (flags & IFA_F_OPTIMISTIC) {
+        return "optimistic";
+    }
 
-        // set parent to the interfaces container
-        SRPC_SAFE_CALL_ERR(error, interfaces_ly_tree_create_interfaces(ly_ctx, parent), error_out);
+    if (flags & IFA_F_TENTATIVE) {
+        return "tentative";
     }
 
-    // iterate links and add them to the operational DS
-    link_iter = (struct rtnl_link*)nl_cache_get_first(nl_ctx->link_cache);
-    while (link_iter) {
-        // add interface
-        SRPC_SAFE_CALL_ERR(error, interfaces_ly_tree_create_interfaces_interface(ly_ctx, *parent, &interface_list_node, rtnl_link_get_name(link_iter)), error_out);
+    if (flags & IFA_F_DEPRECATED) {
+        return "deprecated";
+    }
 
-        // create needed containers for the interface
-        SRPC_SAFE_CALL_ERR(error, interfaces_ly_tree_create_interfaces_interface_statistics(ly_ctx, interface_list_node, NULL), error_out);
-        SRPC_SAFE_CALL_ERR(error, interfaces_ly_tree_create_interfaces_interface_ipv4(ly_ctx, interface_list_node, NULL), error_out);
-        SRPC_SAFE_CALL_ERR(error, interfaces_ly_tree_create_interfaces_interface_ipv6(ly_ctx, interface_list_node, NULL), error_out);
+    return "preferred";
+}
 
-        link_iter = (struct rtnl_link*)nl_cache_get_next((struct nl_object*)link_iter);
+void interfaces_subscription_operational_requests_free(interfaces_oper_request_ctx_t** requests)
+{
+    interfaces_oper_request_ctx_t *request_iter = NULL, *tmp = NULL;
+
+    HASH_ITER(hh, *requests, request_iter, tmp)
+    {
+        HASH_DEL(*requests, request_iter);
+        free(request_iter);
     }
 
-    goto out;
+    *requests = NULL;
+}
 
-error_out:
-    error = SR_ERR_CALLBACK_FAILED;
+static interfaces_oper_request_ctx_t* interfaces_oper_request_get(interfaces_oper_ctx_t* oper_ctx, uint32_t request_id)
+{
+    interfaces_oper_request_ctx_t* request = NULL;
+    const time_t current_time = time(NULL);
 
-out:
+    HASH_FIND(hh, oper_ctx->requests, &request_id, sizeof(request_id), request);
 
-    return error;
+    if (!request) {
+        // first callback of a new request
+        interfaces_oper_request_release_idle(oper_ctx, current_time);
+
+        request = calloc(1, sizeof(*request));
+        if (!request) {
+            return NULL;
+        }
+
+        request->request_id = request_id;
+        HASH_ADD(hh, oper_ctx->requests, request_id, sizeof(request->request_id), request);
+    }
+
+    request->last_used = current_time;
+
+    return request;
 }
 
-static struct rtnl_link* interfaces_get_current_link(interfaces_ctx_t* ctx, sr_session_ctx_t* session, const char* xpath)
+static void interfaces_oper_request_release_idle(interfaces_oper_ctx_t* oper_ctx, time_t current_time)
 {
-    int error = 0;
+    interfaces_oper_request_ctx_t *request_iter = NULL, *tmp = NULL;
+
+    // sysrepo doesn't report finished requests - no callbacks for a while means no more will come
+    HASH_ITER(hh, oper_ctx->requests, request_iter, tmp)
+    {
+        if (current_time - request_iter->last_used >= INTERFACES_OPER_REQUEST_IDLE_TIMEOUT) {
+            HASH_DEL(oper_ctx->requests, request_iter);
+            free(request_iter);
+        }
+    }
+}
 
-    const interfaces_nl_ctx_t* nl_ctx = &ctx->oper_ctx.nl_ctx;
+static void interfaces_oper_request_reset_links(interfaces_oper_ctx_t* oper_ctx)
+{
+    interfaces_oper_request_ctx_t *request_iter = NULL, *tmp = NULL;
 
-    // buffers
-    char interface_name_buffer[100] = { 0 };
+    HASH_ITER(hh, oper_ctx->requests, request_iter, tmp)
+    {
+        request_iter->interface_node = NULL;
+        request_iter->link = NULL;
+    }
+}
 
-    // libnl
-    struct rtnl_link* link = NULL;
+static struct rtnl_link* interfaces_get_current_link(interfaces_ctx_t* ctx, uint32_t request_id, const struct lyd_node* node)
+{
+    const interfaces_nl_ctx_t* nl_ctx = &ctx->oper_ctx.nl_ctx;
+    interfaces_oper_request_ctx_t* request = NULL;
+    const struct lyd_node* interface_node = NULL;
+    const char* interface_name = NULL;
 
     // there needs to be an allocated link cache in memory
     assert(nl_ctx->link_cache != NULL);
 
-    // extract interface name
-    SRPC_SAFE_CALL_ERR(error, interfaces_extract_interface_name(session, xpath, interface_name_buffer, sizeof(interface_name_buffer)), error_out);
+    SRPC_SAFE_CALL_PTR(request, interfaces_oper_request_get(&ctx->oper_ctx, request_id), error_out);
+
+    // notifications applied since the last callback replace cached objects
+    if (interfaces_oper_cache_index(&ctx->oper_ctx)) {
+        SRPLG_LOG_ERR(PLUGIN_NAME, "interfaces_oper_cache_index() failed");
+        goto error_out;
+    }
+
+    SRPC_SAFE_CALL_PTR(interface_node, interfaces_get_list_node(node, "interface"), error_out);
+
+    // leaves of one interface are requested one after another
+    if (request->interface_node == interface_node) {
+        return request->link;
+    }
+
+    // read interface name directly from the list node
+    SRPC_SAFE_CALL_PTR(interface_name, interfaces_get_list_key_value(interface_node, "interface", "name"), error_out);
 
-    // get link by name
-    SRPC_SAFE_CALL_PTR(link, rtnl_link_get_by_name(nl_ctx->link_cache, interface_name_buffer), error_out);
+    request->interface_node = interface_node;
+    request->link = interfaces_link_index_get_by_name(&nl_ctx->link_index, interface_name);
 
-    return link;
+    return request->link;
 
 error_out:
     return NULL;
 }
 
-static int interfaces_extract_interface_name(sr_session_ctx_t* session, const char* xpath, char* buffer, size_t buffer_size)
+static const struct lyd_node* interfaces_get_list_node(const struct lyd_node* node, const char* list_name)
 {
-    int error = 0;
+    // find the list instance at or above the given node
+    while (node && strcmp(LYD_NAME(node), list_name)) {
+        node = lyd_parent(node);
+    }
 
-    const char* name = NULL;
-    char* xpath_copy = NULL;
+    return node;
+}
 
-    sr_xpath_ctx_t xpath_ctx = { 0 };
+static const char* interfaces_get_list_key_value(const struct lyd_node* node, const char* list_name, const char* key_name)
+{
+    const struct lyd_node* key_iter = NULL;
 
-    // copy xpath due to changing it when using xpath_ctx from sysrepo
-    SRPC_SAFE_CALL_PTR(xpath_copy, strdup(xpath), error_out);
+    SRPC_SAFE_CALL_PTR(node, interfaces_get_list_node(node, list_name), error_out);
+
+    // keys are always the first children of a list instance
+    for (key_iter = lyd_child(node); key_iter && lysc_is_key(key_iter->schema); key_iter = key_iter->next) {
+        if (!strcmp(LYD_NAME(key_iter), key_name)) {
+            return lyd_get_value(key_iter);
+        }
+    }
+
+error_out:
+    return NULL;
+}
+
+static int interfaces_extract_interface_address_ip(const struct lyd_node* address_node, char* buffer, size_t buffer_size)
+{
+    int error = 0;
+
+    const char* ip = NULL;
 
     // extract key
-    SRPC_SAFE_CALL_PTR(name, sr_xpath_key_value(xpath_copy, "interface", "name", &xpath_ctx), error_out);
+    SRPC_SAFE_CALL_PTR(ip, interfaces_get_list_key_value(address_node, "address", "ip"), error_out);
 
     // store to buffer
-    SRPC_SAFE_CALL_ERR_COND(error, error < 0, snprintf(buffer, buffer_size, "%s", name), error_out);
+    SRPC_SAFE_CALL_ERR_COND(error, error < 0, snprintf(buffer, buffer_size, "%s", ip), error_out);
 
     error = 0;
+
     goto out;
 
 error_out:
     error = -1;
 
 out:
-    if (xpath_copy) {
-        free(xpath_copy);
-    }
-
     return error;
 }
 
-static int interfaces_extract_interface_address_ip(sr_session_ctx_t* session, const char* xpath, char* buffer, size_t buffer_size)
+static int interfaces_extract_interface_neighbor_ip(const struct lyd_node* neighbor_node, char* buffer, size_t buffer_size)
 {
     int error = 0;
 
     const char* ip = NULL;
-    char* xpath_copy = NULL;
-
-    sr_xpath_ctx_t xpath_ctx = { 0 };
-
-    // copy xpath due to changing it when using xpath_ctx from sysrepo
-    SRPC_SAFE_CALL_PTR(xpath_copy, strdup(xpath), error_out);
 
     // extract key
-    SRPC_SAFE_CALL_PTR(ip, sr_xpath_key_value(xpath_copy, "address", "ip", &xpath_ctx), error_out);
+    SRPC_SAFE_CALL_PTR(ip, interfaces_get_list_key_value(neighbor_node, "neighbor", "ip"), error_out);
 
     // store to buffer
     SRPC_SAFE_CALL_ERR_COND(error, error < 0, snprintf(buffer, buffer_size, "%s", ip), error_out);
@@ -2252,33 +2416,174 @@ error_out:
     error = -1;
 
 out:
-    if (xpath_copy) {
-        free(xpath_copy);
+    return error;
+}
+
+static int interfaces_oper_cache_sync(interfaces_oper_ctx_t* oper_ctx)
+{
+    int error = 0;
+    interfaces_nl_ctx_t* nl_ctx = &oper_ctx->nl_ctx;
+    const time_t current_time = time(NULL);
+    int processed = 0;
+
+    // setup nl socket
+    if (!nl_ctx->socket) {
+        // netlink
+        SRPC_SAFE_CALL_PTR(nl_ctx->socket, nl_socket_alloc(), error_out);
+
+        // connect
+        SRPC_SAFE_CALL_ERR(error, nl_connect(nl_ctx->socket, NETLINK_ROUTE), error_out);
     }
 
+    if (!nl_ctx->link_cache_manager) {
+        // caches are dumped once when added and then follow the link, address and neighbor groups
+        SRPC_SAFE_CALL_ERR(error, nl_cache_mngr_alloc(NULL, NETLINK_ROUTE, 0, &nl_ctx->link_cache_manager), error_out);
+        SRPC_SAFE_CALL_ERR(error, nl_cache_mngr_add(nl_ctx->link_cache_manager, "route/link", interfaces_oper_cache_change_cb, &oper_ctx->cache_sync.links_changed, &nl_ctx->link_cache), error_out);
+        SRPC_SAFE_CALL_ERR(error, nl_cache_mngr_add(nl_ctx->link_cache_manager, "route/addr", interfaces_oper_cache_change_cb, &oper_ctx->cache_sync.addresses_changed, &nl_ctx->addr_cache), error_out);
+        SRPC_SAFE_CALL_ERR(error, nl_cache_mngr_add(nl_ctx->link_cache_manager, "route/neigh", interfaces_oper_cache_change_cb, &oper_ctx->cache_sync.neighbors_changed, &nl_ctx->neigh_cache), error_out);
+
+        oper_ctx->cache_sync.last_sync = current_time;
+        oper_ctx->cache_sync.links_changed = 1;
+        oper_ctx->cache_sync.addresses_changed = 1;
+        oper_ctx->cache_sync.neighbors_changed = 1;
+
+        // the manager thread applies notifications between requests - the socket doesn't overrun while nobody reads
+        if (oper_ctx->state_changes_ctx.manager_thread_started) {
+            struct epoll_event event = { .events = EPOLLIN, .data.fd = nl_cache_mngr_get_fd(nl_ctx->link_cache_manager) };
+
+            if (epoll_ctl(oper_ctx->state_changes_ctx.epoll_fd, EPOLL_CTL_ADD, event.data.fd, &event) < 0) {
+                SRPLG_LOG_ERR(PLUGIN_NAME, "epoll_ctl() failed (%s) - operational cache notifications are applied on requests only", strerror(errno));
+            }
+        }
+    } else {
+        // apply pending notifications - the manager socket is non-blocking
+        processed = nl_cache_mngr_data_ready(nl_ctx->link_cache_manager);
+        if (processed < 0) {
+            // notifications were lost (socket overrun) - the caches can't be trusted anymore
+            SRPLG_LOG_INF(PLUGIN_NAME, "Lost operational cache notifications (%s) - dumping caches again", nl_geterror(processed));
+            oper_ctx->cache_sync.last_sync = 0;
+        }
+
+        if (oper_ctx->cache_sync.max_age == 0 || current_time - oper_ctx->cache_sync.last_sync >= oper_ctx->cache_sync.max_age) {
+            SRPC_SAFE_CALL_ERR(error, nl_cache_refill(nl_ctx->socket, nl_ctx->link_cache), error_out);
+            SRPC_SAFE_CALL_ERR(error, nl_cache_refill(nl_ctx->socket, nl_ctx->addr_cache), error_out);
+            SRPC_SAFE_CALL_ERR(error, nl_cache_refill(nl_ctx->socket, nl_ctx->neigh_cache), error_out);
+
+            oper_ctx->cache_sync.last_sync = current_time;
+            oper_ctx->cache_sync.links_changed = 1;
+            oper_ctx->cache_sync.addresses_changed = 1;
+            oper_ctx->cache_sync.neighbors_changed = 1;
+        } else {
+            oper_ctx->cache_sync.avoided_dumps += 3;
+            SRPLG_LOG_DBG(PLUGIN_NAME, "Operational caches served from notifications (%d processed, %" PRIu64 " dumps avoided)", processed > 0 ? processed : 0, oper_ctx->cache_sync.avoided_dumps);
+        }
+    }
+
+    SRPC_SAFE_CALL_ERR(error, interfaces_oper_cache_index(oper_ctx), error_out);
+
+    goto out;
+
+error_out:
+    error = -1;
+
+    // partially setup manager - start over on the next request
+    if (nl_ctx->link_cache_manager && !nl_ctx->neigh_cache) {
+        nl_cache_mngr_free(nl_ctx->link_cache_manager);
+        nl_ctx->link_cache_manager = NULL;
+        nl_ctx->link_cache = NULL;
+        nl_ctx->addr_cache = NULL;
+    }
+
+out:
     return error;
 }
 
-static int interfaces_extract_interface_neighbor_ip(sr_session_ctx_t* session, const char* xpath, char* buffer, size_t buffer_size)
+static int interfaces_oper_cache_index(interfaces_oper_ctx_t* oper_ctx)
 {
     int error = 0;
+    interfaces_nl_ctx_t* nl_ctx = &oper_ctx->nl_ctx;
 
-    const char* ip = NULL;
+    // changed links are replaced in the cache - rebuild lookups for the per-leaf callbacks
+    if (oper_ctx->cache_sync.links_changed) {
+        interfaces_oper_request_reset_links(oper_ctx);
+
+        SRPC_SAFE_CALL_ERR(error, interfaces_link_index_build(&nl_ctx->link_index, nl_ctx->link_cache), error_out);
+        oper_ctx->cache_sync.links_changed = 0;
+    }
+
+    if (oper_ctx->cache_sync.addresses_changed) {
+        SRPC_SAFE_CALL_ERR(error, interfaces_object_index_build_addresses(&nl_ctx->addr_index, nl_ctx->addr_cache), error_out);
+        oper_ctx->cache_sync.addresses_changed = 0;
+    }
+
+    if (oper_ctx->cache_sync.neighbors_changed) {
+        SRPC_SAFE_CALL_ERR(error, interfaces_object_index_build_neighbors(&nl_ctx->neigh_index, nl_ctx->neigh_cache), error_out);
+        oper_ctx->cache_sync.neighbors_changed = 0;
+    }
+
+    goto out;
+
+error_out:
+    error = -1;
+
+out:
+    return error;
+}
+
+int interfaces_subscription_operational_cache_drain(interfaces_oper_ctx_t* oper_ctx)
+{
+    int processed = 0;
+
+    // caches are set up by the first request
+    if (!oper_ctx->nl_ctx.link_cache_manager) {
+        return 0;
+    }
+
+    // indexes are rebuilt by the next callback which uses them
+    processed = nl_cache_mngr_data_ready(oper_ctx->nl_ctx.link_cache_manager);
+    if (processed < 0) {
+        SRPLG_LOG_INF(PLUGIN_NAME, "Lost operational cache notifications (%s) - dumping caches on the next request", nl_geterror(processed));
+        oper_ctx->cache_sync.last_sync = 0;
+        return processed;
+    }
+
+    return 0;
+}
+
+static void interfaces_oper_cache_change_cb(struct nl_cache* cache, struct nl_object* obj, int action, void* arg)
+{
+    // arg points to the cache_sync flag of the changed cache
+    uint8_t* changed = arg;
+
+    (void)cache;
+    (void)obj;
+    (void)action;
+
+    *changed = 1;
+}
+
+static int interfaces_extract_request_interface_name(const char* request_xpath, char* buffer, size_t buffer_size)
+{
+    int error = 0;
+
+    const char* name = NULL;
     char* xpath_copy = NULL;
 
     sr_xpath_ctx_t xpath_ctx = { 0 };
 
     // copy xpath due to changing it when using xpath_ctx from sysrepo
-    SRPC_SAFE_CALL_PTR(xpath_copy, strdup(xpath), error_out);
+    SRPC_SAFE_CALL_PTR(xpath_copy, strdup(request_xpath), error_out);
 
-    // extract key
-    SRPC_SAFE_CALL_PTR(ip, sr_xpath_key_value(xpath_copy, "neighbor", "ip", &xpath_ctx), error_out);
+    // no key in the request - all interfaces are requested
+    name = sr_xpath_key_value(xpath_copy, "interface", "name", &xpath_ctx);
+    if (name == NULL) {
+        goto error_out;
+    }
 
     // store to buffer
-    SRPC_SAFE_CALL_ERR_COND(error, error < 0, snprintf(buffer, buffer_size, "%s", ip), error_out);
+    SRPC_SAFE_CALL_ERR_COND(error, error < 0, snprintf(buffer, buffer_size, "%s", name), error_out);
 
     error = 0;
-
     goto out;
 
 error_out:
@@ -41,9 +41,34 @@ typedef struct interfaces_interface_ipv6 interfaces_interface_ipv6_t;
 typedef struct interfaces_interface interfaces_interface_t;
 typedef struct interfaces_interface_element interfaces_interface_element_t;
 typedef struct interfaces interfaces_t;
-typedef struct interfaces_interface_state interfaces_interface_state_t;
-typedef struct interfaces_interface_state_hash_element interfaces_interface_state_hash_element_t;
+typedef struct interfaces_interface_state_table_element interfaces_interface_state_table_element_t;
+typedef struct interfaces_interface_state_table interfaces_interface_state_table_t;
 typedef struct interfaces_interface_hash_element interfaces_interface_hash_element_t;
+typedef struct interfaces_link_index_element interfaces_link_index_element_t;
+typedef struct interfaces_link_index interfaces_link_index_t;
+typedef struct interfaces_object_index_bucket interfaces_object_index_bucket_t;
+typedef struct interfaces_object_index interfaces_object_index_t;
+typedef struct interfaces_change_operation interfaces_change_operation_t;
+typedef struct interfaces_change_plan_link interfaces_change_plan_link_t;
+typedef struct interfaces_change_plan interfaces_change_plan_t;
+typedef struct interfaces_change_interface_link interfaces_change_interface_link_t;
+
+// libnl
+struct nl_object;
+struct rtnl_link;
+
+// libyang
+struct lyd_node;
+
+enum interfaces_change_operation_type {
+    interfaces_change_operation_link_add = 0,
+    interfaces_change_operation_link_delete,
+    interfaces_change_operation_link_change,
+    interfaces_change_operation_address_add,
+    interfaces_change_operation_address_delete,
+    interfaces_change_operation_neighbor_add,
+    interfaces_change_operation_neighbor_delete,
+};
 
 enum interfaces_interface_enable {
     interfaces_interface_enable_disabled = 0,
@@ -190,15 +215,15 @@ struct interfaces {
     interfaces_interface_element_t* interface;
 };
 
-struct interfaces_interface_state {
+struct interfaces_interface_state_table_element {
     char* name; // key
     uint8_t state;
     time_t last_change;
+    UT_hash_handle hh;
 };
 
-struct interfaces_interface_state_hash_element {
-    interfaces_interface_state_t state;
-    UT_hash_handle hh;
+struct interfaces_interface_state_table {
+    interfaces_interface_state_table_element_t* elements;
 };
 
 struct interfaces_interface_hash_element {
@@ -206,4 +231,77 @@ struct interfaces_interface_hash_element {
     UT_hash_handle hh;
 };
 
+struct interfaces_link_index_element {
+    int ifindex; // key
+    const char* name; // key - owned by the link
+    struct rtnl_link* link;
+    UT_hash_handle name_hh;
+    UT_hash_handle ifindex_hh;
+};
+
+struct interfaces_link_index {
+    interfaces_link_index_element_t* by_name;
+    interfaces_link_index_element_t* by_ifindex;
+};
+
+struct interfaces_object_index_bucket {
+    struct {
+        int ifindex;
+        int family;
+    } key;
+    size_t offset; ///< first object of the bucket in the objects array
+    size_t count;
+    UT_hash_handle hh;
+};
+
+// objects of one cache grouped by (ifindex, family) into contiguous runs
+struct interfaces_object_index {
+    struct nl_object** objects;
+    size_t objects_count;
+    interfaces_object_index_bucket_t* buckets;
+};
+
+// one kernel request of a commit - built on SR_EV_CHANGE, sent on SR_EV_DONE
+struct interfaces_change_operation {
+    enum interfaces_change_operation_type type;
+    char* interface_name;
+    struct nl_object* object; ///< request link, address or neighbor - the interface index is set when it is sent
+    int flags;
+
+    // request restoring the previous kernel state
+    struct {
+        enum interfaces_change_operation_type type;
+        struct nl_object* object;
+        int flags;
+        uint8_t set;
+    } undo;
+
+    int error; ///< libnl error code of the request
+    uint8_t applied; ///< acknowledged by the kernel
+    uint8_t unconfirmed; ///< sent but never acknowledged - the kernel may have applied it
+};
+
+// latest link requests of one interface in a plan - indexes into the operations array
+struct interfaces_change_plan_link {
+    const char* name; // key - owned by the operations
+    size_t link_index; ///< last link add or delete, SIZE_MAX if none
+    size_t change_index; ///< last link change, SIZE_MAX if none
+    UT_hash_handle hh;
+};
+
+// kernel requests of one commit in handler order
+struct interfaces_change_plan {
+    interfaces_change_operation_t* operations;
+    size_t count;
+    size_t size;
+    interfaces_change_plan_link_t* links;
+};
+
+// link of one interface list instance in the change tree - valid during a single change event
+struct interfaces_change_interface_link {
+    const struct lyd_node* interface_node; // key
+    struct rtnl_link* link; ///< borrowed from the link cache or the plan, NULL if the link doesn't exist
+    UT_hash_handle hh;
+};
+
 #endif // INTERFACES_PLUGIN_TYPES_H
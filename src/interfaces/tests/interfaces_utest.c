@@ -14,7 +14,25 @@
 /* interfaces hash table state */
 #include "plugin/data/interfaces/interface/ipv4/address.h"
 #include "plugin/data/interfaces/interface/ipv6/address.h"
-#include "plugin/data/interfaces/interface_state.h"
+#include "plugin/data/interfaces/interface_state_table.h"
+
+/* link lookup index */
+#include "plugin/data/interfaces/link_index.h"
+#include "plugin/data/interfaces/object_index.h"
+#include <netlink/route/addr.h>
+#include <netlink/route/neighbour.h>
+
+/* change plan */
+#include "plugin/api/interfaces/plan.h"
+
+/* operational address origin and status */
+#include "plugin/subscription/operational.h"
+#include <linux/if_addr.h>
+
+/* dump counting */
+#include "plugin/data/interfaces/interface.h"
+#include <netlink/cache.h>
+#include <netlink/route/link.h>
 
 /* interfaces interface linked list */
 #include "plugin/data/interfaces/interface/linked_list.h"
@@ -24,17 +42,25 @@
 static int setup(void** state);
 static int teardown(void** state);
 
+/* kernel dumps - wrapped at link time */
+static unsigned int cache_dumps = 0;
+
+int __real_rtnl_link_alloc_cache(struct nl_sock* socket, int family, struct nl_cache** result);
+int __real_rtnl_addr_alloc_cache(struct nl_sock* socket, struct nl_cache** result);
+int __real_rtnl_neigh_alloc_cache(struct nl_sock* socket, struct nl_cache** result);
+int __real_nl_cache_refill(struct nl_sock* socket, struct nl_cache* cache);
+
+int __wrap_rtnl_link_alloc_cache(struct nl_sock* socket, int family, struct nl_cache** result);
+int __wrap_rtnl_addr_alloc_cache(struct nl_sock* socket, struct nl_cache** result);
+int __wrap_rtnl_neigh_alloc_cache(struct nl_sock* socket, struct nl_cache** result);
+int __wrap_nl_cache_refill(struct nl_sock* socket, struct nl_cache* cache);
+
 /* tests */
 
 /** interface hash table state **/
-static void test_state_hash_new_correct(void** state);
-static void test_state_hash_element_new_correct(void** state);
-static void test_state_hash_add_correct(void** state);
-static void test_state_hash_add_incorrect(void** state);
-static void test_state_hash_get_correct(void** state);
-static void test_state_hash_get_incorrect(void** state);
-static void test_state_hash_set_name_correct(void** state);
-static void test_state_hash_set_name_incorrect(void** state);
+static void test_state_table_set_get_correct(void** state);
+static void test_state_table_get_incorrect(void** state);
+static void test_state_table_remove_correct(void** state);
 
 /** interface list state **/
 static void test_interface_list_new_correct(void** state);
@@ -60,6 +86,26 @@ static void test_interface_list_element_new_ipv6_neighbor_correct(void** state);
 static void test_interface_ipv6_address_set_ip_correct(void** state);
 static void test_interface_ipv6_address_set_prefix_length_correct(void** state);
 
+/** link index **/
+static void test_link_index_add_get_correct(void** state);
+static void test_link_index_get_incorrect(void** state);
+
+/** address and neighbor index **/
+static void test_object_index_build_get_correct(void** state);
+static void test_object_index_get_incorrect(void** state);
+
+/** change plan **/
+static void test_change_plan_add_undo_correct(void** state);
+static void test_change_plan_set_undo_incorrect(void** state);
+static void test_change_plan_get_link_correct(void** state);
+static void test_change_plan_get_link_request_correct(void** state);
+static void test_change_plan_check_correct(void** state);
+static void test_change_plan_check_incorrect(void** state);
+
+/** operational address origin and status **/
+static void test_oper_address_origin_correct(void** state);
+static void test_oper_ipv6_address_status_correct(void** state);
+
 /** load **/
 static void test_correct_load_interface(void** state);
 
@@ -68,14 +114,9 @@ int main(void)
     const struct CMUnitTest tests[] = {
         /** interface hash table state **/
         cmocka_unit_test(test_correct_load_interface),
-        cmocka_unit_test(test_state_hash_new_correct),
-        cmocka_unit_test(test_state_hash_element_new_correct),
-        cmocka_unit_test(test_state_hash_add_correct),
-        cmocka_unit_test(test_state_hash_add_incorrect),
-        cmocka_unit_test(test_state_hash_get_correct),
-        cmocka_unit_test(test_state_hash_get_incorrect),
-        cmocka_unit_test(test_state_hash_set_name_correct),
-        cmocka_unit_test(test_state_hash_set_name_incorrect),
+        cmocka_unit_test(test_state_table_set_get_correct),
+        cmocka_unit_test(test_state_table_get_incorrect),
+        cmocka_unit_test(test_state_table_remove_correct),
         /** interface list state **/
         cmocka_unit_test(test_interface_list_new_correct),
         cmocka_unit_test(test_interface_list_add_element_correct),
@@ -96,6 +137,22 @@ int main(void)
         cmocka_unit_test(test_interface_list_element_new_ipv6_neighbor_correct),
         cmocka_unit_test(test_interface_ipv6_address_set_ip_correct),
         cmocka_unit_test(test_interface_ipv6_address_set_prefix_length_correct),
+        /** link index **/
+        cmocka_unit_test(test_link_index_add_get_correct),
+        cmocka_unit_test(test_link_index_get_incorrect),
+        /** address and neighbor index **/
+        cmocka_unit_test(test_object_index_build_get_correct),
+        cmocka_unit_test(test_object_index_get_incorrect),
+        /** change plan **/
+        cmocka_unit_test(test_change_plan_add_undo_correct),
+        cmocka_unit_test(test_change_plan_set_undo_incorrect),
+        cmocka_unit_test(test_change_plan_get_link_correct),
+        cmocka_unit_test(test_change_plan_get_link_request_correct),
+        cmocka_unit_test(test_change_plan_check_correct),
+        cmocka_unit_test(test_change_plan_check_incorrect),
+        /** operational address origin and status **/
+        cmocka_unit_test(test_oper_address_origin_correct),
+        cmocka_unit_test(test_oper_ipv6_address_status_correct),
     };
 
     return cmocka_run_group_tests(tests, setup, teardown);
@@ -123,170 +180,162 @@ static int teardown(void** state)
     return 0;
 }
 
-static void test_correct_load_interface(void** state)
+int __wrap_rtnl_link_alloc_cache(struct nl_sock* socket, int family, struct nl_cache** result)
 {
-    (void)state;
+    int error = 0;
+    struct nl_object* iter = NULL;
+    struct nl_object* next = NULL;
+    const char* ly_type = NULL;
 
-    int rc = 0;
+    cache_dumps++;
 
-    assert_int_equal(rc, 0);
-}
-
-static void test_state_hash_new_correct(void** state)
-{
-    (void)state;
+    error = __real_rtnl_link_alloc_cache(socket, family, result);
+    if (error != 0) {
+        return error;
+    }
 
-    interfaces_interface_state_hash_element_t* state_hash;
+    // links of a type without a YANG mapping fail the load - keep the result independent of the host
+    iter = nl_cache_get_first(*result);
+    while (iter) {
+        next = nl_cache_get_next(iter);
+        if (interfaces_interface_type_nl2ly(rtnl_link_get_type((struct rtnl_link*)iter), &ly_type) != 0) {
+            nl_cache_remove(iter);
+        }
+        iter = next;
+    }
 
-    state_hash = interfaces_interface_state_hash_new();
-    assert_null(state_hash);
+    return 0;
 }
 
-static void test_state_hash_element_new_correct(void** state)
+int __wrap_rtnl_addr_alloc_cache(struct nl_sock* socket, struct nl_cache** result)
 {
-    (void)state;
-
-    interfaces_interface_state_hash_element_t* new_elem;
-
-    new_elem = interfaces_interface_state_hash_element_new();
-    assert_non_null(new_elem);
-
-    interfaces_interface_state_hash_element_free(&new_elem);
-    assert_null(new_elem);
+    cache_dumps++;
+    return __real_rtnl_addr_alloc_cache(socket, result);
 }
 
-static void test_state_hash_add_correct(void** state)
+int __wrap_rtnl_neigh_alloc_cache(struct nl_sock* socket, struct nl_cache** result)
 {
-    (void)state;
+    cache_dumps++;
+    return __real_rtnl_neigh_alloc_cache(socket, result);
+}
 
-    int rc = 0;
+int __wrap_nl_cache_refill(struct nl_sock* socket, struct nl_cache* cache)
+{
+    cache_dumps++;
+    return __real_nl_cache_refill(socket, cache);
+}
 
-    interfaces_interface_state_hash_element_t *state_hash, *new_elem;
+static void test_correct_load_interface(void** state)
+{
+    interfaces_ctx_t* ctx = *state;
+    interfaces_interface_hash_element_t* if_hash = NULL;
 
-    state_hash = interfaces_interface_state_hash_new();
-    assert_null(state_hash);
+    cache_dumps = 0;
 
-    new_elem = interfaces_interface_state_hash_element_new();
+    assert_int_equal(interfaces_load_interface(ctx, &if_hash), 0);
+    assert_non_null(if_hash);
 
-    interfaces_interface_state_hash_element_set_name(&new_elem, "FOO");
-    assert_int_equal(rc, 0);
+    // one link, address and neighbor dump regardless of the number of interfaces
+    assert_int_equal(cache_dumps, 3);
 
-    rc = interfaces_interface_state_hash_add(&state_hash, new_elem);
-    assert_int_equal(rc, 0);
+    // startup netlink data is released once loaded
+    assert_null(ctx->startup_ctx.nl_ctx.socket);
+    assert_null(ctx->startup_ctx.nl_ctx.addr_cache);
+    assert_null(ctx->startup_ctx.nl_ctx.neigh_cache);
+    assert_null(ctx->startup_ctx.nl_ctx.addr_index.objects);
 
-    interfaces_interface_state_hash_free(&state_hash);
+    interfaces_interface_hash_free(&if_hash);
 }
 
-static void test_state_hash_add_incorrect(void** state)
+static void test_state_table_set_get_correct(void** state)
 {
     (void)state;
 
     int rc = 0;
+    const char* names[] = { "FOO", "BAR" };
+    uint8_t oper_state = 0;
+    time_t last_change = 0;
 
-    interfaces_interface_state_hash_element_t *state_hash, *new_elem;
-
-    state_hash = interfaces_interface_state_hash_new();
-    assert_null(state_hash);
-
-    new_elem = interfaces_interface_state_hash_element_new();
+    interfaces_interface_state_table_t table = { 0 };
 
-    interfaces_interface_state_hash_element_set_name(&new_elem, "FOO");
+    rc = interfaces_interface_state_table_set(&table, names[0], 2, 100);
     assert_int_equal(rc, 0);
 
-    rc = interfaces_interface_state_hash_add(&state_hash, new_elem);
+    rc = interfaces_interface_state_table_set(&table, names[1], 6, 200);
     assert_int_equal(rc, 0);
 
-    /* try adding the same element */
-    rc = interfaces_interface_state_hash_add(&state_hash, new_elem);
-    assert_int_not_equal(rc, 0);
-
-    interfaces_interface_state_hash_free(&state_hash);
-}
-
-static void test_state_hash_get_correct(void** state)
-{
-    (void)state;
-
-    int rc = 0;
-    const char* name = "FOO";
-
-    interfaces_interface_state_hash_element_t *state_hash, *new_elem, *found;
-
-    state_hash = interfaces_interface_state_hash_new();
-    assert_null(state_hash);
-
-    new_elem = interfaces_interface_state_hash_element_new();
+    rc = interfaces_interface_state_table_get(&table, names[0], &oper_state, &last_change);
+    assert_int_equal(rc, 0);
+    assert_int_equal(oper_state, 2);
+    assert_int_equal(last_change, 100);
 
-    interfaces_interface_state_hash_element_set_name(&new_elem, name);
+    // update existing entry in place
+    rc = interfaces_interface_state_table_set(&table, names[0], 6, 300);
     assert_int_equal(rc, 0);
 
-    rc = interfaces_interface_state_hash_add(&state_hash, new_elem);
+    rc = interfaces_interface_state_table_get(&table, names[0], &oper_state, &last_change);
     assert_int_equal(rc, 0);
+    assert_int_equal(oper_state, 6);
+    assert_int_equal(last_change, 300);
 
-    found = interfaces_interface_state_hash_get(state_hash, name);
-    assert_non_null(found);
+    rc = interfaces_interface_state_table_get(&table, names[1], &oper_state, NULL);
+    assert_int_equal(rc, 0);
+    assert_int_equal(oper_state, 6);
 
-    interfaces_interface_state_hash_free(&state_hash);
+    interfaces_interface_state_table_free(&table);
+    assert_null(table.elements);
 }
 
-static void test_state_hash_get_incorrect(void** state)
+static void test_state_table_get_incorrect(void** state)
 {
     (void)state;
 
     int rc = 0;
-    const char* names[] = { "FOO", "BAR" };
-
-    interfaces_interface_state_hash_element_t *state_hash, *new_elem, *found;
 
-    state_hash = interfaces_interface_state_hash_new();
-    assert_null(state_hash);
+    interfaces_interface_state_table_t table = { 0 };
 
-    new_elem = interfaces_interface_state_hash_element_new();
+    rc = interfaces_interface_state_table_get(&table, "FOO", NULL, NULL);
+    assert_int_equal(rc, -1);
 
-    interfaces_interface_state_hash_element_set_name(&new_elem, names[0]);
+    rc = interfaces_interface_state_table_set(&table, "FOO", 2, 100);
     assert_int_equal(rc, 0);
 
-    rc = interfaces_interface_state_hash_add(&state_hash, new_elem);
-    assert_int_equal(rc, 0);
-
-    found = interfaces_interface_state_hash_get(state_hash, names[1]);
-    assert_null(found);
+    rc = interfaces_interface_state_table_get(&table, "BAR", NULL, NULL);
+    assert_int_equal(rc, -1);
 
-    interfaces_interface_state_hash_free(&state_hash);
+    interfaces_interface_state_table_free(&table);
 }
 
-static void test_state_hash_set_name_correct(void** state)
+static void test_state_table_remove_correct(void** state)
 {
     (void)state;
 
     int rc = 0;
+    time_t last_change = 0;
 
-    interfaces_interface_state_hash_element_t* new_elem;
-
-    new_elem = interfaces_interface_state_hash_element_new();
+    interfaces_interface_state_table_t table = { 0 };
 
-    rc = interfaces_interface_state_hash_element_set_name(&new_elem, "FOO");
+    rc = interfaces_interface_state_table_set(&table, "FOO", 2, 100);
     assert_int_equal(rc, 0);
-    assert_non_null(new_elem->state.name);
-
-    interfaces_interface_state_hash_element_free(&new_elem);
-}
 
-static void test_state_hash_set_name_incorrect(void** state)
-{
-    (void)state;
+    rc = interfaces_interface_state_table_set(&table, "BAR", 6, 200);
+    assert_int_equal(rc, 0);
 
-    int rc = 0;
+    rc = interfaces_interface_state_table_remove(&table, "FOO");
+    assert_int_equal(rc, 0);
 
-    interfaces_interface_state_hash_element_t* new_elem;
+    rc = interfaces_interface_state_table_get(&table, "FOO", NULL, NULL);
+    assert_int_equal(rc, -1);
 
-    new_elem = interfaces_interface_state_hash_element_new();
+    rc = interfaces_interface_state_table_get(&table, "BAR", NULL, &last_change);
+    assert_int_equal(rc, 0);
+    assert_int_equal(last_change, 200);
 
-    rc = interfaces_interface_state_hash_element_set_name(&new_elem, NULL);
+    // removing a missing interface is not an error
+    rc = interfaces_interface_state_table_remove(&table, "FOO");
     assert_int_equal(rc, 0);
-    assert_null(new_elem->state.name);
 
-    interfaces_interface_state_hash_element_free(&new_elem);
+    interfaces_interface_state_table_free(&table);
 }
 
 static void test_interface_list_new_correct(void** state)
@@ -610,3 +659,591 @@ static void test_interface_ipv6_address_set_prefix_length_correct(void** state)
     interfaces_interface_ipv6_address_element_free(&address);
     assert_null(address);
 }
+
+static void test_link_index_add_get_correct(void** state)
+{
+    (void)state;
+
+    int rc = 0;
+    const char* names[] = { "FOO", "BAR" };
+    const int ifindexes[] = { 10, 20 };
+
+    interfaces_link_index_t index = { 0 };
+    struct rtnl_link* links[2] = { 0 };
+
+    for (int i = 0; i < 2; i++) {
+        links[i] = rtnl_link_alloc();
+        assert_non_null(links[i]);
+
+        rtnl_link_set_name(links[i], names[i]);
+        rtnl_link_set_ifindex(links[i], ifindexes[i]);
+
+        rc = interfaces_link_index_add(&index, links[i]);
+        assert_int_equal(rc, 0);
+    }
+
+    // duplicate entries are ignored
+    rc = interfaces_link_index_add(&index, links[0]);
+    assert_int_equal(rc, 0);
+    assert_int_equal(interfaces_link_index_count(&index), 2);
+
+    assert_ptr_equal(interfaces_link_index_get_by_name(&index, names[0]), links[0]);
+    assert_ptr_equal(interfaces_link_index_get_by_name(&index, names[1]), links[1]);
+    assert_ptr_equal(interfaces_link_index_get_by_ifindex(&index, ifindexes[0]), links[0]);
+    assert_ptr_equal(interfaces_link_index_get_by_ifindex(&index, ifindexes[1]), links[1]);
+
+    // the index holds its own references
+    rtnl_link_put(links[0]);
+    rtnl_link_put(links[1]);
+
+    assert_string_equal(rtnl_link_get_name(interfaces_link_index_get_by_ifindex(&index, ifindexes[1])), names[1]);
+
+    interfaces_link_index_free(&index);
+    assert_null(index.by_name);
+    assert_null(index.by_ifindex);
+    assert_int_equal(interfaces_link_index_count(&index), 0);
+}
+
+static void test_link_index_get_incorrect(void** state)
+{
+    (void)state;
+
+    int rc = 0;
+
+    interfaces_link_index_t index = { 0 };
+    struct rtnl_link* link = NULL;
+
+    assert_null(interfaces_link_index_get_by_name(&index, "FOO"));
+    assert_null(interfaces_link_index_get_by_ifindex(&index, 10));
+
+    link = rtnl_link_alloc();
+    assert_non_null(link);
+
+    rtnl_link_set_name(link, "FOO");
+    rtnl_link_set_ifindex(link, 10);
+
+    rc = interfaces_link_index_add(&index, link);
+    assert_int_equal(rc, 0);
+    rtnl_link_put(link);
+
+    assert_null(interfaces_link_index_get_by_name(&index, "BAR"));
+    assert_null(interfaces_link_index_get_by_ifindex(&index, 20));
+
+    interfaces_link_index_free(&index);
+}
+
+static void test_object_index_build_get_correct(void** state)
+{
+    (void)state;
+
+    int rc = 0;
+
+    interfaces_object_index_t index = { 0 };
+    struct nl_cache* addr_cache = NULL;
+    struct rtnl_addr* addrs[4] = { 0 };
+    struct nl_object* const* objects = NULL;
+    size_t count = 0;
+
+    const int ifindexes[] = { 2, 3, 2, 2 };
+    const int families[] = { AF_INET, AF_INET, AF_INET6, AF_INET };
+
+    rc = nl_cache_alloc_name("route/addr", &addr_cache);
+    assert_int_equal(rc, 0);
+
+    for (int i = 0; i < 4; i++) {
+        addrs[i] = rtnl_addr_alloc();
+        assert_non_null(addrs[i]);
+
+        rtnl_addr_set_ifindex(addrs[i], ifindexes[i]);
+        rtnl_addr_set_family(addrs[i], families[i]);
+
+        rc = nl_cache_add(addr_cache, (struct nl_object*)addrs[i]);
+        assert_int_equal(rc, 0);
+    }
+
+    rc = interfaces_object_index_build_addresses(&index, addr_cache);
+    assert_int_equal(rc, 0);
+    assert_int_equal(index.objects_count, 4);
+
+    // objects of one bucket keep the cache order
+    count = interfaces_object_index_get(&index, 2, AF_INET, &objects);
+    assert_int_equal(count, 2);
+    assert_ptr_equal(objects[0], addrs[0]);
+    assert_ptr_equal(objects[1], addrs[3]);
+
+    count = interfaces_object_index_get(&index, 3, AF_INET, &objects);
+    assert_int_equal(count, 1);
+    assert_ptr_equal(objects[0], addrs[1]);
+
+    count = interfaces_object_index_get(&index, 2, AF_INET6, &objects);
+    assert_int_equal(count, 1);
+    assert_ptr_equal(objects[0], addrs[2]);
+
+    // the index holds its own references
+    for (int i = 0; i < 4; i++) {
+        rtnl_addr_put(addrs[i]);
+    }
+    nl_cache_free(addr_cache);
+
+    assert_int_equal(rtnl_addr_get_ifindex((struct rtnl_addr*)objects[0]), 2);
+
+    interfaces_object_index_free(&index);
+    assert_null(index.objects);
+    assert_null(index.buckets);
+    assert_int_equal(index.objects_count, 0);
+}
+
+static void test_object_index_get_incorrect(void** state)
+{
+    (void)state;
+
+    int rc = 0;
+
+    interfaces_object_index_t index = { 0 };
+    struct nl_cache* neigh_cache = NULL;
+    struct rtnl_neigh* neigh = NULL;
+    struct nl_object* const* objects = NULL;
+
+    assert_int_equal(interfaces_object_index_get(&index, 2, AF_INET, &objects), 0);
+    assert_null(objects);
+
+    rc = nl_cache_alloc_name("route/neigh", &neigh_cache);
+    assert_int_equal(rc, 0);
+
+    // empty cache - empty index
+    rc = interfaces_object_index_build_neighbors(&index, neigh_cache);
+    assert_int_equal(rc, 0);
+    assert_int_equal(interfaces_object_index_get(&index, 2, AF_INET, &objects), 0);
+
+    neigh = rtnl_neigh_alloc();
+    assert_non_null(neigh);
+
+    rtnl_neigh_set_ifindex(neigh, 2);
+    rtnl_neigh_set_family(neigh, AF_INET);
+
+    rc = nl_cache_add(neigh_cache, (struct nl_object*)neigh);
+    assert_int_equal(rc, 0);
+    rtnl_neigh_put(neigh);
+
+    rc = interfaces_object_index_build_neighbors(&index, neigh_cache);
+    assert_int_equal(rc, 0);
+
+    assert_int_equal(interfaces_object_index_get(&index, 2, AF_INET6, &objects), 0);
+    assert_int_equal(interfaces_object_index_get(&index, 3, AF_INET, &objects), 0);
+    assert_int_equal(interfaces_object_index_get(&index, 2, AF_INET, &objects), 1);
+
+    interfaces_object_index_free(&index);
+    nl_cache_free(neigh_cache);
+}
+
+static void test_change_plan_add_undo_correct(void** state)
+{
+    (void)state;
+
+    int rc = 0;
+
+    interfaces_change_plan_t plan = { 0 };
+    struct rtnl_addr* addr = NULL;
+    struct rtnl_neigh* neigh = NULL;
+    struct rtnl_neigh* previous_neigh = NULL;
+    struct rtnl_link* link = NULL;
+    const interfaces_change_operation_t* operation = NULL;
+
+    interfaces_change_plan_init(&plan);
+
+    addr = rtnl_addr_alloc();
+    neigh = rtnl_neigh_alloc();
+    previous_neigh = rtnl_neigh_alloc();
+    link = rtnl_link_alloc();
+    assert_non_null(addr);
+    assert_non_null(neigh);
+    assert_non_null(previous_neigh);
+    assert_non_null(link);
+
+    // address requests undo each other with the same address
+    rc = interfaces_change_plan_add(&plan, interfaces_change_operation_address_add, "FOO", (struct nl_object*)addr, 0);
+    assert_int_equal(rc, 0);
+    operation = &plan.operations[0];
+    assert_string_equal(operation->interface_name, "FOO");
+    assert_ptr_equal(operation->object, addr);
+    assert_true(operation->undo.set);
+    assert_int_equal(operation->undo.type, interfaces_change_operation_address_delete);
+    assert_ptr_equal(operation->undo.object, addr);
+
+    rc = interfaces_change_plan_add(&plan, interfaces_change_operation_address_delete, "FOO", (struct nl_object*)addr, 0);
+    assert_int_equal(rc, 0);
+    assert_int_equal(plan.operations[1].undo.type, interfaces_change_operation_address_add);
+
+    // a new neighbor is undone by deleting it
+    rc = interfaces_change_plan_add(&plan, interfaces_change_operation_neighbor_add, "FOO", (struct nl_object*)neigh, NLM_F_CREATE);
+    assert_int_equal(rc, 0);
+    assert_true(plan.operations[2].undo.set);
+    assert_int_equal(plan.operations[2].undo.type, interfaces_change_operation_neighbor_delete);
+
+    // a replaced neighbor needs its previous LL address from the caller
+    rc = interfaces_change_plan_add(&plan, interfaces_change_operation_neighbor_add, "FOO", (struct nl_object*)neigh, NLM_F_CREATE | NLM_F_REPLACE);
+    assert_int_equal(rc, 0);
+    assert_false(plan.operations[3].undo.set);
+
+    rc = interfaces_change_plan_set_undo(&plan, interfaces_change_operation_neighbor_add, (struct nl_object*)previous_neigh, NLM_F_REPLACE);
+    assert_int_equal(rc, 0);
+    operation = &plan.operations[3];
+    assert_true(operation->undo.set);
+    assert_int_equal(operation->undo.type, interfaces_change_operation_neighbor_add);
+    assert_ptr_equal(operation->undo.object, previous_neigh);
+    assert_int_equal(operation->undo.flags, NLM_F_REPLACE);
+
+    // deleted neighbors and links are restored from state known only when they are sent
+    rc = interfaces_change_plan_add(&plan, interfaces_change_operation_neighbor_delete, "FOO", (struct nl_object*)neigh, 0);
+    assert_int_equal(rc, 0);
+    assert_false(plan.operations[4].undo.set);
+
+    rc = interfaces_change_plan_add(&plan, interfaces_change_operation_link_delete, "FOO", (struct nl_object*)link, 0);
+    assert_int_equal(rc, 0);
+    assert_false(plan.operations[5].undo.set);
+
+    // a new link is undone by deleting it by name
+    rc = interfaces_change_plan_add(&plan, interfaces_change_operation_link_add, "BAR", (struct nl_object*)link, NLM_F_CREATE);
+    assert_int_equal(rc, 0);
+    operation = &plan.operations[6];
+    assert_true(operation->undo.set);
+    assert_int_equal(operation->undo.type, interfaces_change_operation_link_delete);
+    assert_string_equal(rtnl_link_get_name((struct rtnl_link*)operation->undo.object), "BAR");
+
+    assert_int_equal(plan.count, 7);
+
+    // the plan holds its own references
+    rtnl_addr_put(addr);
+    rtnl_neigh_put(neigh);
+    rtnl_neigh_put(previous_neigh);
+    rtnl_link_put(link);
+
+    assert_int_equal(rtnl_neigh_get_ifindex((struct rtnl_neigh*)plan.operations[3].undo.object), 0);
+
+    assert_string_equal(interfaces_change_operation_type2str(interfaces_change_operation_neighbor_delete), "delete neighbor");
+
+    interfaces_change_plan_free(&plan);
+    assert_null(plan.operations);
+    assert_null(plan.links);
+    assert_int_equal(plan.count, 0);
+}
+
+static void test_change_plan_set_undo_incorrect(void** state)
+{
+    (void)state;
+
+    int rc = 0;
+
+    interfaces_change_plan_t plan = { 0 };
+    struct rtnl_addr* addr = NULL;
+
+    interfaces_change_plan_init(&plan);
+
+    addr = rtnl_addr_alloc();
+    assert_non_null(addr);
+
+    // no operation to undo yet
+    rc = interfaces_change_plan_set_undo(&plan, interfaces_change_operation_address_delete, (struct nl_object*)addr, 0);
+    assert_int_equal(rc, -1);
+
+    rtnl_addr_put(addr);
+    interfaces_change_plan_free(&plan);
+}
+
+static void test_change_plan_get_link_correct(void** state)
+{
+    (void)state;
+
+    int rc = 0;
+
+    interfaces_change_plan_t plan = { 0 };
+    struct nl_cache* link_cache = NULL;
+    struct rtnl_link* cached_link = NULL;
+    struct rtnl_link* new_link = NULL;
+    struct rtnl_link* delete_link = NULL;
+
+    interfaces_change_plan_init(&plan);
+
+    rc = nl_cache_alloc_name("route/link", &link_cache);
+    assert_int_equal(rc, 0);
+
+    cached_link = rtnl_link_alloc();
+    assert_non_null(cached_link);
+    rtnl_link_set_name(cached_link, "FOO");
+    rtnl_link_set_ifindex(cached_link, 10);
+
+    rc = nl_cache_add(link_cache, (struct nl_object*)cached_link);
+    assert_int_equal(rc, 0);
+    rtnl_link_put(cached_link);
+
+    // links not touched by the plan come from the cache
+    assert_ptr_equal(interfaces_change_plan_get_link(&plan, link_cache, "FOO"), cached_link);
+    assert_null(interfaces_change_plan_get_link(&plan, link_cache, "BAR"));
+
+    // a planned link is found before it reaches the kernel
+    new_link = rtnl_link_alloc();
+    assert_non_null(new_link);
+    rtnl_link_set_name(new_link, "BAR");
+
+    rc = interfaces_change_plan_add(&plan, interfaces_change_operation_link_add, "BAR", (struct nl_object*)new_link, NLM_F_CREATE);
+    assert_int_equal(rc, 0);
+    rtnl_link_put(new_link);
+
+    assert_ptr_equal(interfaces_change_plan_get_link(&plan, link_cache, "BAR"), new_link);
+
+    // a planned delete hides the cached link
+    delete_link = rtnl_link_alloc();
+    assert_non_null(delete_link);
+    rtnl_link_set_name(delete_link, "FOO");
+
+    rc = interfaces_change_plan_add(&plan, interfaces_change_operation_link_delete, "FOO", (struct nl_object*)delete_link, 0);
+    assert_int_equal(rc, 0);
+    rtnl_link_put(delete_link);
+
+    assert_null(interfaces_change_plan_get_link(&plan, link_cache, "FOO"));
+    assert_ptr_equal(interfaces_change_plan_get_link(&plan, link_cache, "BAR"), new_link);
+
+    interfaces_change_plan_free(&plan);
+    nl_cache_free(link_cache);
+}
+
+static void test_change_plan_get_link_request_correct(void** state)
+{
+    (void)state;
+
+    int rc = 0;
+
+    interfaces_change_plan_t plan = { 0 };
+    struct rtnl_link* request_link = NULL;
+    struct rtnl_link* other_link = NULL;
+    struct rtnl_link* link = NULL;
+
+    interfaces_change_plan_init(&plan);
+
+    // one request per interface, shared by all link attribute changes
+    request_link = interfaces_change_plan_get_link_request(&plan, "FOO");
+    assert_non_null(request_link);
+    assert_string_equal(rtnl_link_get_name(request_link), "FOO");
+    assert_null(rtnl_link_get_type(request_link));
+
+    assert_ptr_equal(interfaces_change_plan_get_link_request(&plan, "FOO"), request_link);
+    assert_int_equal(plan.count, 1);
+    assert_int_equal(plan.operations[0].type, interfaces_change_operation_link_change);
+    assert_ptr_equal(plan.operations[0].object, request_link);
+
+    other_link = interfaces_change_plan_get_link_request(&plan, "BAR");
+    assert_non_null(other_link);
+    assert_ptr_not_equal(other_link, request_link);
+    assert_int_equal(plan.count, 2);
+
+    // changes after the link is re-created go into a new request
+    link = rtnl_link_alloc();
+    assert_non_null(link);
+    rtnl_link_set_name(link, "FOO");
+
+    rc = interfaces_change_plan_add(&plan, interfaces_change_operation_link_delete, "FOO", (struct nl_object*)link, 0);
+    assert_int_equal(rc, 0);
+    rc = interfaces_change_plan_add(&plan, interfaces_change_operation_link_add, "FOO", (struct nl_object*)link, NLM_F_CREATE);
+    assert_int_equal(rc, 0);
+    rtnl_link_put(link);
+
+    request_link = interfaces_change_plan_get_link_request(&plan, "FOO");
+    assert_non_null(request_link);
+    assert_ptr_not_equal(request_link, plan.operations[0].object);
+    assert_int_equal(plan.count, 5);
+    assert_ptr_equal(plan.operations[4].object, request_link);
+
+    assert_ptr_equal(interfaces_change_plan_get_link_request(&plan, "FOO"), request_link);
+    assert_ptr_equal(interfaces_change_plan_get_link_request(&plan, "BAR"), other_link);
+    assert_int_equal(plan.count, 5);
+
+    interfaces_change_plan_free(&plan);
+}
+
+static void test_change_plan_check_correct(void** state)
+{
+    (void)state;
+
+    int rc = 0;
+
+    interfaces_change_plan_t plan = { 0 };
+    struct nl_cache* link_cache = NULL;
+    struct rtnl_link* link = NULL;
+    struct rtnl_addr* addr = NULL;
+
+    interfaces_change_plan_init(&plan);
+
+    rc = nl_cache_alloc_name("route/link", &link_cache);
+    assert_int_equal(rc, 0);
+
+    link = rtnl_link_alloc();
+    assert_non_null(link);
+    rtnl_link_set_name(link, "FOO");
+    rtnl_link_set_ifindex(link, 10);
+
+    rc = nl_cache_add(link_cache, (struct nl_object*)link);
+    assert_int_equal(rc, 0);
+
+    addr = rtnl_addr_alloc();
+    assert_non_null(addr);
+
+    // empty plan
+    assert_int_equal(interfaces_change_plan_check(&plan, link_cache), 0);
+
+    // existing link, a link added by the plan and a link deleted and added again
+    assert_int_equal(interfaces_change_plan_add(&plan, interfaces_change_operation_address_add, "FOO", (struct nl_object*)addr, 0), 0);
+    assert_int_equal(interfaces_change_plan_add(&plan, interfaces_change_operation_link_add, "BAR", (struct nl_object*)link, NLM_F_CREATE), 0);
+    assert_int_equal(interfaces_change_plan_add(&plan, interfaces_change_operation_address_add, "BAR", (struct nl_object*)addr, 0), 0);
+    assert_int_equal(interfaces_change_plan_add(&plan, interfaces_change_operation_link_delete, "FOO", (struct nl_object*)link, 0), 0);
+    assert_int_equal(interfaces_change_plan_add(&plan, interfaces_change_operation_link_add, "FOO", (struct nl_object*)link, NLM_F_CREATE), 0);
+    assert_non_null(interfaces_change_plan_get_link_request(&plan, "FOO"));
+
+    assert_int_equal(interfaces_change_plan_check(&plan, link_cache), 0);
+
+    rtnl_link_put(link);
+    rtnl_addr_put(addr);
+    interfaces_change_plan_free(&plan);
+    nl_cache_free(link_cache);
+}
+
+static void test_change_plan_check_incorrect(void** state)
+{
+    (void)state;
+
+    int rc = 0;
+
+    interfaces_change_plan_t plan = { 0 };
+    struct nl_cache* link_cache = NULL;
+    struct rtnl_link* link = NULL;
+    struct rtnl_addr* addr = NULL;
+
+    rc = nl_cache_alloc_name("route/link", &link_cache);
+    assert_int_equal(rc, 0);
+
+    link = rtnl_link_alloc();
+    assert_non_null(link);
+    rtnl_link_set_name(link, "FOO");
+    rtnl_link_set_ifindex(link, 10);
+
+    rc = nl_cache_add(link_cache, (struct nl_object*)link);
+    assert_int_equal(rc, 0);
+
+    addr = rtnl_addr_alloc();
+    assert_non_null(addr);
+
+    // missing link
+    interfaces_change_plan_init(&plan);
+    assert_int_equal(interfaces_change_plan_add(&plan, interfaces_change_operation_address_add, "BAR", (struct nl_object*)addr, 0), 0);
+    assert_int_equal(interfaces_change_plan_check(&plan, link_cache), -1);
+    interfaces_change_plan_free(&plan);
+
+    // link deleted earlier in the plan
+    interfaces_change_plan_init(&plan);
+    assert_int_equal(interfaces_change_plan_add(&plan, interfaces_change_operation_link_delete, "FOO", (struct nl_object*)link, 0), 0);
+    assert_int_equal(interfaces_change_plan_add(&plan, interfaces_change_operation_address_delete, "FOO", (struct nl_object*)addr, 0), 0);
+    assert_int_equal(interfaces_change_plan_check(&plan, link_cache), -1);
+    interfaces_change_plan_free(&plan);
+
+    // existing link added again
+    interfaces_change_plan_init(&plan);
+    assert_int_equal(interfaces_change_plan_add(&plan, interfaces_change_operation_link_add, "FOO", (struct nl_object*)link, NLM_F_CREATE), 0);
+    assert_int_equal(interfaces_change_plan_check(&plan, link_cache), -1);
+    interfaces_change_plan_free(&plan);
+
+    rtnl_link_put(link);
+    rtnl_addr_put(addr);
+    nl_cache_free(link_cache);
+}
+
+static struct rtnl_addr* oper_address_new(const char* ip, int family, unsigned int flags)
+{
+    struct rtnl_addr* addr = NULL;
+    struct nl_addr* local = NULL;
+
+    addr = rtnl_addr_alloc();
+    assert_non_null(addr);
+
+    assert_int_equal(nl_addr_parse(ip, family, &local), 0);
+    assert_int_equal(rtnl_addr_set_local(addr, local), 0);
+    rtnl_addr_set_flags(addr, flags);
+
+    nl_addr_put(local);
+
+    return addr;
+}
+
+static void test_oper_address_origin_correct(void** state)
+{
+    (void)state;
+
+    struct rtnl_addr* addr = NULL;
+
+    // IPv4
+    addr = oper_address_new("192.0.2.1", AF_INET, IFA_F_PERMANENT);
+    assert_string_equal(interfaces_oper_get_address_origin(addr), "static");
+    rtnl_addr_put(addr);
+
+    addr = oper_address_new("192.0.2.1", AF_INET, 0);
+    assert_string_equal(interfaces_oper_get_address_origin(addr), "dhcp");
+    rtnl_addr_put(addr);
+
+    // secondary shares its value with the IPv6 temporary flag
+    addr = oper_address_new("192.0.2.1", AF_INET, IFA_F_SECONDARY);
+    assert_string_equal(interfaces_oper_get_address_origin(addr), "dhcp");
+    rtnl_addr_put(addr);
+
+    addr = oper_address_new("192.0.2.1", AF_INET, IFA_F_SECONDARY | IFA_F_PERMANENT);
+    assert_string_equal(interfaces_oper_get_address_origin(addr), "static");
+    rtnl_addr_put(addr);
+
+    // IPv6 link-local is permanent but generated by the kernel
+    addr = oper_address_new("fe80::1", AF_INET6, IFA_F_PERMANENT);
+    assert_string_equal(interfaces_oper_get_address_origin(addr), "link-layer");
+    rtnl_addr_put(addr);
+
+    addr = oper_address_new("febf::1", AF_INET6, IFA_F_PERMANENT);
+    assert_string_equal(interfaces_oper_get_address_origin(addr), "link-layer");
+    rtnl_addr_put(addr);
+
+    addr = oper_address_new("fec0::1", AF_INET6, IFA_F_PERMANENT);
+    assert_string_equal(interfaces_oper_get_address_origin(addr), "static");
+    rtnl_addr_put(addr);
+
+    addr = oper_address_new("2001:db8::1", AF_INET6, IFA_F_PERMANENT);
+    assert_string_equal(interfaces_oper_get_address_origin(addr), "static");
+    rtnl_addr_put(addr);
+
+    addr = oper_address_new("2001:db8::1", AF_INET6, IFA_F_TEMPORARY);
+    assert_string_equal(interfaces_oper_get_address_origin(addr), "random");
+    rtnl_addr_put(addr);
+
+    addr = oper_address_new("2001:db8::1", AF_INET6, 0);
+    assert_string_equal(interfaces_oper_get_address_origin(addr), "link-layer");
+    rtnl_addr_put(addr);
+}
+
+static void test_oper_ipv6_address_status_correct(void** state)
+{
+    (void)state;
+
+    const struct {
+        unsigned int flags;
+        const char* status;
+    } cases[] = {
+        { 0, "preferred" },
+        { IFA_F_PERMANENT, "preferred" },
+        { IFA_F_DEPRECATED, "deprecated" },
+        { IFA_F_TENTATIVE, "tentative" },
+        { IFA_F_OPTIMISTIC, "optimistic" },
+        { IFA_F_OPTIMISTIC | IFA_F_TENTATIVE, "optimistic" },
+        { IFA_F_DADFAILED, "duplicate" },
+        { IFA_F_DADFAILED | IFA_F_TENTATIVE, "duplicate" },
+        { IFA_F_TENTATIVE | IFA_F_DEPRECATED, "tentative" },
+    };
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        struct rtnl_addr* addr = oper_address_new("2001:db8::1", AF_INET6, cases[i].flags);
+        assert_string_equal(interfaces_oper_get_ipv6_address_status(addr), cases[i].status);
+        rtnl_addr_put(addr);
+    }
+}
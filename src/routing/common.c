@@ -15,6 +15,10 @@
 #include <utils/memory.h>
 #include <routing/route/next_hop.h>
 
+// stdlib
+#include <pthread.h>
+#include <stdatomic.h>
+
 #include <sysrepo.h>
 
 #include <netlink/route/route.h>
@@ -22,43 +26,35 @@
 
 #include <utlist.h>
 
+// routes of one RIB from the shared dump - built into the RIB by a single worker
+struct routing_collect_task {
+	struct rib *rib;
+	int table_id;
+	struct rtnl_route **routes;
+	size_t routes_count;
+	size_t routes_size;
+};
+
+struct routing_parallel_ctx {
+	size_t count;
+	atomic_size_t next;
+	routing_parallel_cb cb;
+	void *arg;
+};
+
+static void routing_collect_rib_routes(size_t index, void *arg);
+static void routing_index_rib(struct rib *rib);
+static void *routing_parallel_worker(void *arg);
+static int routing_queue_static_routes(struct route_batch *batch, enum route_batch_operation operation, struct route_list_hash_element *routes_hash);
+static int routing_build_static_route(enum route_batch_operation operation, struct nl_addr *prefix, struct route *static_route, struct rtnl_route **out);
+static void routing_set_next_hop_gateway(struct rtnl_nexthop *next_hop, const struct route_address *gateway);
+
 void foreach_nexthop(struct rtnl_nexthop *nh, void *arg)
 {
 	struct route_next_hop *nexthop = arg;
-	struct nl_cache *link_cache = NULL;
-	struct nl_sock *socket = NULL;
-	struct rtnl_link *iface = NULL;
-	int ifindex = 0;
-	char *if_name = NULL;
-	int nl_err = 0;
-
-	socket = nl_socket_alloc();
-	if (socket == NULL) {
-		SRPLG_LOG_ERR(PLUGIN_NAME, "unable to init nl_sock struct...");
-		return;
-	}
-
-	nl_err = nl_connect(socket, NETLINK_ROUTE);
-	if (nl_err != 0) {
-		SRPLG_LOG_ERR(PLUGIN_NAME, "nl_connect failed (%d): %s", nl_err, nl_geterror(nl_err));
-		return;
-	}
-
-	nl_err = rtnl_link_alloc_cache(socket, AF_UNSPEC, &link_cache);
-	if (nl_err != 0) {
-		SRPLG_LOG_ERR(PLUGIN_NAME, "rtnl_route_alloc_cache failed (%d): %s", nl_err, nl_geterror(nl_err));
-		return;
-	}
-
-	ifindex = rtnl_route_nh_get_ifindex(nh);
-	iface = rtnl_link_get(link_cache, ifindex);
-	if_name = xstrdup(rtnl_link_get_name(iface));
-
-	route_next_hop_add_list(nexthop, ifindex, if_name, rtnl_route_nh_get_gateway(nh));
 
-	rtnl_link_put(iface);
-	nl_cache_free(link_cache);
-	nl_socket_free(socket);
+	// only the ifindex is stored - names are resolved from the interface table when serialized
+	route_next_hop_add_list(nexthop, rtnl_route_nh_get_ifindex(nh), rtnl_route_nh_get_gateway(nh));
 }
 
 int routing_collect_ribs(struct nl_cache *routes_cache, struct rib_list_element **ribs_head)
@@ -102,116 +98,178 @@ out:
 	return error;
 }
 
-int routing_collect_routes(struct nl_cache *routes_cache, struct nl_cache *link_cache, struct rib_list_element **ribs_head)
+int routing_collect_routes(struct nl_cache *routes_cache, struct rib_list_element **ribs_head, unsigned int workers)
 {
 	int error = 0;
 	struct rtnl_route *route = NULL;
-	struct route tmp_route = {0};
 	char table_buffer[32] = {0};
-	struct rib *tmp_rib = NULL;
-	struct rtnl_link *iface = NULL;
-	int ifindex = 0;
-	char *if_name = NULL;
 	struct rib_list_element *ribs_iter = NULL;
-	struct route_list_hash_element *routes_hash_iter = NULL;
-	struct route_list_element *routes_iter = NULL;
+	struct routing_collect_task *tasks = NULL, *task = NULL;
+	size_t tasks_count = 0;
 
 	error = routing_collect_ribs(routes_cache, ribs_head);
 	if (error != 0) {
 		goto error_out;
 	}
 
-	// gather all routes for each table
+	LL_COUNT(*ribs_head, ribs_iter, tasks_count);
+	tasks = xcalloc(tasks_count, sizeof(*tasks));
+
+	// partition the dump by RIB - every RIB has its own hash, trie and arena and is built without locking
 	route = (struct rtnl_route *) nl_cache_get_first(routes_cache);
 	while (route != NULL) {
 		// fetch table name
 		const int table_id = (int) rtnl_route_get_table(route);
-		const int route_type = (int) rtnl_route_get_type(route);
 		const uint8_t af = rtnl_route_get_family(route);
-		rtnl_route_table2str(table_id, table_buffer, sizeof(table_buffer));
 
-		// get the current RIB of the route
-		tmp_rib = rib_list_get(ribs_head, table_buffer, af);
-		if (tmp_rib == NULL) {
-			error = -1;
-			goto error_out;
-		}
+		// routes of a table are mostly dumped together - skip the RIB lookup for consecutive routes
+		if (task == NULL || task->table_id != table_id || task->rib->address_family != af) {
+			struct rib *tmp_rib = NULL;
 
-		// fill the route with info and add to the hash of the current RIB
-		route_init(&tmp_route);
-		route_set_preference(&tmp_route, rtnl_route_get_priority(route));
+			rtnl_route_table2str(table_id, table_buffer, sizeof(table_buffer));
 
-		// next-hop container
-		switch (route_type) {
-			case RTN_BLACKHOLE:
-				route_next_hop_set_special(&tmp_route.next_hop, "blackhole");
-				break;
-			case RTN_UNREACHABLE:
-				route_next_hop_set_special(&tmp_route.next_hop, "unreachable");
-				break;
-			case RTN_PROHIBIT:
-				route_next_hop_set_special(&tmp_route.next_hop, "prohibit");
-				break;
-			case RTN_LOCAL:
-				route_next_hop_set_special(&tmp_route.next_hop, "local");
-				break;
-			default: {
-				const int NEXTHOP_COUNT = rtnl_route_get_nnexthops(route);
-				if (NEXTHOP_COUNT == 1) {
-					struct rtnl_nexthop *nh = rtnl_route_nexthop_n(route, 0);
-					ifindex = rtnl_route_nh_get_ifindex(nh);
-					iface = rtnl_link_get(link_cache, ifindex);
-					if_name = rtnl_link_get_name(iface);
-					route_next_hop_set_simple(&tmp_route.next_hop, ifindex, if_name, rtnl_route_nh_get_gateway(nh));
-
-					// free recieved link
-					rtnl_link_put(iface);
-				} else {
-					rtnl_route_foreach_nexthop(route, foreach_nexthop, &tmp_route.next_hop);
+			// get the current RIB of the route
+			tmp_rib = rib_list_get(ribs_head, table_buffer, af);
+			if (tmp_rib == NULL) {
+				error = -1;
+				goto error_out;
+			}
+
+			task = NULL;
+			for (size_t i = 0; i < tasks_count && tasks[i].rib != NULL; i++) {
+				if (tasks[i].rib == tmp_rib) {
+					task = &tasks[i];
+					break;
 				}
 			}
-		}
 
-		// route-metadata/source-protocol
-		if (rtnl_route_get_protocol(route) == RTPROT_STATIC) {
-			route_set_source_protocol(&tmp_route, "ietf-routing:static");
-		} else {
-			route_set_source_protocol(&tmp_route, "ietf-routing:direct");
+			if (task == NULL) {
+				for (task = tasks; task->rib != NULL; task++) {
+				}
+				task->rib = tmp_rib;
+			}
+			task->table_id = table_id;
 		}
 
-		// add the created route to the hash by a destination address
-		route_list_hash_add(&tmp_rib->routes_head, rtnl_route_get_dst(route), &tmp_route);
+		if (task->routes_count == task->routes_size) {
+			task->routes_size = task->routes_size ? task->routes_size * 2 : 64;
+			task->routes = xrealloc(task->routes, task->routes_size * sizeof(*task->routes));
+		}
+		task->routes[task->routes_count++] = route;
 
-		// last-updated -> TODO: implement later
-		route_free(&tmp_route);
 		route = (struct rtnl_route *) nl_cache_get_next((struct nl_object *) route);
 	}
 
-	LL_FOREACH(*ribs_head, ribs_iter)
-	{
-		struct route_list_hash_element **routes_hash_head = &ribs_iter->rib.routes_head;
+	routing_parallel_for(tasks_count, workers, routing_collect_rib_routes, tasks);
 
-		LL_FOREACH(*routes_hash_head, routes_hash_iter)
-		{
-			struct route_list_element **routes_list_head = &routes_hash_iter->routes_head;
-			if (*routes_list_head != NULL) {
-				struct route *pref = &(*routes_list_head)->route;
-
-				LL_FOREACH(*routes_list_head, routes_iter)
-				{
-					// struct route *ptr = &ls->list[k];
-					if (routes_iter->route.preference < pref->preference) {
-						pref = &routes_iter->route;
-					}
-				}
+error_out:
+	for (size_t i = 0; i < tasks_count; i++) {
+		FREE_SAFE(tasks[i].routes);
+	}
+	FREE_SAFE(tasks);
 
-				pref->metadata.active = 1;
+	return error;
+}
+
+void routing_parallel_for(size_t count, unsigned int workers, routing_parallel_cb cb, void *arg)
+{
+	struct routing_parallel_ctx ctx = {
+		.count = count,
+		.cb = cb,
+		.arg = arg,
+	};
+	pthread_t *threads = NULL;
+	size_t threads_count = 0;
+
+	atomic_init(&ctx.next, 0);
+
+	if (workers > count) {
+		workers = (unsigned int) count;
+	}
+
+	// the caller is one of the workers - a failed thread start only lowers the parallelism
+	if (workers > 1) {
+		threads = xmalloc((workers - 1) * sizeof(*threads));
+		for (unsigned int i = 0; i < workers - 1; i++) {
+			if (pthread_create(&threads[threads_count], NULL, routing_parallel_worker, &ctx) != 0) {
+				SRPLG_LOG_INF(PLUGIN_NAME, "unable to start worker thread - continuing with %zu workers", threads_count + 1);
+				break;
 			}
+			threads_count++;
 		}
 	}
 
-error_out:
-	return error;
+	routing_parallel_worker(&ctx);
+
+	for (size_t i = 0; i < threads_count; i++) {
+		pthread_join(threads[i], NULL);
+	}
+
+	FREE_SAFE(threads);
+}
+
+void routing_build_route(struct rtnl_route *route, struct route *out)
+{
+	const int route_type = (int) rtnl_route_get_type(route);
+
+	route_init(out);
+	route_set_preference(out, rtnl_route_get_priority(route));
+
+	// next-hop container
+	switch (route_type) {
+		case RTN_BLACKHOLE:
+			route_next_hop_set_special(&out->next_hop, route_next_hop_special_blackhole);
+			break;
+		case RTN_UNREACHABLE:
+			route_next_hop_set_special(&out->next_hop, route_next_hop_special_unreachable);
+			break;
+		case RTN_PROHIBIT:
+			route_next_hop_set_special(&out->next_hop, route_next_hop_special_prohibit);
+			break;
+		case RTN_LOCAL:
+			// local routes are the receive special next-hop of the model
+			route_next_hop_set_special(&out->next_hop, route_next_hop_special_receive);
+			break;
+		default: {
+			const int NEXTHOP_COUNT = rtnl_route_get_nnexthops(route);
+			if (NEXTHOP_COUNT == 1) {
+				struct rtnl_nexthop *nh = rtnl_route_nexthop_n(route, 0);
+				route_next_hop_set_simple(&out->next_hop, rtnl_route_nh_get_ifindex(nh), rtnl_route_nh_get_gateway(nh));
+			} else {
+				rtnl_route_foreach_nexthop(route, foreach_nexthop, &out->next_hop);
+			}
+		}
+	}
+
+	// route-metadata/source-protocol
+	if (rtnl_route_get_protocol(route) == RTPROT_STATIC) {
+		route_set_source_protocol(out, route_source_protocol_static);
+	} else {
+		route_set_source_protocol(out, route_source_protocol_direct);
+	}
+}
+
+void routing_update_active_route(struct route_list_element **routes_head)
+{
+	struct route_list_element *routes_iter = NULL;
+	struct route *pref = NULL;
+
+	if (*routes_head == NULL) {
+		return;
+	}
+
+	// the route with the lowest preference value of a prefix is the active one
+	pref = &(*routes_head)->route;
+
+	LL_FOREACH(*routes_head, routes_iter)
+	{
+		routes_iter->route.metadata.active = 0;
+		if (routes_iter->route.preference < pref->preference) {
+			pref = &routes_iter->route;
+		}
+	}
+
+	pref->metadata.active = 1;
 }
 
 int routing_build_rib_descriptions(struct rib_list_element **ribs_head)
@@ -263,15 +321,28 @@ int routing_is_rib_known(int table)
 	return table == RT_TABLE_DEFAULT || table == RT_TABLE_LOCAL || table == RT_TABLE_MAIN;
 }
 
-int routing_apply_new_routes(struct nl_sock *socket, struct route_list_hash_element *routes_hash)
+int routing_apply_new_routes(struct route_batch *batch, struct route_list_hash_element *routes_hash)
+{
+	return routing_queue_static_routes(batch, route_batch_operation_add, routes_hash);
+}
+
+int routing_apply_modify_routes(struct route_batch *batch, struct route_list_hash_element *routes_hash)
+{
+	// the kernel replaces the route with the same prefix and preference
+	return routing_queue_static_routes(batch, route_batch_operation_replace, routes_hash);
+}
+
+int routing_apply_delete_routes(struct route_batch *batch, struct route_list_hash_element *routes_hash)
+{
+	return routing_queue_static_routes(batch, route_batch_operation_delete, routes_hash);
+}
+
+static int routing_queue_static_routes(struct route_batch *batch, enum route_batch_operation operation, struct route_list_hash_element *routes_hash)
 {
 	int error = 0;
-	int nl_err = 0;
 
 	// libnl
 	struct rtnl_route *route = NULL;
-	struct rtnl_nexthop *next_hop = NULL;
-	struct nl_addr *dst_addr = NULL;
 
 	// plugin
 	struct route_list_hash_element *routes_iter = NULL;
@@ -281,73 +352,20 @@ int routing_apply_new_routes(struct nl_sock *socket, struct route_list_hash_elem
 	{
 		LL_FOREACH(routes_iter->routes_head, route_iter)
 		{
-			route = rtnl_route_alloc();
-			if (route == NULL) {
-				SRPLG_LOG_ERR(PLUGIN_NAME, "unable to alloc rtnl_route struct");
+			error = routing_build_static_route(operation, routes_iter->prefix, &route_iter->route, &route);
+			if (error != 0) {
 				goto error_out;
 			}
 
-			dst_addr = nl_addr_clone(routes_iter->prefix);
-
-			rtnl_route_set_table(route, RT_TABLE_MAIN);
-			rtnl_route_set_protocol(route, RTPROT_STATIC);
-			rtnl_route_set_dst(route, dst_addr);
-			rtnl_route_set_priority(route, route_iter->route.preference);
-
-			if (route_iter->route.next_hop.kind == route_next_hop_kind_simple) {
-				next_hop = rtnl_route_nh_alloc();
-				if (next_hop == NULL) {
-					error = -1;
-					SRPLG_LOG_ERR(PLUGIN_NAME, "unable to alloc rtnl_nexthop struct");
-					goto error_out;
-				}
-
-				if (route_iter->route.next_hop.value.simple.if_name == NULL && route_iter->route.next_hop.value.simple.addr == NULL) {
-					error = -1;
-					SRPLG_LOG_ERR(PLUGIN_NAME, "outgoing-interface and next-hop-address can't both be NULL");
-					goto error_out;
-				}
-
-				if (route_iter->route.next_hop.value.simple.if_name != NULL) {
-					rtnl_route_nh_set_ifindex(next_hop, route_iter->route.next_hop.value.simple.ifindex);
-				}
-
-				if (route_iter->route.next_hop.value.simple.addr != NULL) {
-					rtnl_route_nh_set_gateway(next_hop, route_iter->route.next_hop.value.simple.addr);
-				}
-				rtnl_route_add_nexthop(route, next_hop);
-			} else if (route_iter->route.next_hop.kind == route_next_hop_kind_list) {
-				struct route_next_hop_list_element *nexthop_iter = NULL;
-
-				LL_FOREACH(route_iter->route.next_hop.value.list_head, nexthop_iter)
-				{
-					next_hop = rtnl_route_nh_alloc();
-					if (next_hop == NULL) {
-						error = -1;
-						SRPLG_LOG_ERR(PLUGIN_NAME, "unable to alloc rtnl_nexthop struct");
-						goto error_out;
-					}
-
-					rtnl_route_nh_set_ifindex(next_hop, nexthop_iter->simple.ifindex);
-					rtnl_route_nh_set_gateway(next_hop, nexthop_iter->simple.addr);
-					rtnl_route_add_nexthop(route, next_hop);
-				}
-			}
-
-			rtnl_route_set_scope(route, (uint8_t) rtnl_route_guess_scope(route));
-
-			// create new route
-			nl_err = rtnl_route_add(socket, route, NLM_F_CREATE);
-			if (nl_err != 0) {
-				error = -1;
-				SRPLG_LOG_ERR(PLUGIN_NAME, "rtnl_route_add() failed (%d): %s", nl_err, nl_geterror(nl_err));
+			// only queued - ACKs are collected when the batch is flushed
+			error = route_batch_add(batch, operation, route);
+			if (error != 0) {
+				SRPLG_LOG_ERR(PLUGIN_NAME, "route_batch_add() failed (%d)", error);
 				goto error_out;
 			}
 
-			nl_addr_put(dst_addr);
 			rtnl_route_put(route);
 			route = NULL;
-			dst_addr = NULL;
 		}
 	}
 
@@ -357,10 +375,6 @@ error_out:
 	error = -1;
 
 out:
-	if (dst_addr) {
-		nl_addr_put(dst_addr);
-	}
-
 	if (route) {
 		rtnl_route_put(route);
 	}
@@ -368,70 +382,142 @@ out:
 	return error;
 }
 
-int routing_apply_modify_routes(struct nl_sock *socket, struct route_list_hash_element *routes_hash)
-{
-	int error = 0;
-
-	return error;
-}
-
-int routing_apply_delete_routes(struct nl_sock *socket, struct route_list_hash_element *routes_hash)
+static int routing_build_static_route(enum route_batch_operation operation, struct nl_addr *prefix, struct route *static_route, struct rtnl_route **out)
 {
 	int error = 0;
-	int nl_err = 0;
 
 	// libnl
 	struct rtnl_route *route = NULL;
+	struct rtnl_nexthop *next_hop = NULL;
 	struct nl_addr *dst_addr = NULL;
 
-	// plugin
-	struct route_list_hash_element *routes_iter = NULL;
-	struct route_list_element *route_iter = NULL;
+	route = rtnl_route_alloc();
+	if (route == NULL) {
+		SRPLG_LOG_ERR(PLUGIN_NAME, "unable to alloc rtnl_route struct");
+		goto error_out;
+	}
 
-	LL_FOREACH(routes_hash, routes_iter)
-	{
-		LL_FOREACH(routes_iter->routes_head, route_iter)
-		{
-			route = rtnl_route_alloc();
-			if (route == NULL) {
-				error = -1;
-				SRPLG_LOG_ERR(PLUGIN_NAME, "unable to alloc rtnl_route struct");
-				goto error_out;
-			}
+	dst_addr = nl_addr_clone(prefix);
 
-			// alloc destination prefix for route
-			dst_addr = nl_addr_clone(routes_iter->prefix);
+	rtnl_route_set_table(route, RT_TABLE_MAIN);
+	rtnl_route_set_protocol(route, RTPROT_STATIC);
+	rtnl_route_set_dst(route, dst_addr);
+	rtnl_route_set_priority(route, static_route->preference);
 
-			// setup route for deletion
-			rtnl_route_set_table(route, RT_TABLE_MAIN);
-			rtnl_route_set_protocol(route, RTPROT_STATIC);
-			rtnl_route_set_dst(route, dst_addr);
-			rtnl_route_set_priority(route, route_iter->route.preference);
-			rtnl_route_set_scope(route, RT_SCOPE_NOWHERE);
+	// deletion only needs the route key
+	if (operation == route_batch_operation_delete) {
+		rtnl_route_set_scope(route, RT_SCOPE_NOWHERE);
+		goto out;
+	}
 
-			// delete route
-			nl_err = rtnl_route_delete(socket, route, 0);
-			if (nl_err != 0) {
-				SRPLG_LOG_ERR(PLUGIN_NAME, "rtnl_route_delete() failed (%d): %s", nl_err, nl_geterror(nl_err));
-				error = -1;
+	if (static_route->next_hop.kind == route_next_hop_kind_simple) {
+		if (static_route->next_hop.value.simple.ifindex == 0 && !route_address_is_set(&static_route->next_hop.value.simple.addr)) {
+			SRPLG_LOG_ERR(PLUGIN_NAME, "outgoing-interface and next-hop-address can't both be NULL");
+			goto error_out;
+		}
+
+		next_hop = rtnl_route_nh_alloc();
+		if (next_hop == NULL) {
+			SRPLG_LOG_ERR(PLUGIN_NAME, "unable to alloc rtnl_nexthop struct");
+			goto error_out;
+		}
+
+		if (static_route->next_hop.value.simple.ifindex != 0) {
+			rtnl_route_nh_set_ifindex(next_hop, static_route->next_hop.value.simple.ifindex);
+		}
+
+		routing_set_next_hop_gateway(next_hop, &static_route->next_hop.value.simple.addr);
+		rtnl_route_add_nexthop(route, next_hop);
+	} else if (static_route->next_hop.kind == route_next_hop_kind_list) {
+		struct route_next_hop_list_element *nexthop_iter = NULL;
+
+		LL_FOREACH(static_route->next_hop.value.list_head, nexthop_iter)
+		{
+			next_hop = rtnl_route_nh_alloc();
+			if (next_hop == NULL) {
+				SRPLG_LOG_ERR(PLUGIN_NAME, "unable to alloc rtnl_nexthop struct");
 				goto error_out;
 			}
 
-			nl_addr_put(dst_addr);
-			rtnl_route_put(route);
-			route = NULL;
-			dst_addr = NULL;
+			rtnl_route_nh_set_ifindex(next_hop, nexthop_iter->simple.ifindex);
+			routing_set_next_hop_gateway(next_hop, &nexthop_iter->simple.addr);
+			rtnl_route_add_nexthop(route, next_hop);
 		}
 	}
 
+	rtnl_route_set_scope(route, (uint8_t) rtnl_route_guess_scope(route));
+
+	goto out;
+
 error_out:
-	if (dst_addr) {
-		nl_addr_put(dst_addr);
-	}
+	error = -1;
 
 	if (route) {
 		rtnl_route_put(route);
+		route = NULL;
+	}
+
+out:
+	if (dst_addr) {
+		nl_addr_put(dst_addr);
 	}
 
+	*out = route;
+
 	return error;
-}
\ No newline at end of file
+}
+
+static void routing_set_next_hop_gateway(struct rtnl_nexthop *next_hop, const struct route_address *gateway)
+{
+	struct nl_addr *addr = route_address_to_nl_addr(gateway);
+
+	if (addr) {
+		// the next-hop takes its own reference
+		rtnl_route_nh_set_gateway(next_hop, addr);
+		nl_addr_put(addr);
+	}
+}
+
+static void routing_collect_rib_routes(size_t index, void *arg)
+{
+	struct routing_collect_task *task = &((struct routing_collect_task *) arg)[index];
+	struct route tmp_route = {0};
+
+	for (size_t i = 0; i < task->routes_count; i++) {
+		// fill the route with info and add to the hash of the current RIB
+		routing_build_route(task->routes[i], &tmp_route);
+
+		// add the created route to the hash by a destination address
+		route_list_hash_add_arena(&task->rib->routes_head, &task->rib->routes_arena, rtnl_route_get_dst(task->routes[i]), &tmp_route);
+
+		// last-updated -> TODO: implement later
+		route_free(&tmp_route);
+	}
+
+	routing_index_rib(task->rib);
+}
+
+static void routing_index_rib(struct rib *rib)
+{
+	struct route_list_hash_element *routes_hash_iter = NULL;
+
+	LL_FOREACH(rib->routes_head, routes_hash_iter)
+	{
+		routing_update_active_route(&routes_hash_iter->routes_head);
+
+		// index the prefix for active-route lookups
+		rib_trie_insert(&rib->routes_trie, routes_hash_iter);
+	}
+}
+
+static void *routing_parallel_worker(void *arg)
+{
+	struct routing_parallel_ctx *ctx = arg;
+	size_t index = 0;
+
+	while ((index = atomic_fetch_add(&ctx->next, 1)) < ctx->count) {
+		ctx->cb(index, ctx->arg);
+	}
+
+	return NULL;
+}
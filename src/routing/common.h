@@ -44,18 +44,34 @@
 #define ROUTING_RIB_LIST_YANG_PATH ROUTING_RIBS_CONTAINER_YANG_PATH "/rib"
 #define ROUTING_RIB_LIST_ACTIVE_ROUTE_RPC_PATH ROUTING_RIB_LIST_YANG_PATH "/active-route"
 
+// static route requests waiting for their kernel ACKs at a time - see route/batch.h
+#define ROUTING_ROUTE_BATCH_WINDOW_ENV "ROUTING_PLUGIN_ROUTE_BATCH_WINDOW"
+#define ROUTING_ROUTE_BATCH_WINDOW_DEFAULT 512
+
+// worker threads building and serializing RIBs - one RIB (table and address family) per task, 1 keeps everything on the caller thread
+#define ROUTING_RIB_WORKERS_ENV "ROUTING_PLUGIN_RIB_WORKERS"
+#define ROUTING_RIB_WORKERS_DEFAULT 1
+
 #include <netlink/route/nexthop.h>
+#include <netlink/route/route.h>
 #include <routing/rib/list.h>
+#include <routing/route/batch.h>
 
 void foreach_nexthop(struct rtnl_nexthop *nh, void *arg);
 
 int routing_collect_ribs(struct nl_cache *routes_cache, struct rib_list_element **ribs_head);
-int routing_collect_routes(struct nl_cache *routes_cache, struct nl_cache *link_cache, struct rib_list_element **ribs_head);
+// called once for every task index - tasks of one call must not share mutable data
+typedef void (*routing_parallel_cb)(size_t index, void *arg);
+
+int routing_collect_routes(struct nl_cache *routes_cache, struct rib_list_element **ribs_head, unsigned int workers);
+void routing_parallel_for(size_t count, unsigned int workers, routing_parallel_cb cb, void *arg);
+void routing_build_route(struct rtnl_route *route, struct route *out);
+void routing_update_active_route(struct route_list_element **routes_head);
 int routing_build_rib_descriptions(struct rib_list_element **ribs_head);
 int routing_is_rib_known(int table);
 
-int routing_apply_new_routes(struct nl_sock *socket, struct route_list_hash_element *routes_hash);
-int routing_apply_modify_routes(struct nl_sock *socket, struct route_list_hash_element *routes_hash);
-int routing_apply_delete_routes(struct nl_sock *socket, struct route_list_hash_element *routes_hash);
+int routing_apply_new_routes(struct route_batch *batch, struct route_list_hash_element *routes_hash);
+int routing_apply_modify_routes(struct route_batch *batch, struct route_list_hash_element *routes_hash);
+int routing_apply_delete_routes(struct route_batch *batch, struct route_list_hash_element *routes_hash);
 
 #endif // ROUTING_PLUGIN_COMMON_H
\ No newline at end of file
@@ -14,12 +14,26 @@
 #ifndef ROUTING_PLUGIN_CONTEXT_H
 #define ROUTING_PLUGIN_CONTEXT_H
 
+#include <pthread.h>
+#include <stdint.h>
+
 #include <sysrepo_types.h>
 
+#include "rib/mirror.h"
 #include "route/list_hash.h"
 
 struct routing_ctx {
 	sr_session_ctx_t *startup_session;
+	sr_subscription_ctx_t *subscription; // change, operational and RPC callbacks - processed by the event thread
+	struct rib_mirror rib_mirror;
+	unsigned int route_batch_window;
+
+	// event thread - runs the callbacks and applies RIB mirror notifications between requests
+	pthread_t event_thread;
+	uint8_t event_thread_started;
+	int epoll_fd;
+	int shutdown_fd;
+	int manager_fd; // RIB mirror manager socket in the epoll set, -1 until the first sync sets it up
 };
 
 #endif // ROUTING_PLUGIN_CONTEXT_H
\ No newline at end of file
@@ -0,0 +1,96 @@
+/*
+ * telekom / sysrepo-plugin-interfaces
+ *
+ * This program is made available under the terms of the
+ * BSD 3-Clause license which is available at
+ * https://opensource.org/licenses/BSD-3-Clause
+ *
+ * SPDX-FileCopyrightText: 2022 Deutsche Telekom AG
+ * SPDX-FileContributor: Sartura Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <string.h>
+#include <stdio.h>
+
+#include <netlink/route/link.h>
+
+#include "interface_table.h"
+#include "utils/memory.h"
+
+// ifindexes are allocated sequentially by the kernel - start with room for a typical host
+#define INTERFACE_TABLE_INITIAL_SIZE 64
+
+void interface_table_init(struct interface_table *table)
+{
+	table->names = NULL;
+	table->size = 0;
+}
+
+int interface_table_load(struct interface_table *table, struct nl_cache *link_cache)
+{
+	struct rtnl_link *link = NULL;
+
+	if (link_cache == NULL) {
+		return -1;
+	}
+
+	if (table->names) {
+		memset(table->names, 0, table->size * sizeof(*table->names));
+	}
+
+	link = (struct rtnl_link *) nl_cache_get_first(link_cache);
+	while (link != NULL) {
+		interface_table_set(table, rtnl_link_get_ifindex(link), rtnl_link_get_name(link));
+		link = (struct rtnl_link *) nl_cache_get_next((struct nl_object *) link);
+	}
+
+	return 0;
+}
+
+void interface_table_set(struct interface_table *table, int ifindex, const char *name)
+{
+	size_t new_size = 0;
+
+	if (ifindex <= 0 || name == NULL) {
+		return;
+	}
+
+	if ((size_t) ifindex >= table->size) {
+		new_size = table->size ? table->size : INTERFACE_TABLE_INITIAL_SIZE;
+		while (new_size <= (size_t) ifindex) {
+			new_size *= 2;
+		}
+
+		table->names = xrealloc(table->names, new_size * sizeof(*table->names));
+		memset(table->names + table->size, 0, (new_size - table->size) * sizeof(*table->names));
+		table->size = new_size;
+	}
+
+	snprintf(table->names[ifindex], sizeof(table->names[ifindex]), "%s", name);
+}
+
+void interface_table_remove(struct interface_table *table, int ifindex)
+{
+	if (ifindex <= 0 || (size_t) ifindex >= table->size) {
+		return;
+	}
+
+	table->names[ifindex][0] = '\0';
+}
+
+const char *interface_table_get_name(const struct interface_table *table, int ifindex)
+{
+	if (ifindex <= 0 || (size_t) ifindex >= table->size || table->names[ifindex][0] == '\0') {
+		return NULL;
+	}
+
+	return table->names[ifindex];
+}
+
+void interface_table_free(struct interface_table *table)
+{
+	FREE_SAFE(table->names);
+	interface_table_init(table);
+}
@@ -0,0 +1,35 @@
+/*
+ * telekom / sysrepo-plugin-interfaces
+ *
+ * This program is made available under the terms of the
+ * BSD 3-Clause license which is available at
+ * https://opensource.org/licenses/BSD-3-Clause
+ *
+ * SPDX-FileCopyrightText: 2022 Deutsche Telekom AG
+ * SPDX-FileContributor: Sartura Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef ROUTING_INTERFACE_TABLE_H
+#define ROUTING_INTERFACE_TABLE_H
+
+#include <stddef.h>
+#include <net/if.h>
+
+#include <netlink/cache.h>
+
+// interface names indexed by ifindex - routes only store the ifindex and resolve the name when serialized
+struct interface_table {
+	char (*names)[IF_NAMESIZE]; // empty for unknown indexes
+	size_t size;
+};
+
+void interface_table_init(struct interface_table *table);
+int interface_table_load(struct interface_table *table, struct nl_cache *link_cache);
+void interface_table_set(struct interface_table *table, int ifindex, const char *name);
+void interface_table_remove(struct interface_table *table, int ifindex);
+const char *interface_table_get_name(const struct interface_table *table, int ifindex);
+void interface_table_free(struct interface_table *table);
+
+#endif // ROUTING_INTERFACE_TABLE_H
@@ -37,6 +37,7 @@ int routing_persist_static_routes(sr_session_ctx_t *session)
 	int error = 0;
 	struct route_list_hash_element *routes_head = NULL;
 	struct nl_sock *socket = NULL;
+	struct route_batch batch = {0};
 
 	// netlink
 	socket = nl_socket_alloc();
@@ -64,18 +65,28 @@ int routing_persist_static_routes(sr_session_ctx_t *session)
 		goto error_out;
 	}
 
-	error = routing_apply_new_routes(socket, routes_head);
+	route_batch_init(&batch, socket, ROUTING_ROUTE_BATCH_WINDOW_DEFAULT);
+
+	error = routing_apply_new_routes(&batch, routes_head);
 	if (error != 0) {
 		SRPLG_LOG_ERR(PLUGIN_NAME, "routing_apply_new_routes() failed (%d)", error);
 		goto error_out;
 	}
 
+	error = route_batch_flush(&batch);
+	if (error != 0 || batch.failed > 0) {
+		route_batch_log_failures(&batch);
+		SRPLG_LOG_ERR(PLUGIN_NAME, "%zu of %zu static routes couldn't be applied", batch.failed, batch.entries_count);
+		goto error_out;
+	}
+
 	goto out;
 
 error_out:
 	error = -1;
 
 out:
+	route_batch_free(&batch);
 	nl_socket_free(socket);
 	route_list_hash_free(&routes_head);
 	return error;
@@ -158,7 +169,7 @@ static int gather_static_routes(struct route_list_hash_element **routes_head, sr
 		if (outgoing_interface != NULL) {
 			SRPLG_LOG_DBG(PLUGIN_NAME, "outgoing-interface: %s", lyd_get_value(outgoing_interface));
 			const int ifindex = (int) if_nametoindex(lyd_get_value(outgoing_interface));
-			route_next_hop_set_simple_interface(&(*route_list_head)->route.next_hop, ifindex, lyd_get_value(outgoing_interface));
+			route_next_hop_set_simple_interface(&(*route_list_head)->route.next_hop, ifindex);
 		}
 
 		route_node_iterator = route_node_iterator->next;
@@ -30,6 +30,8 @@ void rib_init(struct rib *rib)
 	memset(rib->description, 0, sizeof(rib->description));
 
 	route_list_hash_init(&rib->routes_head);
+	rib_trie_init(&rib->routes_trie);
+	route_arena_init(&rib->routes_arena);
 }
 
 void rib_set_address_family(struct rib *rib, int af)
@@ -54,5 +56,7 @@ void rib_set_name(struct rib *rib, char *buff)
 
 void rib_free(struct rib *rib)
 {
-	route_list_hash_free(&rib->routes_head);
+	rib_trie_free(&rib->routes_trie);
+	route_list_hash_free_arena(&rib->routes_head, &rib->routes_arena);
+	route_arena_free(&rib->routes_arena);
 }
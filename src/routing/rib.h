@@ -14,8 +14,10 @@
 #ifndef ROUTING_RIB_H
 #define ROUTING_RIB_H
 
+#include "route/arena.h"
 #include "route/list_hash.h"
 #include "rib/description_pair.h"
+#include "rib/trie.h"
 
 struct rib {
 	char name[32];
@@ -23,6 +25,8 @@ struct rib {
 	int address_family;
 	int default_rib;
 	struct route_list_hash_element *routes_head;
+	struct rib_trie routes_trie; // longest-prefix-match index over routes_head
+	struct route_arena routes_arena; // records of routes_head - released at once with the RIB
 };
 
 void rib_init(struct rib *rib);
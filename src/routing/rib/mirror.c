@@ -0,0 +1,337 @@
+/*
+ * telekom / sysrepo-plugin-interfaces
+ *
+ * This program is made available under the terms of the
+ * BSD 3-Clause license which is available at
+ * https://opensource.org/licenses/BSD-3-Clause
+ *
+ * SPDX-FileCopyrightText: 2022 Deutsche Telekom AG
+ * SPDX-FileContributor: Sartura Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <string.h>
+
+#include <sysrepo.h>
+#include <utlist.h>
+
+#include <netlink/errno.h>
+#include <netlink/route/link.h>
+#include <netlink/route/route.h>
+
+#include "common.h"
+#include "rib/list.h"
+#include "rib/mirror.h"
+#include "rib/trie.h"
+#include "route/list.h"
+#include "route/list_hash.h"
+
+static int rib_mirror_build(struct rib_mirror *mirror);
+static void rib_mirror_link_change_cb(struct nl_cache *cache, struct nl_object *obj, int action, void *arg);
+static void rib_mirror_route_change_cb(struct nl_cache *cache, struct nl_object *old_obj, struct nl_object *new_obj, uint64_t diff, int action, void *arg);
+
+void rib_mirror_init(struct rib_mirror *mirror)
+{
+	*mirror = (struct rib_mirror){0};
+	rib_list_init(&mirror->ribs_head);
+	interface_table_init(&mirror->interfaces);
+}
+
+int rib_mirror_sync(struct rib_mirror *mirror)
+{
+	int error = 0;
+	int nl_err = 0;
+
+	if (mirror->cache_manager == NULL) {
+		// table and protocol names are only read once - rtnl_route_table2str() uses them for RIB names
+		nl_err = rtnl_route_read_table_names("/etc/iproute2/rt_tables");
+		if (nl_err != 0) {
+			SRPLG_LOG_ERR(PLUGIN_NAME, "rtnl_route_read_table_names failed (%d): %s", nl_err, nl_geterror(nl_err));
+			goto error_out;
+		}
+
+		nl_err = rtnl_route_read_protocol_names("/etc/iproute2/rt_protos");
+		if (nl_err != 0) {
+			SRPLG_LOG_ERR(PLUGIN_NAME, "rtnl_route_read_protocol_names failed (%d): %s", nl_err, nl_geterror(nl_err));
+			goto error_out;
+		}
+
+		mirror->socket = nl_socket_alloc();
+		if (mirror->socket == NULL) {
+			SRPLG_LOG_ERR(PLUGIN_NAME, "unable to init nl_sock struct...");
+			goto error_out;
+		}
+
+		nl_err = nl_connect(mirror->socket, NETLINK_ROUTE);
+		if (nl_err != 0) {
+			SRPLG_LOG_ERR(PLUGIN_NAME, "nl_connect failed (%d): %s", nl_err, nl_geterror(nl_err));
+			nl_socket_free(mirror->socket);
+			mirror->socket = NULL;
+			goto error_out;
+		}
+
+		nl_err = nl_cache_mngr_alloc(NULL, NETLINK_ROUTE, 0, &mirror->cache_manager);
+		if (nl_err != 0) {
+			SRPLG_LOG_ERR(PLUGIN_NAME, "nl_cache_mngr_alloc failed (%d): %s", nl_err, nl_geterror(nl_err));
+			goto error_out;
+		}
+
+		// links only resolve next-hop interface names - renames and removals are applied to the interface table
+		nl_err = nl_cache_mngr_add(mirror->cache_manager, "route/link", rib_mirror_link_change_cb, mirror, &mirror->link_cache);
+		if (nl_err != 0) {
+			SRPLG_LOG_ERR(PLUGIN_NAME, "nl_cache_mngr_add failed (%d): %s", nl_err, nl_geterror(nl_err));
+			goto error_out;
+		}
+
+		nl_err = nl_cache_alloc_name("route/route", &mirror->route_cache);
+		if (nl_err != 0) {
+			SRPLG_LOG_ERR(PLUGIN_NAME, "nl_cache_alloc_name failed (%d): %s", nl_err, nl_geterror(nl_err));
+			goto error_out;
+		}
+
+		// the v2 callback also hands over the replaced route on changes
+		nl_err = nl_cache_mngr_add_cache_v2(mirror->cache_manager, mirror->route_cache, rib_mirror_route_change_cb, mirror);
+		if (nl_err != 0) {
+			SRPLG_LOG_ERR(PLUGIN_NAME, "nl_cache_mngr_add_cache_v2 failed (%d): %s", nl_err, nl_geterror(nl_err));
+			nl_cache_free(mirror->route_cache);
+			mirror->route_cache = NULL;
+			goto error_out;
+		}
+
+		// both caches are filled once added to the manager
+		mirror->resync = 1;
+	} else {
+		// apply pending route and link notifications - the manager socket is non-blocking
+		nl_err = nl_cache_mngr_data_ready(mirror->cache_manager);
+		if (nl_err < 0) {
+			SRPLG_LOG_INF(PLUGIN_NAME, "lost RIB notifications (%s) - dumping routes again", nl_geterror(nl_err));
+
+			nl_err = nl_cache_refill(mirror->socket, mirror->link_cache);
+			if (nl_err != 0) {
+				SRPLG_LOG_ERR(PLUGIN_NAME, "nl_cache_refill failed (%d): %s", nl_err, nl_geterror(nl_err));
+				goto error_out;
+			}
+
+			nl_err = nl_cache_refill(mirror->socket, mirror->route_cache);
+			if (nl_err != 0) {
+				SRPLG_LOG_ERR(PLUGIN_NAME, "nl_cache_refill failed (%d): %s", nl_err, nl_geterror(nl_err));
+				goto error_out;
+			}
+
+			mirror->resync = 1;
+		}
+	}
+
+	if (mirror->resync) {
+		error = rib_mirror_build(mirror);
+		if (error != 0) {
+			goto error_out;
+		}
+	}
+
+	goto out;
+
+error_out:
+	error = -1;
+
+	// partially setup socket or manager - start over on the next request
+	if ((mirror->socket != NULL || mirror->cache_manager != NULL) && mirror->route_cache == NULL) {
+		rib_mirror_free(mirror);
+	}
+
+out:
+	return error;
+}
+
+int rib_mirror_add_route(struct rib_mirror *mirror, struct rtnl_route *route)
+{
+	struct route tmp_route = {0};
+	struct route_list_element **routes_head = NULL;
+	struct rib *rib = NULL;
+	char table_buffer[32] = {0};
+	const int table_id = (int) rtnl_route_get_table(route);
+	const uint8_t af = rtnl_route_get_family(route);
+
+	rtnl_route_table2str(table_id, table_buffer, sizeof(table_buffer));
+
+	rib = rib_list_get(&mirror->ribs_head, table_buffer, af);
+	if (rib == NULL) {
+		// first route of a new table
+		rib_list_add(&mirror->ribs_head, table_buffer, af);
+
+		if (strncmp(table_buffer, "main", sizeof("main") - 1) == 0) {
+			rib_list_set_default(&mirror->ribs_head, table_buffer, af, 1);
+		}
+
+		if (routing_build_rib_descriptions(&mirror->ribs_head) != 0) {
+			return -1;
+		}
+
+		rib = rib_list_get(&mirror->ribs_head, table_buffer, af);
+	}
+
+	routing_build_route(route, &tmp_route);
+
+	// a new prefix needs to be indexed for active-route lookups as well
+	if (route_list_hash_get(&rib->routes_head, rtnl_route_get_dst(route)) == NULL) {
+		route_list_hash_add_arena(&rib->routes_head, &rib->routes_arena, rtnl_route_get_dst(route), &tmp_route);
+		rib_trie_insert(&rib->routes_trie, route_list_hash_get_element(&rib->routes_head, rtnl_route_get_dst(route)));
+	} else {
+		route_list_hash_add_arena(&rib->routes_head, &rib->routes_arena, rtnl_route_get_dst(route), &tmp_route);
+	}
+
+	route_free(&tmp_route);
+
+	// the new route can replace the active route of its prefix
+	routes_head = route_list_hash_get(&rib->routes_head, rtnl_route_get_dst(route));
+	routing_update_active_route(routes_head);
+
+	return 0;
+}
+
+int rib_mirror_remove_route(struct rib_mirror *mirror, struct rtnl_route *route)
+{
+	struct route_list_element **routes_head = NULL;
+	struct route_list_element *routes_iter = NULL;
+	struct rib *rib = NULL;
+	char table_buffer[32] = {0};
+	const int table_id = (int) rtnl_route_get_table(route);
+	const uint8_t af = rtnl_route_get_family(route);
+	const uint32_t preference = rtnl_route_get_priority(route);
+
+	rtnl_route_table2str(table_id, table_buffer, sizeof(table_buffer));
+
+	rib = rib_list_get(&mirror->ribs_head, table_buffer, af);
+	if (rib == NULL) {
+		return -1;
+	}
+
+	routes_head = route_list_hash_get(&rib->routes_head, rtnl_route_get_dst(route));
+	if (routes_head == NULL) {
+		return -1;
+	}
+
+	// routes of one prefix in a table differ by their preference (kernel metric)
+	LL_FOREACH(*routes_head, routes_iter)
+	{
+		if (routes_iter->route.preference == preference) {
+			break;
+		}
+	}
+
+	if (routes_iter == NULL) {
+		return -1;
+	}
+
+	route_list_remove_arena(routes_head, &rib->routes_arena, routes_iter);
+
+	if (*routes_head == NULL) {
+		rib_trie_remove(&rib->routes_trie, rtnl_route_get_dst(route));
+		route_list_hash_remove_arena(&rib->routes_head, &rib->routes_arena, rtnl_route_get_dst(route));
+	} else {
+		routing_update_active_route(routes_head);
+	}
+
+	return 0;
+}
+
+void rib_mirror_free(struct rib_mirror *mirror)
+{
+	const unsigned int workers = mirror->workers;
+
+	rib_list_free(&mirror->ribs_head);
+	interface_table_free(&mirror->interfaces);
+
+	// frees the managed route and link caches as well
+	if (mirror->cache_manager) {
+		nl_cache_mngr_free(mirror->cache_manager);
+	}
+
+	if (mirror->socket) {
+		nl_socket_free(mirror->socket);
+	}
+
+	rib_mirror_init(mirror);
+	mirror->workers = workers;
+}
+
+static int rib_mirror_build(struct rib_mirror *mirror)
+{
+	int error = 0;
+
+	rib_list_free(&mirror->ribs_head);
+
+	error = interface_table_load(&mirror->interfaces, mirror->link_cache);
+	if (error != 0) {
+		SRPLG_LOG_ERR(PLUGIN_NAME, "interface_table_load() failed (%d)", error);
+		return error;
+	}
+
+	error = routing_collect_routes(mirror->route_cache, &mirror->ribs_head, mirror->workers);
+	if (error != 0) {
+		SRPLG_LOG_ERR(PLUGIN_NAME, "routing_collect_routes() failed (%d)", error);
+		return error;
+	}
+
+	mirror->resync = 0;
+
+	return 0;
+}
+
+static void rib_mirror_link_change_cb(struct nl_cache *cache, struct nl_object *obj, int action, void *arg)
+{
+	struct rib_mirror *mirror = arg;
+	struct rtnl_link *link = (struct rtnl_link *) obj;
+
+	(void) cache;
+
+	switch (action) {
+		case NL_ACT_NEW:
+		case NL_ACT_CHANGE:
+			interface_table_set(&mirror->interfaces, rtnl_link_get_ifindex(link), rtnl_link_get_name(link));
+			break;
+		case NL_ACT_DEL:
+			interface_table_remove(&mirror->interfaces, rtnl_link_get_ifindex(link));
+			break;
+		default:
+			break;
+	}
+}
+
+static void rib_mirror_route_change_cb(struct nl_cache *cache, struct nl_object *old_obj, struct nl_object *new_obj, uint64_t diff, int action, void *arg)
+{
+	struct rib_mirror *mirror = arg;
+	int error = 0;
+
+	(void) cache;
+	(void) diff;
+
+	// the whole mirror is rebuilt anyway
+	if (mirror->resync) {
+		return;
+	}
+
+	switch (action) {
+		case NL_ACT_NEW:
+			error = rib_mirror_add_route(mirror, (struct rtnl_route *) new_obj);
+			break;
+		case NL_ACT_DEL:
+			error = rib_mirror_remove_route(mirror, (struct rtnl_route *) old_obj);
+			break;
+		case NL_ACT_CHANGE:
+			// next-hops or other route attributes changed - replace the route
+			error = rib_mirror_remove_route(mirror, (struct rtnl_route *) old_obj);
+			if (error == 0) {
+				error = rib_mirror_add_route(mirror, (struct rtnl_route *) new_obj);
+			}
+			break;
+		default:
+			break;
+	}
+
+	if (error != 0) {
+		SRPLG_LOG_INF(PLUGIN_NAME, "unable to apply route notification (action %d) - rebuilding the RIBs", action);
+		mirror->resync = 1;
+	}
+}
@@ -0,0 +1,43 @@
+/*
+ * telekom / sysrepo-plugin-interfaces
+ *
+ * This program is made available under the terms of the
+ * BSD 3-Clause license which is available at
+ * https://opensource.org/licenses/BSD-3-Clause
+ *
+ * SPDX-FileCopyrightText: 2022 Deutsche Telekom AG
+ * SPDX-FileContributor: Sartura Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef ROUTING_RIB_MIRROR_H
+#define ROUTING_RIB_MIRROR_H
+
+#include <stdint.h>
+
+#include <netlink/cache.h>
+#include <netlink/route/route.h>
+
+#include "interface_table.h"
+#include "rib/list.h"
+
+// RIBs built from one kernel dump and kept current by route and link notifications of the cache manager
+struct rib_mirror {
+	struct nl_sock *socket;
+	struct nl_cache_mngr *cache_manager;
+	struct nl_cache *route_cache;
+	struct nl_cache *link_cache;
+	struct rib_list_element *ribs_head;
+	struct interface_table interfaces; // ifindex -> name of all links, shared by every routing code path
+	uint8_t resync; // an update couldn't be applied or notifications were lost - rebuild from a new dump
+	unsigned int workers; // threads building RIBs from a dump, kept across rib_mirror_free()
+};
+
+void rib_mirror_init(struct rib_mirror *mirror);
+int rib_mirror_sync(struct rib_mirror *mirror);
+int rib_mirror_add_route(struct rib_mirror *mirror, struct rtnl_route *route);
+int rib_mirror_remove_route(struct rib_mirror *mirror, struct rtnl_route *route);
+void rib_mirror_free(struct rib_mirror *mirror);
+
+#endif // ROUTING_RIB_MIRROR_H
@@ -0,0 +1,132 @@
+/*
+ * telekom / sysrepo-plugin-interfaces
+ *
+ * This program is made available under the terms of the
+ * BSD 3-Clause license which is available at
+ * https://opensource.org/licenses/BSD-3-Clause
+ *
+ * SPDX-FileCopyrightText: 2022 Deutsche Telekom AG
+ * SPDX-FileContributor: Sartura Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "rib/trie.h"
+#include "utils/memory.h"
+
+// deepest possible path - one node per IPv6 prefix bit and the root
+#define RIB_TRIE_MAX_DEPTH (128 + 1)
+
+static inline int rib_trie_bit(const uint8_t *address, unsigned int bit);
+static void rib_trie_node_free(struct rib_trie_node *node);
+
+void rib_trie_init(struct rib_trie *trie)
+{
+	trie->root = NULL;
+}
+
+void rib_trie_insert(struct rib_trie *trie, struct route_list_hash_element *element)
+{
+	struct rib_trie_node **node = &trie->root;
+	const struct route_list_hash_key *KEY = &element->key;
+
+	// the key holds the prefix bits zero padded to the full address size
+	for (unsigned int i = 0; i < KEY->prefixlen; i++) {
+		if (*node == NULL) {
+			*node = xcalloc(1, sizeof(**node));
+		}
+		node = &(*node)->children[rib_trie_bit(KEY->address, i)];
+	}
+
+	if (*node == NULL) {
+		*node = xcalloc(1, sizeof(**node));
+	}
+
+	(*node)->element = element;
+}
+
+void rib_trie_remove(struct rib_trie *trie, struct nl_addr *prefix)
+{
+	struct rib_trie_node **path[RIB_TRIE_MAX_DEPTH] = {0};
+	struct rib_trie_node **node = &trie->root;
+	const uint8_t *address = nl_addr_get_binary_addr(prefix);
+	unsigned int prefixlen = nl_addr_get_prefixlen(prefix);
+	int depth = 0;
+
+	if (prefixlen > nl_addr_get_len(prefix) * 8) {
+		prefixlen = nl_addr_get_len(prefix) * 8;
+	}
+
+	for (unsigned int i = 0; i < prefixlen && *node != NULL; i++) {
+		path[depth++] = node;
+		node = &(*node)->children[rib_trie_bit(address, i)];
+	}
+
+	if (*node == NULL) {
+		return;
+	}
+
+	(*node)->element = NULL;
+	path[depth] = node;
+
+	// release nodes which no longer lead to any prefix
+	for (int i = depth; i >= 0; i--) {
+		struct rib_trie_node *iter = *path[i];
+
+		if (iter->element != NULL || iter->children[0] != NULL || iter->children[1] != NULL) {
+			break;
+		}
+
+		free(iter);
+		*path[i] = NULL;
+	}
+}
+
+struct route_list_hash_element *rib_trie_lookup(struct rib_trie *trie, struct nl_addr *address)
+{
+	struct rib_trie_node *node = trie->root;
+	struct route_list_hash_element *longest = NULL;
+	const uint8_t *bytes = nl_addr_get_binary_addr(address);
+	const unsigned int BITS = nl_addr_get_len(address) * 8;
+
+	// the last prefix passed on the way down is the longest match
+	for (unsigned int i = 0; node != NULL; i++) {
+		if (node->element != NULL) {
+			longest = node->element;
+		}
+
+		if (i == BITS) {
+			break;
+		}
+
+		node = node->children[rib_trie_bit(bytes, i)];
+	}
+
+	return longest;
+}
+
+void rib_trie_free(struct rib_trie *trie)
+{
+	rib_trie_node_free(trie->root);
+	trie->root = NULL;
+}
+
+static inline int rib_trie_bit(const uint8_t *address, unsigned int bit)
+{
+	return (address[bit / 8] >> (7 - (bit % 8))) & 1;
+}
+
+static void rib_trie_node_free(struct rib_trie_node *node)
+{
+	if (node == NULL) {
+		return;
+	}
+
+	// recursion depth is bounded by the address length
+	rib_trie_node_free(node->children[0]);
+	rib_trie_node_free(node->children[1]);
+	free(node);
+}
@@ -0,0 +1,37 @@
+/*
+ * telekom / sysrepo-plugin-interfaces
+ *
+ * This program is made available under the terms of the
+ * BSD 3-Clause license which is available at
+ * https://opensource.org/licenses/BSD-3-Clause
+ *
+ * SPDX-FileCopyrightText: 2022 Deutsche Telekom AG
+ * SPDX-FileContributor: Sartura Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef ROUTING_RIB_TRIE_H
+#define ROUTING_RIB_TRIE_H
+
+#include <netlink/addr.h>
+
+#include "route/list_hash.h"
+
+// binary trie over the destination prefixes of one RIB - nodes point to the route_list_hash elements owned by the RIB
+struct rib_trie_node {
+	struct rib_trie_node *children[2];
+	struct route_list_hash_element *element;
+};
+
+struct rib_trie {
+	struct rib_trie_node *root;
+};
+
+void rib_trie_init(struct rib_trie *trie);
+void rib_trie_insert(struct rib_trie *trie, struct route_list_hash_element *element);
+void rib_trie_remove(struct rib_trie *trie, struct nl_addr *prefix);
+struct route_list_hash_element *rib_trie_lookup(struct rib_trie *trie, struct nl_addr *address);
+void rib_trie_free(struct rib_trie *trie);
+
+#endif // ROUTING_RIB_TRIE_H
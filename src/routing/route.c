@@ -18,8 +18,8 @@ void route_init(struct route *route)
 {
 	route->preference = 0;
 	route->metadata.active = 0;
-	route->metadata.source_protocol = NULL;
-	route->metadata.last_updated = NULL;
+	route->metadata.source_protocol = route_source_protocol_none;
+	route->metadata.last_updated = 0;
 	route->metadata.description = NULL;
 	route_next_hop_init(&route->next_hop);
 }
@@ -34,18 +34,14 @@ void route_set_active(struct route *route, bool active)
 	route->metadata.active = active;
 }
 
-void route_set_source_protocol(struct route *route, char *proto)
+void route_set_source_protocol(struct route *route, enum route_source_protocol proto)
 {
-	if (proto) {
-		route->metadata.source_protocol = xstrdup(proto);
-	}
+	route->metadata.source_protocol = proto;
 }
 
-void route_set_last_updated(struct route *route, char *last_up)
+void route_set_last_updated(struct route *route, time_t last_up)
 {
-	if (last_up) {
-		route->metadata.source_protocol = xstrdup(last_up);
-	}
+	route->metadata.last_updated = last_up;
 }
 
 void route_set_description(struct route *route, const char *description)
@@ -55,7 +51,24 @@ void route_set_description(struct route *route, const char *description)
 	}
 }
 
+const char *route_source_protocol2str(enum route_source_protocol proto)
+{
+	switch (proto) {
+		case route_source_protocol_direct:
+			return "ietf-routing:direct";
+		case route_source_protocol_static:
+			return "ietf-routing:static";
+		default:
+			return NULL;
+	}
+}
+
 struct route route_clone(struct route *route)
+{
+	return route_clone_arena(route, NULL);
+}
+
+struct route route_clone_arena(struct route *route, struct route_arena *arena)
 {
 	struct route out;
 
@@ -65,26 +78,28 @@ struct route route_clone(struct route *route)
 	route_set_active(&out, route->metadata.active);
 	route_set_source_protocol(&out, route->metadata.source_protocol);
 	route_set_last_updated(&out, route->metadata.last_updated);
-	route_set_description(&out, route->metadata.description);
-	out.next_hop = route_next_hop_clone(&route->next_hop);
+
+	// RIB routes have no description - arena records don't own any heap memory
+	if (arena == NULL) {
+		route_set_description(&out, route->metadata.description);
+	}
+
+	out.next_hop = route_next_hop_clone_arena(&route->next_hop, arena);
 
 	return out;
 }
 
 void route_free(struct route *route)
 {
-	if (route->metadata.source_protocol) {
-		FREE_SAFE(route->metadata.source_protocol);
-	}
-
-	if (route->metadata.last_updated) {
-		FREE_SAFE(route->metadata.last_updated);
-	}
+	route_free_arena(route, NULL);
+}
 
+void route_free_arena(struct route *route, struct route_arena *arena)
+{
 	if (route->metadata.description) {
 		FREE_SAFE(route->metadata.description);
 	}
 
-	route_next_hop_free(&route->next_hop);
+	route_next_hop_free_arena(&route->next_hop, arena);
 	route_init(route);
 }
@@ -16,14 +16,24 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <time.h>
 #include <netlink/addr.h>
 
 #include "route/next_hop.h"
 
+struct route_arena;
+
+// source-protocol identities - written as identity strings only when serialized
+enum route_source_protocol {
+	route_source_protocol_none = 0,
+	route_source_protocol_direct,
+	route_source_protocol_static
+};
+
 struct route_metadata {
-	char *source_protocol;
-	char *last_updated;
-	char *description; // used only in control_plane_protocol struct
+	char *description; // used only in control_plane_protocol struct - never kept in RIB arenas
+	time_t last_updated; // 0 if unknown
+	enum route_source_protocol source_protocol;
 	bool active;
 };
 
@@ -36,10 +46,13 @@ struct route {
 void route_init(struct route *route);
 void route_set_preference(struct route *route, uint32_t pref);
 void route_set_active(struct route *route, bool active);
-void route_set_source_protocol(struct route *route, char *proto);
-void route_set_last_updated(struct route *route, char *last_up);
+void route_set_source_protocol(struct route *route, enum route_source_protocol proto);
+void route_set_last_updated(struct route *route, time_t last_up);
 void route_set_description(struct route *route, const char *description);
+const char *route_source_protocol2str(enum route_source_protocol proto);
 struct route route_clone(struct route *route);
+struct route route_clone_arena(struct route *route, struct route_arena *arena);
 void route_free(struct route *route);
+void route_free_arena(struct route *route, struct route_arena *arena);
 
 #endif // ROUTING_ROUTE_H
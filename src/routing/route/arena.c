@@ -0,0 +1,113 @@
+/*
+ * telekom / sysrepo-plugin-interfaces
+ *
+ * This program is made available under the terms of the
+ * BSD 3-Clause license which is available at
+ * https://opensource.org/licenses/BSD-3-Clause
+ *
+ * SPDX-FileCopyrightText: 2022 Deutsche Telekom AG
+ * SPDX-FileContributor: Sartura Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "route/arena.h"
+#include "route/list.h"
+#include "route/next_hop.h"
+#include "utils/memory.h"
+
+// small RIBs (local, unused tables) shouldn't reserve much - chunks double up to the maximum
+#define ROUTE_SLAB_CHUNK_OBJECTS_MIN 64
+#define ROUTE_SLAB_CHUNK_OBJECTS_MAX 65536
+
+struct route_slab_chunk {
+	struct route_slab_chunk *next;
+	max_align_t objects[];
+};
+
+void route_slab_init(struct route_slab *slab, size_t object_size)
+{
+	// freed objects hold the free list link - round up to pointer alignment, route objects need no more
+	if (object_size < sizeof(void *)) {
+		object_size = sizeof(void *);
+	}
+	object_size = (object_size + sizeof(void *) - 1) & ~(sizeof(void *) - 1);
+
+	*slab = (struct route_slab){
+		.object_size = object_size,
+	};
+}
+
+void *route_slab_alloc(struct route_slab *slab)
+{
+	struct route_slab_chunk *chunk = NULL;
+	void *object = NULL;
+	size_t chunk_objects = 0;
+
+	if (slab->free_list) {
+		object = slab->free_list;
+		slab->free_list = *(void **) object;
+		slab->objects++;
+		return object;
+	}
+
+	if (slab->chunks == NULL || slab->chunk_used == slab->chunk_objects) {
+		chunk_objects = slab->chunk_objects ? slab->chunk_objects * 2 : ROUTE_SLAB_CHUNK_OBJECTS_MIN;
+		if (chunk_objects > ROUTE_SLAB_CHUNK_OBJECTS_MAX) {
+			chunk_objects = ROUTE_SLAB_CHUNK_OBJECTS_MAX;
+		}
+
+		chunk = xmalloc(sizeof(*chunk) + chunk_objects * slab->object_size);
+		chunk->next = slab->chunks;
+		slab->chunks = chunk;
+		slab->chunk_objects = chunk_objects;
+		slab->chunk_used = 0;
+		slab->reserved += sizeof(*chunk) + chunk_objects * slab->object_size;
+	}
+
+	object = (uint8_t *) slab->chunks->objects + slab->chunk_used * slab->object_size;
+	slab->chunk_used++;
+	slab->objects++;
+
+	return object;
+}
+
+void route_slab_release(struct route_slab *slab, void *object)
+{
+	*(void **) object = slab->free_list;
+	slab->free_list = object;
+	slab->objects--;
+}
+
+void route_slab_free(struct route_slab *slab)
+{
+	struct route_slab_chunk *chunk = slab->chunks, *next = NULL;
+
+	while (chunk) {
+		next = chunk->next;
+		free(chunk);
+		chunk = next;
+	}
+
+	route_slab_init(slab, slab->object_size);
+}
+
+void route_arena_init(struct route_arena *arena)
+{
+	route_slab_init(&arena->routes, sizeof(struct route_list_element));
+	route_slab_init(&arena->next_hops, sizeof(struct route_next_hop_list_element));
+}
+
+size_t route_arena_size(const struct route_arena *arena)
+{
+	return arena->routes.reserved + arena->next_hops.reserved;
+}
+
+void route_arena_free(struct route_arena *arena)
+{
+	route_slab_free(&arena->routes);
+	route_slab_free(&arena->next_hops);
+}
@@ -0,0 +1,47 @@
+/*
+ * telekom / sysrepo-plugin-interfaces
+ *
+ * This program is made available under the terms of the
+ * BSD 3-Clause license which is available at
+ * https://opensource.org/licenses/BSD-3-Clause
+ *
+ * SPDX-FileCopyrightText: 2022 Deutsche Telekom AG
+ * SPDX-FileContributor: Sartura Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef ROUTING_ROUTE_ARENA_H
+#define ROUTING_ROUTE_ARENA_H
+
+#include <stddef.h>
+
+struct route_slab_chunk;
+
+// fixed-size objects carved from growing chunks - released objects are reused through a free list
+struct route_slab {
+	size_t object_size;
+	size_t chunk_objects; // capacity of the newest chunk
+	size_t chunk_used;	  // objects taken from the newest chunk
+	size_t objects;		  // objects currently allocated
+	size_t reserved;	  // bytes of all chunks
+	struct route_slab_chunk *chunks;
+	void *free_list;
+};
+
+// storage of route records and next-hop list entries of one RIB - released at once with the RIB
+struct route_arena {
+	struct route_slab routes;
+	struct route_slab next_hops;
+};
+
+void route_slab_init(struct route_slab *slab, size_t object_size);
+void *route_slab_alloc(struct route_slab *slab);
+void route_slab_release(struct route_slab *slab, void *object);
+void route_slab_free(struct route_slab *slab);
+
+void route_arena_init(struct route_arena *arena);
+size_t route_arena_size(const struct route_arena *arena);
+void route_arena_free(struct route_arena *arena);
+
+#endif // ROUTING_ROUTE_ARENA_H
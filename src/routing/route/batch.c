@@ -0,0 +1,145 @@
+/*
+ * telekom / sysrepo-plugin-interfaces
+ *
+ * This program is made available under the terms of the
+ * BSD 3-Clause license which is available at
+ * https://opensource.org/licenses/BSD-3-Clause
+ *
+ * SPDX-FileCopyrightText: 2022 Deutsche Telekom AG
+ * SPDX-FileContributor: Sartura Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <arpa/inet.h>
+#include <sysrepo.h>
+
+#include <netlink/errno.h>
+#include <netlink/msg.h>
+
+#include "common.h"
+#include "route/batch.h"
+#include "utils/memory.h"
+
+void route_batch_init(struct route_batch *batch, struct nl_sock *socket, unsigned int window)
+{
+	*batch = (struct route_batch){0};
+
+	netlink_batch_init(&batch->requests, socket, window);
+
+	if (batch->requests.window < window) {
+		SRPLG_LOG_INF(PLUGIN_NAME, "route batch window limited to %zu requests by the socket receive buffer", batch->requests.window);
+	}
+}
+
+int route_batch_add(struct route_batch *batch, enum route_batch_operation operation, struct rtnl_route *route)
+{
+	int nl_err = 0;
+	struct nl_msg *msg = NULL;
+
+	switch (operation) {
+		case route_batch_operation_add:
+			nl_err = rtnl_route_build_add_request(route, NLM_F_CREATE, &msg);
+			break;
+		case route_batch_operation_replace:
+			nl_err = rtnl_route_build_add_request(route, NLM_F_CREATE | NLM_F_REPLACE, &msg);
+			break;
+		case route_batch_operation_delete:
+			nl_err = rtnl_route_build_del_request(route, 0, &msg);
+			break;
+	}
+
+	if (nl_err != 0) {
+		SRPLG_LOG_ERR(PLUGIN_NAME, "unable to build %s route request (%d): %s", route_batch_operation2str(operation), nl_err, nl_geterror(nl_err));
+		return -1;
+	}
+
+	nl_err = netlink_batch_add(&batch->requests, msg);
+	nlmsg_free(msg);
+
+	if (nl_err != 0) {
+		SRPLG_LOG_ERR(PLUGIN_NAME, "unable to send %s route requests (%d): %s", route_batch_operation2str(operation), nl_err, nl_geterror(nl_err));
+		return -1;
+	}
+
+	if (batch->entries_count == batch->entries_size) {
+		batch->entries_size = batch->entries_size ? batch->entries_size * 2 : 64;
+		batch->entries = xrealloc(batch->entries, batch->entries_size * sizeof(*batch->entries));
+	}
+
+	batch->entries[batch->entries_count++] = (struct route_batch_entry){
+		.operation = operation,
+		.prefix = nl_addr_clone(rtnl_route_get_dst(route)),
+		.preference = rtnl_route_get_priority(route),
+		.error = 0,
+	};
+
+	return 0;
+}
+
+int route_batch_flush(struct route_batch *batch)
+{
+	int nl_err = 0;
+
+	nl_err = netlink_batch_flush(&batch->requests);
+	if (nl_err != 0) {
+		SRPLG_LOG_ERR(PLUGIN_NAME, "unable to send route requests (%d): %s", nl_err, nl_geterror(nl_err));
+	}
+
+	// the netlink batch tracks the ACKs - entries were added in the same order
+	for (size_t i = 0; i < batch->entries_count; i++) {
+		batch->entries[i].error = batch->requests.acks[i].error;
+	}
+	batch->failed = batch->requests.failed;
+
+	return nl_err != 0 ? -1 : 0;
+}
+
+const char *route_batch_operation2str(enum route_batch_operation operation)
+{
+	switch (operation) {
+		case route_batch_operation_add:
+			return "add";
+		case route_batch_operation_replace:
+			return "replace";
+		case route_batch_operation_delete:
+			return "delete";
+	}
+
+	return "unknown";
+}
+
+const struct route_batch_entry *route_batch_log_failures(const struct route_batch *batch)
+{
+	const struct route_batch_entry *first = NULL;
+	char prefix_buffer[INET6_ADDRSTRLEN + 1 + 3] = {0};
+
+	for (size_t i = 0; i < batch->entries_count; i++) {
+		const struct route_batch_entry *ENTRY = &batch->entries[i];
+
+		if (ENTRY->error == 0) {
+			continue;
+		}
+
+		if (first == NULL) {
+			first = ENTRY;
+		}
+
+		nl_addr2str(ENTRY->prefix, prefix_buffer, sizeof(prefix_buffer));
+		SRPLG_LOG_ERR(PLUGIN_NAME, "unable to %s route %s (preference %u): %s", route_batch_operation2str(ENTRY->operation), prefix_buffer, ENTRY->preference, nl_geterror(ENTRY->error));
+	}
+
+	return first;
+}
+
+void route_batch_free(struct route_batch *batch)
+{
+	for (size_t i = 0; i < batch->entries_count; i++) {
+		nl_addr_put(batch->entries[i].prefix);
+	}
+
+	FREE_SAFE(batch->entries);
+	netlink_batch_free(&batch->requests);
+
+	*batch = (struct route_batch){0};
+}
@@ -0,0 +1,56 @@
+/*
+ * telekom / sysrepo-plugin-interfaces
+ *
+ * This program is made available under the terms of the
+ * BSD 3-Clause license which is available at
+ * https://opensource.org/licenses/BSD-3-Clause
+ *
+ * SPDX-FileCopyrightText: 2022 Deutsche Telekom AG
+ * SPDX-FileContributor: Sartura Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef ROUTING_ROUTE_BATCH_H
+#define ROUTING_ROUTE_BATCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <netlink/addr.h>
+#include <netlink/socket.h>
+#include <netlink/route/route.h>
+
+#include "utils/netlink_batch.h"
+
+enum route_batch_operation {
+	route_batch_operation_add = 0,
+	route_batch_operation_replace,
+	route_batch_operation_delete,
+};
+
+// one queued route request - entries follow the order of the netlink batch requests
+struct route_batch_entry {
+	enum route_batch_operation operation;
+	struct nl_addr *prefix;
+	uint32_t preference;
+	int error; // libnl error code of the request, 0 when acknowledged
+};
+
+// route requests sent through a netlink batch - see utils/netlink_batch.h
+struct route_batch {
+	struct netlink_batch requests;
+	struct route_batch_entry *entries;
+	size_t entries_count;
+	size_t entries_size;
+	size_t failed;
+};
+
+void route_batch_init(struct route_batch *batch, struct nl_sock *socket, unsigned int window);
+int route_batch_add(struct route_batch *batch, enum route_batch_operation operation, struct rtnl_route *route);
+int route_batch_flush(struct route_batch *batch);
+const char *route_batch_operation2str(enum route_batch_operation operation);
+const struct route_batch_entry *route_batch_log_failures(const struct route_batch *batch);
+void route_batch_free(struct route_batch *batch);
+
+#endif // ROUTING_ROUTE_BATCH_H
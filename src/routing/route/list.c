@@ -30,25 +30,58 @@ bool route_list_is_empty(struct route_list_element **head)
 }
 
 void route_list_add(struct route_list_element **head, struct route *route)
+{
+	route_list_add_arena(head, NULL, route);
+}
+
+void route_list_add_arena(struct route_list_element **head, struct route_arena *arena, struct route *route)
 {
 	struct route_list_element *new_route = NULL;
 
-	new_route = xmalloc(sizeof(*new_route));
+	new_route = arena ? route_slab_alloc(&arena->routes) : xmalloc(sizeof(*new_route));
 	new_route->next = NULL;
-	new_route->route = route_clone(route);
+	new_route->route = route_clone_arena(route, arena);
 
 	// use prepend - used when adding static routes - head is always the newest element and can be modified easily
 	LL_PREPEND(*head, new_route);
 }
 
+void route_list_remove(struct route_list_element **head, struct route_list_element *element)
+{
+	route_list_remove_arena(head, NULL, element);
+}
+
+void route_list_remove_arena(struct route_list_element **head, struct route_arena *arena, struct route_list_element *element)
+{
+	LL_DELETE(*head, element);
+	route_free_arena(&element->route, arena);
+
+	if (arena) {
+		route_slab_release(&arena->routes, element);
+	} else {
+		free(element);
+	}
+}
+
 void route_list_free(struct route_list_element **head)
+{
+	route_list_free_arena(head, NULL);
+}
+
+void route_list_free_arena(struct route_list_element **head, struct route_arena *arena)
 {
 	struct route_list_element *iter = NULL, *tmp = NULL;
 
+	// arena records are released together with the arena
+	if (arena) {
+		*head = NULL;
+		return;
+	}
+
 	LL_FOREACH_SAFE(*head, iter, tmp)
 	{
 		LL_DELETE(*head, iter);
 		route_free(&iter->route);
 		free(iter);
 	}
-}
\ No newline at end of file
+}
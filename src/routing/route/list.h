@@ -15,6 +15,7 @@
 #define ROUTING_ROUTE_LIST_H
 
 #include "route.h"
+#include "route/arena.h"
 
 struct route_list_element {
 	struct route route;
@@ -24,6 +25,10 @@ struct route_list_element {
 void route_list_init(struct route_list_element **head);
 bool route_list_is_empty(struct route_list_element **head);
 void route_list_add(struct route_list_element **head, struct route *route);
+void route_list_add_arena(struct route_list_element **head, struct route_arena *arena, struct route *route);
+void route_list_remove(struct route_list_element **head, struct route_list_element *element);
+void route_list_remove_arena(struct route_list_element **head, struct route_arena *arena, struct route_list_element *element);
 void route_list_free(struct route_list_element **head);
+void route_list_free_arena(struct route_list_element **head, struct route_arena *arena);
 
 #endif // ROUTING_ROUTE_LIST_H
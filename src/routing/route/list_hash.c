@@ -11,6 +11,7 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#include <string.h>
 #include <sysrepo.h>
 
 #include "netlink/addr.h"
@@ -18,9 +19,10 @@
 #include "route/list_hash.h"
 #include "utils/memory.h"
 
-#include <utlist.h>
+#include <uthash.h>
 
-static int route_list_hash_element_cmp(struct route_list_hash_element *e1, struct route_list_hash_element *e2);
+static struct route_list_hash_element *route_list_hash_add_element(struct route_list_hash_element **head, struct nl_addr *addr);
+static void route_list_hash_key_init(struct route_list_hash_key *key, struct nl_addr *addr);
 
 void route_list_hash_init(struct route_list_hash_element **head)
 {
@@ -28,33 +30,36 @@ void route_list_hash_init(struct route_list_hash_element **head)
 }
 
 void route_list_hash_add(struct route_list_hash_element **head, struct nl_addr *addr, struct route *route)
+{
+	route_list_hash_add_arena(head, NULL, addr, route);
+}
+
+void route_list_hash_add_arena(struct route_list_hash_element **head, struct route_arena *arena, struct nl_addr *addr, struct route *route)
 {
 	struct route_list_element **routes_head = NULL;
 	struct route_list_hash_element *new_hash = NULL;
 
 	routes_head = route_list_hash_get(head, addr);
 	if (routes_head) {
-		route_list_add(routes_head, route);
+		route_list_add_arena(routes_head, arena, route);
 	} else {
-		// create new hash
-		new_hash = xmalloc(sizeof(*new_hash));
-		new_hash->prefix = nl_addr_clone(addr);
-		new_hash->next = NULL;
-		new_hash->routes_head = NULL;
-
-		route_list_add(&new_hash->routes_head, route);
-		LL_APPEND(*head, new_hash);
+		new_hash = route_list_hash_add_element(head, addr);
+		route_list_add_arena(&new_hash->routes_head, arena, route);
+	}
+}
+
+void route_list_hash_add_empty(struct route_list_hash_element **head, struct nl_addr *addr)
+{
+	if (route_list_hash_get_element(head, addr) == NULL) {
+		route_list_hash_add_element(head, addr);
 	}
 }
 
 struct route_list_element **route_list_hash_get(struct route_list_hash_element **head, struct nl_addr *addr)
 {
 	struct route_list_hash_element *found = NULL;
-	struct route_list_hash_element find_element = {
-		.prefix = addr,
-	};
 
-	LL_SEARCH(*head, found, &find_element, route_list_hash_element_cmp);
+	found = route_list_hash_get_element(head, addr);
 	if (found) {
 		return &found->routes_head;
 	}
@@ -62,20 +67,118 @@ struct route_list_element **route_list_hash_get(struct route_list_hash_element *
 	return NULL;
 }
 
+struct route_list_hash_element *route_list_hash_get_element(struct route_list_hash_element **head, struct nl_addr *addr)
+{
+	struct route_list_hash_element *found = NULL;
+	struct route_list_hash_key key;
+
+	route_list_hash_key_init(&key, addr);
+
+	HASH_FIND(hh, *head, &key, sizeof(key), found);
+
+	return found;
+}
+
+void route_list_hash_remove(struct route_list_hash_element **head, struct nl_addr *addr)
+{
+	route_list_hash_remove_arena(head, NULL, addr);
+}
+
+void route_list_hash_remove_arena(struct route_list_hash_element **head, struct route_arena *arena, struct nl_addr *addr)
+{
+	struct route_list_hash_element *found = NULL;
+	struct route_list_hash_key key;
+
+	route_list_hash_key_init(&key, addr);
+
+	HASH_FIND(hh, *head, &key, sizeof(key), found);
+	if (!found) {
+		return;
+	}
+
+	// unlink from the insertion ordered list - uthash keeps the previous element
+	if (found->hh.prev) {
+		((struct route_list_hash_element *) found->hh.prev)->next = found->next;
+	}
+
+	HASH_DEL(*head, found);
+	nl_addr_put(found->prefix);
+
+	// single prefix - return the records to the arena for reuse
+	while (found->routes_head) {
+		route_list_remove_arena(&found->routes_head, arena, found->routes_head);
+	}
+
+	free(found);
+}
+
 void route_list_hash_free(struct route_list_hash_element **head)
 {
-	struct route_list_hash_element *iter = NULL, *tmp = NULL;
+	route_list_hash_free_arena(head, NULL);
+}
+
+void route_list_hash_free_arena(struct route_list_hash_element **head, struct route_arena *arena)
+{
+	struct route_list_hash_element *iter = *head, *tmp = NULL;
 
-	LL_FOREACH_SAFE(*head, iter, tmp)
-	{
-		LL_DELETE(*head, iter);
+	// all elements are freed - drop the buckets at once instead of unlinking them one by one
+	HASH_CLEAR(hh, *head);
+
+	while (iter) {
+		tmp = iter->hh.next;
 		nl_addr_put(iter->prefix);
-		route_list_free(&iter->routes_head);
+		route_list_free_arena(&iter->routes_head, arena);
 		free(iter);
+		iter = tmp;
+	}
+}
+
+static struct route_list_hash_element *route_list_hash_add_element(struct route_list_hash_element **head, struct nl_addr *addr)
+{
+	struct route_list_hash_element *new_hash = NULL;
+	struct route_list_hash_element *tail = NULL;
+
+	new_hash = xmalloc(sizeof(*new_hash));
+	route_list_hash_key_init(&new_hash->key, addr);
+	new_hash->prefix = nl_addr_clone(addr);
+	new_hash->next = NULL;
+	new_hash->routes_head = NULL;
+
+	// uthash keeps elements in insertion order - link the new element after the current tail
+	if (*head) {
+		tail = ELMT_FROM_HH((*head)->hh.tbl, (*head)->hh.tbl->tail);
+		tail->next = new_hash;
 	}
+
+	HASH_ADD(hh, *head, key, sizeof(new_hash->key), new_hash);
+
+	return new_hash;
 }
 
-static int route_list_hash_element_cmp(struct route_list_hash_element *e1, struct route_list_hash_element *e2)
+static void route_list_hash_key_init(struct route_list_hash_key *key, struct nl_addr *addr)
 {
-	return nl_addr_cmp(e1->prefix, e2->prefix);
-}
\ No newline at end of file
+	unsigned int len = nl_addr_get_len(addr);
+	unsigned int prefixlen = nl_addr_get_prefixlen(addr);
+
+	if (len > sizeof(key->address)) {
+		len = sizeof(key->address);
+	}
+
+	if (prefixlen > sizeof(key->address) * 8) {
+		prefixlen = sizeof(key->address) * 8;
+	}
+
+	// zero the whole key - padding and bits past the prefix are hashed as well
+	memset(key, 0, sizeof(*key));
+
+	key->family = (uint8_t) nl_addr_get_family(addr);
+	key->prefixlen = (uint8_t) prefixlen;
+	memcpy(key->address, nl_addr_get_binary_addr(addr), len);
+
+	// clear the host bits
+	if (prefixlen % 8) {
+		key->address[prefixlen / 8] &= (uint8_t) (0xff << (8 - prefixlen % 8));
+		prefixlen += 8 - prefixlen % 8;
+	}
+	memset(key->address + prefixlen / 8, 0, sizeof(key->address) - prefixlen / 8);
+}
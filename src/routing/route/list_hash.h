@@ -14,23 +14,40 @@
 #ifndef ROUTING_ROUTE_LIST_HASH_H
 #define ROUTING_ROUTE_LIST_HASH_H
 
+#include <stdint.h>
 #include <netlink/addr.h>
 
+#include <uthash.h>
+
 #include "route.h"
 #include "route/list.h"
 
-// "hash" like struct - simpler implementation rather than adding one more linked list struct for real hash implementation
-// use this implementation for now instead of using uthash - see about key and how to implement hash because of prefix pointer being the key
+// prefix key - only the first prefixlen address bits are kept, so the address length doesn't matter
+// (0.0.0.0/0 from the configuration and the kernel default route without address bytes share a key)
+struct route_list_hash_key {
+	uint8_t family;
+	uint8_t prefixlen;
+	uint8_t address[16];
+};
+
+// routes grouped by destination prefix - hashed on the prefix key and linked through next in insertion order
 struct route_list_hash_element {
+	struct route_list_hash_key key;
 	struct nl_addr *prefix;
 	struct route_list_element *routes_head;
 	struct route_list_hash_element *next;
+	UT_hash_handle hh;
 };
 
 void route_list_hash_init(struct route_list_hash_element **head);
 void route_list_hash_add(struct route_list_hash_element **head, struct nl_addr *addr, struct route *route);
+void route_list_hash_add_arena(struct route_list_hash_element **head, struct route_arena *arena, struct nl_addr *addr, struct route *route);
 void route_list_hash_add_empty(struct route_list_hash_element **head, struct nl_addr *addr);
 struct route_list_element **route_list_hash_get(struct route_list_hash_element **head, struct nl_addr *addr);
+struct route_list_hash_element *route_list_hash_get_element(struct route_list_hash_element **head, struct nl_addr *addr);
+void route_list_hash_remove(struct route_list_hash_element **head, struct nl_addr *addr);
+void route_list_hash_remove_arena(struct route_list_hash_element **head, struct route_arena *arena, struct nl_addr *addr);
 void route_list_hash_free(struct route_list_hash_element **head);
+void route_list_hash_free_arena(struct route_list_hash_element **head, struct route_arena *arena);
 
 #endif // ROUTING_ROUTE_LIST_HASH_H
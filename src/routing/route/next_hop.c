@@ -11,15 +11,106 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#include <string.h>
+#include <arpa/inet.h>
+
 #include <netlink/addr.h>
 #include <netlink/route/nexthop.h>
 #include <sysrepo.h>
 
+#include "route/arena.h"
 #include "route/next_hop.h"
 #include "utils/memory.h"
 
 #include <utlist.h>
 
+static const char *route_next_hop_special_names[] = {
+	[route_next_hop_special_blackhole] = "blackhole",
+	[route_next_hop_special_unreachable] = "unreachable",
+	[route_next_hop_special_prohibit] = "prohibit",
+	[route_next_hop_special_receive] = "receive",
+};
+
+static struct route_next_hop_list_element *route_next_hop_list_element_alloc(struct route_arena *arena);
+static void route_next_hop_list_append(struct route_next_hop *nh, struct route_arena *arena, const struct route_next_hop_simple *simple);
+
+void route_address_set(struct route_address *addr, struct nl_addr *nl_addr)
+{
+	unsigned int len = 0;
+
+	memset(addr, 0, sizeof(*addr));
+
+	if (nl_addr == NULL) {
+		return;
+	}
+
+	len = nl_addr_get_len(nl_addr);
+	if (len > sizeof(addr->data)) {
+		len = sizeof(addr->data);
+	}
+
+	addr->family = (uint8_t) nl_addr_get_family(nl_addr);
+	addr->len = (uint8_t) len;
+	memcpy(addr->data, nl_addr_get_binary_addr(nl_addr), len);
+}
+
+bool route_address_is_set(const struct route_address *addr)
+{
+	return addr->family != AF_UNSPEC;
+}
+
+int route_address_cmp(const struct route_address *a, const struct route_address *b)
+{
+	if (a->family != b->family) {
+		return a->family - b->family;
+	}
+
+	if (a->len != b->len) {
+		return a->len - b->len;
+	}
+
+	return memcmp(a->data, b->data, a->len);
+}
+
+struct nl_addr *route_address_to_nl_addr(const struct route_address *addr)
+{
+	if (!route_address_is_set(addr)) {
+		return NULL;
+	}
+
+	return nl_addr_build(addr->family, addr->data, addr->len);
+}
+
+char *route_address2str(const struct route_address *addr, char *buffer, size_t size)
+{
+	if (!route_address_is_set(addr) || inet_ntop(addr->family, addr->data, buffer, (socklen_t) size) == NULL) {
+		snprintf(buffer, size, "none");
+	}
+
+	return buffer;
+}
+
+const char *route_next_hop_special2str(enum route_next_hop_special special)
+{
+	if ((size_t) special >= sizeof(route_next_hop_special_names) / sizeof(route_next_hop_special_names[0])) {
+		return NULL;
+	}
+
+	return route_next_hop_special_names[special];
+}
+
+int route_next_hop_str2special(const char *str, enum route_next_hop_special *special)
+{
+	for (size_t i = 0; i < sizeof(route_next_hop_special_names) / sizeof(route_next_hop_special_names[0]); i++) {
+		if (strcmp(route_next_hop_special_names[i], str) == 0) {
+			*special = (enum route_next_hop_special) i;
+			return 0;
+		}
+	}
+
+	return -1;
+}
+
 void route_next_hop_init(struct route_next_hop *nh)
 {
 	nh->kind = route_next_hop_kind_none;
@@ -28,73 +119,57 @@ void route_next_hop_init(struct route_next_hop *nh)
 void route_next_hop_set_simple_gateway(struct route_next_hop *nh, struct nl_addr *gw)
 {
 	nh->kind = route_next_hop_kind_simple;
-	if (gw) {
-		nh->value.simple.addr = nl_addr_clone(gw);
-	} else {
-		nh->value.simple.addr = NULL;
-	}
+	route_address_set(&nh->value.simple.addr, gw);
 }
 
-void route_next_hop_set_simple_interface(struct route_next_hop *nh, int ifindex, const char *if_name)
+void route_next_hop_set_simple_interface(struct route_next_hop *nh, int ifindex)
 {
 	nh->value.simple.ifindex = ifindex;
-	nh->value.simple.if_name = xstrdup(if_name);
 }
 
-void route_next_hop_set_simple(struct route_next_hop *nh, int ifindex, const char *if_name, struct nl_addr *gw)
+void route_next_hop_set_simple(struct route_next_hop *nh, int ifindex, struct nl_addr *gw)
 {
 	route_next_hop_set_simple_gateway(nh, gw);
-	route_next_hop_set_simple_interface(nh, ifindex, if_name);
+	route_next_hop_set_simple_interface(nh, ifindex);
 }
 
-void route_next_hop_set_special(struct route_next_hop *nh, char *value)
+void route_next_hop_set_special(struct route_next_hop *nh, enum route_next_hop_special special)
 {
 	nh->kind = route_next_hop_kind_special;
-	if (value) {
-		nh->value.special.value = xstrdup(value);
-	}
+	nh->value.special = special;
 }
 
-void route_next_hop_add_list(struct route_next_hop *nh, int ifindex, const char *if_name, struct nl_addr *gw)
+void route_next_hop_add_list(struct route_next_hop *nh, int ifindex, struct nl_addr *gw)
 {
-	struct route_next_hop_list_element *new_element = NULL;
-
-	if (nh->kind == route_next_hop_kind_none) {
-		nh->value.list_head = NULL;
-		nh->kind = route_next_hop_kind_list;
-	}
+	struct route_next_hop_simple simple = {0};
 
-	new_element = xmalloc(sizeof(*new_element));
-	new_element->next = NULL;
-	new_element->simple.ifindex = ifindex;
-	new_element->simple.if_name = xstrdup(if_name);
-	if (gw) {
-		new_element->simple.addr = nl_addr_clone(gw);
-	} else {
-		new_element->simple.addr = NULL;
-	}
+	simple.ifindex = ifindex;
+	route_address_set(&simple.addr, gw);
 
-	LL_APPEND(nh->value.list_head, new_element);
+	route_next_hop_list_append(nh, NULL, &simple);
 }
 
 struct route_next_hop route_next_hop_clone(struct route_next_hop *nh)
+{
+	return route_next_hop_clone_arena(nh, NULL);
+}
+
+struct route_next_hop route_next_hop_clone_arena(struct route_next_hop *nh, struct route_arena *arena)
 {
 	struct route_next_hop out = {0};
 	struct route_next_hop_list_element *list_iter = NULL;
 
 	switch (nh->kind) {
 		case route_next_hop_kind_none:
-			break;
 		case route_next_hop_kind_simple:
-			route_next_hop_set_simple(&out, nh->value.simple.ifindex, nh->value.simple.if_name, nh->value.simple.addr);
-			break;
 		case route_next_hop_kind_special:
-			route_next_hop_set_special(&out, nh->value.special.value);
+			// no allocations - the value is copied as is
+			out = *nh;
 			break;
 		case route_next_hop_kind_list:
 			LL_FOREACH(nh->value.list_head, list_iter)
 			{
-				route_next_hop_add_list(&out, list_iter->simple.ifindex, list_iter->simple.if_name, list_iter->simple.addr);
+				route_next_hop_list_append(&out, arena, &list_iter->simple);
 			}
 			break;
 	}
@@ -103,42 +178,51 @@ struct route_next_hop route_next_hop_clone(struct route_next_hop *nh)
 }
 
 void route_next_hop_free(struct route_next_hop *nh)
+{
+	route_next_hop_free_arena(nh, NULL);
+}
+
+void route_next_hop_free_arena(struct route_next_hop *nh, struct route_arena *arena)
 {
 	struct route_next_hop_list_element *list_iter = NULL, *tmp = NULL;
 
-	switch (nh->kind) {
-		case route_next_hop_kind_none:
-			break;
-		case route_next_hop_kind_simple:
-			if (nh->value.simple.addr) {
-				nl_addr_put(nh->value.simple.addr);
-			}
+	if (nh->kind == route_next_hop_kind_list) {
+		LL_FOREACH_SAFE(nh->value.list_head, list_iter, tmp)
+		{
+			LL_DELETE(nh->value.list_head, list_iter);
 
-			if (nh->value.simple.if_name) {
-				FREE_SAFE(nh->value.simple.if_name);
-			}
-			break;
-		case route_next_hop_kind_special:
-			if (nh->value.special.value != NULL) {
-				FREE_SAFE(nh->value.special.value);
+			if (arena) {
+				route_slab_release(&arena->next_hops, list_iter);
+			} else {
+				free(list_iter);
 			}
-			break;
-		case route_next_hop_kind_list:
-			LL_FOREACH_SAFE(nh->value.list_head, list_iter, tmp)
-			{
-				LL_DELETE(nh->value.list_head, list_iter);
+		}
+	}
+
+	route_next_hop_init(nh);
+}
 
-				if (list_iter->simple.addr) {
-					nl_addr_put(list_iter->simple.addr);
-				}
+static struct route_next_hop_list_element *route_next_hop_list_element_alloc(struct route_arena *arena)
+{
+	if (arena) {
+		return route_slab_alloc(&arena->next_hops);
+	}
 
-				if (list_iter->simple.if_name) {
-					FREE_SAFE(list_iter->simple.if_name);
-				}
+	return xmalloc(sizeof(struct route_next_hop_list_element));
+}
 
-				free(list_iter);
-			}
-			break;
+static void route_next_hop_list_append(struct route_next_hop *nh, struct route_arena *arena, const struct route_next_hop_simple *simple)
+{
+	struct route_next_hop_list_element *new_element = NULL;
+
+	if (nh->kind == route_next_hop_kind_none) {
+		nh->value.list_head = NULL;
+		nh->kind = route_next_hop_kind_list;
 	}
-	route_next_hop_init(nh);
+
+	new_element = route_next_hop_list_element_alloc(arena);
+	new_element->next = NULL;
+	new_element->simple = *simple;
+
+	LL_APPEND(nh->value.list_head, new_element);
 }
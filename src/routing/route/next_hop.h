@@ -15,6 +15,11 @@
 #define ROUTING_ROUTE_NEXT_HOP_H
 
 #include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <netlink/addr.h>
+
+struct route_arena;
 
 enum route_next_hop_kind {
 	route_next_hop_kind_none = 0,
@@ -23,16 +28,25 @@ enum route_next_hop_kind {
 	route_next_hop_kind_list
 };
 
-// single next hop - interface index
-struct route_next_hop_simple {
-	struct nl_addr *addr;
-	int ifindex;
-	char *if_name;
+// special-next-hop enum values of the model
+enum route_next_hop_special {
+	route_next_hop_special_blackhole = 0,
+	route_next_hop_special_unreachable,
+	route_next_hop_special_prohibit,
+	route_next_hop_special_receive
 };
 
-// enum string value
-struct route_next_hop_special {
-	char *value;
+// next-hop address stored inline - family AF_UNSPEC when not set
+struct route_address {
+	uint8_t family;
+	uint8_t len;
+	uint8_t data[16];
+};
+
+// single next hop - interface index, the name is resolved from the interface table when serialized
+struct route_next_hop_simple {
+	struct route_address addr;
+	int ifindex;
 };
 
 struct route_next_hop_list_element {
@@ -42,7 +56,7 @@ struct route_next_hop_list_element {
 
 union route_next_hop_value {
 	struct route_next_hop_simple simple;
-	struct route_next_hop_special special;
+	enum route_next_hop_special special;
 	struct route_next_hop_list_element *list_head;
 };
 
@@ -51,13 +65,24 @@ struct route_next_hop {
 	union route_next_hop_value value;
 };
 
+void route_address_set(struct route_address *addr, struct nl_addr *nl_addr);
+bool route_address_is_set(const struct route_address *addr);
+int route_address_cmp(const struct route_address *a, const struct route_address *b);
+struct nl_addr *route_address_to_nl_addr(const struct route_address *addr);
+char *route_address2str(const struct route_address *addr, char *buffer, size_t size);
+
+const char *route_next_hop_special2str(enum route_next_hop_special special);
+int route_next_hop_str2special(const char *str, enum route_next_hop_special *special);
+
 void route_next_hop_init(struct route_next_hop *nh);
 void route_next_hop_set_simple_gateway(struct route_next_hop *nh, struct nl_addr *gw);
-void route_next_hop_set_simple_interface(struct route_next_hop *nh, int ifindex, const char *if_name);
-void route_next_hop_set_simple(struct route_next_hop *nh, int ifindex, const char *if_name, struct nl_addr *gw);
-void route_next_hop_set_special(struct route_next_hop *nh, char *value);
-void route_next_hop_add_list(struct route_next_hop *nh, int ifindex, const char *if_name, struct nl_addr *gw);
+void route_next_hop_set_simple_interface(struct route_next_hop *nh, int ifindex);
+void route_next_hop_set_simple(struct route_next_hop *nh, int ifindex, struct nl_addr *gw);
+void route_next_hop_set_special(struct route_next_hop *nh, enum route_next_hop_special special);
+void route_next_hop_add_list(struct route_next_hop *nh, int ifindex, struct nl_addr *gw);
 struct route_next_hop route_next_hop_clone(struct route_next_hop *nh);
+struct route_next_hop route_next_hop_clone_arena(struct route_next_hop *nh, struct route_arena *arena);
 void route_next_hop_free(struct route_next_hop *nh);
+void route_next_hop_free_arena(struct route_next_hop *nh, struct route_arena *arena);
 
 #endif // ROUTING_ROUTE_NEXT_HOP_H
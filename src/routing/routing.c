@@ -11,11 +11,14 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#include <errno.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <netinet/in.h>
 #include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
 #include <linux/genetlink.h>
 #include <linux/limits.h>
 #include <linux/neighbour.h>
@@ -57,6 +60,10 @@
 #include "persist.h"
 
 static bool routing_running_datastore_is_empty(sr_session_ctx_t *session);
+static int routing_events_start(struct routing_ctx *ctx);
+static void routing_events_stop(struct routing_ctx *ctx);
+static void routing_events_watch_manager(struct routing_ctx *ctx);
+static void *routing_events_thread_cb(void *data);
 
 int sr_plugin_init_cb(sr_session_ctx_t *session, void **private_data)
 {
@@ -65,9 +72,12 @@ int sr_plugin_init_cb(sr_session_ctx_t *session, void **private_data)
 	// sysrepo
 	sr_session_ctx_t *startup_session = NULL;
 	sr_conn_ctx_t *connection = NULL;
-	sr_subscription_ctx_t *subscription = NULL;
 	struct routing_ctx *ctx = NULL;
 
+	// plugin configuration
+	const char *route_batch_window_env = NULL;
+	const char *rib_workers_env = NULL;
+
 	*private_data = NULL;
 
 	// allocate routing plugin context
@@ -79,6 +89,26 @@ int sr_plugin_init_cb(sr_session_ctx_t *session, void **private_data)
 
 	// memset context to 0
 	*ctx = (struct routing_ctx){0};
+	rib_mirror_init(&ctx->rib_mirror);
+	ctx->epoll_fd = -1;
+	ctx->shutdown_fd = -1;
+	ctx->manager_fd = -1;
+
+	// static route requests in flight while applying changes
+	route_batch_window_env = getenv(ROUTING_ROUTE_BATCH_WINDOW_ENV);
+	ctx->route_batch_window = route_batch_window_env ? (unsigned int) strtoul(route_batch_window_env, NULL, 10) : ROUTING_ROUTE_BATCH_WINDOW_DEFAULT;
+	if (ctx->route_batch_window == 0) {
+		ctx->route_batch_window = ROUTING_ROUTE_BATCH_WINDOW_DEFAULT;
+	}
+	SRPLG_LOG_INF(PLUGIN_NAME, "Static routes will be programmed with up to %u requests in flight", ctx->route_batch_window);
+
+	// RIBs built and serialized in parallel
+	rib_workers_env = getenv(ROUTING_RIB_WORKERS_ENV);
+	ctx->rib_mirror.workers = rib_workers_env ? (unsigned int) strtoul(rib_workers_env, NULL, 10) : ROUTING_RIB_WORKERS_DEFAULT;
+	if (ctx->rib_mirror.workers == 0) {
+		ctx->rib_mirror.workers = ROUTING_RIB_WORKERS_DEFAULT;
+	}
+	SRPLG_LOG_INF(PLUGIN_NAME, "RIBs will be built and serialized by up to %u workers", ctx->rib_mirror.workers);
 
 	// set to private data
 	*private_data = ctx;
@@ -115,8 +145,8 @@ int sr_plugin_init_cb(sr_session_ctx_t *session, void **private_data)
 
 	SRPLG_LOG_INF(PLUGIN_NAME, "subscribing to module change");
 
-	// control-plane-protocol list module changes
-	error = sr_module_change_subscribe(session, BASE_YANG_MODEL, ROUTING_CONTROL_PLANE_PROTOCOL_LIST_YANG_PATH, routing_control_plane_protocol_list_change_cb, *private_data, 0, SR_SUBSCR_DEFAULT, &subscription);
+	// control-plane-protocol list module changes - all callbacks are processed by the event thread
+	error = sr_module_change_subscribe(session, BASE_YANG_MODEL, ROUTING_CONTROL_PLANE_PROTOCOL_LIST_YANG_PATH, routing_control_plane_protocol_list_change_cb, *private_data, 0, SR_SUBSCR_NO_THREAD, &ctx->subscription);
 	if (error) {
 		SRPLG_LOG_ERR(PLUGIN_NAME, "sr_module_change_subscribe error (%d): %s", error, sr_strerror(error));
 		goto error_out;
@@ -125,14 +155,14 @@ int sr_plugin_init_cb(sr_session_ctx_t *session, void **private_data)
 	SRPLG_LOG_INF(PLUGIN_NAME, "subscribing to interfaces operational data");
 
 	// interface leaf-list oper data
-	error = sr_oper_get_subscribe(session, BASE_YANG_MODEL, ROUTING_INTERFACES_CONTAINER_YANG_PATH, routing_oper_get_interfaces_cb, NULL, 0, &subscription);
+	error = sr_oper_get_subscribe(session, BASE_YANG_MODEL, ROUTING_INTERFACES_CONTAINER_YANG_PATH, routing_oper_get_interfaces_cb, *private_data, SR_SUBSCR_NO_THREAD, &ctx->subscription);
 	if (error) {
 		SRPLG_LOG_ERR(PLUGIN_NAME, "sr_oper_get_items_subscribe error (%d): %s", error, sr_strerror(error));
 		goto error_out;
 	}
 
 	// RIB oper data
-	error = sr_oper_get_subscribe(session, BASE_YANG_MODEL, ROUTING_RIB_LIST_YANG_PATH, routing_oper_get_rib_routes_cb, NULL, 1, &subscription);
+	error = sr_oper_get_subscribe(session, BASE_YANG_MODEL, ROUTING_RIB_LIST_YANG_PATH, routing_oper_get_rib_routes_cb, *private_data, SR_SUBSCR_NO_THREAD, &ctx->subscription);
 	if (error) {
 		SRPLG_LOG_ERR(PLUGIN_NAME, "sr_oper_get_items_subscribe error (%d): %s", error, sr_strerror(error));
 		goto error_out;
@@ -141,12 +171,18 @@ int sr_plugin_init_cb(sr_session_ctx_t *session, void **private_data)
 	SRPLG_LOG_INF(PLUGIN_NAME, "subscribing to plugin RPCs/actions");
 
 	// active-route RPC/action
-	error = sr_rpc_subscribe(session, ROUTING_RIB_LIST_ACTIVE_ROUTE_RPC_PATH, routing_rpc_active_route_cb, NULL, 1, 1, &subscription);
+	error = sr_rpc_subscribe(session, ROUTING_RIB_LIST_ACTIVE_ROUTE_RPC_PATH, routing_rpc_active_route_cb, *private_data, 1, SR_SUBSCR_NO_THREAD, &ctx->subscription);
 	if (error) {
 		SRPLG_LOG_ERR(PLUGIN_NAME, "sr_rpc_subscribe error (%d): %s", error, sr_strerror(error));
 		goto error_out;
 	}
 
+	error = routing_events_start(ctx);
+	if (error) {
+		SRPLG_LOG_ERR(PLUGIN_NAME, "routing_events_start() failed (%d)", error);
+		goto error_out;
+	}
+
 	goto out;
 
 error_out:
@@ -165,6 +201,15 @@ void sr_plugin_cleanup_cb(sr_session_ctx_t *session, void *private_data)
 		sr_session_stop(startup_session);
 	}
 
+	// no callback may run once the RIB mirror is freed
+	routing_events_stop(ctx);
+
+	if (ctx->subscription) {
+		sr_unsubscribe(ctx->subscription);
+	}
+
+	rib_mirror_free(&ctx->rib_mirror);
+
 	// release context memory
 	FREE_SAFE(ctx);
 }
@@ -191,3 +236,165 @@ static bool routing_running_datastore_is_empty(sr_session_ctx_t *session)
 out:
 	return is_empty;
 }
+
+static int routing_events_start(struct routing_ctx *ctx)
+{
+	int error = 0;
+	int event_pipe = -1;
+	struct epoll_event event = {0};
+
+	error = sr_subscription_get_event_pipe(ctx->subscription, &event_pipe);
+	if (error) {
+		SRPLG_LOG_ERR(PLUGIN_NAME, "sr_subscription_get_event_pipe error (%d): %s", error, sr_strerror(error));
+		goto error_out;
+	}
+
+	ctx->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+	if (ctx->epoll_fd < 0) {
+		SRPLG_LOG_ERR(PLUGIN_NAME, "epoll_create1() failed (%s)", strerror(errno));
+		goto error_out;
+	}
+
+	ctx->shutdown_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+	if (ctx->shutdown_fd < 0) {
+		SRPLG_LOG_ERR(PLUGIN_NAME, "eventfd() failed (%s)", strerror(errno));
+		goto error_out;
+	}
+
+	event.events = EPOLLIN;
+	event.data.fd = event_pipe;
+	if (epoll_ctl(ctx->epoll_fd, EPOLL_CTL_ADD, event.data.fd, &event) < 0) {
+		SRPLG_LOG_ERR(PLUGIN_NAME, "epoll_ctl() failed (%s)", strerror(errno));
+		goto error_out;
+	}
+
+	event.events = EPOLLIN;
+	event.data.fd = ctx->shutdown_fd;
+	if (epoll_ctl(ctx->epoll_fd, EPOLL_CTL_ADD, event.data.fd, &event) < 0) {
+		SRPLG_LOG_ERR(PLUGIN_NAME, "epoll_ctl() failed (%s)", strerror(errno));
+		goto error_out;
+	}
+
+	// joined on cleanup
+	if (pthread_create(&ctx->event_thread, NULL, routing_events_thread_cb, ctx) != 0) {
+		SRPLG_LOG_ERR(PLUGIN_NAME, "pthread_create() failed");
+		goto error_out;
+	}
+	ctx->event_thread_started = 1;
+
+	goto out;
+
+error_out:
+	error = -1;
+
+	if (ctx->shutdown_fd >= 0) {
+		close(ctx->shutdown_fd);
+		ctx->shutdown_fd = -1;
+	}
+
+	if (ctx->epoll_fd >= 0) {
+		close(ctx->epoll_fd);
+		ctx->epoll_fd = -1;
+	}
+
+out:
+	return error;
+}
+
+static void routing_events_stop(struct routing_ctx *ctx)
+{
+	if (!ctx->event_thread_started) {
+		return;
+	}
+
+	// wake up the event thread and wait for it to exit
+	if (eventfd_write(ctx->shutdown_fd, 1) < 0) {
+		SRPLG_LOG_ERR(PLUGIN_NAME, "eventfd_write() failed (%s)", strerror(errno));
+		pthread_cancel(ctx->event_thread);
+	}
+	pthread_join(ctx->event_thread, NULL);
+
+	close(ctx->shutdown_fd);
+	close(ctx->epoll_fd);
+
+	ctx->shutdown_fd = -1;
+	ctx->epoll_fd = -1;
+	ctx->manager_fd = -1;
+	ctx->event_thread_started = 0;
+}
+
+static void routing_events_watch_manager(struct routing_ctx *ctx)
+{
+	struct epoll_event event = {0};
+	const int manager_fd = ctx->rib_mirror.cache_manager ? nl_cache_mngr_get_fd(ctx->rib_mirror.cache_manager) : -1;
+
+	// the manager is set up by the first sync and set up again after a failed one
+	if (manager_fd == ctx->manager_fd) {
+		return;
+	}
+
+	// a closed socket leaves the epoll set on its own
+	if (ctx->manager_fd >= 0) {
+		epoll_ctl(ctx->epoll_fd, EPOLL_CTL_DEL, ctx->manager_fd, NULL);
+	}
+
+	ctx->manager_fd = -1;
+
+	if (manager_fd < 0) {
+		return;
+	}
+
+	event.events = EPOLLIN;
+	event.data.fd = manager_fd;
+	if (epoll_ctl(ctx->epoll_fd, EPOLL_CTL_ADD, event.data.fd, &event) < 0) {
+		SRPLG_LOG_ERR(PLUGIN_NAME, "epoll_ctl() failed (%s) - RIB notifications are applied on requests only", strerror(errno));
+		return;
+	}
+
+	ctx->manager_fd = manager_fd;
+}
+
+static void *routing_events_thread_cb(void *data)
+{
+	struct routing_ctx *ctx = data;
+	struct epoll_event events[3];
+	int events_count = 0;
+	int error = 0;
+
+	do {
+		// block until sysrepo events or RIB notifications arrive or cleanup signals the shutdown event
+		events_count = epoll_wait(ctx->epoll_fd, events, (int) (sizeof(events) / sizeof(events[0])), -1);
+		if (events_count < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+
+			SRPLG_LOG_ERR(PLUGIN_NAME, "epoll_wait() failed (%s) - stopping the event thread", strerror(errno));
+			break;
+		}
+
+		for (int i = 0; i < events_count; i++) {
+			if (events[i].data.fd == ctx->shutdown_fd) {
+				return NULL;
+			}
+
+			if (events[i].data.fd == ctx->manager_fd) {
+				// the callbacks run on this thread as well - the RIBs never change under them
+				error = rib_mirror_sync(&ctx->rib_mirror);
+				if (error != 0) {
+					SRPLG_LOG_ERR(PLUGIN_NAME, "rib_mirror_sync() failed (%d)", error);
+				}
+			} else {
+				error = sr_subscription_process_events(ctx->subscription, NULL, NULL);
+				if (error != SR_ERR_OK) {
+					SRPLG_LOG_ERR(PLUGIN_NAME, "sr_subscription_process_events error (%d): %s", error, sr_strerror(error));
+				}
+			}
+
+			// callbacks and failed syncs set up the mirror manager
+			routing_events_watch_manager(ctx);
+		}
+	} while (1);
+
+	return NULL;
+}
@@ -26,8 +26,8 @@
 #include <utlist.h>
 
 static int routing_startup_load_ribs(sr_session_ctx_t *session, struct lyd_node *routing_container_node);
-static int routing_startup_load_control_plane_protocols(sr_session_ctx_t *session, struct lyd_node *routing_container_node);
-static int routing_startup_collect_static_routes(struct route_list_hash_element **ipv4_head, struct route_list_hash_element **ipv6_head);
+static int routing_startup_load_control_plane_protocols(struct routing_ctx *ctx, sr_session_ctx_t *session, struct lyd_node *routing_container_node);
+static int routing_startup_collect_static_routes(struct rib_mirror *mirror, struct route_list_hash_element **ipv4_head, struct route_list_hash_element **ipv6_head);
 static int routing_build_protos_map(struct control_plane_protocol map[ROUTING_PROTOS_COUNT]);
 static int routing_is_proto_type_known(int type);
 
@@ -57,7 +57,7 @@ int routing_startup_load_data(struct routing_ctx *ctx, sr_session_ctx_t *session
 		goto error_out;
 	}
 
-	error = routing_startup_load_control_plane_protocols(session, routing_container_node);
+	error = routing_startup_load_control_plane_protocols(ctx, session, routing_container_node);
 	if (error) {
 		SRPLG_LOG_ERR(PLUGIN_NAME, "routing_load_control_plane_protocols failed : %d", error);
 		goto error_out;
@@ -199,7 +199,7 @@ out:
 	return error;
 }
 
-static int routing_startup_load_control_plane_protocols(sr_session_ctx_t *session, struct lyd_node *routing_container_node)
+static int routing_startup_load_control_plane_protocols(struct routing_ctx *ctx, sr_session_ctx_t *session, struct lyd_node *routing_container_node)
 {
 	// error handling
 	int error = 0;
@@ -216,6 +216,7 @@ static int routing_startup_load_control_plane_protocols(sr_session_ctx_t *sessio
 	struct lyd_node *ipv4_container_node = NULL, *ipv6_container_node = NULL;
 	struct lyd_node *route_node = NULL;
 	struct lyd_node *nh_node = NULL, *nh_list_node = NULL;
+	const char *if_name = NULL;
 
 	// temp buffers
 	char list_buffer[PATH_MAX] = {0};
@@ -263,7 +264,7 @@ static int routing_startup_load_control_plane_protocols(sr_session_ctx_t *sessio
 	}
 
 	// collect current system static routes
-	error = routing_startup_collect_static_routes(&ipv4_static_routes_head, &ipv6_static_routes_head);
+	error = routing_startup_collect_static_routes(&ctx->rib_mirror, &ipv4_static_routes_head, &ipv6_static_routes_head);
 	if (error) {
 		SRPLG_LOG_ERR(PLUGIN_NAME, "routing_startup_collect_static_routes() failed: %d", error);
 		goto error_out;
@@ -359,8 +360,8 @@ static int routing_startup_load_control_plane_protocols(sr_session_ctx_t *sessio
 							break;
 						case route_next_hop_kind_simple: {
 							// next-hop-address
-							if (NEXTHOP->simple.addr) {
-								nl_addr2str(NEXTHOP->simple.addr, ip_buffer, sizeof(ip_buffer));
+							if (route_address_is_set(&NEXTHOP->simple.addr)) {
+								route_address2str(&NEXTHOP->simple.addr, ip_buffer, sizeof(ip_buffer));
 								ly_err = lyd_new_term(nh_node, ly_uv4mod, "next-hop-address", ip_buffer, false, &tmp_node);
 								if (ly_err != LY_SUCCESS) {
 									SRPLG_LOG_ERR(PLUGIN_NAME, "unable to create next-hop-address leaf for the node %s", route_path_buffer);
@@ -369,10 +370,11 @@ static int routing_startup_load_control_plane_protocols(sr_session_ctx_t *sessio
 							}
 
 							// outgoing-interface
-							if (NEXTHOP->simple.if_name) {
-								SRPLG_LOG_DBG(PLUGIN_NAME, "outgoing-interface = %s", NEXTHOP->simple.if_name);
+							if_name = interface_table_get_name(&ctx->rib_mirror.interfaces, NEXTHOP->simple.ifindex);
+							if (if_name) {
+								SRPLG_LOG_DBG(PLUGIN_NAME, "outgoing-interface = %s", if_name);
 
-								ly_err = lyd_new_term(nh_node, ly_uv4mod, "outgoing-interface", NEXTHOP->simple.if_name, false, &tmp_node);
+								ly_err = lyd_new_term(nh_node, ly_uv4mod, "outgoing-interface", if_name, false, &tmp_node);
 								if (ly_err != LY_SUCCESS) {
 									SRPLG_LOG_ERR(PLUGIN_NAME, "unable to create outgoing-interface leaf for the node %s", route_path_buffer);
 									goto error_out;
@@ -400,8 +402,8 @@ static int routing_startup_load_control_plane_protocols(sr_session_ctx_t *sessio
 									goto error_out;
 								}
 								// next-hop-address
-								if (nexthop_iter->simple.addr) {
-									nl_addr2str(nexthop_iter->simple.addr, ip_buffer, sizeof(ip_buffer));
+								if (route_address_is_set(&nexthop_iter->simple.addr)) {
+									route_address2str(&nexthop_iter->simple.addr, ip_buffer, sizeof(ip_buffer));
 									ly_err = lyd_new_term(nh_list_node, ly_uv4mod, "next-hop-address", ip_buffer, false, &tmp_node);
 									if (ly_err != LY_SUCCESS) {
 										SRPLG_LOG_ERR(PLUGIN_NAME, "unable to create next-hop-address leaf in the list for route %s", route_path_buffer);
@@ -410,8 +412,9 @@ static int routing_startup_load_control_plane_protocols(sr_session_ctx_t *sessio
 								}
 
 								// outgoing-interface
-								if (nexthop_iter->simple.if_name) {
-									ly_err = lyd_new_term(nh_list_node, ly_uv4mod, "outgoing-interface", nexthop_iter->simple.if_name, false, &tmp_node);
+								if_name = interface_table_get_name(&ctx->rib_mirror.interfaces, nexthop_iter->simple.ifindex);
+								if (if_name) {
+									ly_err = lyd_new_term(nh_list_node, ly_uv4mod, "outgoing-interface", if_name, false, &tmp_node);
 									if (ly_err != LY_SUCCESS) {
 										SRPLG_LOG_ERR(PLUGIN_NAME, "unable to create outgoing-interface leaf in the list for route %s", route_path_buffer);
 										goto error_out;
@@ -465,8 +468,8 @@ static int routing_startup_load_control_plane_protocols(sr_session_ctx_t *sessio
 							break;
 						case route_next_hop_kind_simple: {
 							// next-hop-address
-							if (NEXTHOP->simple.addr) {
-								nl_addr2str(NEXTHOP->simple.addr, ip_buffer, sizeof(ip_buffer));
+							if (route_address_is_set(&NEXTHOP->simple.addr)) {
+								route_address2str(&NEXTHOP->simple.addr, ip_buffer, sizeof(ip_buffer));
 								ly_err = lyd_new_term(nh_node, ly_uv6mod, "next-hop-address", ip_buffer, false, &tmp_node);
 								if (ly_err != LY_SUCCESS) {
 									SRPLG_LOG_ERR(PLUGIN_NAME, "unable to create next-hop-address leaf for the node %s", route_path_buffer);
@@ -475,8 +478,9 @@ static int routing_startup_load_control_plane_protocols(sr_session_ctx_t *sessio
 							}
 
 							// outgoing-interface
-							if (NEXTHOP->simple.if_name) {
-								ly_err = lyd_new_term(nh_node, ly_uv6mod, "outgoing-interface", NEXTHOP->simple.if_name, false, &tmp_node);
+							if_name = interface_table_get_name(&ctx->rib_mirror.interfaces, NEXTHOP->simple.ifindex);
+							if (if_name) {
+								ly_err = lyd_new_term(nh_node, ly_uv6mod, "outgoing-interface", if_name, false, &tmp_node);
 								if (ly_err != LY_SUCCESS) {
 									SRPLG_LOG_ERR(PLUGIN_NAME, "unable to create outgoing-interface leaf for the node %s", route_path_buffer);
 									goto error_out;
@@ -502,8 +506,8 @@ static int routing_startup_load_control_plane_protocols(sr_session_ctx_t *sessio
 									goto error_out;
 								}
 								// next-hop-address
-								if (nexthop_iter->simple.addr) {
-									nl_addr2str(nexthop_iter->simple.addr, ip_buffer, sizeof(ip_buffer));
+								if (route_address_is_set(&nexthop_iter->simple.addr)) {
+									route_address2str(&nexthop_iter->simple.addr, ip_buffer, sizeof(ip_buffer));
 									ly_err = lyd_new_term(nh_list_node, ly_uv6mod, "next-hop-address", ip_buffer, false, &tmp_node);
 									if (ly_err != LY_SUCCESS) {
 										SRPLG_LOG_ERR(PLUGIN_NAME, "unable to create next-hop-address leaf in the list for route %s", route_path_buffer);
@@ -512,8 +516,9 @@ static int routing_startup_load_control_plane_protocols(sr_session_ctx_t *sessio
 								}
 
 								// outgoing-interface
-								if (nexthop_iter->simple.if_name) {
-									ly_err = lyd_new_term(nh_list_node, ly_uv6mod, "outgoing-interface", nexthop_iter->simple.if_name, false, &tmp_node);
+								if_name = interface_table_get_name(&ctx->rib_mirror.interfaces, nexthop_iter->simple.ifindex);
+								if (if_name) {
+									ly_err = lyd_new_term(nh_list_node, ly_uv6mod, "outgoing-interface", if_name, false, &tmp_node);
 									if (ly_err != LY_SUCCESS) {
 										SRPLG_LOG_ERR(PLUGIN_NAME, "unable to create outgoing-interface leaf in the list for route %s", route_path_buffer);
 										goto error_out;
@@ -545,45 +550,21 @@ out:
 	return error;
 }
 
-static int routing_startup_collect_static_routes(struct route_list_hash_element **ipv4_head, struct route_list_hash_element **ipv6_head)
+static int routing_startup_collect_static_routes(struct rib_mirror *mirror, struct route_list_hash_element **ipv4_head, struct route_list_hash_element **ipv6_head)
 {
-	int nl_err = 0;
 	int error = 0;
 
-	struct nl_sock *socket = NULL;
 	struct rtnl_route *route = NULL;
-	struct nl_cache *cache = NULL;
-	struct nl_cache *link_cache = NULL;
 	struct route tmp_route = {0};
-	struct rtnl_link *iface = NULL;
-	char *if_name = NULL;
-	int ifindex = 0;
-
-	socket = nl_socket_alloc();
-	if (socket == NULL) {
-		SRPLG_LOG_ERR(PLUGIN_NAME, "unable to init nl_sock struct...");
-		goto error_out;
-	}
-
-	nl_err = nl_connect(socket, NETLINK_ROUTE);
-	if (nl_err != 0) {
-		SRPLG_LOG_ERR(PLUGIN_NAME, "nl_connect failed (%d): %s", nl_err, nl_geterror(nl_err));
-		goto error_out;
-	}
 
-	nl_err = rtnl_route_alloc_cache(socket, AF_UNSPEC, 0, &cache);
-	if (nl_err != 0) {
-		SRPLG_LOG_ERR(PLUGIN_NAME, "rtnl_route_alloc_cache failed (%d): %s", nl_err, nl_geterror(nl_err));
-		goto error_out;
-	}
-
-	nl_err = rtnl_link_alloc_cache(socket, AF_UNSPEC, &link_cache);
-	if (nl_err != 0) {
-		SRPLG_LOG_ERR(PLUGIN_NAME, "rtnl_route_alloc_cache failed (%d): %s", nl_err, nl_geterror(nl_err));
+	// the mirror dump is reused by the operational callbacks - no separate route and link dump at startup
+	error = rib_mirror_sync(mirror);
+	if (error != 0) {
+		SRPLG_LOG_ERR(PLUGIN_NAME, "rib_mirror_sync() failed (%d)", error);
 		goto error_out;
 	}
 
-	route = (struct rtnl_route *) nl_cache_get_first(cache);
+	route = (struct rtnl_route *) nl_cache_get_first(mirror->route_cache);
 	while (route != NULL) {
 		const int PROTO = rtnl_route_get_protocol(route);
 
@@ -597,17 +578,13 @@ static int routing_startup_collect_static_routes(struct route_list_hash_element
 			const int NEXTHOP_COUNT = rtnl_route_get_nnexthops(route);
 			if (NEXTHOP_COUNT == 1) {
 				struct rtnl_nexthop *nh = rtnl_route_nexthop_n(route, 0);
-				ifindex = rtnl_route_nh_get_ifindex(nh);
-				iface = rtnl_link_get(link_cache, ifindex);
-				if_name = rtnl_link_get_name(iface);
-				route_next_hop_set_simple(&tmp_route.next_hop, ifindex, if_name, rtnl_route_nh_get_gateway(nh));
-				rtnl_link_put(iface);
+				route_next_hop_set_simple(&tmp_route.next_hop, rtnl_route_nh_get_ifindex(nh), rtnl_route_nh_get_gateway(nh));
 			} else {
 				rtnl_route_foreach_nexthop(route, foreach_nexthop, &tmp_route.next_hop);
 			}
 
 			// route-metadata/source-protocol
-			route_set_source_protocol(&tmp_route, "ietf-routing:static");
+			route_set_source_protocol(&tmp_route, route_source_protocol_static);
 
 			// add the route to the protocol's container
 			if (AF == AF_INET) {
@@ -629,9 +606,6 @@ error_out:
 	SRPLG_LOG_ERR(PLUGIN_NAME, "error initializing static routes");
 	error = -1;
 out:
-	nl_cache_free(cache);
-	nl_cache_free(link_cache);
-	nl_socket_free(socket);
 	return error;
 }
 
@@ -39,6 +39,10 @@
 
 // helpers
 static int apply_static_routes_changes(struct routing_ctx *ctx, sr_session_ctx_t *session, const char *base_xpath);
+static int load_static_route(const struct lyd_node *route_node, struct route *route);
+static const struct route *find_installed_static_route(struct routing_ctx *ctx, struct nl_addr *prefix);
+static bool static_route_next_hop_matches(const struct route_next_hop *desired, const struct route_next_hop *installed);
+static bool next_hop_simple_matches(const struct route_next_hop_simple *desired, const struct route_next_hop_simple *installed);
 
 int routing_control_plane_protocol_list_change_cb(sr_session_ctx_t *session, uint32_t subscription_id, const char *module_name, const char *xpath, sr_event_t event, uint32_t request_id, void *private_data)
 {
@@ -101,36 +105,39 @@ static int apply_static_routes_changes(struct routing_ctx *ctx, sr_session_ctx_t
 {
 	int error = 0;
 
-	// buffers
-	char change_path[PATH_MAX] = {0};
-
 	// sysrepo
 	sr_change_iter_t *changes_iterator = NULL;
 	sr_change_oper_t operation = SR_OP_CREATED;
 	const char *prev_value = NULL;
 	const char *prev_list = NULL;
 	int prev_default = 0;
-	const char *node_value = NULL;
-	const char *node_name = NULL;
+	sr_data_t *route_data = NULL;
 
 	// libnl
-	struct nl_addr *prefix = NULL, *gateway = NULL;
+	struct nl_addr *prefix = NULL;
 	struct nl_sock *socket = NULL;
 
 	// libyang
-	const struct lyd_node *node = NULL;
+	const struct lyd_node *node = NULL, *route_node = NULL;
+	struct lyd_node *prefix_node = NULL;
 
-	// new routes to add
-	struct route_list_hash_element *new_routes = NULL;
+	// prefixes of all changed routes - every prefix is reconciled once
+	struct route_list_hash_element *changed_routes = NULL;
+	struct route_list_hash_element *changed_iter = NULL;
+	char **changed_paths = NULL;
+	size_t changed_count = 0;
 
-	// routes to modify
+	// kernel delta - only routes which differ from the installed ones
+	struct route_list_hash_element *new_routes = NULL;
 	struct route_list_hash_element *modify_routes = NULL;
-
-	// existing routes to delete
 	struct route_list_hash_element *delete_routes = NULL;
+	struct route desired_route = {0};
+	const struct route *installed_route = NULL;
 
-	// helper value
-	struct route_list_element **routes_head = NULL;
+	// route requests of all changes
+	struct route_batch batch = {0};
+	const struct route_batch_entry *failed_entry = NULL;
+	char prefix_buffer[INET6_ADDRSTRLEN + 1 + 3] = {0};
 
 	error = sr_get_changes_iter(session, xpath, &changes_iterator);
 	if (error != SR_ERR_OK) {
@@ -139,110 +146,89 @@ static int apply_static_routes_changes(struct routing_ctx *ctx, sr_session_ctx_t
 	}
 
 	while (sr_get_change_tree_next(session, changes_iterator, &operation, &node, &prev_value, &prev_list, &prev_default) == SR_ERR_OK) {
-		error = (lyd_path(node, LYD_PATH_STD, change_path, sizeof(change_path)) == NULL);
-		if (error) {
-			SRPLG_LOG_ERR(PLUGIN_NAME, "lyd_path() error");
+		// any change inside a route list entry (created, modified or deleted) changes that route
+		for (route_node = node; route_node != NULL && strcmp(LYD_NAME(route_node), "route") != 0; route_node = lyd_parent(route_node)) {
+		}
+
+		if (route_node == NULL) {
+			continue;
+		}
+
+		if (lyd_find_path(route_node, "destination-prefix", 0, &prefix_node) != LY_SUCCESS) {
+			SRPLG_LOG_ERR(PLUGIN_NAME, "unable to find destination-prefix of a changed route");
 			goto error_out;
 		}
 
-		node_name = sr_xpath_node_name(change_path);
-		node_value = lyd_get_value(node);
-
-		SRPLG_LOG_DBG(PLUGIN_NAME, "Node Path: %s", change_path);
-		SRPLG_LOG_DBG(PLUGIN_NAME, "Node Name: %s", node_name);
-		SRPLG_LOG_DBG(PLUGIN_NAME, "Previous Value: %s; Value: %s; Operation: %d", prev_value, node_value, operation);
-
-		switch (operation) {
-			case SR_OP_CREATED:
-				// data needed: destination-prefix and next-hop address
-				if (!strncmp(node_name, "destination-prefix", sizeof("destination-prefix") - 1)) {
-					// create new route
-					error = nl_addr_parse(node_value, AF_UNSPEC, &prefix);
-					if (error != 0) {
-						SRPLG_LOG_ERR(PLUGIN_NAME, "nl_addr_parse() error (%d): %s", error, nl_geterror(error));
-						goto error_out;
-					}
+		error = nl_addr_parse(lyd_get_value(prefix_node), AF_UNSPEC, &prefix);
+		if (error != 0) {
+			SRPLG_LOG_ERR(PLUGIN_NAME, "nl_addr_parse() error (%d): %s", error, nl_geterror(error));
+			goto error_out;
+		}
 
-					// add empty route to the start of the list for 'prefix'
-					route_list_hash_add(&new_routes, prefix, &(struct route){0});
-					routes_head = route_list_hash_get(&new_routes, prefix);
-
-					// free created prefix
-					nl_addr_put(prefix);
-				} else if (!strncmp(node_name, "description", sizeof("description") - 1)) {
-					if (!routes_head) {
-						// error
-						SRPLG_LOG_ERR(PLUGIN_NAME, "invalid routes_head value");
-						goto error_out;
-					} else {
-						route_set_description(&(*routes_head)->route, node_value);
-					}
-				} else if (!strncmp(node_name, "next-hop-address", sizeof("next-hop-address") - 1)) {
-					// simple next hop
-					if (!routes_head) {
-						SRPLG_LOG_ERR(PLUGIN_NAME, "invalid routes_head value");
-						goto error_out;
-					} else {
-						error = nl_addr_parse(node_value, AF_UNSPEC, &gateway);
-						if (error != 0) {
-							SRPLG_LOG_ERR(PLUGIN_NAME, "nl_addr_parse() error (%d): %s", error, nl_geterror(error));
-							goto error_out;
-						}
-						route_next_hop_set_simple_gateway(&(*routes_head)->route.next_hop, gateway);
-
-						// free created gateway
-						nl_addr_put(gateway);
-					}
-				}
-				break;
-			case SR_OP_MODIFIED:
-				// data needed: next-hop container value
-				break;
-			case SR_OP_DELETED:
-				// data needed: destination-prefix (optional next-hop value)
-				if (!strncmp(node_name, "destination-prefix", sizeof("destination-prefix") - 1)) {
-					// create new route
-					error = nl_addr_parse(node_value, AF_UNSPEC, &prefix);
-					if (error != 0) {
-						SRPLG_LOG_ERR(PLUGIN_NAME, "nl_addr_parse() error (%d): %s", error, nl_geterror(error));
-						goto error_out;
-					}
+		if (route_list_hash_get_element(&changed_routes, prefix) == NULL) {
+			route_list_hash_add_empty(&changed_routes, prefix);
 
-					// add empty route to the start of the list for 'prefix'
-					route_list_hash_add(&delete_routes, prefix, &(struct route){0});
-					routes_head = route_list_hash_get(&delete_routes, prefix);
-
-					// free created prefix
-					nl_addr_put(prefix);
-				} else if (!strncmp(node_name, "description", sizeof("description") - 1)) {
-					if (!routes_head) {
-						// error
-						SRPLG_LOG_ERR(PLUGIN_NAME, "invalid routes_head value");
-						goto error_out;
-					} else {
-						route_set_description(&(*routes_head)->route, node_value);
-					}
-				} else if (!strncmp(node_name, "next-hop-address", sizeof("next-hop-address") - 1)) {
-					// simple next hop
-					if (!routes_head) {
-						SRPLG_LOG_ERR(PLUGIN_NAME, "invalid routes_head value");
-						goto error_out;
-					} else {
-						error = nl_addr_parse(node_value, AF_UNSPEC, &gateway);
-						if (error != 0) {
-							SRPLG_LOG_ERR(PLUGIN_NAME, "nl_addr_parse() error (%d): %s", error, nl_geterror(error));
-							goto error_out;
-						}
-						route_next_hop_set_simple_gateway(&(*routes_head)->route.next_hop, gateway);
-
-						// free created gateway
-						nl_addr_put(gateway);
-					}
-				}
-				break;
-			default:
-				break;
+			changed_paths = xrealloc(changed_paths, (changed_count + 1) * sizeof(*changed_paths));
+			changed_paths[changed_count++] = lyd_path(route_node, LYD_PATH_STD, NULL, 0);
+		}
+
+		nl_addr_put(prefix);
+		prefix = NULL;
+	}
+
+	if (changed_count == 0) {
+		goto out;
+	}
+
+	// kernel static routes are compared against the RIB mirror - no route dump per change
+	error = rib_mirror_sync(&ctx->rib_mirror);
+	if (error != 0) {
+		SRPLG_LOG_ERR(PLUGIN_NAME, "rib_mirror_sync() failed (%d)", error);
+		goto error_out;
+	}
+
+	// changed_paths is filled in the same order as the changed_routes elements are linked
+	changed_iter = changed_routes;
+	for (size_t i = 0; i < changed_count; i++, changed_iter = changed_iter->next) {
+		installed_route = find_installed_static_route(ctx, changed_iter->prefix);
+
+		// the change session already sees the new configuration - a missing route was deleted
+		error = sr_get_subtree(session, changed_paths[i], 0, &route_data);
+		if ((error == SR_ERR_OK || error == SR_ERR_NOT_FOUND) && (route_data == NULL || route_data->tree == NULL)) {
+			if (installed_route) {
+				route_list_hash_add(&delete_routes, changed_iter->prefix, (struct route *) installed_route);
+			}
+			error = 0;
+		} else if (error == SR_ERR_OK) {
+			route_init(&desired_route);
+
+			error = load_static_route(route_data->tree, &desired_route);
+			if (error != 0) {
+				route_free(&desired_route);
+				goto error_out;
+			}
+
+			if (installed_route == NULL) {
+				route_list_hash_add(&new_routes, changed_iter->prefix, &desired_route);
+			} else if (!static_route_next_hop_matches(&desired_route.next_hop, &installed_route->next_hop)) {
+				// keep the installed metric - the replaced route has to match it
+				route_set_preference(&desired_route, installed_route->preference);
+				route_list_hash_add(&modify_routes, changed_iter->prefix, &desired_route);
+			}
+
+			route_free(&desired_route);
+		} else {
+			SRPLG_LOG_ERR(PLUGIN_NAME, "sr_get_subtree() failed (%d): %s", error, sr_strerror(error));
+			goto error_out;
 		}
+
+		sr_release_data(route_data);
+		route_data = NULL;
+	}
+
+	if (new_routes == NULL && modify_routes == NULL && delete_routes == NULL) {
+		SRPLG_LOG_INF(PLUGIN_NAME, "installed static routes already match the configuration");
+		goto out;
 	}
 
 	// allocate libnl socket for all modifications (new, modify and delete)
@@ -259,32 +245,63 @@ static int apply_static_routes_changes(struct routing_ctx *ctx, sr_session_ctx_t
 		goto error_out;
 	}
 
-	SRPLG_LOG_INF(PLUGIN_NAME, "applying recieved changes for static routes");
+	SRPLG_LOG_INF(PLUGIN_NAME, "reconciling %zu changed static routes", changed_count);
 
-	error = routing_apply_new_routes(socket, new_routes);
+	route_batch_init(&batch, socket, ctx->route_batch_window);
+
+	error = routing_apply_new_routes(&batch, new_routes);
 	if (error) {
 		SRPLG_LOG_ERR(PLUGIN_NAME, "routing_apply_new_routes() error (%d)", error);
 		goto error_out;
 	}
 
-	error = routing_apply_modify_routes(socket, modify_routes);
+	error = routing_apply_modify_routes(&batch, modify_routes);
 	if (error) {
 		SRPLG_LOG_ERR(PLUGIN_NAME, "routing_apply_modify_routes() error (%d)", error);
 		goto error_out;
 	}
 
-	error = routing_apply_delete_routes(socket, delete_routes);
+	error = routing_apply_delete_routes(&batch, delete_routes);
 	if (error) {
 		SRPLG_LOG_ERR(PLUGIN_NAME, "routing_apply_delete_routes() error (%d)", error);
 		goto error_out;
 	}
 
+	// send the remaining requests and wait for all ACKs
+	error = route_batch_flush(&batch);
+	if (error != 0 || batch.failed > 0) {
+		failed_entry = route_batch_log_failures(&batch);
+		if (failed_entry) {
+			nl_addr2str(failed_entry->prefix, prefix_buffer, sizeof(prefix_buffer));
+			sr_session_set_error_message(session, "%zu of %zu static route changes failed - unable to %s route %s: %s", batch.failed, batch.entries_count, route_batch_operation2str(failed_entry->operation), prefix_buffer, nl_geterror(failed_entry->error));
+		}
+		goto error_out;
+	}
+
+	SRPLG_LOG_INF(PLUGIN_NAME, "applied %zu static route changes", batch.entries_count);
+
 	goto out;
 
 error_out:
 	error = -1;
 
 out:
+	route_batch_free(&batch);
+
+	if (prefix) {
+		nl_addr_put(prefix);
+	}
+
+	if (route_data) {
+		sr_release_data(route_data);
+	}
+
+	for (size_t i = 0; i < changed_count; i++) {
+		free(changed_paths[i]);
+	}
+	FREE_SAFE(changed_paths);
+	route_list_hash_free(&changed_routes);
+
 	// libnl
 	if (socket) {
 		nl_socket_free(socket);
@@ -299,4 +316,198 @@ out:
 	sr_free_change_iter(changes_iterator);
 
 	return error;
-}
\ No newline at end of file
+}
+static int load_static_route(const struct lyd_node *route_node, struct route *route)
+{
+	int error = 0;
+
+	// libnl
+	struct nl_addr *gateway = NULL;
+	int ifindex = 0;
+	enum route_next_hop_special special = route_next_hop_special_blackhole;
+
+	// libyang
+	struct lyd_node *next_hop_node = NULL, *address_node = NULL, *interface_node = NULL, *special_node = NULL, *description_node = NULL;
+	struct lyd_node *list_node = NULL;
+	struct ly_set *list_set = NULL;
+
+	if (lyd_find_path(route_node, "description", 0, &description_node) == LY_SUCCESS) {
+		route_set_description(route, lyd_get_value(description_node));
+	}
+
+	if (lyd_find_path(route_node, "next-hop", 0, &next_hop_node) != LY_SUCCESS) {
+		SRPLG_LOG_ERR(PLUGIN_NAME, "static route without a next-hop container");
+		goto error_out;
+	}
+
+	if (lyd_find_path(next_hop_node, "special-next-hop", 0, &special_node) == LY_SUCCESS) {
+		if (route_next_hop_str2special(lyd_get_value(special_node), &special) != 0) {
+			SRPLG_LOG_ERR(PLUGIN_NAME, "unknown special-next-hop %s", lyd_get_value(special_node));
+			goto error_out;
+		}
+
+		route_next_hop_set_special(&route->next_hop, special);
+		goto out;
+	}
+
+	if (lyd_find_xpath(next_hop_node, "next-hop-list/next-hop", &list_set) == LY_SUCCESS && list_set->count > 0) {
+		for (uint32_t i = 0; i < list_set->count; i++) {
+			list_node = list_set->dnodes[i];
+			address_node = NULL;
+			interface_node = NULL;
+
+			lyd_find_path(list_node, "next-hop-address", 0, &address_node);
+			lyd_find_path(list_node, "outgoing-interface", 0, &interface_node);
+
+			if (address_node) {
+				error = nl_addr_parse(lyd_get_value(address_node), AF_UNSPEC, &gateway);
+				if (error != 0) {
+					SRPLG_LOG_ERR(PLUGIN_NAME, "nl_addr_parse() error (%d): %s", error, nl_geterror(error));
+					goto error_out;
+				}
+			}
+
+			ifindex = 0;
+			if (interface_node) {
+				ifindex = (int) if_nametoindex(lyd_get_value(interface_node));
+				if (ifindex == 0) {
+					SRPLG_LOG_ERR(PLUGIN_NAME, "unknown outgoing-interface %s", lyd_get_value(interface_node));
+					goto error_out;
+				}
+			}
+
+			route_next_hop_add_list(&route->next_hop, ifindex, gateway);
+
+			if (gateway) {
+				nl_addr_put(gateway);
+				gateway = NULL;
+			}
+		}
+		goto out;
+	}
+
+	lyd_find_path(next_hop_node, "next-hop-address", 0, &address_node);
+	lyd_find_path(next_hop_node, "outgoing-interface", 0, &interface_node);
+
+	if (address_node == NULL && interface_node == NULL) {
+		SRPLG_LOG_ERR(PLUGIN_NAME, "unable to get next-hop-address or outgoing-interface node");
+		goto error_out;
+	}
+
+	if (address_node) {
+		error = nl_addr_parse(lyd_get_value(address_node), AF_UNSPEC, &gateway);
+		if (error != 0) {
+			SRPLG_LOG_ERR(PLUGIN_NAME, "nl_addr_parse() error (%d): %s", error, nl_geterror(error));
+			goto error_out;
+		}
+	}
+
+	if (interface_node) {
+		ifindex = (int) if_nametoindex(lyd_get_value(interface_node));
+		if (ifindex == 0) {
+			SRPLG_LOG_ERR(PLUGIN_NAME, "unknown outgoing-interface %s", lyd_get_value(interface_node));
+			goto error_out;
+		}
+	}
+
+	route_next_hop_set_simple(&route->next_hop, ifindex, gateway);
+
+	goto out;
+
+error_out:
+	error = -1;
+
+out:
+	if (gateway) {
+		nl_addr_put(gateway);
+	}
+
+	ly_set_free(list_set, NULL);
+
+	return error;
+}
+
+static const struct route *find_installed_static_route(struct routing_ctx *ctx, struct nl_addr *prefix)
+{
+	struct rib *main_rib = NULL;
+	struct route_list_element **routes_head = NULL;
+	struct route_list_element *routes_iter = NULL;
+
+	main_rib = rib_list_get(&ctx->rib_mirror.ribs_head, "main", nl_addr_get_family(prefix));
+	if (main_rib == NULL) {
+		return NULL;
+	}
+
+	routes_head = route_list_hash_get(&main_rib->routes_head, prefix);
+	if (routes_head == NULL) {
+		return NULL;
+	}
+
+	// static routes are only installed with RTPROT_STATIC - the metric can differ (IPv6 maps 0 to 1024)
+	LL_FOREACH(*routes_head, routes_iter)
+	{
+		if (routes_iter->route.metadata.source_protocol == route_source_protocol_static) {
+			return &routes_iter->route;
+		}
+	}
+
+	return NULL;
+}
+
+static bool static_route_next_hop_matches(const struct route_next_hop *desired, const struct route_next_hop *installed)
+{
+	const struct route_next_hop_list_element *desired_iter = NULL, *installed_iter = NULL;
+	size_t desired_count = 0, installed_count = 0;
+	bool found = false;
+
+	if (desired->kind != installed->kind) {
+		return false;
+	}
+
+	switch (desired->kind) {
+		case route_next_hop_kind_simple:
+			return next_hop_simple_matches(&desired->value.simple, &installed->value.simple);
+		case route_next_hop_kind_special:
+			return desired->value.special == installed->value.special;
+		case route_next_hop_kind_list:
+			// the kernel doesn't keep the configured order of multipath next-hops - compare as sets
+			LL_COUNT(desired->value.list_head, desired_iter, desired_count);
+			LL_COUNT(installed->value.list_head, installed_iter, installed_count);
+			if (desired_count != installed_count) {
+				return false;
+			}
+
+			LL_FOREACH(desired->value.list_head, desired_iter)
+			{
+				found = false;
+				LL_FOREACH(installed->value.list_head, installed_iter)
+				{
+					if (next_hop_simple_matches(&desired_iter->simple, &installed_iter->simple)) {
+						found = true;
+						break;
+					}
+				}
+
+				if (!found) {
+					return false;
+				}
+			}
+			return true;
+		default:
+			return true;
+	}
+}
+
+static bool next_hop_simple_matches(const struct route_next_hop_simple *desired, const struct route_next_hop_simple *installed)
+{
+	if (route_address_cmp(&desired->addr, &installed->addr) != 0) {
+		return false;
+	}
+
+	// the kernel always reports the outgoing interface - only compare it when it is configured
+	if (desired->ifindex != 0 && desired->ifindex != installed->ifindex) {
+		return false;
+	}
+
+	return true;
+}
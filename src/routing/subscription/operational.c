@@ -13,14 +13,18 @@
 
 #include "operational.h"
 #include <routing/common.h>
+#include <routing/context.h>
+#include <routing/interface_table.h>
 #include <routing/rib.h>
 #include <routing/rib/list.h>
 #include <routing/route.h>
 #include <routing/route/list_hash.h>
 #include <routing/control_plane_protocol.h>
+#include <utils/memory.h>
 
 // sysrepo
 #include <sysrepo.h>
+#include <sysrepo/xpath.h>
 
 // libnl
 #include <netlink/route/link.h>
@@ -29,276 +33,151 @@
 // uthash
 #include <utlist.h>
 
+// RIB, address family, destination-prefix and source-protocol predicates of a request - empty fields match everything
+struct routing_oper_rib_filter {
+	char rib_name[64];
+	int address_family;
+	struct nl_addr *destination_prefix;
+	char source_protocol[64];
+};
+
+// one requested RIB - with workers every RIB is serialized into its own tree and merged into the parent afterwards
+struct routing_oper_rib_task {
+	struct rib *rib;
+	char name[64];
+	const struct lys_module *af_module;
+	struct lyd_node *tree;
+	struct lyd_node *rib_node;
+	int error;
+};
+
+struct routing_oper_rib_tasks {
+	const struct ly_ctx *ly_ctx;
+	const struct routing_oper_rib_filter *filter;
+	const struct interface_table *interfaces;
+	struct routing_oper_rib_task *tasks;
+};
+
+static int routing_oper_extract_request_key(const char *request_xpath, const char *node_name, const char *key_name, char *buffer, size_t buffer_size);
+static int routing_oper_parse_rib_filter(const char *request_xpath, struct routing_oper_rib_filter *filter);
+static bool routing_oper_source_protocol_matches(const struct routing_oper_rib_filter *filter, const char *source_protocol);
+static void routing_oper_build_prefix(struct nl_addr *prefix, int address_family, char *buffer, size_t buffer_size);
+static int routing_oper_build_rib_routes(struct lyd_node *routes_node, struct rib *rib, const struct lys_module *af_module, const struct routing_oper_rib_filter *filter, const struct interface_table *interfaces);
+static void routing_oper_build_rib_tree(size_t index, void *arg);
+static int routing_oper_build_route(struct lyd_node *routes_node, const struct lys_module *af_module, const char *prefix, const struct route *route, const struct interface_table *interfaces);
+
 int routing_oper_get_rib_routes_cb(sr_session_ctx_t *session, uint32_t subscription_id, const char *module_name, const char *path, const char *request_xpath, uint32_t request_id, struct lyd_node **parent, void *private_data)
 {
 	int error = SR_ERR_OK;
-	int nl_err = 0;
 	LY_ERR ly_err = LY_SUCCESS;
+	struct routing_ctx *ctx = (struct routing_ctx *) private_data;
+	struct routing_oper_rib_filter filter = {0};
 
 	// libyang
 	const struct ly_ctx *ly_ctx = NULL;
 	const struct lys_module *ly_uv4mod = NULL, *ly_uv6mod = NULL;
-	struct lyd_node *ly_node = NULL, *routes_node = NULL, *nh_node = NULL, *nh_list_node = NULL;
+	struct lyd_node *rib_node = NULL, *routes_node = NULL;
 
 	// libnl
-	struct nl_sock *socket = NULL;
-	struct nl_cache *cache = NULL;
-	struct nl_cache *link_cache = NULL;
-	struct rib_list_element *ribs_head = NULL, *ribs_iter = NULL;
-	struct route_list_hash_element *routes_hash_iter = NULL;
-	struct route_list_element *routes_iter = NULL;
+	struct rib_list_element *ribs_iter = NULL;
 
-	// temp buffers
-	char routes_buffer[PATH_MAX];
-	char value_buffer[PATH_MAX];
-	char ip_buffer[INET6_ADDRSTRLEN];
-	char prefix_buffer[INET6_ADDRSTRLEN + 1 + 3];
-	char xpath_buffer[256] = {0};
+	// requested RIBs
+	struct routing_oper_rib_tasks rib_tasks = {0};
+	size_t rib_tasks_count = 0;
 
 	ly_ctx = sr_acquire_context(sr_session_get_connection(session));
 
 	ly_uv4mod = ly_ctx_get_module(ly_ctx, "ietf-ipv4-unicast-routing", "2018-03-13");
 	ly_uv6mod = ly_ctx_get_module(ly_ctx, "ietf-ipv6-unicast-routing", "2018-03-13");
 
-	socket = nl_socket_alloc();
-	if (socket == NULL) {
-		SRPLG_LOG_ERR(PLUGIN_NAME, "unable to init nl_sock struct...");
-		goto error_out;
-	}
-
-	nl_err = nl_connect(socket, NETLINK_ROUTE);
-	if (nl_err != 0) {
-		SRPLG_LOG_ERR(PLUGIN_NAME, "nl_connect failed (%d): %s", nl_err, nl_geterror(nl_err));
-		goto error_out;
-	}
-
-	nl_err = rtnl_route_alloc_cache(socket, AF_UNSPEC, 0, &cache);
-	if (nl_err != 0) {
-		SRPLG_LOG_ERR(PLUGIN_NAME, "rtnl_route_alloc_cache failed (%d): %s", nl_err, nl_geterror(nl_err));
-		goto error_out;
-	}
-
-	nl_err = rtnl_link_alloc_cache(socket, AF_UNSPEC, &link_cache);
-	if (nl_err != 0) {
-		SRPLG_LOG_ERR(PLUGIN_NAME, "rtnl_link_alloc_cache failed (%d): %s", nl_err, nl_geterror(nl_err));
-		goto error_out;
+	// narrow requests only need the matching RIBs and routes
+	if (request_xpath) {
+		error = routing_oper_parse_rib_filter(request_xpath, &filter);
+		if (error != 0) {
+			SRPLG_LOG_ERR(PLUGIN_NAME, "unable to parse request xpath %s", request_xpath);
+			goto error_out;
+		}
 	}
 
-	nl_err = rtnl_route_read_table_names("/etc/iproute2/rt_tables");
-	if (nl_err != 0) {
-		SRPLG_LOG_ERR(PLUGIN_NAME, "rtnl_route_read_table_names failed (%d): %s", nl_err, nl_geterror(nl_err));
+	// apply kernel route and link changes since the last request - the first request dumps the tables
+	error = rib_mirror_sync(&ctx->rib_mirror);
+	if (error != 0) {
+		SRPLG_LOG_ERR(PLUGIN_NAME, "rib_mirror_sync() failed (%d)", error);
 		goto error_out;
 	}
 
-	nl_err = rtnl_route_read_protocol_names("/etc/iproute2/rt_protos");
-	if (nl_err != 0) {
-		SRPLG_LOG_ERR(PLUGIN_NAME, "rtnl_route_read_table_names failed (%d): %s", nl_err, nl_geterror(nl_err));
-		goto error_out;
-	}
+	rib_tasks.ly_ctx = ly_ctx;
+	rib_tasks.filter = &filter;
+	rib_tasks.interfaces = &ctx->rib_mirror.interfaces;
 
-	error = routing_collect_routes(cache, link_cache, &ribs_head);
-	if (error != 0) {
-		goto error_out;
-	}
+	LL_COUNT(ctx->rib_mirror.ribs_head, ribs_iter, rib_tasks_count);
+	rib_tasks.tasks = xcalloc(rib_tasks_count, sizeof(*rib_tasks.tasks));
+	rib_tasks_count = 0;
 
-	LL_FOREACH(ribs_head, ribs_iter)
+	LL_FOREACH(ctx->rib_mirror.ribs_head, ribs_iter)
 	{
-		// create new routes container for every table
-		struct route_list_hash_element **routes_hash_head = &ribs_iter->rib.routes_head;
+		struct routing_oper_rib_task *task = &rib_tasks.tasks[rib_tasks_count];
 		const int ADDR_FAMILY = ribs_iter->rib.address_family;
-		const char *TABLE_NAME = ribs_iter->rib.name;
-		snprintf(routes_buffer, sizeof(routes_buffer), "%s[name='%s-%s']/routes", ROUTING_RIB_LIST_YANG_PATH, ADDR_FAMILY == AF_INET ? "ipv4" : "ipv6", TABLE_NAME);
-		ly_err = lyd_new_path(*parent, ly_ctx, routes_buffer, NULL, LYD_NEW_PATH_UPDATE, &routes_node);
-		if (ly_err != LY_SUCCESS) {
-			SRPLG_LOG_ERR(PLUGIN_NAME, "unable to create new routes node");
-			goto error_out;
+
+		snprintf(task->name, sizeof(task->name), "%s-%s", ADDR_FAMILY == AF_INET ? "ipv4" : "ipv6", ribs_iter->rib.name);
+
+		if ((filter.rib_name[0] != 0 && strcmp(filter.rib_name, task->name) != 0) || (filter.address_family != AF_UNSPEC && filter.address_family != ADDR_FAMILY)) {
+			continue;
 		}
 
-		LL_FOREACH(*routes_hash_head, routes_hash_iter)
-		{
-			struct route_list_element **routes_list_head = &routes_hash_iter->routes_head;
-			struct nl_addr *dst_prefix = routes_hash_iter->prefix;
-			nl_addr2str(dst_prefix, ip_buffer, sizeof(ip_buffer));
-
-			// check for prefix - libnl doesn't write prefix into the buffer if its 8*4/8*6 i.e. only that address/no subnet
-			if (strchr(ip_buffer, '/') == NULL) {
-				snprintf(prefix_buffer, sizeof(prefix_buffer), "%s/%d", ip_buffer, nl_addr_get_prefixlen(dst_prefix));
-			} else {
-				snprintf(prefix_buffer, sizeof(prefix_buffer), "%s", ip_buffer);
-			}
+		task->rib = &ribs_iter->rib;
+		task->af_module = ADDR_FAMILY == AF_INET ? ly_uv4mod : ly_uv6mod;
+		rib_tasks_count++;
+	}
 
-			LL_FOREACH(*routes_list_head, routes_iter)
-			{
-				const struct route *ROUTE = &routes_iter->route;
-				// create a new list and after that add properties to it
-				ly_err = lyd_new_path(routes_node, ly_ctx, "routes/route", NULL, 0, &ly_node);
-				if (ly_err != LY_SUCCESS) {
-					SRPLG_LOG_ERR(PLUGIN_NAME, "unable to create new route node");
-					goto error_out;
-				}
+	// a single prefix lookup is cheaper than spawning workers
+	if (ctx->rib_mirror.workers > 1 && rib_tasks_count > 1 && filter.destination_prefix == NULL) {
+		routing_parallel_for(rib_tasks_count, ctx->rib_mirror.workers, routing_oper_build_rib_tree, &rib_tasks);
 
-				// route-preference
-				snprintf(value_buffer, sizeof(value_buffer), "%u", ROUTE->preference);
-				SRPLG_LOG_DBG(PLUGIN_NAME, "route-preference = %s", value_buffer);
-				ly_err = lyd_new_path(ly_node, ly_ctx, "route-preference", (void *) value_buffer, 0, NULL);
-				if (ly_err != LY_SUCCESS) {
-					SRPLG_LOG_ERR(PLUGIN_NAME, "unable to create new route-preference node");
-					goto error_out;
-				}
+		// merge in RIB order to keep the output independent of the worker count
+		for (size_t i = 0; i < rib_tasks_count; i++) {
+			if (rib_tasks.tasks[i].error != 0) {
+				goto error_out;
+			}
+		}
 
-				// next-hop container
-				const union route_next_hop_value *NEXTHOP = &ROUTE->next_hop.value;
-				ly_err = lyd_new_path(ly_node, ly_ctx, "next-hop", NULL, 0, &nh_node);
-				if (ly_err != LY_SUCCESS) {
-					SRPLG_LOG_ERR(PLUGIN_NAME, "unable to create new next-hop node");
-					goto error_out;
-				}
+		for (size_t i = 0; i < rib_tasks_count; i++) {
+			struct routing_oper_rib_task *task = &rib_tasks.tasks[i];
 
-				switch (ROUTE->next_hop.kind) {
-					case route_next_hop_kind_none:
-						break;
-					case route_next_hop_kind_simple: {
-						struct rtnl_link *iface = rtnl_link_get(link_cache, ROUTE->next_hop.value.simple.ifindex);
-						const char *if_name = rtnl_link_get_name(iface);
-
-						// outgoing-interface
-						SRPLG_LOG_DBG(PLUGIN_NAME, "outgoing-interface = %s", if_name);
-						ly_err = lyd_new_path(nh_node, ly_ctx, "outgoing-interface", (void *) if_name, 0, NULL);
-						if (ly_err != LY_SUCCESS) {
-							SRPLG_LOG_ERR(PLUGIN_NAME, "unable to create new outgoing-interface node");
-							goto error_out;
-						}
-
-						// next-hop-address
-						if (NEXTHOP->simple.addr) {
-							nl_addr2str(NEXTHOP->simple.addr, ip_buffer, sizeof(ip_buffer));
-							if (ADDR_FAMILY == AF_INET && ly_uv4mod != NULL) {
-								SRPLG_LOG_DBG(PLUGIN_NAME, "IPv4 next-hop-address = %s", ip_buffer);
-								ly_err = lyd_new_term(nh_node, ly_uv4mod, "next-hop-address", ip_buffer, false, NULL);
-								if (ly_err != LY_SUCCESS) {
-									SRPLG_LOG_ERR(PLUGIN_NAME, "unable to create new IPv4 next-hop-address node");
-									goto error_out;
-								}
-							} else if (ADDR_FAMILY == AF_INET6 && ly_uv6mod != NULL) {
-								SRPLG_LOG_DBG(PLUGIN_NAME, "IPv6 next-hop-address = %s", ip_buffer);
-								ly_err = lyd_new_term(nh_node, ly_uv6mod, "next-hop-address", ip_buffer, false, NULL);
-								if (ly_err != LY_SUCCESS) {
-									SRPLG_LOG_ERR(PLUGIN_NAME, "unable to create new IPv6 next-hop-address node");
-									goto error_out;
-								}
-							}
-						}
-						rtnl_link_put(iface);
-						break;
-					}
-					case route_next_hop_kind_special:
-						// SRPLG_LOG_DBG(PLUGIN_NAME, "special-next-hop = %s", NEXTHOP->special.value);
-						// ly_err = lyd_new_path(nh_node, ly_ctx, "special-next-hop", NEXTHOP->special.value, false, NULL);
-						// if (ly_err != LY_SUCCESS) {
-						// 	SRPLG_LOG_ERR(PLUGIN_NAME, "unable to create new special-next-hop node");
-						// 	goto error_out;
-						// }
-						break;
-					case route_next_hop_kind_list: {
-						struct route_next_hop_list_element *nexthop_iter = NULL;
-
-						LL_FOREACH(ROUTE->next_hop.value.list_head, nexthop_iter)
-						{
-							struct rtnl_link *iface = rtnl_link_get(link_cache, nexthop_iter->simple.ifindex);
-							const char *if_name = rtnl_link_get_name(iface);
-
-							error = snprintf(xpath_buffer, sizeof(xpath_buffer), "next-hop/next-hop-list/next-hop[index=%d]", nexthop_iter->simple.ifindex);
-							if (error < 0) {
-								SRPLG_LOG_ERR(PLUGIN_NAME, "unable to create new next-hop-list/next-hop node, couldn't retrieve interface index");
-								goto error_out;
-							}
-							ly_err = lyd_new_path(nh_node, ly_ctx, xpath_buffer, NULL, 0, &nh_list_node);
-							if (ly_err != LY_SUCCESS) {
-								SRPLG_LOG_ERR(PLUGIN_NAME, "unable to create new next-hop-list/next-hop node");
-								goto error_out;
-							}
-
-							// outgoing-interface
-							SRPLG_LOG_DBG(PLUGIN_NAME, "outgoing-interface = %s", if_name);
-							ly_err = lyd_new_path(nh_list_node, ly_ctx, "outgoing-interface", (void *) if_name, 0, NULL);
-							if (ly_err != LY_SUCCESS) {
-								SRPLG_LOG_ERR(PLUGIN_NAME, "unable to create new outgoing-interface node");
-								goto error_out;
-							}
-
-							// next-hop-address
-							if (nexthop_iter->simple.addr) {
-								nl_addr2str(nexthop_iter->simple.addr, ip_buffer, sizeof(ip_buffer));
-								if (ADDR_FAMILY == AF_INET && ly_uv4mod != NULL) {
-									SRPLG_LOG_DBG(PLUGIN_NAME, "IPv4 next-hop/next-hop-list/next-hop/next-hop-address = %s", ip_buffer);
-									ly_err = lyd_new_term(nh_list_node, ly_uv4mod, "next-hop-address", ip_buffer, false, NULL);
-									if (ly_err != LY_SUCCESS) {
-										SRPLG_LOG_ERR(PLUGIN_NAME, "unable to create new IPv4 next-hop-address node");
-										goto error_out;
-									}
-								} else if (ADDR_FAMILY == AF_INET6 && ly_uv6mod != NULL) {
-									SRPLG_LOG_DBG(PLUGIN_NAME, "IPv6 next-hop/next-hop-list/next-hop/next-hop-address = %s", ip_buffer);
-									ly_err = lyd_new_term(nh_list_node, ly_uv6mod, "next-hop-address", ip_buffer, false, NULL);
-									if (ly_err != LY_SUCCESS) {
-										SRPLG_LOG_ERR(PLUGIN_NAME, "unable to create new IPv6 next-hop-address node");
-										goto error_out;
-									}
-								}
-							}
-							rtnl_link_put(iface);
-						}
-						break;
-					}
-				}
+			rib_node = task->rib_node;
 
-				// destination-prefix
-				if (ADDR_FAMILY == AF_INET && ly_uv4mod != NULL) {
-					if (strncmp("none/0", prefix_buffer, strnlen(prefix_buffer, sizeof(prefix_buffer))) == 0) {
-						strcpy(prefix_buffer, "0.0.0.0/0");
-					}
+			lyd_unlink_tree(rib_node);
+			ly_err = lyd_insert_child(*parent, rib_node);
+			if (ly_err != LY_SUCCESS) {
+				SRPLG_LOG_ERR(PLUGIN_NAME, "unable to insert rib node %s", task->name);
+				lyd_free_tree(rib_node);
+				goto error_out;
+			}
+		}
 
-					SRPLG_LOG_DBG(PLUGIN_NAME, "destination-prefix = %s", prefix_buffer);
-					ly_err = lyd_new_term(ly_node, ly_uv4mod, "destination-prefix", prefix_buffer, false, NULL);
-					if (ly_err != LY_SUCCESS) {
-						SRPLG_LOG_ERR(PLUGIN_NAME, "unable to create new IPv4 destination-prefix node");
-						goto error_out;
-					}
-				} else if (ADDR_FAMILY == AF_INET6 && ly_uv6mod != NULL) {
-					if (strncmp("none/0", prefix_buffer, strnlen(prefix_buffer, sizeof(prefix_buffer))) == 0) {
-						strcpy(prefix_buffer, "::/0");
-					}
+		goto out;
+	}
 
-					SRPLG_LOG_DBG(PLUGIN_NAME, "destination-prefix = %s", prefix_buffer);
-					ly_err = lyd_new_term(ly_node, ly_uv6mod, "destination-prefix", prefix_buffer, false, NULL);
-					if (ly_err != LY_SUCCESS) {
-						SRPLG_LOG_ERR(PLUGIN_NAME, "unable to create new IPv6 destination-prefix node");
-						goto error_out;
-					}
-				}
+	for (size_t i = 0; i < rib_tasks_count; i++) {
+		struct routing_oper_rib_task *task = &rib_tasks.tasks[i];
 
-				// route-metadata/source-protocol
-				SRPLG_LOG_DBG(PLUGIN_NAME, "source-protocol = %s", ROUTE->metadata.source_protocol);
-				ly_err = lyd_new_path(ly_node, ly_ctx, "source-protocol", ROUTE->metadata.source_protocol, 0, NULL);
-				if (ly_err != LY_SUCCESS) {
-					SRPLG_LOG_ERR(PLUGIN_NAME, "unable to create new source-protocol node");
-					goto error_out;
-				}
+		// create new rib entry with its routes container for every table
+		ly_err = lyd_new_list(*parent, NULL, "rib", 0, &rib_node, task->name);
+		if (ly_err != LY_SUCCESS) {
+			SRPLG_LOG_ERR(PLUGIN_NAME, "unable to create new rib node");
+			goto error_out;
+		}
 
-				// route-metadata/active
-				if (ROUTE->metadata.active == 1) {
-					SRPLG_LOG_DBG(PLUGIN_NAME, "active = %d", ROUTE->metadata.active);
-					ly_err = lyd_new_path(ly_node, ly_ctx, "active", NULL, 0, NULL);
-					if (ly_err != LY_SUCCESS) {
-						SRPLG_LOG_ERR(PLUGIN_NAME, "unable to create new active node");
-						goto error_out;
-					}
-				}
-			}
+		ly_err = lyd_new_inner(rib_node, NULL, "routes", 0, &routes_node);
+		if (ly_err != LY_SUCCESS) {
+			SRPLG_LOG_ERR(PLUGIN_NAME, "unable to create new routes node");
+			goto error_out;
 		}
-	}
 
-	if (error != 0) {
-		goto error_out;
+		error = routing_oper_build_rib_routes(routes_node, task->rib, task->af_module, &filter, &ctx->rib_mirror.interfaces);
+		if (error != 0) {
+			goto error_out;
+		}
 	}
 
 	goto out;
@@ -308,10 +187,15 @@ error_out:
 	error = SR_ERR_CALLBACK_FAILED;
 
 out:
-	rib_list_free(&ribs_head);
-	nl_socket_free(socket);
-	nl_cache_free(cache);
-	nl_cache_free(link_cache);
+	if (filter.destination_prefix) {
+		nl_addr_put(filter.destination_prefix);
+	}
+
+	for (size_t i = 0; i < rib_tasks_count; i++) {
+		lyd_free_all(rib_tasks.tasks[i].tree);
+	}
+	FREE_SAFE(rib_tasks.tasks);
+
 	return error;
 }
 
@@ -324,10 +208,9 @@ int routing_oper_get_interfaces_cb(sr_session_ctx_t *session, uint32_t subscript
 	// libyang
 	const struct ly_ctx *ly_ctx = NULL;
 
-	// libnl
-	struct nl_sock *socket = NULL;
-	struct nl_cache *cache = NULL;
-	struct rtnl_link *link = NULL;
+	// context
+	struct routing_ctx *ctx = (struct routing_ctx *) private_data;
+	const struct interface_table *interfaces = &ctx->rib_mirror.interfaces;
 
 	if (*parent == NULL) {
 		ly_ctx = sr_acquire_context(sr_session_get_connection(session));
@@ -342,29 +225,21 @@ int routing_oper_get_interfaces_cb(sr_session_ctx_t *session, uint32_t subscript
 		}
 	}
 
-	socket = nl_socket_alloc();
-	if (socket == NULL) {
-		SRPLG_LOG_ERR(PLUGIN_NAME, "unable to init nl_sock struct...");
-		goto error_out;
-	}
-
-	error = nl_connect(socket, NETLINK_ROUTE);
-	if (error != 0) {
-		SRPLG_LOG_ERR(PLUGIN_NAME, "nl_connect failed (%d): %s", error, nl_geterror(error));
-		goto error_out;
-	}
-
-	error = rtnl_link_alloc_cache(socket, AF_UNSPEC, &cache);
+	// interface names are kept current by the RIB mirror link notifications
+	error = rib_mirror_sync(&ctx->rib_mirror);
 	if (error != 0) {
-		SRPLG_LOG_ERR(PLUGIN_NAME, "rtnl_link_alloc_cache failed (%d): %s", error, nl_geterror(error));
+		SRPLG_LOG_ERR(PLUGIN_NAME, "rib_mirror_sync() failed (%d)", error);
 		goto error_out;
 	}
 
 	SRPLG_LOG_DBG(PLUGIN_NAME, "adding interfaces to the list");
 
-	link = (struct rtnl_link *) nl_cache_get_first(cache);
-	while (link) {
-		const char *name = rtnl_link_get_name(link);
+	for (size_t i = 0; i < interfaces->size; i++) {
+		const char *name = interface_table_get_name(interfaces, (int) i);
+		if (name == NULL) {
+			continue;
+		}
+
 		SRPLG_LOG_DBG(PLUGIN_NAME, "adding interface '%s' ", name);
 
 		ly_err = lyd_new_path(*parent, ly_ctx, ROUTING_INTERFACE_LEAF_LIST_YANG_PATH, (void *) name, 0, NULL);
@@ -372,8 +247,6 @@ int routing_oper_get_interfaces_cb(sr_session_ctx_t *session, uint32_t subscript
 			SRPLG_LOG_ERR(PLUGIN_NAME, "unable to create new interface node");
 			goto error_out;
 		}
-
-		link = (struct rtnl_link *) nl_cache_get_next((struct nl_object *) link);
 	}
 
 	goto out;
@@ -381,9 +254,336 @@ int routing_oper_get_interfaces_cb(sr_session_ctx_t *session, uint32_t subscript
 error_out:
 	error = SR_ERR_CALLBACK_FAILED;
 out:
-	// free allocated objects
-	nl_cache_free(cache);
-	nl_socket_free(socket);
+	return error;
+}
+
+static int routing_oper_extract_request_key(const char *request_xpath, const char *node_name, const char *key_name, char *buffer, size_t buffer_size)
+{
+	int error = 0;
+	const char *value = NULL;
+	char *xpath_copy = NULL;
+	sr_xpath_ctx_t xpath_ctx = {0};
+
+	// copy xpath due to changing it when using xpath_ctx from sysrepo
+	xpath_copy = xstrdup(request_xpath);
+
+	// no such predicate in the request
+	value = sr_xpath_key_value(xpath_copy, node_name, key_name, &xpath_ctx);
+	if (value == NULL) {
+		goto error_out;
+	}
+
+	error = snprintf(buffer, buffer_size, "%s", value);
+	if (error < 0 || (size_t) error >= buffer_size) {
+		goto error_out;
+	}
+
+	error = 0;
+	goto out;
+
+error_out:
+	error = -1;
+
+out:
+	FREE_SAFE(xpath_copy);
 
 	return error;
-}
\ No newline at end of file
+}
+
+static int routing_oper_parse_rib_filter(const char *request_xpath, struct routing_oper_rib_filter *filter)
+{
+	int nl_err = 0;
+	char prefix_buffer[INET6_ADDRSTRLEN + 1 + 3] = {0};
+	const char *prefix_keys[] = {
+		"destination-prefix",
+		"ietf-ipv4-unicast-routing:destination-prefix",
+		"ietf-ipv6-unicast-routing:destination-prefix",
+	};
+
+	filter->address_family = AF_UNSPEC;
+
+	if (routing_oper_extract_request_key(request_xpath, "rib", "name", filter->rib_name, sizeof(filter->rib_name)) == 0) {
+		// RIB names carry the address family - see routing_collect_routes()
+		if (strncmp(filter->rib_name, "ipv4-", sizeof("ipv4-") - 1) == 0) {
+			filter->address_family = AF_INET;
+		} else if (strncmp(filter->rib_name, "ipv6-", sizeof("ipv6-") - 1) == 0) {
+			filter->address_family = AF_INET6;
+		}
+	}
+
+	for (size_t i = 0; i < sizeof(prefix_keys) / sizeof(prefix_keys[0]); i++) {
+		if (routing_oper_extract_request_key(request_xpath, "route", prefix_keys[i], prefix_buffer, sizeof(prefix_buffer)) == 0) {
+			break;
+		}
+	}
+
+	if (prefix_buffer[0] != 0) {
+		nl_err = nl_addr_parse(prefix_buffer, filter->address_family, &filter->destination_prefix);
+		if (nl_err != 0) {
+			SRPLG_LOG_ERR(PLUGIN_NAME, "nl_addr_parse failed (%d): %s", nl_err, nl_geterror(nl_err));
+			return -1;
+		}
+
+		filter->address_family = nl_addr_get_family(filter->destination_prefix);
+	}
+
+	routing_oper_extract_request_key(request_xpath, "route", "source-protocol", filter->source_protocol, sizeof(filter->source_protocol));
+
+	return 0;
+}
+
+static bool routing_oper_source_protocol_matches(const struct routing_oper_rib_filter *filter, const char *source_protocol)
+{
+	const char *identity = NULL;
+
+	if (filter->source_protocol[0] == 0) {
+		return true;
+	}
+
+	if (source_protocol == NULL) {
+		return false;
+	}
+
+	// requests can leave out the ietf-routing module prefix of the identity
+	identity = strchr(source_protocol, ':');
+
+	return strcmp(filter->source_protocol, source_protocol) == 0 || (identity != NULL && strcmp(filter->source_protocol, identity + 1) == 0);
+}
+
+static void routing_oper_build_prefix(struct nl_addr *prefix, int address_family, char *buffer, size_t buffer_size)
+{
+	char ip_buffer[INET6_ADDRSTRLEN];
+
+	nl_addr2str(prefix, ip_buffer, sizeof(ip_buffer));
+
+	// check for prefix - libnl doesn't write prefix into the buffer if its 8*4/8*6 i.e. only that address/no subnet
+	if (strchr(ip_buffer, '/') == NULL) {
+		snprintf(buffer, buffer_size, "%s/%d", ip_buffer, nl_addr_get_prefixlen(prefix));
+	} else {
+		snprintf(buffer, buffer_size, "%s", ip_buffer);
+	}
+
+	if (strcmp(buffer, "none/0") == 0) {
+		snprintf(buffer, buffer_size, "%s", address_family == AF_INET ? "0.0.0.0/0" : "::/0");
+	}
+}
+
+static int routing_oper_build_rib_routes(struct lyd_node *routes_node, struct rib *rib, const struct lys_module *af_module, const struct routing_oper_rib_filter *filter, const struct interface_table *interfaces)
+{
+	int error = 0;
+	struct route_list_hash_element *routes_hash_iter = NULL;
+	struct route_list_element **routes_list_head = NULL;
+	struct route_list_element *routes_iter = NULL;
+	char prefix_buffer[INET6_ADDRSTRLEN + 1 + 3];
+
+	if (filter->destination_prefix) {
+		// single prefix requested - no need to walk the whole table
+		routes_list_head = route_list_hash_get(&rib->routes_head, filter->destination_prefix);
+		if (routes_list_head == NULL) {
+			return 0;
+		}
+
+		routing_oper_build_prefix(filter->destination_prefix, rib->address_family, prefix_buffer, sizeof(prefix_buffer));
+
+		LL_FOREACH(*routes_list_head, routes_iter)
+		{
+			if (!routing_oper_source_protocol_matches(filter, route_source_protocol2str(routes_iter->route.metadata.source_protocol))) {
+				continue;
+			}
+
+			error = routing_oper_build_route(routes_node, af_module, prefix_buffer, &routes_iter->route, interfaces);
+			if (error != 0) {
+				return error;
+			}
+		}
+
+		return 0;
+	}
+
+	LL_FOREACH(rib->routes_head, routes_hash_iter)
+	{
+		routing_oper_build_prefix(routes_hash_iter->prefix, rib->address_family, prefix_buffer, sizeof(prefix_buffer));
+
+		LL_FOREACH(routes_hash_iter->routes_head, routes_iter)
+		{
+			if (!routing_oper_source_protocol_matches(filter, route_source_protocol2str(routes_iter->route.metadata.source_protocol))) {
+				continue;
+			}
+
+			error = routing_oper_build_route(routes_node, af_module, prefix_buffer, &routes_iter->route, interfaces);
+			if (error != 0) {
+				return error;
+			}
+		}
+	}
+
+	return 0;
+}
+
+static void routing_oper_build_rib_tree(size_t index, void *arg)
+{
+	struct routing_oper_rib_tasks *rib_tasks = arg;
+	struct routing_oper_rib_task *task = &rib_tasks->tasks[index];
+	LY_ERR ly_err = LY_SUCCESS;
+	struct lyd_node *routes_node = NULL;
+	char path_buffer[PATH_MAX];
+
+	// standalone ribs/rib/routes tree - the RIB subtree is moved into the parent by the caller
+	snprintf(path_buffer, sizeof(path_buffer), ROUTING_RIB_LIST_YANG_PATH "[name='%s']/routes", task->name);
+
+	ly_err = lyd_new_path2(NULL, rib_tasks->ly_ctx, path_buffer, NULL, 0, 0, 0, &task->tree, &routes_node);
+	if (ly_err != LY_SUCCESS) {
+		SRPLG_LOG_ERR(PLUGIN_NAME, "unable to create new rib tree %s", task->name);
+		task->error = -1;
+		return;
+	}
+
+	task->rib_node = lyd_parent(routes_node);
+	task->error = routing_oper_build_rib_routes(routes_node, task->rib, task->af_module, rib_tasks->filter, rib_tasks->interfaces);
+}
+
+static int routing_oper_build_route(struct lyd_node *routes_node, const struct lys_module *af_module, const char *prefix, const struct route *route, const struct interface_table *interfaces)
+{
+	LY_ERR ly_err = LY_SUCCESS;
+	struct lyd_node *route_node = NULL, *nh_node = NULL, *nh_list_node = NULL, *nh_entry_node = NULL;
+	struct route_next_hop_list_element *nexthop_iter = NULL;
+	const char *if_name = NULL;
+	const union route_next_hop_value *NEXTHOP = &route->next_hop.value;
+
+	// temp buffers
+	char value_buffer[32];
+	char ip_buffer[INET6_ADDRSTRLEN];
+
+	// create a new list entry and after that add properties to it
+	ly_err = lyd_new_list(routes_node, NULL, "route", 0, &route_node);
+	if (ly_err != LY_SUCCESS) {
+		SRPLG_LOG_ERR(PLUGIN_NAME, "unable to create new route node");
+		goto error_out;
+	}
+
+	// route-preference
+	snprintf(value_buffer, sizeof(value_buffer), "%u", route->preference);
+	SRPLG_LOG_DBG(PLUGIN_NAME, "route-preference = %s", value_buffer);
+	ly_err = lyd_new_term(route_node, NULL, "route-preference", value_buffer, 0, NULL);
+	if (ly_err != LY_SUCCESS) {
+		SRPLG_LOG_ERR(PLUGIN_NAME, "unable to create new route-preference node");
+		goto error_out;
+	}
+
+	// next-hop container
+	ly_err = lyd_new_inner(route_node, NULL, "next-hop", 0, &nh_node);
+	if (ly_err != LY_SUCCESS) {
+		SRPLG_LOG_ERR(PLUGIN_NAME, "unable to create new next-hop node");
+		goto error_out;
+	}
+
+	switch (route->next_hop.kind) {
+		case route_next_hop_kind_none:
+			break;
+		case route_next_hop_kind_simple:
+			if_name = interface_table_get_name(interfaces, NEXTHOP->simple.ifindex);
+
+			// outgoing-interface
+			if (if_name) {
+				SRPLG_LOG_DBG(PLUGIN_NAME, "outgoing-interface = %s", if_name);
+				ly_err = lyd_new_term(nh_node, NULL, "outgoing-interface", if_name, 0, NULL);
+				if (ly_err != LY_SUCCESS) {
+					SRPLG_LOG_ERR(PLUGIN_NAME, "unable to create new outgoing-interface node");
+					goto error_out;
+				}
+			}
+
+			// next-hop-address
+			if (route_address_is_set(&NEXTHOP->simple.addr) && af_module != NULL) {
+				route_address2str(&NEXTHOP->simple.addr, ip_buffer, sizeof(ip_buffer));
+				SRPLG_LOG_DBG(PLUGIN_NAME, "next-hop-address = %s", ip_buffer);
+				ly_err = lyd_new_term(nh_node, af_module, "next-hop-address", ip_buffer, 0, NULL);
+				if (ly_err != LY_SUCCESS) {
+					SRPLG_LOG_ERR(PLUGIN_NAME, "unable to create new next-hop-address node");
+					goto error_out;
+				}
+			}
+			break;
+		case route_next_hop_kind_special:
+			// SRPLG_LOG_DBG(PLUGIN_NAME, "special-next-hop = %s", route_next_hop_special2str(NEXTHOP->special));
+			// ly_err = lyd_new_term(nh_node, NULL, "special-next-hop", route_next_hop_special2str(NEXTHOP->special), 0, NULL);
+			// if (ly_err != LY_SUCCESS) {
+			// 	SRPLG_LOG_ERR(PLUGIN_NAME, "unable to create new special-next-hop node");
+			// 	goto error_out;
+			// }
+			break;
+		case route_next_hop_kind_list:
+			ly_err = lyd_new_inner(nh_node, NULL, "next-hop-list", 0, &nh_list_node);
+			if (ly_err != LY_SUCCESS) {
+				SRPLG_LOG_ERR(PLUGIN_NAME, "unable to create new next-hop-list node");
+				goto error_out;
+			}
+
+			LL_FOREACH(NEXTHOP->list_head, nexthop_iter)
+			{
+				if_name = interface_table_get_name(interfaces, nexthop_iter->simple.ifindex);
+
+				snprintf(value_buffer, sizeof(value_buffer), "%d", nexthop_iter->simple.ifindex);
+				ly_err = lyd_new_list(nh_list_node, NULL, "next-hop", 0, &nh_entry_node, value_buffer);
+				if (ly_err != LY_SUCCESS) {
+					SRPLG_LOG_ERR(PLUGIN_NAME, "unable to create new next-hop-list/next-hop node");
+					goto error_out;
+				}
+
+				// outgoing-interface
+				if (if_name) {
+					SRPLG_LOG_DBG(PLUGIN_NAME, "outgoing-interface = %s", if_name);
+					ly_err = lyd_new_term(nh_entry_node, NULL, "outgoing-interface", if_name, 0, NULL);
+					if (ly_err != LY_SUCCESS) {
+						SRPLG_LOG_ERR(PLUGIN_NAME, "unable to create new outgoing-interface node");
+						goto error_out;
+					}
+				}
+
+				// next-hop-address
+				if (route_address_is_set(&nexthop_iter->simple.addr) && af_module != NULL) {
+					route_address2str(&nexthop_iter->simple.addr, ip_buffer, sizeof(ip_buffer));
+					SRPLG_LOG_DBG(PLUGIN_NAME, "next-hop/next-hop-list/next-hop/next-hop-address = %s", ip_buffer);
+					ly_err = lyd_new_term(nh_entry_node, af_module, "next-hop-address", ip_buffer, 0, NULL);
+					if (ly_err != LY_SUCCESS) {
+						SRPLG_LOG_ERR(PLUGIN_NAME, "unable to create new next-hop-address node");
+						goto error_out;
+					}
+				}
+			}
+			break;
+	}
+
+	// destination-prefix
+	if (af_module != NULL) {
+		SRPLG_LOG_DBG(PLUGIN_NAME, "destination-prefix = %s", prefix);
+		ly_err = lyd_new_term(route_node, af_module, "destination-prefix", prefix, 0, NULL);
+		if (ly_err != LY_SUCCESS) {
+			SRPLG_LOG_ERR(PLUGIN_NAME, "unable to create new destination-prefix node");
+			goto error_out;
+		}
+	}
+
+	// route-metadata/source-protocol
+	SRPLG_LOG_DBG(PLUGIN_NAME, "source-protocol = %s", route_source_protocol2str(route->metadata.source_protocol));
+	ly_err = lyd_new_term(route_node, NULL, "source-protocol", route_source_protocol2str(route->metadata.source_protocol), 0, NULL);
+	if (ly_err != LY_SUCCESS) {
+		SRPLG_LOG_ERR(PLUGIN_NAME, "unable to create new source-protocol node");
+		goto error_out;
+	}
+
+	// route-metadata/active
+	if (route->metadata.active == 1) {
+		SRPLG_LOG_DBG(PLUGIN_NAME, "active = %d", route->metadata.active);
+		ly_err = lyd_new_term(route_node, NULL, "active", NULL, 0, NULL);
+		if (ly_err != LY_SUCCESS) {
+			SRPLG_LOG_ERR(PLUGIN_NAME, "unable to create new active node");
+			goto error_out;
+		}
+	}
+
+	return 0;
+
+error_out:
+	return -1;
+}
@@ -13,12 +13,308 @@
 
 #include "rpc.h"
 #include <routing/common.h>
+#include <routing/context.h>
+#include <routing/interface_table.h>
+#include <routing/rib.h>
+#include <routing/rib/list.h>
+#include <routing/rib/trie.h>
+#include <routing/route.h>
+#include <routing/route/list_hash.h>
+#include <utils/memory.h>
+
+#include <string.h>
+#include <linux/limits.h>
 
 #include <sysrepo.h>
+#include <sysrepo/xpath.h>
+
+#include <netlink/addr.h>
+#include <netlink/errno.h>
+
+#include <utlist.h>
+
+static int routing_rpc_active_route_get_rib(const char *op_path, char *table_buffer, size_t buffer_size, int *af);
+static int routing_rpc_active_route_build_output(const char *op_path, int af, const struct interface_table *interfaces, const struct route_list_hash_element *element, const struct route *route, sr_val_t **output, size_t *output_cnt);
+static int routing_rpc_add_output_value(const char *op_path, const char *node_path, sr_val_type_t type, const char *value, sr_val_t **output, size_t *output_cnt);
 
 int routing_rpc_active_route_cb(sr_session_ctx_t *session, uint32_t subscription_id, const char *op_path, const sr_val_t *input, const size_t input_cnt, sr_event_t event, uint32_t request_id, sr_val_t **output, size_t *output_cnt, void *private_data)
 {
 	int error = SR_ERR_OK;
+	int nl_err = 0;
+	struct routing_ctx *ctx = (struct routing_ctx *) private_data;
+	struct rib *rib = NULL;
+	struct nl_addr *destination = NULL;
+	struct route_list_hash_element *found = NULL;
+	struct route_list_element *routes_iter = NULL;
+	const struct route *active = NULL;
+	const char *destination_address = NULL;
+	char table_buffer[32] = {0};
+	int af = AF_UNSPEC;
+
 	SRPLG_LOG_DBG(PLUGIN_NAME, "xpath for RPC: %s", op_path);
+
+	*output = NULL;
+	*output_cnt = 0;
+
+	// destination-address is augmented into the input by the address family modules
+	for (size_t i = 0; i < input_cnt; i++) {
+		if (strstr(input[i].xpath, "destination-address") != NULL) {
+			destination_address = input[i].data.string_val;
+		}
+	}
+
+	if (destination_address == NULL) {
+		SRPLG_LOG_ERR(PLUGIN_NAME, "active-route RPC is missing the destination-address input");
+		goto error_out;
+	}
+
+	error = routing_rpc_active_route_get_rib(op_path, table_buffer, sizeof(table_buffer), &af);
+	if (error != 0) {
+		SRPLG_LOG_ERR(PLUGIN_NAME, "unable to get the RIB from %s", op_path);
+		goto error_out;
+	}
+
+	nl_err = nl_addr_parse(destination_address, af, &destination);
+	if (nl_err != 0) {
+		SRPLG_LOG_ERR(PLUGIN_NAME, "nl_addr_parse failed (%d): %s", nl_err, nl_geterror(nl_err));
+		goto error_out;
+	}
+
+	// only applies pending route notifications - the kernel FIB is dumped once for the mirror
+	error = rib_mirror_sync(&ctx->rib_mirror);
+	if (error != 0) {
+		SRPLG_LOG_ERR(PLUGIN_NAME, "rib_mirror_sync() failed (%d)", error);
+		goto error_out;
+	}
+
+	rib = rib_list_get(&ctx->rib_mirror.ribs_head, table_buffer, af);
+	if (rib == NULL) {
+		SRPLG_LOG_ERR(PLUGIN_NAME, "RIB %s doesn't exist", table_buffer);
+		goto error_out;
+	}
+
+	// no route for the destination - no output is returned
+	found = rib_trie_lookup(&rib->routes_trie, destination);
+	if (found == NULL) {
+		goto out;
+	}
+
+	LL_FOREACH(found->routes_head, routes_iter)
+	{
+		if (routes_iter->route.metadata.active) {
+			active = &routes_iter->route;
+			break;
+		}
+	}
+
+	if (active == NULL) {
+		goto out;
+	}
+
+	error = routing_rpc_active_route_build_output(op_path, af, &ctx->rib_mirror.interfaces, found, active, output, output_cnt);
+	if (error != 0) {
+		goto error_out;
+	}
+
+	goto out;
+
+error_out:
+	error = SR_ERR_CALLBACK_FAILED;
+
+	if (*output) {
+		sr_free_values(*output, *output_cnt);
+		*output = NULL;
+		*output_cnt = 0;
+	}
+
+out:
+	if (destination) {
+		nl_addr_put(destination);
+	}
+
 	return error;
-}
\ No newline at end of file
+}
+
+static int routing_rpc_active_route_get_rib(const char *op_path, char *table_buffer, size_t buffer_size, int *af)
+{
+	int error = 0;
+	const char *name = NULL;
+	char *xpath_copy = NULL;
+	sr_xpath_ctx_t xpath_ctx = {0};
+
+	// copy xpath due to changing it when using xpath_ctx from sysrepo
+	xpath_copy = xstrdup(op_path);
+
+	name = sr_xpath_key_value(xpath_copy, "rib", "name", &xpath_ctx);
+	if (name == NULL) {
+		goto error_out;
+	}
+
+	// RIB names are the table names prefixed with the address family - see routing_oper_get_rib_routes_cb()
+	if (strncmp(name, "ipv4-", sizeof("ipv4-") - 1) == 0) {
+		*af = AF_INET;
+	} else if (strncmp(name, "ipv6-", sizeof("ipv6-") - 1) == 0) {
+		*af = AF_INET6;
+	} else {
+		goto error_out;
+	}
+
+	error = snprintf(table_buffer, buffer_size, "%s", name + sizeof("ipv4-") - 1);
+	if (error < 0 || (size_t) error >= buffer_size) {
+		goto error_out;
+	}
+
+	error = 0;
+	goto out;
+
+error_out:
+	error = -1;
+
+out:
+	FREE_SAFE(xpath_copy);
+
+	return error;
+}
+
+static int routing_rpc_active_route_build_output(const char *op_path, int af, const struct interface_table *interfaces, const struct route_list_hash_element *element, const struct route *route, sr_val_t **output, size_t *output_cnt)
+{
+	int error = 0;
+	const char *af_module = af == AF_INET ? "ietf-ipv4-unicast-routing" : "ietf-ipv6-unicast-routing";
+	const union route_next_hop_value *NEXTHOP = &route->next_hop.value;
+	struct route_next_hop_list_element *nexthop_iter = NULL;
+	const char *if_name = NULL;
+	size_t nexthop_index = 1;
+
+	// temp buffers
+	char path_buffer[256] = {0};
+	char ip_buffer[INET6_ADDRSTRLEN];
+	char prefix_buffer[INET6_ADDRSTRLEN + 1 + 3];
+
+	// destination-prefix - libnl doesn't write the prefix length of host routes and names the default route none
+	nl_addr2str(element->prefix, ip_buffer, sizeof(ip_buffer));
+	if (strcmp(ip_buffer, "none") == 0) {
+		snprintf(prefix_buffer, sizeof(prefix_buffer), "%s", af == AF_INET ? "0.0.0.0/0" : "::/0");
+	} else if (strchr(ip_buffer, '/') == NULL) {
+		snprintf(prefix_buffer, sizeof(prefix_buffer), "%s/%d", ip_buffer, nl_addr_get_prefixlen(element->prefix));
+	} else {
+		snprintf(prefix_buffer, sizeof(prefix_buffer), "%s", ip_buffer);
+	}
+
+	snprintf(path_buffer, sizeof(path_buffer), "route/%s:destination-prefix", af_module);
+	error = routing_rpc_add_output_value(op_path, path_buffer, SR_STRING_T, prefix_buffer, output, output_cnt);
+	if (error != 0) {
+		goto error_out;
+	}
+
+	switch (route->next_hop.kind) {
+		case route_next_hop_kind_none:
+			break;
+		case route_next_hop_kind_simple:
+			if_name = interface_table_get_name(interfaces, NEXTHOP->simple.ifindex);
+			if (if_name) {
+				error = routing_rpc_add_output_value(op_path, "route/next-hop/outgoing-interface", SR_STRING_T, if_name, output, output_cnt);
+				if (error != 0) {
+					goto error_out;
+				}
+			}
+
+			if (route_address_is_set(&NEXTHOP->simple.addr)) {
+				route_address2str(&NEXTHOP->simple.addr, ip_buffer, sizeof(ip_buffer));
+				snprintf(path_buffer, sizeof(path_buffer), "route/next-hop/%s:next-hop-address", af_module);
+				error = routing_rpc_add_output_value(op_path, path_buffer, SR_STRING_T, ip_buffer, output, output_cnt);
+				if (error != 0) {
+					goto error_out;
+				}
+			}
+			break;
+		case route_next_hop_kind_special:
+			error = routing_rpc_add_output_value(op_path, "route/next-hop/special-next-hop", SR_ENUM_T, route_next_hop_special2str(NEXTHOP->special), output, output_cnt);
+			if (error != 0) {
+				goto error_out;
+			}
+			break;
+		case route_next_hop_kind_list:
+			LL_FOREACH(NEXTHOP->list_head, nexthop_iter)
+			{
+				// next-hop list entries of the output have no key - address them by position
+				if_name = interface_table_get_name(interfaces, nexthop_iter->simple.ifindex);
+				if (if_name) {
+					snprintf(path_buffer, sizeof(path_buffer), "route/next-hop/next-hop-list/next-hop[%zu]/outgoing-interface", nexthop_index);
+					error = routing_rpc_add_output_value(op_path, path_buffer, SR_STRING_T, if_name, output, output_cnt);
+					if (error != 0) {
+						goto error_out;
+					}
+				}
+
+				if (route_address_is_set(&nexthop_iter->simple.addr)) {
+					route_address2str(&nexthop_iter->simple.addr, ip_buffer, sizeof(ip_buffer));
+					snprintf(path_buffer, sizeof(path_buffer), "route/next-hop/next-hop-list/next-hop[%zu]/%s:next-hop-address", nexthop_index, af_module);
+					error = routing_rpc_add_output_value(op_path, path_buffer, SR_STRING_T, ip_buffer, output, output_cnt);
+					if (error != 0) {
+						goto error_out;
+					}
+				}
+
+				nexthop_index++;
+			}
+			break;
+	}
+
+	// route-metadata
+	error = routing_rpc_add_output_value(op_path, "route/source-protocol", SR_IDENTITYREF_T, route_source_protocol2str(route->metadata.source_protocol), output, output_cnt);
+	if (error != 0) {
+		goto error_out;
+	}
+
+	error = routing_rpc_add_output_value(op_path, "route/active", SR_LEAF_EMPTY_T, NULL, output, output_cnt);
+	if (error != 0) {
+		goto error_out;
+	}
+
+	goto out;
+
+error_out:
+	SRPLG_LOG_ERR(PLUGIN_NAME, "unable to build active-route output");
+	error = -1;
+
+out:
+	return error;
+}
+
+static int routing_rpc_add_output_value(const char *op_path, const char *node_path, sr_val_type_t type, const char *value, sr_val_t **output, size_t *output_cnt)
+{
+	int error = SR_ERR_OK;
+	char xpath_buffer[PATH_MAX] = {0};
+	sr_val_t *val = NULL;
+
+	snprintf(xpath_buffer, sizeof(xpath_buffer), "%s/%s", op_path, node_path);
+
+	error = sr_realloc_values(*output_cnt, *output_cnt + 1, output);
+	if (error != SR_ERR_OK) {
+		SRPLG_LOG_ERR(PLUGIN_NAME, "sr_realloc_values error (%d): %s", error, sr_strerror(error));
+		return -1;
+	}
+
+	val = &(*output)[*output_cnt];
+	*output_cnt += 1;
+
+	error = sr_val_set_xpath(val, xpath_buffer);
+	if (error != SR_ERR_OK) {
+		SRPLG_LOG_ERR(PLUGIN_NAME, "sr_val_set_xpath error (%d): %s", error, sr_strerror(error));
+		return -1;
+	}
+
+	if (value == NULL) {
+		// empty leaf
+		val->type = type;
+		return 0;
+	}
+
+	error = sr_val_set_str_data(val, type, value);
+	if (error != SR_ERR_OK) {
+		SRPLG_LOG_ERR(PLUGIN_NAME, "sr_val_set_str_data error (%d): %s", error, sr_strerror(error));
+		return -1;
+	}
+
+	return 0;
+}
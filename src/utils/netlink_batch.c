@@ -0,0 +1,211 @@
+/*
+ * telekom / sysrepo-plugin-interfaces
+ *
+ * This program is made available under the terms of the
+ * BSD 3-Clause license which is available at
+ * https://opensource.org/licenses/BSD-3-Clause
+ *
+ * SPDX-FileCopyrightText: 2022 Deutsche Telekom AG
+ * SPDX-FileContributor: Sartura Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <limits.h>
+#include <string.h>
+#include <sys/socket.h>
+
+#include <linux/netlink.h>
+
+#include <netlink/errno.h>
+#include <netlink/netlink.h>
+
+#include "memory.h"
+#include "netlink_batch.h"
+
+static int netlink_batch_send(struct netlink_batch *batch);
+static int netlink_batch_receive(struct netlink_batch *batch);
+static void netlink_batch_fail_pending(struct netlink_batch *batch, int error);
+
+void netlink_batch_init(struct netlink_batch *batch, struct nl_sock *socket, size_t window)
+{
+	int cap_ack = 1;
+	int rcvbuf = 0;
+	socklen_t rcvbuf_length = sizeof(rcvbuf);
+
+	*batch = (struct netlink_batch){0};
+
+	batch->socket = socket;
+	batch->window = window > 0 ? window : 1;
+	batch->buffer = xmalloc(NETLINK_BATCH_BUFFER_SIZE);
+
+	if (batch->window > INT_MAX / NETLINK_BATCH_ACK_SIZE) {
+		batch->window = INT_MAX / NETLINK_BATCH_ACK_SIZE;
+	}
+
+	// room for the ACKs of a whole window - if the kernel refuses, the window is clamped below
+	nl_socket_set_buffer_size(socket, (int) batch->window * NETLINK_BATCH_ACK_SIZE, NETLINK_BATCH_BUFFER_SIZE * 2);
+
+	// failed requests aren't echoed back in their ACKs - older kernels simply ignore this
+	setsockopt(nl_socket_get_fd(socket), SOL_NETLINK, NETLINK_CAP_ACK, &cap_ack, sizeof(cap_ack));
+
+	// the kernel caps the receive buffer (net.core.rmem_max) - ACKs that don't fit are dropped
+	if (getsockopt(nl_socket_get_fd(socket), SOL_SOCKET, SO_RCVBUF, &rcvbuf, &rcvbuf_length) == 0 && (size_t) rcvbuf / NETLINK_BATCH_ACK_SIZE < batch->window) {
+		batch->window = (size_t) rcvbuf / NETLINK_BATCH_ACK_SIZE > 0 ? (size_t) rcvbuf / NETLINK_BATCH_ACK_SIZE : 1;
+	}
+}
+
+int netlink_batch_add(struct netlink_batch *batch, struct nl_msg *msg)
+{
+	int error = 0;
+	struct nlmsghdr *hdr = nlmsg_hdr(msg);
+	uint32_t seq = 0;
+
+	if (NLMSG_ALIGN(hdr->nlmsg_len) > NETLINK_BATCH_BUFFER_SIZE) {
+		return -NLE_MSGSIZE;
+	}
+
+	// full buffer or a whole window packed - hand it to the kernel before packing more requests
+	if (batch->buffer_length + NLMSG_ALIGN(hdr->nlmsg_len) > NETLINK_BATCH_BUFFER_SIZE || batch->count - batch->sent >= batch->window) {
+		error = netlink_batch_send(batch);
+		if (error != 0) {
+			return error;
+		}
+	}
+
+	// ACKs are matched by their offset from the first sequence number
+	seq = nl_socket_use_seq(batch->socket);
+	if (batch->count == 0) {
+		batch->first_seq = seq;
+	} else if (seq != batch->first_seq + (uint32_t) batch->count) {
+		return -NLE_SEQ_MISMATCH;
+	}
+
+	if (batch->count == batch->size) {
+		batch->size = batch->size ? batch->size * 2 : 64;
+		batch->acks = xrealloc(batch->acks, batch->size * sizeof(*batch->acks));
+	}
+
+	batch->acks[batch->count++] = (struct netlink_batch_ack){0};
+
+	// every request is acknowledged - errors and successes alike
+	hdr->nlmsg_seq = seq;
+	hdr->nlmsg_pid = nl_socket_get_local_port(batch->socket);
+	hdr->nlmsg_flags |= NLM_F_REQUEST | NLM_F_ACK;
+
+	memcpy(batch->buffer + batch->buffer_length, hdr, hdr->nlmsg_len);
+	batch->buffer_length += NLMSG_ALIGN(hdr->nlmsg_len);
+
+	return 0;
+}
+
+int netlink_batch_flush(struct netlink_batch *batch)
+{
+	int error = 0;
+
+	error = netlink_batch_send(batch);
+	if (error != 0) {
+		return error;
+	}
+
+	while (batch->completed < batch->sent) {
+		error = netlink_batch_receive(batch);
+		if (error != 0) {
+			return error;
+		}
+	}
+
+	return 0;
+}
+
+void netlink_batch_free(struct netlink_batch *batch)
+{
+	FREE_SAFE(batch->acks);
+	FREE_SAFE(batch->buffer);
+
+	*batch = (struct netlink_batch){0};
+}
+
+static int netlink_batch_send(struct netlink_batch *batch)
+{
+	int error = 0;
+	const size_t packed = batch->count - batch->sent;
+
+	if (batch->buffer_length == 0) {
+		return 0;
+	}
+
+	// keep at most window requests unacknowledged
+	while (batch->sent - batch->completed > 0 && batch->sent - batch->completed + packed > batch->window) {
+		error = netlink_batch_receive(batch);
+		if (error != 0) {
+			return error;
+		}
+	}
+
+	error = nl_sendto(batch->socket, batch->buffer, batch->buffer_length);
+	if (error < 0) {
+		netlink_batch_fail_pending(batch, error);
+		return error;
+	}
+
+	batch->sent = batch->count;
+	batch->buffer_length = 0;
+
+	return 0;
+}
+
+static int netlink_batch_receive(struct netlink_batch *batch)
+{
+	int length = 0;
+	unsigned char *buffer = NULL;
+	struct nlmsghdr *hdr = NULL;
+	struct sockaddr_nl nla = {0};
+
+	length = nl_recv(batch->socket, &nla, &buffer, NULL);
+	if (length <= 0) {
+		free(buffer);
+		netlink_batch_fail_pending(batch, length < 0 ? length : -NLE_FAILURE);
+		return length < 0 ? length : -NLE_FAILURE;
+	}
+
+	hdr = (struct nlmsghdr *) buffer;
+	while (nlmsg_ok(hdr, length)) {
+		const uint32_t INDEX = hdr->nlmsg_seq - batch->first_seq;
+
+		// requests are only answered by ACKs - anything else isn't part of the batch
+		if (hdr->nlmsg_type == NLMSG_ERROR && INDEX < batch->sent && !batch->acks[INDEX].done) {
+			const struct nlmsgerr *ack = nlmsg_data(hdr);
+			struct netlink_batch_ack *request = &batch->acks[INDEX];
+
+			request->error = ack->error != 0 ? -nl_syserr2nlerr(ack->error) : 0;
+			request->done = 1;
+			if (request->error != 0) {
+				batch->failed++;
+			}
+			batch->completed++;
+		}
+
+		hdr = nlmsg_next(hdr, &length);
+	}
+
+	free(buffer);
+
+	return 0;
+}
+
+static void netlink_batch_fail_pending(struct netlink_batch *batch, int error)
+{
+	// the ACKs of outstanding requests can't be matched anymore - only requests still in the buffer never reached the kernel
+	for (size_t i = 0; i < batch->count; i++) {
+		if (!batch->acks[i].done) {
+			batch->acks[i].error = error;
+			batch->acks[i].done = 1;
+			batch->acks[i].lost = i < batch->sent;
+			batch->failed++;
+		}
+	}
+
+	batch->completed = batch->sent = batch->count;
+	batch->buffer_length = 0;
+}
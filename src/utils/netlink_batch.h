@@ -0,0 +1,56 @@
+/*
+ * telekom / sysrepo-plugin-interfaces
+ *
+ * This program is made available under the terms of the
+ * BSD 3-Clause license which is available at
+ * https://opensource.org/licenses/BSD-3-Clause
+ *
+ * SPDX-FileCopyrightText: 2022 Deutsche Telekom AG
+ * SPDX-FileContributor: Sartura Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef NETLINK_BATCH_H_ONCE
+#define NETLINK_BATCH_H_ONCE
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <netlink/msg.h>
+#include <netlink/socket.h>
+
+// bytes of requests packed into a single send
+#define NETLINK_BATCH_BUFFER_SIZE (64 * 1024)
+
+// receive buffer bytes taken by one ACK in flight - the kernel accounts the whole socket buffer, not the message
+#define NETLINK_BATCH_ACK_SIZE 1024
+
+// outcome of one request, in the order the requests were added
+struct netlink_batch_ack {
+	int error; // libnl error code, 0 when acknowledged
+	int done;  // ACK received or the request given up
+	int lost;  // given up after it was sent - the kernel may have applied it
+};
+
+// requests packed into large sends on a socket nothing else uses meanwhile - at most window requests wait for their ACKs at a time
+struct netlink_batch {
+	struct nl_sock *socket;
+	size_t window;
+	uint32_t first_seq;
+	uint8_t *buffer;
+	size_t buffer_length;
+	struct netlink_batch_ack *acks;
+	size_t count;
+	size_t size;
+	size_t sent;
+	size_t completed;
+	size_t failed;
+};
+
+void netlink_batch_init(struct netlink_batch *batch, struct nl_sock *socket, size_t window);
+int netlink_batch_add(struct netlink_batch *batch, struct nl_msg *msg);
+int netlink_batch_flush(struct netlink_batch *batch);
+void netlink_batch_free(struct netlink_batch *batch);
+
+#endif /* NETLINK_BATCH_H_ONCE */
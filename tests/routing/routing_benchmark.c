@@ -0,0 +1,199 @@
+/*
+ * telekom / sysrepo-plugin-interfaces
+ *
+ * This program is made available under the terms of the
+ * BSD 3-Clause license which is available at
+ * https://opensource.org/licenses/BSD-3-Clause
+ *
+ * SPDX-FileCopyrightText: 2022 Deutsche Telekom AG
+ * SPDX-FileContributor: Sartura Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <arpa/inet.h>
+
+#include <netlink/addr.h>
+#include <utlist.h>
+
+#include "rib/trie.h"
+#include "route.h"
+#include "route/list_hash.h"
+
+// synthetic prefixes loaded by default - roughly a full IPv4 BGP table
+#define ROUTING_BENCHMARK_PREFIXES 1000000
+
+static struct nl_addr *build_address(uint32_t index, uint8_t host, int prefixlen);
+static double elapsed_seconds(const struct timespec *start);
+static int benchmark_route_list_hash(uint32_t prefixes);
+static int benchmark_rib_trie(uint32_t prefixes);
+
+int main(int argc, char **argv)
+{
+	uint32_t prefixes = ROUTING_BENCHMARK_PREFIXES;
+
+	// distinct /24 prefixes starting at 1.0.0.0 - at most the rest of the IPv4 space
+	if (argc > 1) {
+		prefixes = (uint32_t) strtoul(argv[1], NULL, 10);
+	}
+
+	if (prefixes == 0 || prefixes > (1U << 24) - (1U << 16)) {
+		fprintf(stderr, "usage: %s [prefixes: 1 - %u]\n", argv[0], (1U << 24) - (1U << 16));
+		return EXIT_FAILURE;
+	}
+
+	if (benchmark_route_list_hash(prefixes) != 0 || benchmark_rib_trie(prefixes) != 0) {
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+static struct nl_addr *build_address(uint32_t index, uint8_t host, int prefixlen)
+{
+	const uint32_t raw_address = htonl((1U << 24) + (index << 8) + host);
+	struct nl_addr *address = nl_addr_build(AF_INET, &raw_address, sizeof(raw_address));
+
+	if (address != NULL && prefixlen >= 0) {
+		nl_addr_set_prefixlen(address, prefixlen);
+	}
+
+	return address;
+}
+
+static double elapsed_seconds(const struct timespec *start)
+{
+	struct timespec now = {0};
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return (double) (now.tv_sec - start->tv_sec) + (double) (now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+static int benchmark_route_list_hash(uint32_t prefixes)
+{
+	struct route_list_hash_element *head = NULL;
+	struct nl_addr *prefix = NULL;
+	struct route route = {0};
+	struct timespec start = {0};
+	uint32_t found = 0;
+
+	route_init(&route);
+	route_list_hash_init(&head);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	for (uint32_t i = 0; i < prefixes; i++) {
+		prefix = build_address(i, 0, 24);
+		if (prefix == NULL) {
+			goto error_out;
+		}
+
+		route_list_hash_add(&head, prefix, &route);
+		nl_addr_put(prefix);
+	}
+
+	printf("route_list_hash: inserted %u prefixes in %.3f s\n", prefixes, elapsed_seconds(&start));
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	for (uint32_t i = 0; i < prefixes; i++) {
+		prefix = build_address(i, 0, 24);
+		if (prefix == NULL) {
+			goto error_out;
+		}
+
+		if (route_list_hash_get(&head, prefix)) {
+			found++;
+		}
+		nl_addr_put(prefix);
+	}
+
+	printf("route_list_hash: looked up %u prefixes in %.3f s\n", prefixes, elapsed_seconds(&start));
+
+	if (found != prefixes) {
+		fprintf(stderr, "route_list_hash: found %u of %u prefixes\n", found, prefixes);
+		goto error_out;
+	}
+
+	route_list_hash_free(&head);
+
+	return 0;
+
+error_out:
+	route_list_hash_free(&head);
+
+	return -1;
+}
+
+static int benchmark_rib_trie(uint32_t prefixes)
+{
+	struct route_list_hash_element *head = NULL, *found = NULL;
+	struct route_list_element *routes_iter = NULL;
+	struct rib_trie trie = {0};
+	struct nl_addr *address = NULL;
+	struct route route = {0};
+	struct timespec start = {0};
+	double elapsed = 0;
+	uint32_t active = 0;
+
+	route_init(&route);
+	route_set_active(&route, true);
+	route_list_hash_init(&head);
+	rib_trie_init(&trie);
+
+	for (uint32_t i = 0; i < prefixes; i++) {
+		address = build_address(i, 0, 24);
+		if (address == NULL) {
+			goto error_out;
+		}
+
+		route_list_hash_add(&head, address, &route);
+		rib_trie_insert(&trie, route_list_hash_get_element(&head, address));
+		nl_addr_put(address);
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	// same work as the active-route RPC - longest-prefix match and the active route of the prefix
+	for (uint32_t i = 0; i < prefixes; i++) {
+		address = build_address(i, 77, -1);
+		if (address == NULL) {
+			goto error_out;
+		}
+
+		found = rib_trie_lookup(&trie, address);
+		if (found) {
+			LL_FOREACH(found->routes_head, routes_iter)
+			{
+				if (routes_iter->route.metadata.active) {
+					active++;
+					break;
+				}
+			}
+		}
+		nl_addr_put(address);
+	}
+
+	elapsed = elapsed_seconds(&start);
+	printf("rib_trie: resolved %u active routes in %.3f s (%.0f lookups/s)\n", prefixes, elapsed, prefixes / elapsed);
+
+	if (active != prefixes) {
+		fprintf(stderr, "rib_trie: resolved %u of %u active routes\n", active, prefixes);
+		goto error_out;
+	}
+
+	rib_trie_free(&trie);
+	route_list_hash_free(&head);
+
+	return 0;
+
+error_out:
+	rib_trie_free(&trie);
+	route_list_hash_free(&head);
+
+	return -1;
+}
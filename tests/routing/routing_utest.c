@@ -5,13 +5,103 @@
 #include <string.h>
 #include <errno.h>
 #include <unistd.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+
+#include <netlink/addr.h>
+#include <netlink/cache.h>
+#include <netlink/msg.h>
+#include <netlink/route/route.h>
+#include <utlist.h>
+
+#include "common.h"
+#include "interface_table.h"
+#include "rib.h"
+#include "rib/mirror.h"
+#include "rib/trie.h"
+#include "route.h"
+#include "route/batch.h"
+#include "route/list_hash.h"
+
+// synthetic prefixes loaded by the bulk tests - routing_benchmark loads a full table
+#define ROUTING_UTEST_BULK_PREFIXES 4096
+
+// most route requests queued by a single route batch test
+#define ROUTING_UTEST_BATCH_ROUTES 4096
+
+// netlink peer of the route batch tests - nl_sendto() and nl_recv() are wrapped, requests are recorded and answered with ACKs
+struct batch_peer {
+	int enabled;
+	uint32_t first_seq;
+	uint32_t pending[ROUTING_UTEST_BATCH_ROUTES];
+	size_t pending_count;
+	int fail[ROUTING_UTEST_BATCH_ROUTES];
+	size_t acks_per_recv; // 0 - all pending ACKs at once
+	int reverse;		  // answer the newest requests first
+	int noise;			  // add messages which aren't ACKs of the batch
+	size_t recv_limit;	  // reads answered before nl_recv() fails, 0 - unlimited
+	size_t recvs;
+	size_t sends;
+	size_t requests;
+	size_t max_send_length;
+	size_t max_pending;
+};
+
+static struct batch_peer batch_peer;
+
+int __real_nl_sendto(struct nl_sock *sk, void *buf, size_t size);
+int __real_nl_recv(struct nl_sock *sk, struct sockaddr_nl *nla, unsigned char **buf, struct ucred **creds);
+int __wrap_nl_sendto(struct nl_sock *sk, void *buf, size_t size);
+int __wrap_nl_recv(struct nl_sock *sk, struct sockaddr_nl *nla, unsigned char **buf, struct ucred **creds);
 
 static void test_correct_routing(void **state);
+static void test_route_list_hash_add_get_correct(void **state);
+static void test_route_list_hash_get_incorrect(void **state);
+static void test_route_list_hash_add_empty_correct(void **state);
+static void test_route_list_hash_prefix_key_correct(void **state);
+static void test_route_list_hash_bulk_correct(void **state);
+static void test_rib_mirror_add_remove_correct(void **state);
+static void test_rib_mirror_remove_incorrect(void **state);
+static void test_rib_trie_lookup_correct(void **state);
+static void test_rib_trie_bulk_correct(void **state);
+static void test_interface_table_correct(void **state);
+static void test_rib_arena_correct(void **state);
+static void test_routing_collect_routes_parallel_correct(void **state);
+static void test_route_batch_window_correct(void **state);
+static void test_route_batch_buffer_correct(void **state);
+static void test_route_batch_ack_correct(void **state);
+static void test_route_batch_lost_ack_correct(void **state);
+
+static struct nl_addr *build_prefix(int family, const char *address, int prefixlen);
+static struct rtnl_route *build_route(struct nl_addr *dst, uint32_t priority);
+static void check_lookup(struct rib_trie *trie, const char *address, struct nl_addr *expected);
+static void batch_peer_start(struct route_batch *batch, unsigned int window);
+static void batch_peer_add_routes(struct route_batch *batch, size_t count);
+static void batch_peer_stop(struct route_batch *batch);
 
 int main(void)
 {
 	const struct CMUnitTest tests[] = {
 		cmocka_unit_test(test_correct_routing),
+		cmocka_unit_test(test_route_list_hash_add_get_correct),
+		cmocka_unit_test(test_route_list_hash_get_incorrect),
+		cmocka_unit_test(test_route_list_hash_add_empty_correct),
+		cmocka_unit_test(test_route_list_hash_prefix_key_correct),
+		cmocka_unit_test(test_route_list_hash_bulk_correct),
+		cmocka_unit_test(test_rib_mirror_add_remove_correct),
+		cmocka_unit_test(test_rib_mirror_remove_incorrect),
+		cmocka_unit_test(test_rib_trie_lookup_correct),
+		cmocka_unit_test(test_rib_trie_bulk_correct),
+		cmocka_unit_test(test_interface_table_correct),
+		cmocka_unit_test(test_rib_arena_correct),
+		cmocka_unit_test(test_routing_collect_routes_parallel_correct),
+		cmocka_unit_test(test_route_batch_window_correct),
+		cmocka_unit_test(test_route_batch_buffer_correct),
+		cmocka_unit_test(test_route_batch_ack_correct),
+		cmocka_unit_test(test_route_batch_lost_ack_correct),
 	};
 
 	return cmocka_run_group_tests(tests, NULL, NULL);
@@ -19,4 +109,874 @@ int main(void)
 
 static void test_correct_routing(void **state)
 {
-}
\ No newline at end of file
+}
+
+static void test_route_list_hash_add_get_correct(void **state)
+{
+	struct route_list_hash_element *head = NULL, *iter = NULL;
+	struct route_list_element **routes_head = NULL;
+	struct nl_addr *prefixes[3] = {0};
+	struct route route = {0};
+	int count = 0;
+
+	route_init(&route);
+	route_list_hash_init(&head);
+
+	prefixes[0] = build_prefix(AF_INET, "10.0.0.0", 8);
+	prefixes[1] = build_prefix(AF_INET, "10.0.0.0", 16);
+	prefixes[2] = build_prefix(AF_INET6, "2001:db8::", 32);
+
+	for (int i = 0; i < 3; i++) {
+		route_list_hash_add(&head, prefixes[i], &route);
+	}
+
+	// second route for an existing prefix goes to the same element
+	route_set_preference(&route, 10);
+	route_list_hash_add(&head, prefixes[1], &route);
+
+	routes_head = route_list_hash_get(&head, prefixes[1]);
+	assert_non_null(routes_head);
+	assert_int_equal((*routes_head)->route.preference, 10);
+	assert_non_null((*routes_head)->next);
+	assert_null((*routes_head)->next->next);
+
+	routes_head = route_list_hash_get(&head, prefixes[2]);
+	assert_non_null(routes_head);
+	assert_null((*routes_head)->next);
+
+	// elements are linked in insertion order
+	LL_FOREACH(head, iter)
+	{
+		assert_int_equal(nl_addr_cmp(iter->prefix, prefixes[count]), 0);
+		count++;
+	}
+	assert_int_equal(count, 3);
+
+	for (int i = 0; i < 3; i++) {
+		nl_addr_put(prefixes[i]);
+	}
+
+	route_list_hash_free(&head);
+	assert_null(head);
+}
+
+static void test_route_list_hash_get_incorrect(void **state)
+{
+	struct route_list_hash_element *head = NULL;
+	struct nl_addr *prefix = NULL, *other = NULL;
+	struct route route = {0};
+
+	route_init(&route);
+	route_list_hash_init(&head);
+
+	prefix = build_prefix(AF_INET, "192.168.1.0", 24);
+	assert_null(route_list_hash_get(&head, prefix));
+
+	route_list_hash_add(&head, prefix, &route);
+
+	// same address with another prefix length
+	other = build_prefix(AF_INET, "192.168.1.0", 25);
+	assert_null(route_list_hash_get(&head, other));
+	nl_addr_put(other);
+
+	// same bytes in another family
+	other = build_prefix(AF_INET6, "c0a8:100::", 24);
+	assert_null(route_list_hash_get(&head, other));
+	nl_addr_put(other);
+
+	nl_addr_put(prefix);
+	route_list_hash_free(&head);
+}
+
+static void test_route_list_hash_add_empty_correct(void **state)
+{
+	struct route_list_hash_element *head = NULL, *iter = NULL;
+	struct route_list_element **routes_head = NULL;
+	struct nl_addr *prefixes[3] = {0};
+	struct route route = {0};
+	int count = 0;
+
+	route_init(&route);
+	route_list_hash_init(&head);
+
+	prefixes[0] = build_prefix(AF_INET, "10.0.0.0", 8);
+	prefixes[1] = build_prefix(AF_INET, "172.16.0.0", 12);
+	prefixes[2] = build_prefix(AF_INET6, "2001:db8::", 32);
+
+	route_list_hash_add_empty(&head, prefixes[0]);
+	route_list_hash_add(&head, prefixes[1], &route);
+	route_list_hash_add_empty(&head, prefixes[2]);
+
+	// empty elements are found like any other, just without routes
+	assert_non_null(route_list_hash_get_element(&head, prefixes[0]));
+	routes_head = route_list_hash_get(&head, prefixes[0]);
+	assert_non_null(routes_head);
+	assert_null(*routes_head);
+
+	// adding an existing prefix again keeps its routes
+	route_list_hash_add_empty(&head, prefixes[1]);
+	routes_head = route_list_hash_get(&head, prefixes[1]);
+	assert_non_null(routes_head);
+	assert_non_null(*routes_head);
+
+	// a route added later goes to the empty element
+	route_list_hash_add(&head, prefixes[2], &route);
+	routes_head = route_list_hash_get(&head, prefixes[2]);
+	assert_non_null(routes_head);
+	assert_non_null(*routes_head);
+	assert_null((*routes_head)->next);
+
+	// empty elements are linked in insertion order as well
+	LL_FOREACH(head, iter)
+	{
+		assert_int_equal(nl_addr_cmp(iter->prefix, prefixes[count]), 0);
+		count++;
+	}
+	assert_int_equal(count, 3);
+
+	route_list_hash_remove(&head, prefixes[0]);
+	assert_null(route_list_hash_get_element(&head, prefixes[0]));
+	assert_int_equal(nl_addr_cmp(head->prefix, prefixes[1]), 0);
+
+	for (int i = 0; i < 3; i++) {
+		nl_addr_put(prefixes[i]);
+	}
+
+	route_list_hash_free(&head);
+	assert_null(head);
+}
+
+static void test_route_list_hash_prefix_key_correct(void **state)
+{
+	struct route_list_hash_element *head = NULL;
+	struct nl_addr *prefix = NULL, *other = NULL;
+	struct route route = {0};
+
+	route_init(&route);
+	route_list_hash_init(&head);
+
+	// the kernel default route carries no address bytes, the configured one does
+	prefix = nl_addr_alloc(0);
+	assert_non_null(prefix);
+	nl_addr_set_family(prefix, AF_INET);
+	route_list_hash_add(&head, prefix, &route);
+	nl_addr_put(prefix);
+
+	other = build_prefix(AF_INET, "0.0.0.0", 0);
+	assert_non_null(route_list_hash_get(&head, other));
+	nl_addr_put(other);
+
+	other = build_prefix(AF_INET6, "::", 0);
+	assert_null(route_list_hash_get(&head, other));
+	nl_addr_put(other);
+
+	// host bits are not part of the key
+	prefix = build_prefix(AF_INET, "10.1.0.0", 12);
+	route_list_hash_add(&head, prefix, &route);
+	nl_addr_put(prefix);
+
+	other = build_prefix(AF_INET, "10.15.255.255", 12);
+	assert_non_null(route_list_hash_get(&head, other));
+	nl_addr_put(other);
+
+	other = build_prefix(AF_INET, "10.16.0.0", 12);
+	assert_null(route_list_hash_get(&head, other));
+	nl_addr_put(other);
+
+	route_list_hash_free(&head);
+}
+
+static void test_route_list_hash_bulk_correct(void **state)
+{
+	struct route_list_hash_element *head = NULL;
+	struct nl_addr *prefix = NULL;
+	struct route route = {0};
+	uint32_t address = 0;
+	int found = 0;
+
+	route_init(&route);
+	route_list_hash_init(&head);
+
+	for (uint32_t i = 0; i < ROUTING_UTEST_BULK_PREFIXES; i++) {
+		// distinct /24 prefixes starting at 1.0.0.0
+		address = htonl((1U << 24) + (i << 8));
+		prefix = nl_addr_build(AF_INET, &address, sizeof(address));
+		assert_non_null(prefix);
+		nl_addr_set_prefixlen(prefix, 24);
+
+		route_list_hash_add(&head, prefix, &route);
+		nl_addr_put(prefix);
+	}
+
+	assert_int_equal(HASH_COUNT(head), ROUTING_UTEST_BULK_PREFIXES);
+
+	for (uint32_t i = 0; i < ROUTING_UTEST_BULK_PREFIXES; i++) {
+		address = htonl((1U << 24) + (i << 8));
+		prefix = nl_addr_build(AF_INET, &address, sizeof(address));
+		assert_non_null(prefix);
+		nl_addr_set_prefixlen(prefix, 24);
+
+		if (route_list_hash_get(&head, prefix)) {
+			found++;
+		}
+		nl_addr_put(prefix);
+	}
+
+	assert_int_equal(found, ROUTING_UTEST_BULK_PREFIXES);
+
+	route_list_hash_free(&head);
+}
+
+static void test_rib_mirror_add_remove_correct(void **state)
+{
+	struct rib_mirror mirror = {0};
+	struct rib *rib = NULL;
+	struct route_list_element **routes_head = NULL;
+	struct nl_addr *prefix = NULL;
+	struct rtnl_route *routes[2] = {0};
+
+	rib_mirror_init(&mirror);
+
+	prefix = build_prefix(AF_INET, "10.1.0.0", 16);
+	routes[0] = build_route(prefix, 100);
+	routes[1] = build_route(prefix, 50);
+
+	// first route creates the main table RIB
+	assert_int_equal(rib_mirror_add_route(&mirror, routes[0]), 0);
+	rib = rib_list_get(&mirror.ribs_head, "main", AF_INET);
+	assert_non_null(rib);
+	assert_int_equal(rib->default_rib, 1);
+
+	routes_head = route_list_hash_get(&rib->routes_head, prefix);
+	assert_non_null(routes_head);
+	assert_int_equal((*routes_head)->route.metadata.active, 1);
+
+	// lower preference value takes over the active flag
+	assert_int_equal(rib_mirror_add_route(&mirror, routes[1]), 0);
+	assert_int_equal((*routes_head)->route.preference, 50);
+	assert_int_equal((*routes_head)->route.metadata.active, 1);
+	assert_int_equal((*routes_head)->next->route.metadata.active, 0);
+
+	// and hands it back once removed
+	assert_int_equal(rib_mirror_remove_route(&mirror, routes[1]), 0);
+	assert_null((*routes_head)->next);
+	assert_int_equal((*routes_head)->route.preference, 100);
+	assert_int_equal((*routes_head)->route.metadata.active, 1);
+
+	// last route removes the prefix
+	assert_int_equal(rib_mirror_remove_route(&mirror, routes[0]), 0);
+	assert_null(route_list_hash_get(&rib->routes_head, prefix));
+	assert_null(rib->routes_head);
+
+	rtnl_route_put(routes[0]);
+	rtnl_route_put(routes[1]);
+	nl_addr_put(prefix);
+
+	rib_mirror_free(&mirror);
+	assert_null(mirror.ribs_head);
+}
+
+static void test_rib_mirror_remove_incorrect(void **state)
+{
+	struct rib_mirror mirror = {0};
+	struct nl_addr *prefix = NULL;
+	struct rtnl_route *route = NULL, *other = NULL;
+
+	rib_mirror_init(&mirror);
+
+	prefix = build_prefix(AF_INET6, "2001:db8::", 32);
+	route = build_route(prefix, 1024);
+
+	// no RIB for the table yet
+	assert_int_not_equal(rib_mirror_remove_route(&mirror, route), 0);
+
+	assert_int_equal(rib_mirror_add_route(&mirror, route), 0);
+
+	// same prefix with an unknown preference
+	other = build_route(prefix, 256);
+	assert_int_not_equal(rib_mirror_remove_route(&mirror, other), 0);
+	rtnl_route_put(other);
+
+	rtnl_route_put(route);
+	nl_addr_put(prefix);
+
+	rib_mirror_free(&mirror);
+}
+
+static void test_rib_trie_lookup_correct(void **state)
+{
+	struct route_list_hash_element *head = NULL;
+	struct rib_trie trie = {0};
+	struct nl_addr *prefixes[4] = {0};
+	struct route route = {0};
+
+	route_init(&route);
+	route_list_hash_init(&head);
+	rib_trie_init(&trie);
+
+	prefixes[0] = nl_addr_build(AF_INET, NULL, 0);
+	assert_non_null(prefixes[0]);
+	prefixes[1] = build_prefix(AF_INET, "10.0.0.0", 8);
+	prefixes[2] = build_prefix(AF_INET, "10.1.0.0", 16);
+	prefixes[3] = build_prefix(AF_INET, "10.1.2.0", 24);
+
+	// no routes at all
+	check_lookup(&trie, "10.1.2.3", NULL);
+
+	for (int i = 0; i < 4; i++) {
+		route_list_hash_add(&head, prefixes[i], &route);
+		rib_trie_insert(&trie, route_list_hash_get_element(&head, prefixes[i]));
+	}
+
+	check_lookup(&trie, "10.1.2.3", prefixes[3]);
+	check_lookup(&trie, "10.1.3.1", prefixes[2]);
+	check_lookup(&trie, "10.2.0.1", prefixes[1]);
+	check_lookup(&trie, "11.0.0.1", prefixes[0]);
+
+	// lookups fall back to the next shorter prefix
+	rib_trie_remove(&trie, prefixes[2]);
+	check_lookup(&trie, "10.1.3.1", prefixes[1]);
+	check_lookup(&trie, "10.1.2.3", prefixes[3]);
+
+	rib_trie_remove(&trie, prefixes[0]);
+	check_lookup(&trie, "11.0.0.1", NULL);
+
+	rib_trie_free(&trie);
+	assert_null(trie.root);
+
+	for (int i = 0; i < 4; i++) {
+		nl_addr_put(prefixes[i]);
+	}
+
+	route_list_hash_free(&head);
+}
+
+static void test_rib_trie_bulk_correct(void **state)
+{
+	struct route_list_hash_element *head = NULL, *found = NULL;
+	struct route_list_element *routes_iter = NULL;
+	struct rib_trie trie = {0};
+	struct nl_addr *address = NULL;
+	struct route route = {0};
+	uint32_t raw_address = 0;
+	int active = 0;
+
+	route_init(&route);
+	route_set_active(&route, true);
+	route_list_hash_init(&head);
+	rib_trie_init(&trie);
+
+	for (uint32_t i = 0; i < ROUTING_UTEST_BULK_PREFIXES; i++) {
+		raw_address = htonl((1U << 24) + (i << 8));
+		address = nl_addr_build(AF_INET, &raw_address, sizeof(raw_address));
+		assert_non_null(address);
+		nl_addr_set_prefixlen(address, 24);
+
+		route_list_hash_add(&head, address, &route);
+		rib_trie_insert(&trie, route_list_hash_get_element(&head, address));
+		nl_addr_put(address);
+	}
+
+	// same work as the active-route RPC - longest-prefix match and the active route of the prefix
+	for (uint32_t i = 0; i < ROUTING_UTEST_BULK_PREFIXES; i++) {
+		raw_address = htonl((1U << 24) + (i << 8) + 77);
+		address = nl_addr_build(AF_INET, &raw_address, sizeof(raw_address));
+		assert_non_null(address);
+
+		found = rib_trie_lookup(&trie, address);
+		if (found) {
+			LL_FOREACH(found->routes_head, routes_iter)
+			{
+				if (routes_iter->route.metadata.active) {
+					active++;
+					break;
+				}
+			}
+		}
+		nl_addr_put(address);
+	}
+
+	assert_int_equal(active, ROUTING_UTEST_BULK_PREFIXES);
+
+	rib_trie_free(&trie);
+	route_list_hash_free(&head);
+}
+
+static void test_interface_table_correct(void **state)
+{
+	struct interface_table table = {0};
+
+	interface_table_init(&table);
+
+	// unknown and invalid indexes
+	assert_null(interface_table_get_name(&table, 1));
+	assert_null(interface_table_get_name(&table, -1));
+
+	interface_table_set(&table, 1, "lo");
+	interface_table_set(&table, 1000, "eth0");
+	assert_string_equal(interface_table_get_name(&table, 1), "lo");
+	assert_string_equal(interface_table_get_name(&table, 1000), "eth0");
+	assert_null(interface_table_get_name(&table, 999));
+
+	// renamed link
+	interface_table_set(&table, 1000, "wan0");
+	assert_string_equal(interface_table_get_name(&table, 1000), "wan0");
+
+	interface_table_remove(&table, 1000);
+	assert_null(interface_table_get_name(&table, 1000));
+	assert_string_equal(interface_table_get_name(&table, 1), "lo");
+
+	interface_table_free(&table);
+	assert_null(table.names);
+	assert_int_equal(table.size, 0);
+}
+
+static void test_rib_arena_correct(void **state)
+{
+	struct rib rib = {0};
+	struct route route = {0};
+	struct route_list_element **routes_head = NULL;
+	struct route_list_element *released = NULL;
+	struct route_next_hop_list_element *nexthop_iter = NULL;
+	struct nl_addr *prefix = build_prefix(AF_INET6, "2001:db8::", 64);
+	struct nl_addr *gateways[2] = {
+		build_prefix(AF_INET6, "fe80::1", 128),
+		build_prefix(AF_INET6, "fe80::2", 128),
+	};
+	char ip_buffer[INET6_ADDRSTRLEN] = {0};
+	int count = 0;
+
+	rib_init(&rib);
+
+	// multipath route - record and next-hops are carved from the RIB arena
+	route_init(&route);
+	route_set_preference(&route, 1024);
+	route_set_source_protocol(&route, route_source_protocol_static);
+	route_next_hop_add_list(&route.next_hop, 2, gateways[0]);
+	route_next_hop_add_list(&route.next_hop, 3, gateways[1]);
+
+	route_list_hash_add_arena(&rib.routes_head, &rib.routes_arena, prefix, &route);
+	assert_int_equal(rib.routes_arena.routes.objects, 1);
+	assert_int_equal(rib.routes_arena.next_hops.objects, 2);
+
+	routes_head = route_list_hash_get(&rib.routes_head, prefix);
+	assert_non_null(routes_head);
+	assert_string_equal(route_source_protocol2str((*routes_head)->route.metadata.source_protocol), "ietf-routing:static");
+
+	LL_FOREACH((*routes_head)->route.next_hop.value.list_head, nexthop_iter)
+	{
+		assert_int_equal(nexthop_iter->simple.ifindex, count + 2);
+		assert_string_equal(route_address2str(&nexthop_iter->simple.addr, ip_buffer, sizeof(ip_buffer)), count == 0 ? "fe80::1" : "fe80::2");
+		count++;
+	}
+	assert_int_equal(count, 2);
+
+	// a released record is reused by the next route
+	released = *routes_head;
+	route_list_remove_arena(routes_head, &rib.routes_arena, released);
+	assert_int_equal(rib.routes_arena.routes.objects, 0);
+	assert_int_equal(rib.routes_arena.next_hops.objects, 0);
+
+	route_list_hash_add_arena(&rib.routes_head, &rib.routes_arena, prefix, &route);
+	assert_ptr_equal(*routes_head, released);
+
+	route_free(&route);
+	nl_addr_put(gateways[0]);
+	nl_addr_put(gateways[1]);
+	nl_addr_put(prefix);
+
+	rib_free(&rib);
+	assert_null(rib.routes_head);
+	assert_int_equal(route_arena_size(&rib.routes_arena), 0);
+}
+
+static void test_routing_collect_routes_parallel_correct(void **state)
+{
+	struct nl_cache *cache = NULL;
+	struct rib_list_element *sequential_head = NULL, *parallel_head = NULL;
+	struct rib_list_element *ribs_iter = NULL;
+	const int tables[] = {RT_TABLE_MAIN, RT_TABLE_LOCAL, 100};
+	char address_buffer[INET6_ADDRSTRLEN];
+
+	assert_int_equal(nl_cache_alloc_name("route/route", &cache), 0);
+
+	// interleave tables and families so every RIB is split across the dump
+	for (int i = 0; i < 3000; i++) {
+		const int family = i % 2 ? AF_INET6 : AF_INET;
+		struct nl_addr *prefix = NULL;
+		struct rtnl_route *route = NULL;
+
+		if (family == AF_INET) {
+			snprintf(address_buffer, sizeof(address_buffer), "10.%d.%d.0", (i / 256) % 256, i % 256);
+		} else {
+			snprintf(address_buffer, sizeof(address_buffer), "2001:db8:%x::", i % 1000);
+		}
+
+		prefix = build_prefix(family, address_buffer, family == AF_INET ? 24 : 48);
+		route = build_route(prefix, (uint32_t) (i % 7));
+		rtnl_route_set_table(route, (uint32_t) tables[(i / 2) % 3]);
+
+		assert_int_equal(nl_cache_add(cache, (struct nl_object *) route), 0);
+
+		rtnl_route_put(route);
+		nl_addr_put(prefix);
+	}
+
+	rib_list_init(&sequential_head);
+	rib_list_init(&parallel_head);
+
+	assert_int_equal(routing_collect_routes(cache, &sequential_head, 1), 0);
+	assert_int_equal(routing_collect_routes(cache, &parallel_head, 4), 0);
+
+	// workers only change who builds a RIB, never its contents
+	LL_FOREACH(sequential_head, ribs_iter)
+	{
+		struct rib *sequential = &ribs_iter->rib;
+		struct rib *parallel = rib_list_get(&parallel_head, sequential->name, sequential->address_family);
+		struct route_list_hash_element *hash_iter = NULL;
+		size_t sequential_count = 0, parallel_count = 0;
+
+		assert_non_null(parallel);
+
+		LL_COUNT(sequential->routes_head, hash_iter, sequential_count);
+		LL_COUNT(parallel->routes_head, hash_iter, parallel_count);
+		assert_int_equal(sequential_count, parallel_count);
+
+		LL_FOREACH(sequential->routes_head, hash_iter)
+		{
+			struct route_list_element **routes_head = route_list_hash_get(&parallel->routes_head, hash_iter->prefix);
+			struct route_list_element *routes_iter = NULL, *parallel_iter = NULL;
+
+			assert_non_null(routes_head);
+			parallel_iter = *routes_head;
+
+			LL_FOREACH(hash_iter->routes_head, routes_iter)
+			{
+				assert_non_null(parallel_iter);
+				assert_int_equal(routes_iter->route.preference, parallel_iter->route.preference);
+				assert_int_equal(routes_iter->route.metadata.active, parallel_iter->route.metadata.active);
+				parallel_iter = parallel_iter->next;
+			}
+			assert_null(parallel_iter);
+
+			assert_int_equal(nl_addr_cmp(rib_trie_lookup(&parallel->routes_trie, hash_iter->prefix)->prefix, hash_iter->prefix), 0);
+		}
+	}
+
+	rib_list_free(&sequential_head);
+	rib_list_free(&parallel_head);
+	nl_cache_free(cache);
+}
+
+static void test_route_batch_window_correct(void **state)
+{
+	struct route_batch batch = {0};
+
+	batch_peer_start(&batch, 4);
+	batch_peer_add_routes(&batch, 10);
+	assert_int_equal(batch.requests.window, 4);
+
+	// a full window is sent before the fifth request is packed
+	assert_int_equal(batch_peer.sends, 2);
+	assert_int_equal(route_batch_flush(&batch), 0);
+
+	assert_int_equal(batch_peer.sends, 3);
+	assert_int_equal(batch_peer.requests, 10);
+	assert_true(batch_peer.max_pending <= 4);
+
+	assert_int_equal(batch.requests.completed, 10);
+	assert_int_equal(batch.failed, 0);
+	assert_null(route_batch_log_failures(&batch));
+
+	batch_peer_stop(&batch);
+}
+
+static void test_route_batch_buffer_correct(void **state)
+{
+	struct route_batch batch = {0};
+
+	// the window never fills - only the buffer size splits the sends
+	batch_peer_start(&batch, ROUTING_UTEST_BATCH_ROUTES);
+	batch_peer_add_routes(&batch, 3000);
+
+	assert_true(batch_peer.sends >= 1);
+	assert_int_equal(route_batch_flush(&batch), 0);
+
+	assert_true(batch_peer.sends >= 2);
+	assert_true(batch_peer.max_send_length <= NETLINK_BATCH_BUFFER_SIZE);
+	assert_int_equal(batch_peer.requests, 3000);
+
+	// every request was pipelined before the first ACK was read
+	assert_int_equal(batch_peer.max_pending, 3000);
+	assert_int_equal(batch.requests.completed, 3000);
+	assert_int_equal(batch.failed, 0);
+
+	batch_peer_stop(&batch);
+}
+
+static void test_route_batch_ack_correct(void **state)
+{
+	struct route_batch batch = {0};
+	const struct route_batch_entry *first_failed = NULL;
+	struct nl_addr *prefix = NULL;
+
+	batch_peer_start(&batch, 16);
+
+	// ACKs come back newest first, a few per read and mixed with other messages
+	batch_peer.acks_per_recv = 5;
+	batch_peer.reverse = 1;
+	batch_peer.noise = 1;
+	batch_peer.fail[3] = batch_peer.fail[17] = batch_peer.fail[39] = 1;
+
+	batch_peer_add_routes(&batch, 40);
+	assert_int_equal(route_batch_flush(&batch), 0);
+
+	assert_int_equal(batch.requests.completed, 40);
+	assert_int_equal(batch.failed, 3);
+	assert_true(batch_peer.max_pending <= 16);
+
+	for (size_t i = 0; i < batch.entries_count; i++) {
+		assert_int_equal(batch.entries[i].error, batch_peer.fail[i] ? -NLE_EXIST : 0);
+	}
+
+	// the first failed request is reported with its own prefix and operation
+	first_failed = route_batch_log_failures(&batch);
+	assert_ptr_equal(first_failed, &batch.entries[3]);
+	assert_int_equal(first_failed->operation, route_batch_operation_add);
+	assert_int_equal(batch.entries[17].operation, route_batch_operation_delete);
+
+	prefix = build_prefix(AF_INET, "10.0.0.3", 32);
+	assert_int_equal(nl_addr_cmp(first_failed->prefix, prefix), 0);
+	nl_addr_put(prefix);
+
+	batch_peer_stop(&batch);
+}
+
+static void test_route_batch_lost_ack_correct(void **state)
+{
+	struct route_batch batch = {0};
+
+	batch_peer_start(&batch, 64);
+
+	// two reads are answered, then the socket fails with requests still waiting for their ACKs
+	batch_peer.acks_per_recv = 5;
+	batch_peer.recv_limit = 2;
+	batch_peer.fail[3] = 1;
+
+	batch_peer_add_routes(&batch, 40);
+	assert_int_equal(route_batch_flush(&batch), -1);
+
+	assert_int_equal(batch.requests.completed, 40);
+	assert_int_equal(batch.failed, 31);
+
+	// acknowledged requests keep their own outcome - unanswered ones may have been applied
+	for (size_t i = 0; i < 10; i++) {
+		assert_int_equal(batch.requests.acks[i].error, i == 3 ? -NLE_EXIST : 0);
+		assert_false(batch.requests.acks[i].lost);
+	}
+
+	for (size_t i = 10; i < 40; i++) {
+		assert_int_equal(batch.entries[i].error, -NLE_NOMEM);
+		assert_true(batch.requests.acks[i].lost);
+	}
+
+	batch_peer_stop(&batch);
+}
+
+static struct nl_addr *build_prefix(int family, const char *address, int prefixlen)
+{
+	unsigned char buffer[16] = {0};
+	struct nl_addr *addr = NULL;
+
+	assert_int_equal(inet_pton(family, address, buffer), 1);
+
+	addr = nl_addr_build(family, buffer, family == AF_INET ? 4 : 16);
+	assert_non_null(addr);
+	nl_addr_set_prefixlen(addr, prefixlen);
+
+	return addr;
+}
+
+static struct rtnl_route *build_route(struct nl_addr *dst, uint32_t priority)
+{
+	struct rtnl_route *route = rtnl_route_alloc();
+
+	assert_non_null(route);
+
+	rtnl_route_set_family(route, (uint8_t) nl_addr_get_family(dst));
+	rtnl_route_set_table(route, RT_TABLE_MAIN);
+	rtnl_route_set_type(route, RTN_UNICAST);
+	rtnl_route_set_protocol(route, RTPROT_STATIC);
+	rtnl_route_set_priority(route, priority);
+	assert_int_equal(rtnl_route_set_dst(route, dst), 0);
+
+	return route;
+}
+
+static void check_lookup(struct rib_trie *trie, const char *address, struct nl_addr *expected)
+{
+	struct route_list_hash_element *found = NULL;
+	struct nl_addr *destination = build_prefix(AF_INET, address, 32);
+
+	found = rib_trie_lookup(trie, destination);
+	if (expected == NULL) {
+		assert_null(found);
+	} else {
+		assert_non_null(found);
+		assert_int_equal(nl_addr_cmp(found->prefix, expected), 0);
+	}
+
+	nl_addr_put(destination);
+}
+
+static void batch_peer_start(struct route_batch *batch, unsigned int window)
+{
+	struct nl_sock *socket = nl_socket_alloc();
+
+	assert_non_null(socket);
+
+	// the socket is never connected - all requests end up in the wrapped nl_sendto()
+	batch_peer = (struct batch_peer){0};
+	batch_peer.enabled = 1;
+
+	route_batch_init(batch, socket, window);
+}
+
+static void batch_peer_add_routes(struct route_batch *batch, size_t count)
+{
+	static const enum route_batch_operation OPERATIONS[] = {route_batch_operation_add, route_batch_operation_replace, route_batch_operation_delete};
+	struct nl_addr *prefix = NULL;
+	struct rtnl_route *route = NULL;
+	uint32_t address = 0;
+
+	for (size_t i = 0; i < count; i++) {
+		// distinct /32 routes starting at 10.0.0.0
+		address = htonl((10U << 24) + (uint32_t) i);
+		prefix = nl_addr_build(AF_INET, &address, sizeof(address));
+		assert_non_null(prefix);
+		nl_addr_set_prefixlen(prefix, 32);
+
+		route = build_route(prefix, 100);
+		assert_int_equal(route_batch_add(batch, OPERATIONS[i % 3], route), 0);
+
+		rtnl_route_put(route);
+		nl_addr_put(prefix);
+	}
+}
+
+static void batch_peer_stop(struct route_batch *batch)
+{
+	struct nl_sock *socket = batch->requests.socket;
+
+	route_batch_free(batch);
+	nl_socket_free(socket);
+
+	batch_peer.enabled = 0;
+}
+
+int __wrap_nl_sendto(struct nl_sock *sk, void *buf, size_t size)
+{
+	struct nlmsghdr *hdr = (struct nlmsghdr *) buf;
+	int length = (int) size;
+
+	if (!batch_peer.enabled) {
+		return __real_nl_sendto(sk, buf, size);
+	}
+
+	batch_peer.sends++;
+	if (size > batch_peer.max_send_length) {
+		batch_peer.max_send_length = size;
+	}
+
+	while (nlmsg_ok(hdr, length)) {
+		assert_true(hdr->nlmsg_flags & NLM_F_ACK);
+
+		// requests of a batch carry consecutive sequence numbers
+		if (batch_peer.requests == 0) {
+			batch_peer.first_seq = hdr->nlmsg_seq;
+		}
+		assert_int_equal(hdr->nlmsg_seq, batch_peer.first_seq + batch_peer.requests);
+		assert_true(batch_peer.pending_count < ROUTING_UTEST_BATCH_ROUTES);
+
+		batch_peer.pending[batch_peer.pending_count++] = hdr->nlmsg_seq;
+		batch_peer.requests++;
+
+		hdr = nlmsg_next(hdr, &length);
+	}
+
+	if (batch_peer.pending_count > batch_peer.max_pending) {
+		batch_peer.max_pending = batch_peer.pending_count;
+	}
+
+	return (int) size;
+}
+
+int __wrap_nl_recv(struct nl_sock *sk, struct sockaddr_nl *nla, unsigned char **buf, struct ucred **creds)
+{
+	const size_t ACK_LENGTH = NLMSG_ALIGN(NLMSG_LENGTH(sizeof(struct nlmsgerr)));
+	const size_t NOTIFICATION_LENGTH = NLMSG_ALIGN(NLMSG_LENGTH(sizeof(struct rtmsg)));
+	size_t count = batch_peer.pending_count;
+	size_t length = 0;
+	unsigned char *buffer = NULL;
+	struct nlmsghdr *hdr = NULL;
+
+	if (!batch_peer.enabled) {
+		return __real_nl_recv(sk, nla, buf, creds);
+	}
+
+	// the batch only waits for ACKs of requests it has sent
+	assert_true(count > 0);
+
+	// receive buffer overrun - the kernel dropped the remaining ACKs
+	if (batch_peer.recv_limit > 0 && batch_peer.recvs++ == batch_peer.recv_limit) {
+		return -NLE_NOMEM;
+	}
+
+	if (batch_peer.acks_per_recv > 0 && batch_peer.acks_per_recv < count) {
+		count = batch_peer.acks_per_recv;
+	}
+
+	buffer = calloc(1, count * ACK_LENGTH + 2 * NOTIFICATION_LENGTH);
+	assert_non_null(buffer);
+
+	if (batch_peer.noise) {
+		// a route notification and an ACK of a request outside the batch
+		hdr = (struct nlmsghdr *) (buffer + length);
+		hdr->nlmsg_len = NLMSG_LENGTH(sizeof(struct rtmsg));
+		hdr->nlmsg_type = RTM_NEWROUTE;
+		length += NOTIFICATION_LENGTH;
+
+		hdr = (struct nlmsghdr *) (buffer + length);
+		hdr->nlmsg_len = NLMSG_LENGTH(sizeof(struct rtmsg));
+		hdr->nlmsg_type = NLMSG_ERROR;
+		hdr->nlmsg_seq = batch_peer.first_seq - 1;
+		length += NOTIFICATION_LENGTH;
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		const size_t INDEX = batch_peer.reverse ? batch_peer.pending_count - 1 - i : i;
+		const uint32_t SEQ = batch_peer.pending[INDEX];
+		struct nlmsgerr *ack = NULL;
+
+		hdr = (struct nlmsghdr *) (buffer + length);
+		hdr->nlmsg_len = NLMSG_LENGTH(sizeof(struct nlmsgerr));
+		hdr->nlmsg_type = NLMSG_ERROR;
+		hdr->nlmsg_seq = SEQ;
+
+		ack = nlmsg_data(hdr);
+		ack->error = batch_peer.fail[SEQ - batch_peer.first_seq] ? -EEXIST : 0;
+		ack->msg.nlmsg_seq = SEQ;
+
+		length += ACK_LENGTH;
+	}
+
+	// drop the answered requests - reversed ACKs are taken from the end
+	if (!batch_peer.reverse) {
+		memmove(batch_peer.pending, batch_peer.pending + count, (batch_peer.pending_count - count) * sizeof(*batch_peer.pending));
+	}
+	batch_peer.pending_count -= count;
+
+	*buf = buffer;
+
+	return (int) length;
+}